@@ -64,7 +64,7 @@
 typedef struct EventGroupDef_t
 {
     EventBits_t uxEventBits;
-    List_t xTasksWaitingForBits; /*< List of tasks waiting for a bit to be set. */
+    List_t xTasksWaitingForBits[ configEVENT_GROUP_WAITER_BUCKETS ]; /*< Lists of tasks waiting for a bit to be set.  A task is held in the list indexed by one of the bits it waits for, see prvPlaceOnWaitingList(). */
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxEventGroupNumber;
@@ -73,6 +73,18 @@ typedef struct EventGroupDef_t
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
     #endif
+
+    #if ( configUSE_MULTI_WAIT == 1 )
+        TaskHandle_t xMultiWaitTask;    /*< The task, if any, that is waiting for the event group in uxMultiWaitForAny(). */
+        EventBits_t uxMultiWaitBits;    /*< The bits xMultiWaitTask is waiting for - it is notified when any of them are set. */
+    #endif
+
+    EventBits_t uxBucketBits[ configEVENT_GROUP_WAITER_BUCKETS ]; /*< For each list in xTasksWaitingForBits, a superset of the bits that, when set, can unblock a task in the list. */
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+        UBaseType_t uxLocks;         /*< Non-zero while a task is accessing the event group with the scheduler suspended.  Interrupts do not access the lists of waiting tasks while it is set. */
+        EventBits_t uxBitsSetFromISR; /*< Bits set by interrupts while the event group was locked, to be set by the task that unlocks it. */
+    #endif
 } EventGroup_t;
 
 /*-----------------------------------------------------------*/
@@ -89,6 +101,79 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the lists that hold the tasks waiting for bits to be set, and the
+ * state used to set bits from interrupts.
+ */
+static void prvInitialiseWaitingLists( EventGroup_t * pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the index of the list in xTasksWaitingForBits that holds tasks that
+ * wait for the lowest bit set in uxBits.  uxBits must not be zero.
+ */
+static UBaseType_t prvGetBucketIndex( EventBits_t uxBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place the calling task on the list of tasks waiting for bits, then block.
+ * A task waiting for any of its bits is held in the list indexed by the
+ * lowest of them, and that list records all of them in uxBucketBits.  A task
+ * waiting for all of its bits is held in the list indexed by the lowest of
+ * them that is not yet set, as it cannot be unblocked until that bit is set.
+ * Must be called with the scheduler suspended.
+ */
+static void prvPlaceOnWaitingList( EventGroup_t * pxEventBits,
+                                   const EventBits_t uxBitsToWaitFor,
+                                   const EventBits_t uxControlBits,
+                                   const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set bits in the event group and unblock the tasks whose wait condition is
+ * then met.  If xFromISR is pdFALSE this must be called with the scheduler
+ * suspended and the event group locked, otherwise it must be called from a
+ * critical section while the event group is not locked.  Returns pdTRUE if
+ * xFromISR is not pdFALSE and a task with a priority above the interrupted
+ * task was unblocked.
+ */
+static BaseType_t prvSetBitsAndUnblockTasks( EventGroup_t * pxEventBits,
+                                             const EventBits_t uxBitsToSet,
+                                             const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+/*
+ * Interrupts set bits directly, from a critical section, so a task that
+ * accesses the lists of waiting tasks with the scheduler suspended locks the
+ * event group first.  Bits that interrupts set while the event group is locked
+ * are set by prvUnlockEventGroup(), in the same way a locked queue is
+ * processed by prvUnlockQueue().
+ */
+    static void prvLockEventGroup( EventGroup_t * pxEventBits ) PRIVILEGED_FUNCTION;
+    static void prvUnlockEventGroup( EventGroup_t * pxEventBits ) PRIVILEGED_FUNCTION;
+#else
+    #define prvLockEventGroup( pxEventBits )
+    #define prvUnlockEventGroup( pxEventBits )
+#endif
+
+#if ( ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 ) && ( configEVENT_GROUP_ISR_MAX_WAITERS > 0 ) )
+
+/*
+ * Return the number of tasks held in the lists that setting uxBitsToSet would
+ * search, which is the number of tasks an interrupt would have to look at to
+ * set the bits.
+ */
+    static UBaseType_t prvGetWaitersToSearch( const EventGroup_t * pxEventBits,
+                                              const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * Pended to the timer task by xEventGroupSetBitsFromISR() when setting the
+ * bits would take more than configEVENT_GROUP_ISR_MAX_WAITERS tasks to be
+ * looked at.  The interrupt leaves the event group locked, with the bits in
+ * uxBitsSetFromISR, and this sets them and unlocks it.
+ */
+    static void prvUnlockEventGroupCallback( void * pvEventGroup,
+                                             uint32_t ulUnused ) PRIVILEGED_FUNCTION;
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -116,7 +201,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         if( pxEventBits != NULL )
         {
             pxEventBits->uxEventBits = 0;
-            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            prvInitialiseWaitingLists( pxEventBits );
 
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
             {
@@ -127,6 +212,13 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             }
             #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 
+            #if ( configUSE_MULTI_WAIT == 1 )
+            {
+                pxEventBits->xMultiWaitTask = NULL;
+                pxEventBits->uxMultiWaitBits = 0;
+            }
+            #endif /* configUSE_MULTI_WAIT */
+
             traceEVENT_GROUP_CREATE( pxEventBits );
         }
         else
@@ -167,7 +259,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         if( pxEventBits != NULL )
         {
             pxEventBits->uxEventBits = 0;
-            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            prvInitialiseWaitingLists( pxEventBits );
 
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
@@ -178,6 +270,13 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             }
             #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+            #if ( configUSE_MULTI_WAIT == 1 )
+            {
+                pxEventBits->xMultiWaitTask = NULL;
+                pxEventBits->uxMultiWaitBits = 0;
+            }
+            #endif /* configUSE_MULTI_WAIT */
+
             traceEVENT_GROUP_CREATE( pxEventBits );
         }
         else
@@ -211,6 +310,8 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
 
     vTaskSuspendAll();
     {
+        prvLockEventGroup( pxEventBits );
+
         uxOriginalBitValue = pxEventBits->uxEventBits;
 
         ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
@@ -235,7 +336,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                prvPlaceOnWaitingList( pxEventBits, uxBitsToWaitFor, ( eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                 /* This assignment is obsolete as uxReturn will get set after
                  * the task unblocks, but some compilers mistakenly generate a
@@ -251,6 +352,8 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                 xTimeoutOccurred = pdTRUE;
             }
         }
+
+        prvUnlockEventGroup( pxEventBits );
     }
     xAlreadyYielded = xTaskResumeAll();
 
@@ -338,7 +441,11 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
 
     vTaskSuspendAll();
     {
-        const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
+        EventBits_t uxCurrentEventBits;
+
+        prvLockEventGroup( pxEventBits );
+
+        uxCurrentEventBits = pxEventBits->uxEventBits;
 
         /* Check to see if the wait condition is already met or not. */
         xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
@@ -394,7 +501,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
             /* Store the bits that the calling task is waiting for in the
              * task's event list item so the kernel knows when a match is
              * found.  Then enter the blocked state. */
-            vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+            prvPlaceOnWaitingList( pxEventBits, uxBitsToWaitFor, uxControlBits, xTicksToWait );
 
             /* This is obsolete as it will get set after the task unblocks, but
              * some compilers mistakenly generate a warning about the variable
@@ -403,6 +510,8 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
 
             traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
         }
+
+        prvUnlockEventGroup( pxEventBits );
     }
     xAlreadyYielded = xTaskResumeAll();
 
@@ -491,6 +600,15 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
 
         /* Clear the bits. */
         pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+        #if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+        {
+            /* Bits set by an interrupt while the event group is locked have
+             * been set as far as the interrupt is concerned. */
+            uxReturn |= pxEventBits->uxBitsSetFromISR;
+            pxEventBits->uxBitsSetFromISR &= ~uxBitsToClear;
+        }
+        #endif
     }
     taskEXIT_CRITICAL();
 
@@ -498,7 +616,42 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+    BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
+                                            const EventBits_t uxBitsToClear )
+    {
+        EventGroup_t * const pxEventBits = xEventGroup;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xEventGroup );
+        configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        /* See the comments in xQueueGenericSendFromISR() on the use of
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* xEventGroupSetBitsFromISR() sets the bits from the interrupt, so the
+         * bits are cleared from the interrupt too.  Were the clear deferred to
+         * the timer task, a clear followed by a set of the same bit would be
+         * performed in the opposite order.  Clearing bits does not unblock any
+         * tasks, so the bits are cleared even while the event group is
+         * locked, as they are by xEventGroupClearBits(). */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+
+            pxEventBits->uxEventBits &= ~uxBitsToClear;
+            pxEventBits->uxBitsSetFromISR &= ~uxBitsToClear;
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        /* The bits are always cleared, so unlike the deferred version this
+         * cannot fail. */
+        return pdPASS;
+    }
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
     BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
                                             const EventBits_t uxBitsToClear )
@@ -511,7 +664,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
         return xReturn;
     }
 
-#endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
 /*-----------------------------------------------------------*/
 
 EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
@@ -520,11 +673,17 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
     EventGroup_t const * const pxEventBits = xEventGroup;
     EventBits_t uxReturn;
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         uxReturn = pxEventBits->uxEventBits;
+
+        #if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+        {
+            uxReturn |= pxEventBits->uxBitsSetFromISR;
+        }
+        #endif
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return uxReturn;
 } /*lint !e818 EventGroupHandle_t is a typedef used in other functions to so can't be pointer to const. */
@@ -533,92 +692,20 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                 const EventBits_t uxBitsToSet )
 {
-    ListItem_t * pxListItem;
-    ListItem_t * pxNext;
-    ListItem_t const * pxListEnd;
-    List_t const * pxList;
-    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
     EventGroup_t * pxEventBits = xEventGroup;
-    BaseType_t xMatchFound = pdFALSE;
 
     /* Check the user is not attempting to set the bits used by the kernel
      * itself. */
     configASSERT( xEventGroup );
     configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-    pxList = &( pxEventBits->xTasksWaitingForBits );
-    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
     vTaskSuspendAll();
     {
         traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-        pxListItem = listGET_HEAD_ENTRY( pxList );
-
-        /* Set the bits. */
-        pxEventBits->uxEventBits |= uxBitsToSet;
-
-        /* See if the new bit value should unblock any tasks. */
-        while( pxListItem != pxListEnd )
-        {
-            pxNext = listGET_NEXT( pxListItem );
-            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-            xMatchFound = pdFALSE;
-
-            /* Split the bits waited for from the control bits. */
-            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-            {
-                /* Just looking for single bit being set. */
-                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-                {
-                    xMatchFound = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-            {
-                /* All bits are set. */
-                xMatchFound = pdTRUE;
-            }
-            else
-            {
-                /* Need all bits to be set, but not all the bits were set. */
-            }
-
-            if( xMatchFound != pdFALSE )
-            {
-                /* The bits match.  Should the bits be cleared on exit? */
-                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-                {
-                    uxBitsToClear |= uxBitsWaitedFor;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                /* Store the actual event flag value in the task's event list
-                 * item before removing the task from the event list.  The
-                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                 * that is was unblocked due to its required bits matching, rather
-                 * than because it timed out. */
-                vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-            }
-
-            /* Move onto the next list item.  Note pxListItem->pxNext is not
-             * used here as the list item may have been removed from the event list
-             * and inserted into the ready/pending reading list. */
-            pxListItem = pxNext;
-        }
-
-        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-         * bit was set in the control word. */
-        pxEventBits->uxEventBits &= ~uxBitsToClear;
+        prvLockEventGroup( pxEventBits );
+        ( void ) prvSetBitsAndUnblockTasks( pxEventBits, uxBitsToSet, pdFALSE );
+        prvUnlockEventGroup( pxEventBits );
     }
     ( void ) xTaskResumeAll();
 
@@ -630,22 +717,30 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
     EventGroup_t * pxEventBits = xEventGroup;
     const List_t * pxTasksWaitingForBits;
+    UBaseType_t uxBucket;
 
     configASSERT( pxEventBits );
 
-    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
-
     vTaskSuspendAll();
     {
         traceEVENT_GROUP_DELETE( xEventGroup );
 
-        while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+        prvLockEventGroup( pxEventBits );
+
+        for( uxBucket = ( UBaseType_t ) 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
         {
-            /* Unblock the task, returning 0 as the event list is being deleted
-             * and cannot therefore have any bits set. */
-            configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-            vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+            pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits[ uxBucket ] );
+
+            while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+            {
+                /* Unblock the task, returning 0 as the event list is being deleted
+                 * and cannot therefore have any bits set. */
+                configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+                vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+            }
         }
+
+        prvUnlockEventGroup( pxEventBits );
     }
     ( void ) xTaskResumeAll();
 
@@ -727,7 +822,508 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+static void prvInitialiseWaitingLists( EventGroup_t * pxEventBits )
+{
+    UBaseType_t uxBucket;
+
+    for( uxBucket = ( UBaseType_t ) 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
+    {
+        vListInitialise( &( pxEventBits->xTasksWaitingForBits[ uxBucket ] ) );
+        pxEventBits->uxBucketBits[ uxBucket ] = 0;
+    }
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+    {
+        pxEventBits->uxLocks = 0;
+        pxEventBits->uxBitsSetFromISR = 0;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvGetBucketIndex( EventBits_t uxBits )
+{
+    UBaseType_t uxBucket = 0;
+
+    configASSERT( uxBits != ( EventBits_t ) 0 );
+
+    #if ( configEVENT_GROUP_WAITER_BUCKETS > 1 )
+    {
+        /* Bits share the lists in turn, so bit n is held in the list
+         * n % configEVENT_GROUP_WAITER_BUCKETS. */
+        while( ( uxBits & ( EventBits_t ) 1 ) == ( EventBits_t ) 0 )
+        {
+            uxBits >>= 1;
+            uxBucket++;
+        }
+
+        uxBucket %= ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS;
+    }
+    #else
+    {
+        ( void ) uxBits;
+    }
+    #endif /* configEVENT_GROUP_WAITER_BUCKETS */
+
+    return uxBucket;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPlaceOnWaitingList( EventGroup_t * pxEventBits,
+                                   const EventBits_t uxBitsToWaitFor,
+                                   const EventBits_t uxControlBits,
+                                   const TickType_t xTicksToWait )
+{
+    EventBits_t uxBucketBits;
+    UBaseType_t uxBucket;
+
+    if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+    {
+        /* Setting any of the bits can unblock the task. */
+        uxBucketBits = uxBitsToWaitFor;
+        uxBucket = prvGetBucketIndex( uxBitsToWaitFor );
+    }
+    else
+    {
+        /* Only setting the lowest bit that is not already set can unblock the
+         * task.  If that bit is set first then xEventGroupSetBits() moves the
+         * task to the list of the next bit it needs. */
+        uxBucketBits = uxBitsToWaitFor & ~( pxEventBits->uxEventBits );
+        uxBucketBits &= ~( uxBucketBits - ( EventBits_t ) 1 );
+        uxBucket = prvGetBucketIndex( uxBucketBits );
+    }
+
+    pxEventBits->uxBucketBits[ uxBucket ] |= uxBucketBits;
+
+    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits[ uxBucket ] ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSetBitsAndUnblockTasks( EventGroup_t * pxEventBits,
+                                             const EventBits_t uxBitsToSet,
+                                             const BaseType_t xFromISR )
+{
+    ListItem_t * pxListItem;
+    ListItem_t * pxNext;
+    ListItem_t const * pxListEnd;
+    List_t * pxList;
+    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits, uxNewBits, uxBucketBits, uxBitsNotSet;
+    BaseType_t xMatchFound = pdFALSE, xHigherPriorityTaskWoken = pdFALSE;
+    UBaseType_t uxBucket, uxNewBucket;
+
+    /* Only bits that were not already set can unblock a task - a task
+     * does not block on bits that are already set, and a task waiting for
+     * all of its bits is held in the list of a bit that is not set. */
+    uxNewBits = uxBitsToSet & ~( pxEventBits->uxEventBits );
+
+    /* Set the bits. */
+    pxEventBits->uxEventBits |= uxBitsToSet;
+
+    /* See if the new bit value should unblock any tasks.  Only the lists
+     * holding tasks that wait for one of the new bits are searched. */
+    for( uxBucket = ( UBaseType_t ) 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
+    {
+        if( ( pxEventBits->uxBucketBits[ uxBucket ] & uxNewBits ) != ( EventBits_t ) 0 )
+        {
+            traceEVENT_GROUP_SEARCH_WAITERS( pxEventBits, uxBucket );
+
+            pxList = &( pxEventBits->xTasksWaitingForBits[ uxBucket ] );
+            pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+            pxListItem = listGET_HEAD_ENTRY( pxList );
+
+            /* The bits recorded for the list are rebuilt from the tasks that
+             * remain in it, which also drops the bits of tasks that timed out. */
+            uxBucketBits = 0;
+
+            while( pxListItem != pxListEnd )
+            {
+                pxNext = listGET_NEXT( pxListItem );
+                uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+                xMatchFound = pdFALSE;
+
+                /* Split the bits waited for from the control bits. */
+                uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+                uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+                if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+                {
+                    /* Just looking for single bit being set. */
+                    if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+                    {
+                        xMatchFound = pdTRUE;
+                    }
+                    else
+                    {
+                        uxBucketBits |= uxBitsWaitedFor;
+                    }
+                }
+                else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+                {
+                    /* All bits are set. */
+                    xMatchFound = pdTRUE;
+                }
+                else
+                {
+                    /* Need all bits to be set, but not all the bits were set.
+                     * Move the task to the list of the lowest bit it still
+                     * needs, as it cannot be unblocked until that bit is set. */
+                    uxBitsNotSet = uxBitsWaitedFor & ~( pxEventBits->uxEventBits );
+                    uxBitsNotSet &= ~( uxBitsNotSet - ( EventBits_t ) 1 );
+                    uxNewBucket = prvGetBucketIndex( uxBitsNotSet );
+
+                    if( uxNewBucket != uxBucket )
+                    {
+                        listREMOVE_ITEM( pxListItem );
+                        listINSERT_END( &( pxEventBits->xTasksWaitingForBits[ uxNewBucket ] ), pxListItem );
+                        pxEventBits->uxBucketBits[ uxNewBucket ] |= uxBitsNotSet;
+                    }
+                    else
+                    {
+                        uxBucketBits |= uxBitsNotSet;
+                    }
+                }
+
+                if( xMatchFound != pdFALSE )
+                {
+                    /* The bits match.  Should the bits be cleared on exit? */
+                    if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                    {
+                        uxBitsToClear |= uxBitsWaitedFor;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Store the actual event flag value in the task's event list
+                     * item before removing the task from the event list.  The
+                     * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+                     * that is was unblocked due to its required bits matching, rather
+                     * than because it timed out. */
+                    #if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+                    {
+                        if( xFromISR != pdFALSE )
+                        {
+                            if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+                            {
+                                xHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+                        }
+                    }
+                    #else
+                    {
+                        vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+                    }
+                    #endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
+                }
+
+                /* Move onto the next list item.  Note pxListItem->pxNext is not
+                 * used here as the list item may have been removed from the event list
+                 * and inserted into the ready/pending reading list. */
+                pxListItem = pxNext;
+            }
+
+            pxEventBits->uxBucketBits[ uxBucket ] = uxBucketBits;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+     * bit was set in the control word. */
+    pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+    #if ( configUSE_MULTI_WAIT == 1 )
+    {
+        /* The task waiting in uxMultiWaitForAny() is not in the list of
+         * waiting tasks, so is notified separately if any of the bits it is
+         * waiting for remain set.  It does not clear the bits itself. */
+        if( ( pxEventBits->xMultiWaitTask != NULL ) && ( ( pxEventBits->uxEventBits & pxEventBits->uxMultiWaitBits ) != ( EventBits_t ) 0 ) )
+        {
+            if( xFromISR != pdFALSE )
+            {
+                ( void ) xTaskNotifyIndexedFromISR( pxEventBits->xMultiWaitTask, configMULTI_WAIT_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction, &xHigherPriorityTaskWoken );
+            }
+            else
+            {
+                ( void ) xTaskNotifyIndexed( pxEventBits->xMultiWaitTask, configMULTI_WAIT_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_MULTI_WAIT */
+
+    /* Prevent compiler warnings when configUSE_EVENT_GROUP_DIRECT_ISR_SET is
+     * 0, as tasks are then only unblocked from tasks. */
+    ( void ) xFromISR;
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+    static void prvLockEventGroup( EventGroup_t * pxEventBits )
+    {
+        taskENTER_CRITICAL();
+        {
+            ( pxEventBits->uxLocks )++;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+    static void prvUnlockEventGroup( EventGroup_t * pxEventBits )
+    {
+        EventBits_t uxBitsSetFromISR;
+
+        /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+
+        /* Set the bits that interrupts set while the event group was locked.
+         * An interrupt can set more bits while they are being set, so repeat
+         * until there are none left, then unlock in the same critical section
+         * as the last check. */
+        do
+        {
+            taskENTER_CRITICAL();
+            {
+                uxBitsSetFromISR = pxEventBits->uxBitsSetFromISR;
+                pxEventBits->uxBitsSetFromISR = 0;
+
+                if( uxBitsSetFromISR == ( EventBits_t ) 0 )
+                {
+                    ( pxEventBits->uxLocks )--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( uxBitsSetFromISR != ( EventBits_t ) 0 )
+            {
+                ( void ) prvSetBitsAndUnblockTasks( pxEventBits, uxBitsSetFromISR, pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        } while( uxBitsSetFromISR != ( EventBits_t ) 0 );
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 ) && ( configEVENT_GROUP_ISR_MAX_WAITERS > 0 ) )
+
+    static UBaseType_t prvGetWaitersToSearch( const EventGroup_t * pxEventBits,
+                                              const EventBits_t uxBitsToSet )
+    {
+        EventBits_t uxNewBits;
+        UBaseType_t uxBucket, uxWaiters = 0;
+
+        /* As in prvSetBitsAndUnblockTasks(), only the lists holding tasks
+         * that wait for a bit that is not already set are searched. */
+        uxNewBits = uxBitsToSet & ~( pxEventBits->uxEventBits );
+
+        for( uxBucket = ( UBaseType_t ) 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
+        {
+            if( ( pxEventBits->uxBucketBits[ uxBucket ] & uxNewBits ) != ( EventBits_t ) 0 )
+            {
+                uxWaiters += listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBits[ uxBucket ] ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return uxWaiters;
+    }
+
+#endif /* if ( ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 ) && ( configEVENT_GROUP_ISR_MAX_WAITERS > 0 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 ) && ( configEVENT_GROUP_ISR_MAX_WAITERS > 0 ) )
+
+    static void prvUnlockEventGroupCallback( void * pvEventGroup,
+                                             uint32_t ulUnused )
+    {
+        ( void ) ulUnused;
+
+        vTaskSuspendAll();
+        {
+            prvUnlockEventGroup( ( EventGroup_t * ) pvEventGroup );
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* if ( ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 ) && ( configEVENT_GROUP_ISR_MAX_WAITERS > 0 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MULTI_WAIT == 1 )
+
+    BaseType_t xEventGroupRegisterMultiWaitTask( EventGroupHandle_t xEventGroup,
+                                                 TaskHandle_t xTask,
+                                                 const EventBits_t uxBitsToWaitFor )
+    {
+        EventGroup_t * const pxEventBits = xEventGroup;
+        BaseType_t xReturn;
+
+        configASSERT( pxEventBits );
+        configASSERT( ( uxBitsToWaitFor & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        /* This function should not be called by application code.  It is used
+         * by uxMultiWaitForAny() to set the task that is notified when any of
+         * uxBitsToWaitFor are set, or to clear it by passing NULL.  A task
+         * that passes the same event group more than once is notified when
+         * any of the bits of any of its entries are set.  The scheduler is
+         * suspended, rather than a critical section entered, as that is how
+         * xEventGroupSetBits() protects the event group. */
+        vTaskSuspendAll();
+        {
+            prvLockEventGroup( pxEventBits );
+
+            if( ( xTask != NULL ) && ( pxEventBits->xMultiWaitTask != NULL ) && ( pxEventBits->xMultiWaitTask != xTask ) )
+            {
+                /* Only one task at a time can wait for the event group in
+                 * uxMultiWaitForAny(). */
+                xReturn = pdFAIL;
+            }
+            else if( ( xTask != NULL ) && ( pxEventBits->xMultiWaitTask == xTask ) )
+            {
+                /* The event group appears more than once in the objects the
+                 * task is waiting for. */
+                pxEventBits->uxMultiWaitBits |= uxBitsToWaitFor;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                pxEventBits->xMultiWaitTask = xTask;
+                pxEventBits->uxMultiWaitBits = uxBitsToWaitFor;
+                xReturn = pdPASS;
+            }
+
+            prvUnlockEventGroup( pxEventBits );
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MULTI_WAIT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+    BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
+                                          const EventBits_t uxBitsToSet,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        EventGroup_t * const pxEventBits = xEventGroup;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xEventGroup );
+        configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum system call (or maximum API call) interrupt priority.
+         * Interrupts that are above the maximum system call priority are kept
+         * permanently enabled, even when the RTOS kernel is in a critical
+         * section, but cannot make any calls to FreeRTOS API functions.  See
+         * the comment in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+            #if ( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+            {
+                /* Bound the time spent in the critical section.  If more than
+                 * configEVENT_GROUP_ISR_MAX_WAITERS tasks would have to be
+                 * looked at, the event group is locked on behalf of the timer
+                 * task, which then sets the bits as any other task holding the
+                 * lock would.  Bits set from interrupts until then are added to
+                 * the same uxBitsSetFromISR, so are set in order.  If the timer
+                 * queue is full the bits are set here instead, as they cannot
+                 * be lost. */
+                if( ( pxEventBits->uxLocks == ( UBaseType_t ) 0 ) &&
+                    ( prvGetWaitersToSearch( pxEventBits, uxBitsToSet ) > ( UBaseType_t ) configEVENT_GROUP_ISR_MAX_WAITERS ) )
+                {
+                    if( xTimerPendFunctionCallFromISR( prvUnlockEventGroupCallback, ( void * ) pxEventBits, ( uint32_t ) 0, pxHigherPriorityTaskWoken ) != pdFALSE )
+                    {
+                        ( pxEventBits->uxLocks )++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configEVENT_GROUP_ISR_MAX_WAITERS */
+
+            if( pxEventBits->uxLocks == ( UBaseType_t ) 0 )
+            {
+                /* No task is accessing the lists of waiting tasks, so the
+                 * bits are set and the tasks unblocked here.  Only the lists
+                 * holding tasks that wait for one of the bits are searched, so
+                 * the time spent in the critical section depends on how the
+                 * tasks are spread over configEVENT_GROUP_WAITER_BUCKETS lists,
+                 * and is bounded by configEVENT_GROUP_ISR_MAX_WAITERS. */
+                if( prvSetBitsAndUnblockTasks( pxEventBits, uxBitsToSet, pdTRUE ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The task that holds the lock sets the bits when it unlocks
+                 * the event group. */
+                pxEventBits->uxBitsSetFromISR |= uxBitsToSet;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        /* The bits are always set, so unlike the deferred version this
+         * cannot fail. */
+        return pdPASS;
+    }
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
@@ -741,7 +1337,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         return xReturn;
     }
 
-#endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TRACE_FACILITY == 1 )
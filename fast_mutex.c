@@ -0,0 +1,506 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "fast_mutex.h"
+
+#if ( configUSE_MUTEXES != 1 )
+    #error configUSE_MUTEXES must be set to 1 to build fast_mutex.c
+#endif
+
+#if !defined( __GNUC__ )
+    #error fast_mutex.c requires a compiler that provides the __atomic builtins
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+    #define fastmutexYIELD_IF_USING_PREEMPTION()
+#else
+    #define fastmutexYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+#endif
+
+/* The atomic operations used on the holder word.  As in mpsc_queue.c, the
+ * compiler's builtins are used rather than atomic.h, which implements compare
+ * and swap with a critical section on ports that do not have a native
+ * instruction.  Taking the mutex has acquire semantics and giving it has
+ * release semantics, so the accesses made while the mutex is held cannot move
+ * outside of it. */
+#define fastmutexLOAD_RELAXED( pxVariable )                                __atomic_load_n( ( pxVariable ), __ATOMIC_RELAXED )
+#define fastmutexSTORE_RELEASE( pxVariable, xValue )                       __atomic_store_n( ( pxVariable ), ( xValue ), __ATOMIC_RELEASE )
+#define fastmutexCOMPARE_AND_SWAP_ACQUIRE( pxVariable, pxExpected, xValue )    __atomic_compare_exchange_n( ( pxVariable ), ( pxExpected ), ( xValue ), pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED )
+#define fastmutexCOMPARE_AND_SWAP_RELEASE( pxVariable, pxExpected, xValue )    __atomic_compare_exchange_n( ( pxVariable ), ( pxExpected ), ( xValue ), pdFALSE, __ATOMIC_RELEASE, __ATOMIC_RELAXED )
+
+/* The holder word holds the handle of the holding task, or fastmutexFREE if
+ * the mutex is available.  Task control blocks are at least word aligned, so
+ * the least significant bit of a handle is always clear and is used to flag
+ * that other tasks are waiting for the mutex. */
+#define fastmutexFREE                          ( ( portPOINTER_SIZE_TYPE ) 0 )
+#define fastmutexWAITERS_BIT                   ( ( portPOINTER_SIZE_TYPE ) 1 )
+#define fastmutexHOLDER( uxHolderWord )        ( ( TaskHandle_t ) ( ( uxHolderWord ) & ~fastmutexWAITERS_BIT ) ) /*lint !e923 Cast between pointer and integer is required to pack the waiters bit. */
+#define fastmutexHOLDER_WORD( xTask )          ( ( portPOINTER_SIZE_TYPE ) ( xTask ) )                           /*lint !e923 Cast between pointer and integer is required to pack the waiters bit. */
+
+/* Bits that can be set in FastMutex_t.ucFlags. */
+#define fastmutexFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 ) /* Set if the mutex was created using statically allocated memory. */
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the mutex. */
+typedef struct FastMutexDef_t                      /*lint !e9058 Style convention uses tag. */
+{
+    volatile portPOINTER_SIZE_TYPE uxHolder;       /*< The handle of the holding task, with fastmutexWAITERS_BIT set if tasks may be blocked on xTasksWaitingToTake, or fastmutexFREE. */
+    List_t xTasksWaitingToTake;                    /*< List of tasks that are blocked waiting to take the mutex.  Stored in priority order. */
+    uint8_t ucFlags;
+} FastMutex_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by xFastMutexTake() when the mutex is not available.  Blocks on the
+ * mutex's event list, with priority inheritance, until the mutex is passed to
+ * the calling task or xTicksToWait expires.
+ */
+static BaseType_t prvTakeContended( FastMutex_t * const pxMutex,
+                                    const TaskHandle_t xCurrentTask,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by xFastMutexGive() when the waiters bit is set.  Disinherits any
+ * inherited priority and passes the mutex to the highest priority waiting
+ * task, if there is one.
+ */
+static void prvGiveContended( FastMutex_t * const pxMutex,
+                              const TaskHandle_t xCurrentTask ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    FastMutexHandle_t xFastMutexCreate( void )
+    {
+        FastMutex_t * pxMutex;
+
+        pxMutex = ( FastMutex_t * ) pvPortMalloc( sizeof( FastMutex_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxMutex != NULL )
+        {
+            pxMutex->uxHolder = fastmutexFREE;
+            vListInitialise( &( pxMutex->xTasksWaitingToTake ) );
+            pxMutex->ucFlags = 0;
+
+            traceFAST_MUTEX_CREATE( pxMutex );
+        }
+        else
+        {
+            traceFAST_MUTEX_CREATE_FAILED();
+        }
+
+        return pxMutex;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    FastMutexHandle_t xFastMutexCreateStatic( StaticFastMutex_t * const pxStaticMutex )
+    {
+        FastMutex_t * const pxMutex = ( FastMutex_t * ) pxStaticMutex; /*lint !e740 !e9087 Safe cast as StaticFastMutex_t is opaque FastMutex_t. */
+
+        configASSERT( pxStaticMutex );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticFastMutex_t equals the size of the real
+             * mutex structure. */
+            volatile size_t xSize = sizeof( StaticFastMutex_t );
+            configASSERT( xSize == sizeof( FastMutex_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( pxMutex != NULL )
+        {
+            pxMutex->uxHolder = fastmutexFREE;
+            vListInitialise( &( pxMutex->xTasksWaitingToTake ) );
+            pxMutex->ucFlags = fastmutexFLAGS_IS_STATICALLY_ALLOCATED;
+
+            traceFAST_MUTEX_CREATE( pxMutex );
+        }
+        else
+        {
+            traceFAST_MUTEX_CREATE_FAILED();
+        }
+
+        return pxMutex;
+    }
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vFastMutexDelete( FastMutexHandle_t xMutex )
+{
+    FastMutex_t * pxMutex = xMutex;
+
+    configASSERT( pxMutex );
+
+    /* A mutex that is held, or has tasks waiting for it, cannot be deleted. */
+    configASSERT( pxMutex->uxHolder == fastmutexFREE );
+    configASSERT( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) != pdFALSE );
+
+    traceFAST_MUTEX_DELETE( xMutex );
+
+    if( ( pxMutex->ucFlags & fastmutexFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            vPortFree( ( void * ) pxMutex ); /*lint !e9087 Standard free() semantics require void *, plus pxMutex was allocated by pvPortMalloc(). */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xMutex == ( FastMutexHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure was not allocated dynamically and cannot be freed -
+         * just scrub it so future use will assert. */
+        ( void ) memset( pxMutex, 0x00, sizeof( FastMutex_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xFastMutexTake( FastMutexHandle_t xMutex,
+                           TickType_t xTicksToWait )
+{
+    FastMutex_t * const pxMutex = xMutex;
+    const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+    portPOINTER_SIZE_TYPE uxExpected = fastmutexFREE;
+    BaseType_t xReturn;
+
+    configASSERT( pxMutex );
+    configASSERT( xCurrentTask );
+
+    if( fastmutexCOMPARE_AND_SWAP_ACQUIRE( &( pxMutex->uxHolder ), &uxExpected, fastmutexHOLDER_WORD( xCurrentTask ) ) != pdFALSE )
+    {
+        /* The mutex was available.  Only the calling task writes its own
+         * held count, so no critical section is needed to update it. */
+        vTaskIncrementMutexHeldCount( xCurrentTask );
+        xReturn = pdPASS;
+    }
+    else
+    {
+        traceFAST_MUTEX_TAKE_CONTENDED( xMutex );
+        xReturn = prvTakeContended( pxMutex, xCurrentTask, xTicksToWait );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xFastMutexGive( FastMutexHandle_t xMutex )
+{
+    FastMutex_t * const pxMutex = xMutex;
+    const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+    portPOINTER_SIZE_TYPE uxExpected = fastmutexHOLDER_WORD( xCurrentTask );
+    BaseType_t xReturn;
+
+    configASSERT( pxMutex );
+
+    if( fastmutexCOMPARE_AND_SWAP_RELEASE( &( pxMutex->uxHolder ), &uxExpected, fastmutexFREE ) != pdFALSE )
+    {
+        /* No task was waiting.  Unless the calling task has inherited a
+         * priority, through another mutex it still holds, only its held
+         * count needs to be updated. */
+        if( xTaskDecrementMutexHeldCount( xCurrentTask ) == pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( xTaskPriorityDisinherit( xCurrentTask ) != pdFALSE )
+                {
+                    fastmutexYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else if( fastmutexHOLDER( uxExpected ) == xCurrentTask )
+    {
+        /* The calling task holds the mutex, but the waiters bit is set. */
+        prvGiveContended( pxMutex, xCurrentTask );
+        xReturn = pdPASS;
+    }
+    else
+    {
+        /* The calling task does not hold the mutex. */
+        xReturn = pdFAIL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xFastMutexGetHolder( FastMutexHandle_t xMutex )
+{
+    const FastMutex_t * const pxMutex = xMutex;
+
+    configASSERT( pxMutex );
+
+    return fastmutexHOLDER( fastmutexLOAD_RELAXED( &( pxMutex->uxHolder ) ) );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeContended( FastMutex_t * const pxMutex,
+                                    const TaskHandle_t xCurrentTask,
+                                    TickType_t xTicksToWait )
+{
+    BaseType_t xReturn = pdFAIL, xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE, xFinished = pdFALSE;
+    TimeOut_t xTimeOut;
+    portPOINTER_SIZE_TYPE uxHolder;
+    UBaseType_t uxHighestWaitingPriority;
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    while( xFinished == pdFALSE )
+    {
+        taskENTER_CRITICAL();
+        {
+            uxHolder = fastmutexLOAD_RELAXED( &( pxMutex->uxHolder ) );
+
+            if( ( fastmutexHOLDER( uxHolder ) == xCurrentTask ) && ( xEntryTimeSet != pdFALSE ) )
+            {
+                /* The task that gave the mutex passed it to this task, and
+                 * has already updated this task's held count. */
+                xReturn = pdPASS;
+                xFinished = pdTRUE;
+            }
+            else if( uxHolder == fastmutexFREE )
+            {
+                /* The mutex was given while no task was blocked on it.  Holder
+                 * words only change outside of a critical section through the
+                 * compare and swap on the uncontended paths, so it is still
+                 * used here in case another core takes the mutex first. */
+                if( fastmutexCOMPARE_AND_SWAP_ACQUIRE( &( pxMutex->uxHolder ), &uxHolder, fastmutexHOLDER_WORD( xCurrentTask ) ) != pdFALSE )
+                {
+                    vTaskIncrementMutexHeldCount( xCurrentTask );
+                    xReturn = pdPASS;
+                    xFinished = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                /* The mutex is held and either no block time was specified or
+                 * the block time has expired. */
+                xFinished = pdTRUE;
+            }
+            else
+            {
+                if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                {
+                    /* Fast mutexes are not recursive - a task that blocks on
+                     * a mutex it already holds would never be unblocked. */
+                    configASSERT( fastmutexHOLDER( uxHolder ) != xCurrentTask );
+
+                    /* Set the waiters bit so the holder's give takes the
+                     * contended path and passes the mutex on.  The compare and
+                     * swap fails if the holder gave the mutex on another core
+                     * since it was read, in which case the loop tries again. */
+                    if( ( ( uxHolder & fastmutexWAITERS_BIT ) != fastmutexFREE ) ||
+                        ( fastmutexCOMPARE_AND_SWAP_ACQUIRE( &( pxMutex->uxHolder ), &uxHolder, uxHolder | fastmutexWAITERS_BIT ) != pdFALSE ) )
+                    {
+                        if( xTaskPriorityInherit( fastmutexHOLDER( uxHolder ) ) != pdFALSE )
+                        {
+                            xInheritanceOccurred = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        traceBLOCKING_ON_FAST_MUTEX_TAKE( pxMutex );
+                        vTaskPlaceOnEventList( &( pxMutex->xTasksWaitingToTake ), xTicksToWait );
+
+                        /* All ports are written to allow a yield in a critical
+                         * section (some will yield immediately, others wait
+                         * until the critical section exits) - but it is not
+                         * something that application code should ever do. */
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Timed out.  If this task caused the holder to inherit
+                     * its priority then the holder should disinherit it - but
+                     * only down to the highest priority of any other task that
+                     * is still waiting for the mutex. */
+                    if( xInheritanceOccurred != pdFALSE )
+                    {
+                        if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) == pdFALSE )
+                        {
+                            uxHighestWaitingPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxMutex->xTasksWaitingToTake ) );
+                        }
+                        else
+                        {
+                            uxHighestWaitingPriority = tskIDLE_PRIORITY;
+                        }
+
+                        vTaskPriorityDisinheritAfterTimeout( fastmutexHOLDER( uxHolder ), uxHighestWaitingPriority );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xFinished = pdTRUE;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGiveContended( FastMutex_t * const pxMutex,
+                              const TaskHandle_t xCurrentTask )
+{
+    BaseType_t xYieldRequired;
+    TaskHandle_t xNewHolder;
+    portPOINTER_SIZE_TYPE uxNewHolder;
+
+    taskENTER_CRITICAL();
+    {
+        /* The held count is decremented, and any inherited priority is
+         * disinherited if no other mutexes are held. */
+        xYieldRequired = xTaskPriorityDisinherit( xCurrentTask );
+
+        if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) == pdFALSE )
+        {
+            /* Pass the mutex directly to the highest priority waiting task
+             * rather than make it compete with tasks that have not waited,
+             * and leave the waiters bit set if other tasks are still waiting.
+             * The new holder's priority is at least that of every remaining
+             * waiter, so there is nothing for it to inherit. */
+            xNewHolder = ( TaskHandle_t ) listGET_OWNER_OF_HEAD_ENTRY( &( pxMutex->xTasksWaitingToTake ) );
+            vTaskIncrementMutexHeldCount( xNewHolder );
+
+            if( xTaskRemoveFromEventList( &( pxMutex->xTasksWaitingToTake ) ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxNewHolder = fastmutexHOLDER_WORD( xNewHolder );
+
+            if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) == pdFALSE )
+            {
+                uxNewHolder |= fastmutexWAITERS_BIT;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            /* The tasks that set the waiters bit have all timed out. */
+            uxNewHolder = fastmutexFREE;
+        }
+
+        /* No other task can change the holder word while the waiters bit is
+         * set, so a store is sufficient. */
+        fastmutexSTORE_RELEASE( &( pxMutex->uxHolder ), uxNewHolder );
+
+        if( xYieldRequired != pdFALSE )
+        {
+            fastmutexYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
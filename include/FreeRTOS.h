@@ -58,6 +58,12 @@
 /* Application specific configuration options. */
 #include "FreeRTOSConfig.h"
 
+/* Must be defaulted before portable.h is included as the port layer needs to
+ * know whether it is providing the multi-core (SMP) interface. */
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES    1
+#endif
+
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
@@ -383,6 +389,11 @@
     #define vQueueAddToRegistry( xQueue, pcName )
     #define vQueueUnregisterQueue( xQueue )
     #define pcQueueGetName( xQueue )
+    #define xQueueGetHandleFromName( pcQueueName )
+#endif
+
+#ifndef configGENERATE_QUEUE_STATS
+    #define configGENERATE_QUEUE_STATS    0
 #endif
 
 #ifndef configUSE_MINI_LIST_ITEM
@@ -422,6 +433,13 @@
     #define traceINCREASE_TICK_COUNT( x )
 #endif
 
+#ifndef traceVIRTUAL_TIME_ADVANCE
+
+/* Called when the idle task moves the tick count forward by x ticks because
+ * configUSE_VIRTUAL_TIME is 1 and every task is blocked. */
+    #define traceVIRTUAL_TIME_ADVANCE( x )
+#endif
+
 #ifndef traceLOW_POWER_IDLE_BEGIN
     /* Called immediately before entering tickless idle. */
     #define traceLOW_POWER_IDLE_BEGIN()
@@ -439,6 +457,20 @@
     #define traceTASK_SWITCHED_OUT()
 #endif
 
+#ifndef traceCRITICAL_SECTION_ENTERED
+
+/* Called by ports that support it once interrupts have been masked on entering
+ * the outermost task level critical section. */
+    #define traceCRITICAL_SECTION_ENTERED()
+#endif
+
+#ifndef traceCRITICAL_SECTION_EXITED
+
+/* Called by ports that support it before interrupts are unmasked on leaving the
+ * outermost task level critical section. */
+    #define traceCRITICAL_SECTION_EXITED()
+#endif
+
 #ifndef traceTASK_PRIORITY_INHERIT
 
 /* Called when a task attempts to take a mutex that is already held by a
@@ -458,6 +490,14 @@
     #define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+
+/* Called when a task in the earliest deadline first band blocks, so completing
+ * its current job, after the absolute deadline of that job has passed.  pxTCB
+ * is a pointer to the TCB of the task. */
+    #define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
 #ifndef traceBLOCKING_ON_QUEUE_RECEIVE
 
 /* Task is about to block because it cannot read from a
@@ -599,6 +639,38 @@
     #define traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue )
 #endif
 
+#ifndef traceQUEUE_SEND_MULTIPLE
+    #define traceQUEUE_SEND_MULTIPLE( pxQueue, uxItemCount )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_MULTIPLE
+    #define traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxItemCount )
+#endif
+
+#ifndef traceQUEUE_RESERVE
+    #define traceQUEUE_RESERVE( pxQueue )
+#endif
+
+#ifndef traceQUEUE_RESERVE_FAILED
+    #define traceQUEUE_RESERVE_FAILED( pxQueue )
+#endif
+
+#ifndef traceQUEUE_COMMIT
+    #define traceQUEUE_COMMIT( pxQueue )
+#endif
+
+#ifndef traceQUEUE_ACQUIRE
+    #define traceQUEUE_ACQUIRE( pxQueue )
+#endif
+
+#ifndef traceQUEUE_ACQUIRE_FAILED
+    #define traceQUEUE_ACQUIRE_FAILED( pxQueue )
+#endif
+
+#ifndef traceQUEUE_RELEASE
+    #define traceQUEUE_RELEASE( pxQueue )
+#endif
+
 #ifndef traceQUEUE_DELETE
     #define traceQUEUE_DELETE( pxQueue )
 #endif
@@ -711,6 +783,10 @@
     #define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )
 #endif
 
+#ifndef traceEVENT_GROUP_SEARCH_WAITERS
+    #define traceEVENT_GROUP_SEARCH_WAITERS( xEventGroup, uxBucket )
+#endif
+
 #ifndef traceEVENT_GROUP_DELETE
     #define traceEVENT_GROUP_DELETE( xEventGroup )
 #endif
@@ -807,6 +883,102 @@
     #define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceSPSC_RING_CREATE
+    #define traceSPSC_RING_CREATE( pxRing )
+#endif
+
+#ifndef traceSPSC_RING_CREATE_FAILED
+    #define traceSPSC_RING_CREATE_FAILED()
+#endif
+
+#ifndef traceSPSC_RING_DELETE
+    #define traceSPSC_RING_DELETE( xRing )
+#endif
+
+#ifndef traceBLOCKING_ON_SPSC_RING_SEND
+    #define traceBLOCKING_ON_SPSC_RING_SEND( xRing )
+#endif
+
+#ifndef traceBLOCKING_ON_SPSC_RING_RECEIVE
+    #define traceBLOCKING_ON_SPSC_RING_RECEIVE( xRing )
+#endif
+
+#ifndef traceMPSC_QUEUE_CREATE
+    #define traceMPSC_QUEUE_CREATE( pxQueue )
+#endif
+
+#ifndef traceMPSC_QUEUE_CREATE_FAILED
+    #define traceMPSC_QUEUE_CREATE_FAILED()
+#endif
+
+#ifndef traceMPSC_QUEUE_DELETE
+    #define traceMPSC_QUEUE_DELETE( xQueue )
+#endif
+
+#ifndef traceMPSC_QUEUE_SEND_FAILED
+    #define traceMPSC_QUEUE_SEND_FAILED( xQueue )
+#endif
+
+#ifndef traceBLOCKING_ON_MPSC_QUEUE_RECEIVE
+    #define traceBLOCKING_ON_MPSC_QUEUE_RECEIVE( xQueue )
+#endif
+
+#ifndef tracePUBSUB_CREATE
+    #define tracePUBSUB_CREATE( pxChannel )
+#endif
+
+#ifndef tracePUBSUB_CREATE_FAILED
+    #define tracePUBSUB_CREATE_FAILED()
+#endif
+
+#ifndef tracePUBSUB_DELETE
+    #define tracePUBSUB_DELETE( xChannel )
+#endif
+
+#ifndef traceBLOCKING_ON_PUBSUB_RECEIVE
+    #define traceBLOCKING_ON_PUBSUB_RECEIVE( xChannel )
+#endif
+
+#ifndef traceFAST_MUTEX_CREATE
+    #define traceFAST_MUTEX_CREATE( pxMutex )
+#endif
+
+#ifndef traceFAST_MUTEX_CREATE_FAILED
+    #define traceFAST_MUTEX_CREATE_FAILED()
+#endif
+
+#ifndef traceFAST_MUTEX_DELETE
+    #define traceFAST_MUTEX_DELETE( xMutex )
+#endif
+
+#ifndef traceFAST_MUTEX_TAKE_CONTENDED
+    #define traceFAST_MUTEX_TAKE_CONTENDED( xMutex )
+#endif
+
+#ifndef traceBLOCKING_ON_FAST_MUTEX_TAKE
+    #define traceBLOCKING_ON_FAST_MUTEX_TAKE( xMutex )
+#endif
+
+#ifndef traceRWLOCK_CREATE
+    #define traceRWLOCK_CREATE( pxLock )
+#endif
+
+#ifndef traceRWLOCK_CREATE_FAILED
+    #define traceRWLOCK_CREATE_FAILED()
+#endif
+
+#ifndef traceRWLOCK_DELETE
+    #define traceRWLOCK_DELETE( xLock )
+#endif
+
+#ifndef traceBLOCKING_ON_RWLOCK_TAKE_READ
+    #define traceBLOCKING_ON_RWLOCK_TAKE_READ( xLock )
+#endif
+
+#ifndef traceBLOCKING_ON_RWLOCK_TAKE_WRITE
+    #define traceBLOCKING_ON_RWLOCK_TAKE_WRITE( xLock )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
     #define configGENERATE_RUN_TIME_STATS    0
 #endif
@@ -838,7 +1010,14 @@
 #endif
 
 #ifndef portYIELD_WITHIN_API
-    #define portYIELD_WITHIN_API    portYIELD
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define portYIELD_WITHIN_API    portYIELD
+    #else
+
+/* A yield requested from within a critical section cannot be performed until
+ * the critical section exits, so is held pending by the kernel. */
+        #define portYIELD_WITHIN_API    vTaskYieldWithinAPI
+    #endif
 #endif
 
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
@@ -857,6 +1036,19 @@
     #define configUSE_TICKLESS_IDLE    0
 #endif
 
+/* Set configUSE_VIRTUAL_TIME to 1 to let time pass only while every task is
+ * blocked.  The idle task then moves the tick count straight to the time at
+ * which the next task unblocks, rather than waiting for the ticks to occur.
+ * Only meaningful for a simulator port that does not start a periodic tick
+ * when this is set. */
+#ifndef configUSE_VIRTUAL_TIME
+    #define configUSE_VIRTUAL_TIME    0
+#endif
+
+#if ( ( configUSE_VIRTUAL_TIME == 1 ) && ( configUSE_TICKLESS_IDLE != 0 ) )
+    #error configUSE_TICKLESS_IDLE must be 0 when configUSE_VIRTUAL_TIME is 1.
+#endif
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
     #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -873,6 +1065,25 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
+#ifndef configUSE_PRIORITY_QUEUES
+    #define configUSE_PRIORITY_QUEUES    0
+#endif
+
+#ifndef configPRIORITY_QUEUE_INITIAL_SEQUENCE
+
+/* The sequence number given to the first item sent to a priority queue.  Only
+ * changed by tests, so the sequence count wraps after a few items. */
+    #define configPRIORITY_QUEUE_INITIAL_SEQUENCE    0
+#endif
+
+#ifndef configUSE_MULTI_WAIT
+    #define configUSE_MULTI_WAIT    0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -921,6 +1132,75 @@
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 #endif
 
+#ifndef configUSE_DELAYED_TASK_WHEEL
+    #define configUSE_DELAYED_TASK_WHEEL    0
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SLOT_BITS
+    #define configDELAYED_TASK_WHEEL_SLOT_BITS    4
+#endif
+
+#if ( ( configDELAYED_TASK_WHEEL_SLOT_BITS < 1 ) || ( configDELAYED_TASK_WHEEL_SLOT_BITS > 5 ) )
+    #error configDELAYED_TASK_WHEEL_SLOT_BITS must be between 1 and 5 inclusive.
+#endif
+
+#ifndef configUSE_READY_PRIORITY_BITMAP
+    #define configUSE_READY_PRIORITY_BITMAP    0
+#endif
+
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+        #error configUSE_READY_PRIORITY_BITMAP can only be used when configUSE_PORT_OPTIMISED_TASK_SELECTION is 0.
+    #endif
+
+    #if ( configMAX_PRIORITIES > 1024 )
+        #error configMAX_PRIORITIES must be 1024 or less when configUSE_READY_PRIORITY_BITMAP is 1.
+    #endif
+#endif
+
+/* Set configUSE_READY_PRIORITY_BITMAP_BUILTIN to 0 to have the ready priority
+ * bitmap count leading zeros in portable C even when the compiler provides
+ * __builtin_clzl(). */
+#ifndef configUSE_READY_PRIORITY_BITMAP_BUILTIN
+    #if defined( __GNUC__ )
+        #define configUSE_READY_PRIORITY_BITMAP_BUILTIN    1
+    #else
+        #define configUSE_READY_PRIORITY_BITMAP_BUILTIN    0
+    #endif
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+    #define configUSE_EDF_SCHEDULING    0
+#endif
+
+#ifndef configEDF_PRIORITY
+    #define configEDF_PRIORITY    ( configMAX_PRIORITIES - 1 )
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    #if ( ( configEDF_PRIORITY < 1 ) || ( configEDF_PRIORITY >= configMAX_PRIORITIES ) )
+        #error configEDF_PRIORITY must be between 1 and ( configMAX_PRIORITIES - 1 ) inclusive when configUSE_EDF_SCHEDULING is 1.
+    #endif
+#endif
+
+#ifndef configUSE_WAKE_LATENCY_HISTOGRAMS
+    #define configUSE_WAKE_LATENCY_HISTOGRAMS    0
+#endif
+
+#ifndef configWAKE_LATENCY_HISTOGRAM_BUCKETS
+    #define configWAKE_LATENCY_HISTOGRAM_BUCKETS    16
+#endif
+
+#if ( configUSE_WAKE_LATENCY_HISTOGRAMS == 1 )
+    #if ( configGENERATE_RUN_TIME_STATS != 1 )
+        #error configGENERATE_RUN_TIME_STATS must be 1 when configUSE_WAKE_LATENCY_HISTOGRAMS is 1 as the latencies are measured with the run time counter.
+    #endif
+
+    #if ( configWAKE_LATENCY_HISTOGRAM_BUCKETS < 2 )
+        #error configWAKE_LATENCY_HISTOGRAM_BUCKETS must be at least 2.
+    #endif
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
@@ -941,6 +1221,90 @@
     #define configUSE_POSIX_ERRNO    0
 #endif
 
+#ifndef configSPSC_RING_CACHE_LINE_BYTES
+    #define configSPSC_RING_CACHE_LINE_BYTES    64
+#endif
+
+#if ( configSPSC_RING_CACHE_LINE_BYTES < 1 )
+    #error configSPSC_RING_CACHE_LINE_BYTES must be at least 1.
+#endif
+
+#ifndef configSPSC_RING_NOTIFICATION_INDEX
+    #define configSPSC_RING_NOTIFICATION_INDEX    0
+#endif
+
+#if ( configSPSC_RING_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+    #error configSPSC_RING_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+#endif
+
+#ifndef configMPSC_QUEUE_CACHE_LINE_BYTES
+    #define configMPSC_QUEUE_CACHE_LINE_BYTES    configSPSC_RING_CACHE_LINE_BYTES
+#endif
+
+#if ( configMPSC_QUEUE_CACHE_LINE_BYTES < 1 )
+    #error configMPSC_QUEUE_CACHE_LINE_BYTES must be at least 1.
+#endif
+
+#ifndef configMPSC_QUEUE_NOTIFICATION_INDEX
+    #define configMPSC_QUEUE_NOTIFICATION_INDEX    configSPSC_RING_NOTIFICATION_INDEX
+#endif
+
+#if ( configMPSC_QUEUE_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+    #error configMPSC_QUEUE_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+#endif
+
+#ifndef configMULTI_WAIT_NOTIFICATION_INDEX
+    #define configMULTI_WAIT_NOTIFICATION_INDEX    ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#if ( configMULTI_WAIT_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+    #error configMULTI_WAIT_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+#endif
+
+#if ( ( configUSE_MULTI_WAIT == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_MULTI_WAIT requires configUSE_TASK_NOTIFICATIONS to be set to 1.
+#endif
+
+#ifndef configRWLOCK_MAX_READERS
+    #define configRWLOCK_MAX_READERS    8
+#endif
+
+#if ( configRWLOCK_MAX_READERS < 1 )
+    #error configRWLOCK_MAX_READERS must be at least 1.
+#endif
+
+#ifndef configEVENT_GROUP_WAITER_BUCKETS
+
+/* By default all the tasks waiting on an event group are held in one list. */
+    #define configEVENT_GROUP_WAITER_BUCKETS    1
+#endif
+
+#if ( configEVENT_GROUP_WAITER_BUCKETS < 1 )
+    #error configEVENT_GROUP_WAITER_BUCKETS must be at least 1.
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_ISR_SET
+
+/* By default xEventGroupSetBitsFromISR() defers the set to the timer task. */
+    #define configUSE_EVENT_GROUP_DIRECT_ISR_SET    0
+#endif
+
+#ifndef configEVENT_GROUP_ISR_MAX_WAITERS
+
+/* When configUSE_EVENT_GROUP_DIRECT_ISR_SET is 1, an interrupt that would have
+ * to look at more than this many waiting tasks to set event group bits passes
+ * the set to the timer task instead.  0 means there is no limit. */
+    #if ( ( configUSE_TIMERS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) )
+        #define configEVENT_GROUP_ISR_MAX_WAITERS    8
+    #else
+        #define configEVENT_GROUP_ISR_MAX_WAITERS    0
+    #endif
+#endif
+
+#if ( ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 ) && ( configEVENT_GROUP_ISR_MAX_WAITERS > 0 ) && ( ( configUSE_TIMERS == 0 ) || ( INCLUDE_xTimerPendFunctionCall == 0 ) ) )
+    #error configEVENT_GROUP_ISR_MAX_WAITERS requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be set to 1.
+#endif
+
 #ifndef configUSE_SB_COMPLETED_CALLBACK
 
 /* By default per-instance callbacks are not enabled for stream buffer or message buffer. */
@@ -999,6 +1363,68 @@
     #error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#if ( configNUMBER_OF_CORES < 1 )
+    #error configNUMBER_OF_CORES must be at least 1.
+#endif
+
+#ifndef configUSE_CORE_AFFINITY
+    #define configUSE_CORE_AFFINITY    0
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+        #error configUSE_PORT_OPTIMISED_TASK_SELECTION must be 0 when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_READY_PRIORITY_BITMAP != 0 )
+        #error configUSE_READY_PRIORITY_BITMAP must be 0 when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        #error configUSE_TICKLESS_IDLE must be 0 when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_VIRTUAL_TIME != 0 )
+        #error configUSE_VIRTUAL_TIME must be 0 when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_POSIX_ERRNO != 0 )
+        #error configUSE_POSIX_ERRNO must be 0 when configNUMBER_OF_CORES is greater than 1 as there is only one global errno.
+    #endif
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+        #error configSUPPORT_DYNAMIC_ALLOCATION must be 1 when configNUMBER_OF_CORES is greater than 1 as an idle task is created for each core.
+    #endif
+
+    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+        #error portCRITICAL_NESTING_IN_TCB must be 0 when configNUMBER_OF_CORES is greater than 1 as the critical nesting count is kept by the port for each core.
+    #endif
+
+    #if ( ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES > 32 ) )
+        #error configNUMBER_OF_CORES must be 32 or less when configUSE_CORE_AFFINITY is 1.
+    #endif
+
+    #ifndef portGET_CORE_ID
+        #error portGET_CORE_ID() must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #ifndef portYIELD_CORE
+        #error portYIELD_CORE() must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK ) || !defined( portGET_ISR_LOCK ) || !defined( portRELEASE_ISR_LOCK )
+        #error portGET_TASK_LOCK(), portRELEASE_TASK_LOCK(), portGET_ISR_LOCK() and portRELEASE_ISR_LOCK() must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if !defined( portGET_CRITICAL_NESTING_COUNT ) || !defined( portINCREMENT_CRITICAL_NESTING_COUNT ) || !defined( portDECREMENT_CRITICAL_NESTING_COUNT )
+        #error portGET_CRITICAL_NESTING_COUNT(), portINCREMENT_CRITICAL_NESTING_COUNT() and portDECREMENT_CRITICAL_NESTING_COUNT() must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if !defined( portENTER_CRITICAL_FROM_ISR ) || !defined( portEXIT_CRITICAL_FROM_ISR )
+        #error portENTER_CRITICAL_FROM_ISR() and portEXIT_CRITICAL_FROM_ISR() must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+    #endif
+#endif /* configNUMBER_OF_CORES */
+
 #if ( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
@@ -1301,6 +1727,21 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xDummy23;
+        #if ( configUSE_CORE_AFFINITY == 1 )
+            UBaseType_t uxDummy24;
+        #endif
+    #endif
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xDummy25;
+        TickType_t xDummy26;
+    #endif
+    #if ( configUSE_WAKE_LATENCY_HISTOGRAMS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy27;
+        uint32_t ulDummy28[ configWAKE_LATENCY_HISTOGRAM_BUCKETS ];
+        uint8_t ucDummy29;
+    #endif
 } StaticTask_t;
 
 /*
@@ -1343,6 +1784,29 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucDummy10;
+    #endif
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        UBaseType_t uxDummy11;
+        uint8_t ucDummy12;
+    #endif
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+        UBaseType_t uxDummy13;
+        uint8_t ucDummy14;
+    #endif
+
+    #if ( configUSE_MULTI_WAIT == 1 )
+        void * pvDummy15;
+    #endif
+
+    #if ( configGENERATE_QUEUE_STATS == 1 )
+        UBaseType_t uxDummy16;
+        uint32_t ulDummy17[ 6 ];
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1363,7 +1827,7 @@ typedef StaticQueue_t StaticSemaphore_t;
 typedef struct xSTATIC_EVENT_GROUP
 {
     TickType_t xDummy1;
-    StaticList_t xDummy2;
+    StaticList_t xDummy2[ configEVENT_GROUP_WAITER_BUCKETS ];
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy3;
@@ -1372,6 +1836,18 @@ typedef struct xSTATIC_EVENT_GROUP
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
+
+    #if ( configUSE_MULTI_WAIT == 1 )
+        void * pvDummy5;
+        TickType_t xDummy6;
+    #endif
+
+    TickType_t xDummy7[ configEVENT_GROUP_WAITER_BUCKETS ];
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+        UBaseType_t uxDummy8;
+        TickType_t xDummy9;
+    #endif
 } StaticEventGroup_t;
 
 /*
@@ -1426,11 +1902,99 @@ typedef struct xSTATIC_STREAM_BUFFER
     #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
         void * pvDummy5[ 2 ];
     #endif
+    #if ( configUSE_MULTI_WAIT == 1 )
+        void * pvDummy6;
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real single producer single consumer ring
+ * structure is not accessible to the application.  StaticSpscRing_t is provided
+ * so the memory for a ring can be allocated statically.  Its size and alignment
+ * requirements are guaranteed to match those of the genuine structure.
+ */
+typedef struct xSTATIC_SPSC_RING
+{
+    UBaseType_t uxDummy1;
+    void * pvDummy2;
+    uint8_t ucDummy3[ configSPSC_RING_CACHE_LINE_BYTES ];
+    UBaseType_t uxDummy4;
+    void * pvDummy5;
+    uint8_t ucDummy6[ configSPSC_RING_CACHE_LINE_BYTES ];
+    void * pvDummy7;
+    UBaseType_t uxDummy8[ 2 ];
+    uint8_t ucDummy9;
+} StaticSpscRing_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real multiple producer single consumer queue
+ * structure is not accessible to the application.  StaticMpscQueue_t is
+ * provided so the memory for such a queue can be allocated statically.  Its
+ * size and alignment requirements are guaranteed to match those of the genuine
+ * structure.
+ */
+typedef struct xSTATIC_MPSC_QUEUE
+{
+    UBaseType_t uxDummy1;
+    uint8_t ucDummy2[ configMPSC_QUEUE_CACHE_LINE_BYTES ];
+    UBaseType_t uxDummy3;
+    void * pvDummy4;
+    uint8_t ucDummy5[ configMPSC_QUEUE_CACHE_LINE_BYTES ];
+    void * pvDummy6;
+    UBaseType_t uxDummy7[ 3 ];
+    uint8_t ucDummy8;
+} StaticMpscQueue_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real publish/subscribe channel structure is not
+ * accessible to the application.  StaticPubSub_t is provided so the memory for
+ * a channel can be allocated statically.  Its size and alignment requirements
+ * are guaranteed to match those of the genuine structure.
+ */
+typedef struct xSTATIC_PUBSUB
+{
+    StaticList_t xDummy1;
+    UBaseType_t uxDummy2;
+    void * pvDummy3;
+    UBaseType_t uxDummy4[ 2 ];
+    uint8_t ucDummy5;
+} StaticPubSub_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real fast mutex structure is not accessible to the
+ * application.  StaticFastMutex_t is provided so the memory for a fast mutex
+ * can be allocated statically.  Its size and alignment requirements are
+ * guaranteed to match those of the genuine structure.
+ */
+typedef struct xSTATIC_FAST_MUTEX
+{
+    portPOINTER_SIZE_TYPE uxDummy1;
+    StaticList_t xDummy2;
+    uint8_t ucDummy3;
+} StaticFastMutex_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real reader-writer lock structure is not
+ * accessible to the application.  StaticRwLock_t is provided so the memory for
+ * a lock can be allocated statically.  Its size and alignment requirements are
+ * guaranteed to match those of the genuine structure.
+ */
+typedef struct xSTATIC_RWLOCK
+{
+    StaticList_t xDummy1[ 2 ];
+    void * pvDummy2[ 1 + configRWLOCK_MAX_READERS ];
+    UBaseType_t uxDummy3;
+    uint8_t ucDummy4;
+} StaticRwLock_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -376,11 +376,17 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * timer task to have the clear operation performed in the context of the timer
  * task.
  *
- * @note If this function returns pdPASS then the timer task is ready to run
- * and a portYIELD_FROM_ISR(pdTRUE) should be executed to perform the needed
- * clear on the event group.  This behavior is different from
- * xEventGroupSetBitsFromISR because the parameter xHigherPriorityTaskWoken is
- * not present.
+ * If configUSE_EVENT_GROUP_DIRECT_ISR_SET is set to 1 in FreeRTOSConfig.h then
+ * the bits are instead cleared from within the interrupt, in the same way
+ * xEventGroupSetBitsFromISR() then sets them, so a clear followed by a set
+ * from interrupts is performed in that order.  The timer task is not used,
+ * no yield is needed, and the function always returns pdPASS.
+ *
+ * @note If the clear is deferred and this function returns pdPASS then the
+ * timer task is ready to run and a portYIELD_FROM_ISR(pdTRUE) should be
+ * executed to perform the needed clear on the event group.  This behavior is
+ * different from xEventGroupSetBitsFromISR because the parameter
+ * xHigherPriorityTaskWoken is not present.
  *
  * @param xEventGroup The event group in which the bits are to be cleared.
  *
@@ -418,7 +424,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 ) )
     BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
                                             const EventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
 #else
@@ -517,6 +523,20 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_ISR_SET is set to 1 in FreeRTOSConfig.h then
+ * the bits are instead set, and the waiting tasks unblocked, from within the
+ * interrupt, so the timer task is not used.  The time spent in the interrupt
+ * then depends on the number of tasks waiting for the bits being set, which
+ * configEVENT_GROUP_WAITER_BUCKETS can be used to reduce.  If more than
+ * configEVENT_GROUP_ISR_MAX_WAITERS tasks would have to be looked at, the set
+ * is passed to the timer task after all, and bits set from interrupts after
+ * that are set by the timer task too, in order.  If a task is accessing the
+ * event group when the interrupt occurs the bits are set by that task as soon
+ * as it has finished.  *pxHigherPriorityTaskWoken is set to pdTRUE if a task
+ * with a priority above that of the interrupted task was unblocked, or if the
+ * set was passed to a timer task with such a priority, and the function always
+ * returns pdPASS.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -573,7 +593,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 ) )
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
                                           BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
@@ -766,6 +786,9 @@ void vEventGroupSetBitsCallback( void * pvEventGroup,
                                  const uint32_t ulBitsToSet ) PRIVILEGED_FUNCTION;
 void vEventGroupClearBitsCallback( void * pvEventGroup,
                                    const uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
+BaseType_t xEventGroupRegisterMultiWaitTask( EventGroupHandle_t xEventGroup,
+                                             TaskHandle_t xTask,
+                                             const EventBits_t uxBitsToWaitFor ) PRIVILEGED_FUNCTION;
 
 
 #if ( configUSE_TRACE_FACILITY == 1 )
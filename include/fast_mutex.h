@@ -0,0 +1,227 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A fast mutex is a mutex whose take and give, when no other task wants the
+ * mutex at the same time, are a single atomic compare and swap on the word
+ * that records the mutex's holder.  Unlike xSemaphoreTake() and
+ * xSemaphoreGive() on a mutex created with xSemaphoreCreateMutex(), the
+ * uncontended paths never enter a critical section.  When a task has to wait
+ * for the mutex it sets a waiters flag in the holder word, and from then on
+ * both sides fall back to the kernel: the waiting task blocks on the mutex's
+ * event list and the holder inherits its priority, exactly as with a standard
+ * mutex, and the holder's give then passes the mutex directly to the highest
+ * priority waiting task.
+ *
+ * Fast mutexes and standard mutexes share the held count each task uses to
+ * decide when to disinherit a priority, so a task can hold both kinds at once.
+ *
+ * A fast mutex must only be used from tasks, is not recursive, and must be
+ * given by the task that took it.
+ *
+ * The lock free paths use the compiler's __atomic builtins, so fast_mutex.c
+ * must be built with GCC or a compiler that provides them (such as Clang).
+ */
+
+#ifndef FAST_MUTEX_H
+#define FAST_MUTEX_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include fast_mutex.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which fast mutexes are referenced.  For example, a call to
+ * xFastMutexCreate() returns a FastMutexHandle_t variable that can then be
+ * used as a parameter to xFastMutexTake(), xFastMutexGive(), etc.
+ */
+struct FastMutexDef_t;
+typedef struct FastMutexDef_t * FastMutexHandle_t;
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * FastMutexHandle_t xFastMutexCreate( void );
+ * @endcode
+ *
+ * Creates a new fast mutex using dynamically allocated memory.  See
+ * xFastMutexCreateStatic() for a version that uses statically allocated
+ * memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xFastMutexCreate() to be available.
+ *
+ * @return If the mutex is created successfully then a handle to the created
+ * mutex is returned.  If there was not enough heap memory available to create
+ * the mutex then NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * FastMutexHandle_t xBusMutex;
+ *
+ * void vBusWrite( const uint8_t *pucData, size_t xLength )
+ * {
+ *  // Takes the mutex with one compare and swap if no other task holds it.
+ *  if( xFastMutexTake( xBusMutex, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      vBusTransfer( pucData, xLength );
+ *
+ *      // Gives the mutex with one compare and swap if no other task is
+ *      // waiting for it.
+ *      xFastMutexGive( xBusMutex );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xFastMutexCreate xFastMutexCreate
+ * \ingroup FastMutexManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    FastMutexHandle_t xFastMutexCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * FastMutexHandle_t xFastMutexCreateStatic( StaticFastMutex_t *pxStaticMutex );
+ * @endcode
+ *
+ * Creates a new fast mutex using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xFastMutexCreateStatic() to be available.
+ *
+ * @param pxStaticMutex Must point to a variable of type StaticFastMutex_t,
+ * which will be used to hold the mutex's data structure.
+ *
+ * @return If pxStaticMutex is not NULL then a handle to the created mutex is
+ * returned, otherwise NULL is returned.
+ *
+ * \defgroup xFastMutexCreateStatic xFastMutexCreateStatic
+ * \ingroup FastMutexManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    FastMutexHandle_t xFastMutexCreateStatic( StaticFastMutex_t * const pxStaticMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * BaseType_t xFastMutexTake( FastMutexHandle_t xMutex, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a fast mutex, blocking until it is available if another task holds
+ * it.  While the calling task is blocked the holder inherits the calling
+ * task's priority if it is higher than the holder's.
+ *
+ * @param xMutex The handle of the mutex to take.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for the mutex.  Setting xTicksToWait to
+ * portMAX_DELAY causes the task to wait indefinitely, provided
+ * INCLUDE_vTaskSuspend is set to 1 in FreeRTOSConfig.h.
+ *
+ * @return pdPASS if the mutex was taken, or pdFAIL if xTicksToWait expired
+ * without the mutex becoming available.
+ *
+ * \defgroup xFastMutexTake xFastMutexTake
+ * \ingroup FastMutexManagement
+ */
+BaseType_t xFastMutexTake( FastMutexHandle_t xMutex,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * BaseType_t xFastMutexGive( FastMutexHandle_t xMutex );
+ * @endcode
+ *
+ * Gives a fast mutex that was taken by the calling task.  If other tasks are
+ * waiting for the mutex then it is passed to the highest priority of them,
+ * and any priority the calling task inherited is disinherited once it holds
+ * no other mutexes.
+ *
+ * @param xMutex The handle of the mutex to give.
+ *
+ * @return pdPASS if the mutex was given, or pdFAIL if the calling task did
+ * not hold the mutex.
+ *
+ * \defgroup xFastMutexGive xFastMutexGive
+ * \ingroup FastMutexManagement
+ */
+BaseType_t xFastMutexGive( FastMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * TaskHandle_t xFastMutexGetHolder( FastMutexHandle_t xMutex );
+ * @endcode
+ *
+ * Returns the handle of the task that holds a fast mutex, or NULL if the mutex
+ * is available.  The value is a snapshot that can be out of date by the time
+ * it is returned.
+ *
+ * \defgroup xFastMutexGetHolder xFastMutexGetHolder
+ * \ingroup FastMutexManagement
+ */
+TaskHandle_t xFastMutexGetHolder( FastMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * void vFastMutexDelete( FastMutexHandle_t xMutex );
+ * @endcode
+ *
+ * Deletes a fast mutex that was previously created using xFastMutexCreate()
+ * or xFastMutexCreateStatic().  If the mutex was created using dynamic memory
+ * then the memory is freed.  A mutex must not be deleted while it is held.
+ *
+ * \defgroup vFastMutexDelete vFastMutexDelete
+ * \ingroup FastMutexManagement
+ */
+void vFastMutexDelete( FastMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( FAST_MUTEX_H ) */
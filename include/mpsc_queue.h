@@ -0,0 +1,318 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A multiple producer single consumer (MPSC) queue passes fixed size items, by
+ * copy, from any number of tasks and interrupts to a single consumer task.
+ * Sending to a queue that is not full never enters a critical section or masks
+ * interrupts: a producer claims a slot by advancing the queue's enqueue
+ * position with a compare and swap, copies its item into the slot, then
+ * publishes the slot through a sequence number the slot carries.  Producers
+ * never block - a send to a full queue fails immediately - so the queue's
+ * length should cover the worst case burst from all of its producers.
+ *
+ * The kernel is only involved when the consumer has to block because the queue
+ * is empty, in which case the producer that publishes the next item wakes it
+ * with a direct to task notification at index
+ * configMPSC_QUEUE_NOTIFICATION_INDEX.  That index must not be used for
+ * anything else by the consumer task.
+ *
+ * Items are received in the order their slots were claimed.  If a producer is
+ * preempted between claiming a slot and publishing it then the consumer cannot
+ * receive that item, or any item claimed after it, until the producer runs
+ * again.  Producers that can preempt each other should therefore keep the time
+ * between the two steps short, which xMpscQueueSend() does by only copying the
+ * item in between.
+ *
+ * ***NOTE***:  Only one task can receive from the queue.
+ *
+ * The lock free paths use the compiler's __atomic builtins, so mpsc_queue.c
+ * must be built with GCC or a compiler that provides them (such as Clang), for
+ * a target that has a native compare and swap instruction.
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include mpsc_queue.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which multiple producer single consumer queues are referenced.  For
+ * example, a call to xMpscQueueCreate() returns an MpscQueueHandle_t variable
+ * that can then be used as a parameter to xMpscQueueSend(),
+ * xMpscQueueReceive(), etc.
+ */
+struct MpscQueueDef_t;
+typedef struct MpscQueueDef_t * MpscQueueHandle_t;
+
+/**
+ * mpsc_queue.h
+ *
+ * The number of UBaseType_t words of storage area a queue that holds uxLength
+ * items of uxItemSize bytes each needs when it is created with
+ * xMpscQueueCreateStatic().  Each slot holds a sequence number followed by the
+ * item, padded to a whole number of words.
+ */
+#define mpscQUEUE_STORAGE_WORDS( uxLength, uxItemSize ) \
+    ( ( size_t ) ( uxLength ) * ( ( size_t ) 1 + ( ( ( size_t ) ( uxItemSize ) + sizeof( UBaseType_t ) - ( size_t ) 1 ) / sizeof( UBaseType_t ) ) ) )
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * MpscQueueHandle_t xMpscQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new multiple producer single consumer queue using dynamically
+ * allocated memory.  See xMpscQueueCreateStatic() for a version that uses
+ * statically allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xMpscQueueCreate() to be available.
+ *
+ * @param uxLength The maximum number of items the queue can hold at any one
+ * time.  Must be a power of two.
+ *
+ * @param uxItemSize The size, in bytes, of each item.  Items are copied into
+ * and out of the queue.
+ *
+ * @return If the queue is created successfully then a handle to the created
+ * queue is returned.  If there was not enough heap memory available to create
+ * the queue then NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * typedef struct
+ * {
+ *  uint8_t ucSource;
+ *  uint8_t ucEvent;
+ * } Event_t;
+ *
+ * MpscQueueHandle_t xDispatchQueue;
+ *
+ * void vUARTInterruptHandler( void )
+ * {
+ * Event_t xEvent = { SOURCE_UART, usReadUARTStatus() };
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  // Other interrupts and tasks may be sending to the same queue.  None of
+ *  // them masks interrupts unless the dispatcher is blocked.
+ *  ( void ) xMpscQueueSendFromISR( xDispatchQueue, &xEvent, &xHigherPriorityTaskWoken );
+ *
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vDispatcherTask( void *pvParameters )
+ * {
+ * Event_t xEvent;
+ *
+ *  xDispatchQueue = xMpscQueueCreate( 64, sizeof( Event_t ) );
+ *
+ *  for( ;; )
+ *  {
+ *      if( xMpscQueueReceive( xDispatchQueue, &xEvent, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          vDispatch( &xEvent );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xMpscQueueCreate xMpscQueueCreate
+ * \ingroup MpscQueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    MpscQueueHandle_t xMpscQueueCreate( const UBaseType_t uxLength,
+                                        const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * MpscQueueHandle_t xMpscQueueCreateStatic( UBaseType_t uxLength,
+ *                                           UBaseType_t uxItemSize,
+ *                                           UBaseType_t *puxQueueStorageArea,
+ *                                           StaticMpscQueue_t *pxStaticQueue );
+ * @endcode
+ *
+ * Creates a new multiple producer single consumer queue using statically
+ * allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xMpscQueueCreateStatic() to be available.
+ *
+ * @param uxLength The maximum number of items the queue can hold at any one
+ * time.  Must be a power of two.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @param puxQueueStorageArea Must point to a UBaseType_t array that has at
+ * least mpscQUEUE_STORAGE_WORDS( uxLength, uxItemSize ) entries.
+ *
+ * @param pxStaticQueue Must point to a variable of type StaticMpscQueue_t,
+ * which will be used to hold the queue's data structure.
+ *
+ * @return If neither puxQueueStorageArea nor pxStaticQueue are NULL then a
+ * handle to the created queue is returned, otherwise NULL is returned.
+ *
+ * \defgroup xMpscQueueCreateStatic xMpscQueueCreateStatic
+ * \ingroup MpscQueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    MpscQueueHandle_t xMpscQueueCreateStatic( const UBaseType_t uxLength,
+                                              const UBaseType_t uxItemSize,
+                                              UBaseType_t * const puxQueueStorageArea,
+                                              StaticMpscQueue_t * const pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xMpscQueueSend( MpscQueueHandle_t xQueue, const void *pvItemToQueue );
+ * @endcode
+ *
+ * Copies an item into a multiple producer single consumer queue.  Can be
+ * called by any number of tasks at the same time.  Never blocks.
+ *
+ * @param xQueue The handle of the queue to which the item is being sent.
+ *
+ * @param pvItemToQueue A pointer to the item to copy into the queue.
+ *
+ * @return pdPASS if the item was sent, or errQUEUE_FULL if the queue was full.
+ *
+ * \defgroup xMpscQueueSend xMpscQueueSend
+ * \ingroup MpscQueueManagement
+ */
+BaseType_t xMpscQueueSend( MpscQueueHandle_t xQueue,
+                           const void * pvItemToQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xMpscQueueSendFromISR( MpscQueueHandle_t xQueue,
+ *                                   const void *pvItemToQueue,
+ *                                   BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xMpscQueueSend().  Can be called by any number of
+ * interrupts at the same time, including interrupts that preempt a task or
+ * another interrupt that is sending to the same queue.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item unblocked
+ * a consumer task that has a priority higher than the currently running task,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return pdPASS if the item was sent, or errQUEUE_FULL if the queue was full.
+ *
+ * \defgroup xMpscQueueSendFromISR xMpscQueueSendFromISR
+ * \ingroup MpscQueueManagement
+ */
+BaseType_t xMpscQueueSendFromISR( MpscQueueHandle_t xQueue,
+                                  const void * pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xMpscQueueReceive( MpscQueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the oldest published item out of a multiple producer single consumer
+ * queue.  Must only be called by the queue's consumer task.
+ *
+ * @param xQueue The handle of the queue from which the item is being received.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for an item if the queue is empty.
+ *
+ * @return pdPASS if an item was received, or errQUEUE_EMPTY if no item was
+ * published before xTicksToWait expired.
+ *
+ * \defgroup xMpscQueueReceive xMpscQueueReceive
+ * \ingroup MpscQueueManagement
+ */
+BaseType_t xMpscQueueReceive( MpscQueueHandle_t xQueue,
+                              void * pvBuffer,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * UBaseType_t uxMpscQueueItemsWaiting( MpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Queries the number of slots that have been claimed by producers but not yet
+ * received, which includes items that are still being copied in.  The value
+ * is a snapshot that can be out of date by the time it is returned.  Can be
+ * called from an interrupt.
+ *
+ * \defgroup uxMpscQueueItemsWaiting uxMpscQueueItemsWaiting
+ * \ingroup MpscQueueManagement
+ */
+UBaseType_t uxMpscQueueItemsWaiting( MpscQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * void vMpscQueueDelete( MpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Deletes a queue that was previously created using xMpscQueueCreate() or
+ * xMpscQueueCreateStatic().  If the queue was created using dynamic memory
+ * then the memory is freed.  The queue must not be deleted while a task is
+ * blocked on it or a producer could still send to it.
+ *
+ * \defgroup vMpscQueueDelete vMpscQueueDelete
+ * \ingroup MpscQueueManagement
+ */
+void vMpscQueueDelete( MpscQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( MPSC_QUEUE_H ) */
@@ -0,0 +1,227 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Multi object wait.
+ *
+ * uxMultiWaitForAny() blocks the calling task until any one of a set of
+ * queues, semaphores, event groups, stream buffers and message buffers has
+ * something for it, or until its direct to task notification is given.  Unlike
+ * a queue set nothing has to be decided when the objects are created: the
+ * objects to wait for are passed in an array each time the function is called,
+ * nothing is copied into an intermediate queue, and event groups, stream
+ * buffers and notifications can be waited for alongside queues.
+ *
+ * While uxMultiWaitForAny() is waiting each object records the waiting task's
+ * handle.  Sending to a queue, giving a semaphore, setting a bit the task is
+ * waiting for in an event group, or writing to a stream buffer notifies the
+ * recorded task at index configMULTI_WAIT_NOTIFICATION_INDEX without changing
+ * the notification value, which unblocks the task so it can look at its
+ * objects again.  That index must not be used for anything else by a task that
+ * calls uxMultiWaitForAny(), other than to signal an eMultiWaitNotification
+ * object as described below.
+ *
+ * ***NOTE***:  Only one task at a time can wait for any one object using
+ * uxMultiWaitForAny().  The function fails, returning multiwaitOBJECT_BUSY
+ * without blocking, if another task is already waiting for one of the objects.
+ * That is a design error, so it also fails configASSERT().  Queue sets cannot
+ * themselves be waited for - wait for their members instead.
+ *
+ * uxMultiWaitForAny() only reports which objects are ready.  The caller still
+ * has to receive from a queue, take a semaphore, read a stream buffer, etc.
+ * using the object's own API, with a block time of zero.  If another task or
+ * interrupt uses the object in between, the object may no longer be ready
+ * when that call is made.
+ *
+ * configUSE_MULTI_WAIT must be set to 1 in FreeRTOSConfig.h for the API in
+ * this file to be available.
+ */
+
+#ifndef MULTI_WAIT_H
+#define MULTI_WAIT_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include multi_wait.h"
+#endif
+
+#include "queue.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Returned by uxMultiWaitForAny() if another task is already waiting for one
+ * of the objects.  It cannot be a count of ready objects, so it cannot be
+ * mistaken for a timeout.
+ */
+#define multiwaitOBJECT_BUSY    ( ~( ( UBaseType_t ) 0U ) )
+
+/**
+ * The kinds of object uxMultiWaitForAny() can wait for.
+ *
+ * eMultiWaitQueue: pvObject is a QueueHandle_t or SemaphoreHandle_t.  The
+ * object is ready when it holds at least one item, or, for a semaphore, when
+ * it is available.
+ *
+ * eMultiWaitEventGroup: pvObject is an EventGroupHandle_t.  The object is
+ * ready when any of the bits in uxBitsToWaitFor are set.  The bits are not
+ * cleared.
+ *
+ * eMultiWaitStreamBuffer: pvObject is a StreamBufferHandle_t or
+ * MessageBufferHandle_t.  The object is ready when the buffer is not empty.
+ *
+ * eMultiWaitNotification: pvObject is not used.  The object is ready when the
+ * calling task's notification value at index configMULTI_WAIT_NOTIFICATION_INDEX
+ * is not zero.  Other tasks and interrupts signal it using, for example,
+ * xTaskNotifyIndexed( xTask, configMULTI_WAIT_NOTIFICATION_INDEX, ulBits, eSetBits ),
+ * and the waiting task reads and clears the value using
+ * ulTaskNotifyTakeIndexed( configMULTI_WAIT_NOTIFICATION_INDEX, pdTRUE, 0 ).
+ */
+typedef enum
+{
+    eMultiWaitQueue = 0,
+    eMultiWaitEventGroup,
+    eMultiWaitStreamBuffer,
+    eMultiWaitNotification
+} eMultiWaitObjectType;
+
+/**
+ * Describes one object passed to uxMultiWaitForAny().  eObjectType, pvObject
+ * and, for event groups, uxBitsToWaitFor are set by the caller.  xReady is set
+ * by uxMultiWaitForAny() to pdTRUE if the object was ready when the function
+ * returned, otherwise pdFALSE.
+ */
+typedef struct xMULTI_WAIT_OBJECT
+{
+    eMultiWaitObjectType eObjectType;
+    void * pvObject;
+    EventBits_t uxBitsToWaitFor;
+    BaseType_t xReady;
+} MultiWaitObject_t;
+
+/**
+ * multi_wait.h
+ *
+ * @code{c}
+ * UBaseType_t uxMultiWaitForAny( MultiWaitObject_t * const pxObjects,
+ *                                const UBaseType_t uxObjectCount,
+ *                                TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Blocks the calling task until at least one of the objects described by
+ * pxObjects is ready, or until xTicksToWait ticks have passed.
+ *
+ * This function must not be called from an interrupt service routine, or
+ * while the scheduler is suspended.  An event group can appear in the array
+ * more than once, with different bits, in which case the task is woken when
+ * any of the bits of any of its entries are set, and the xReady member of each
+ * entry reflects that entry's own bits.
+ *
+ * @param pxObjects An array of uxObjectCount objects to wait for.  On return
+ * the xReady member of each entry indicates whether that object is ready.
+ *
+ * @param uxObjectCount The number of entries in pxObjects.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for an object to become ready.  Setting xTicksToWait
+ * to zero causes the function to return immediately.  Setting it to
+ * portMAX_DELAY causes the task to wait indefinitely, provided
+ * INCLUDE_vTaskSuspend is set to 1 in FreeRTOSConfig.h.
+ *
+ * @return The number of objects that are ready.  0 is returned if the block
+ * time expired before any object became ready.  multiwaitOBJECT_BUSY is
+ * returned, without blocking, if another task is already waiting for one of
+ * the objects using uxMultiWaitForAny().
+ *
+ * Example usage:
+ * @code{c}
+ * void vGatewayTask( void *pvParameters )
+ * {
+ * MultiWaitObject_t xObjects[ 3 ];
+ * Command_t xCommand;
+ * uint8_t ucRxBytes[ 32 ];
+ * size_t xReceived;
+ *
+ *  xObjects[ 0 ].eObjectType = eMultiWaitQueue;
+ *  xObjects[ 0 ].pvObject = xCommandQueue;
+ *
+ *  xObjects[ 1 ].eObjectType = eMultiWaitStreamBuffer;
+ *  xObjects[ 1 ].pvObject = xUartRxStream;
+ *
+ *  xObjects[ 2 ].eObjectType = eMultiWaitEventGroup;
+ *  xObjects[ 2 ].pvObject = xLinkEvents;
+ *  xObjects[ 2 ].uxBitsToWaitFor = LINK_UP_BIT | LINK_DOWN_BIT;
+ *
+ *  for( ;; )
+ *  {
+ *      if( uxMultiWaitForAny( xObjects, 3, pdMS_TO_TICKS( 500 ) ) == 0 )
+ *      {
+ *          vSendKeepAlive();
+ *          continue;
+ *      }
+ *
+ *      if( xObjects[ 0 ].xReady != pdFALSE )
+ *      {
+ *          while( xQueueReceive( xCommandQueue, &xCommand, 0 ) == pdPASS )
+ *          {
+ *              vProcessCommand( &xCommand );
+ *          }
+ *      }
+ *
+ *      if( xObjects[ 1 ].xReady != pdFALSE )
+ *      {
+ *          xReceived = xStreamBufferReceive( xUartRxStream, ucRxBytes, sizeof( ucRxBytes ), 0 );
+ *          vProcessBytes( ucRxBytes, xReceived );
+ *      }
+ *
+ *      if( xObjects[ 2 ].xReady != pdFALSE )
+ *      {
+ *          vProcessLinkChange( xEventGroupClearBits( xLinkEvents, LINK_UP_BIT | LINK_DOWN_BIT ) );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup uxMultiWaitForAny uxMultiWaitForAny
+ * \ingroup MultiWait
+ */
+UBaseType_t uxMultiWaitForAny( MultiWaitObject_t * const pxObjects,
+                               const UBaseType_t uxObjectCount,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( MULTI_WAIT_H ) */
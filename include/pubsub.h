@@ -0,0 +1,355 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A publish/subscribe channel broadcasts fixed size items from any number of
+ * publishers to any number of subscribers.  Publishing copies the item once,
+ * into a ring of uxLength slots shared by all the subscribers, and unblocks
+ * every task that is waiting for a new item - fanning an item out to K
+ * subscribers does not need K queues, K sends or K copies of the item on the
+ * publishing side.
+ *
+ * Each subscriber has its own read position (a PubSubSubscriber_t that the
+ * subscriber owns), so each receives every item published after it subscribed,
+ * in the order the items were published, at its own pace.  Publishing never
+ * blocks and never fails: when the ring is full the oldest item is
+ * overwritten.  A subscriber that falls more than uxLength items behind is not
+ * waited for - the next xPubSubReceive() call it makes reports how many items
+ * it missed and then returns the oldest item that is still in the ring.
+ *
+ * Subscribers that have to wait for an item block on the channel's event list,
+ * in the same way tasks block on a queue, so any number of subscribers can
+ * block on the same channel.  Publishing from an interrupt unblocks every
+ * waiting subscriber from within the interrupt, so the number of subscribers
+ * that can be blocked on a channel at once adds to interrupt latency.
+ */
+
+#ifndef PUBSUB_H
+#define PUBSUB_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include pubsub.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which publish/subscribe channels are referenced.  For example, a
+ * call to xPubSubCreate() returns a PubSubHandle_t variable that can then be
+ * used as a parameter to vPubSubPublish(), vPubSubSubscribe(), etc.
+ */
+struct PubSubDef_t;
+typedef struct PubSubDef_t * PubSubHandle_t;
+
+/**
+ * Holds the read position of one subscriber.  Each subscriber provides its
+ * own PubSubSubscriber_t, initialised by vPubSubSubscribe(), and passes it to
+ * xPubSubReceive().  A subscriber can stop receiving at any time by no longer
+ * calling xPubSubReceive() - the channel keeps no record of its subscribers.
+ * The members must not be accessed directly.
+ */
+typedef struct xPUBSUB_SUBSCRIBER
+{
+    PubSubHandle_t xChannel;
+    UBaseType_t uxNextSequence;
+} PubSubSubscriber_t;
+
+/**
+ * pubsub.h
+ *
+ * @code{c}
+ * PubSubHandle_t xPubSubCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new publish/subscribe channel using dynamically allocated memory.
+ * See xPubSubCreateStatic() for a version that uses statically allocated
+ * memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xPubSubCreate() to be available.
+ *
+ * @param uxLength The number of most recently published items the channel
+ * keeps for subscribers that have not received them yet.  Must be a power of
+ * two.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return If the channel is created successfully then a handle to the
+ * created channel is returned.  If there was not enough heap memory available
+ * to create the channel then NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * PubSubHandle_t xSensorChannel;
+ *
+ * void vSamplerTask( void *pvParameters )
+ * {
+ * Sample_t xSample;
+ *
+ *  for( ;; )
+ *  {
+ *      vReadSensors( &xSample );
+ *
+ *      // Every subscriber will receive xSample.  This never blocks.
+ *      vPubSubPublish( xSensorChannel, &xSample );
+ *      vTaskDelay( pdMS_TO_TICKS( 10 ) );
+ *  }
+ * }
+ *
+ * void vLoggerTask( void *pvParameters )
+ * {
+ * PubSubSubscriber_t xSubscriber;
+ * Sample_t xSample;
+ * UBaseType_t uxLost;
+ *
+ *  vPubSubSubscribe( xSensorChannel, &xSubscriber );
+ *
+ *  for( ;; )
+ *  {
+ *      if( xPubSubReceive( &xSubscriber, &xSample, &uxLost, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          if( uxLost != 0 )
+ *          {
+ *              // This task fell behind and uxLost samples were overwritten
+ *              // before it received them.
+ *              vLogGap( uxLost );
+ *          }
+ *
+ *          vLogSample( &xSample );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xPubSubCreate xPubSubCreate
+ * \ingroup PubSubManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    PubSubHandle_t xPubSubCreate( const UBaseType_t uxLength,
+                                  const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * pubsub.h
+ *
+ * @code{c}
+ * PubSubHandle_t xPubSubCreateStatic( UBaseType_t uxLength,
+ *                                     UBaseType_t uxItemSize,
+ *                                     uint8_t *pucStorageArea,
+ *                                     StaticPubSub_t *pxStaticChannel );
+ * @endcode
+ *
+ * Creates a new publish/subscribe channel using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xPubSubCreateStatic() to be available.
+ *
+ * @param uxLength The number of most recently published items the channel
+ * keeps.  Must be a power of two.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @param pucStorageArea Must point to a uint8_t array that is at least
+ * uxLength * uxItemSize bytes long.
+ *
+ * @param pxStaticChannel Must point to a variable of type StaticPubSub_t,
+ * which will be used to hold the channel's data structure.
+ *
+ * @return If neither pucStorageArea nor pxStaticChannel are NULL then a
+ * handle to the created channel is returned, otherwise NULL is returned.
+ *
+ * \defgroup xPubSubCreateStatic xPubSubCreateStatic
+ * \ingroup PubSubManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    PubSubHandle_t xPubSubCreateStatic( const UBaseType_t uxLength,
+                                        const UBaseType_t uxItemSize,
+                                        uint8_t * const pucStorageArea,
+                                        StaticPubSub_t * const pxStaticChannel ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * pubsub.h
+ *
+ * @code{c}
+ * void vPubSubSubscribe( PubSubHandle_t xChannel, PubSubSubscriber_t *pxSubscriber );
+ * @endcode
+ *
+ * Initialises *pxSubscriber so it can be passed to xPubSubReceive().  The
+ * subscriber receives the items published to xChannel after this call, not
+ * the items that were published before it.  Calling vPubSubSubscribe() again
+ * with the same pxSubscriber skips any items the subscriber has not yet
+ * received.
+ *
+ * @param xChannel The handle of the channel to subscribe to.
+ *
+ * @param pxSubscriber The read position to initialise.  It must remain valid
+ * for as long as it is used with xPubSubReceive().
+ *
+ * \defgroup vPubSubSubscribe vPubSubSubscribe
+ * \ingroup PubSubManagement
+ */
+void vPubSubSubscribe( PubSubHandle_t xChannel,
+                       PubSubSubscriber_t * const pxSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * pubsub.h
+ *
+ * @code{c}
+ * void vPubSubPublish( PubSubHandle_t xChannel, const void *pvItem );
+ * @endcode
+ *
+ * Publishes an item to every subscriber of a channel, overwriting the oldest
+ * item in the channel if it is full, and unblocks every subscriber that is
+ * waiting for an item.  Never blocks.
+ *
+ * @param xChannel The handle of the channel to publish to.
+ *
+ * @param pvItem A pointer to the item to publish.  uxItemSize bytes, as
+ * passed to xPubSubCreate(), are copied from pvItem into the channel.
+ *
+ * \defgroup vPubSubPublish vPubSubPublish
+ * \ingroup PubSubManagement
+ */
+void vPubSubPublish( PubSubHandle_t xChannel,
+                     const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * pubsub.h
+ *
+ * @code{c}
+ * void vPubSubPublishFromISR( PubSubHandle_t xChannel,
+ *                             const void *pvItem,
+ *                             BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vPubSubPublish() that can be called from an interrupt service
+ * routine (ISR).
+ *
+ * @param xChannel The handle of the channel to publish to.
+ *
+ * @param pvItem A pointer to the item to publish.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to
+ * pdTRUE if publishing the item unblocked a subscriber that has a priority
+ * higher than the task that was running when the interrupt occurred, in which
+ * case a context switch should be requested before the interrupt exits.  It
+ * can be NULL.
+ *
+ * \defgroup vPubSubPublishFromISR vPubSubPublishFromISR
+ * \ingroup PubSubManagement
+ */
+void vPubSubPublishFromISR( PubSubHandle_t xChannel,
+                            const void * pvItem,
+                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * pubsub.h
+ *
+ * @code{c}
+ * BaseType_t xPubSubReceive( PubSubSubscriber_t *pxSubscriber,
+ *                            void *pvBuffer,
+ *                            UBaseType_t *puxItemsLost,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives the next item published to a subscriber's channel, blocking until
+ * one is published if the subscriber has already received every item.
+ *
+ * Must only be called from a task, and must not be called by more than one
+ * task at a time for the same subscriber.
+ *
+ * @param pxSubscriber The read position of the subscriber, as initialised by
+ * vPubSubSubscribe().
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param puxItemsLost If the subscriber fell so far behind that items it had
+ * not received were overwritten then *puxItemsLost is set to the number of
+ * items it missed, and the oldest item still in the channel is received.
+ * Otherwise *puxItemsLost is set to 0.  Can be NULL if the caller does not
+ * need to know.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in
+ * the Blocked state to wait for an item to be published.  Setting
+ * xTicksToWait to portMAX_DELAY causes the task to wait indefinitely,
+ * provided INCLUDE_vTaskSuspend is set to 1 in FreeRTOSConfig.h.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xPubSubReceive xPubSubReceive
+ * \ingroup PubSubManagement
+ */
+BaseType_t xPubSubReceive( PubSubSubscriber_t * const pxSubscriber,
+                           void * const pvBuffer,
+                           UBaseType_t * const puxItemsLost,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * pubsub.h
+ *
+ * @code{c}
+ * UBaseType_t uxPubSubItemsWaiting( const PubSubSubscriber_t *pxSubscriber );
+ * @endcode
+ *
+ * Returns the number of items a subscriber can receive without blocking,
+ * which is at most the length of its channel.
+ *
+ * \defgroup uxPubSubItemsWaiting uxPubSubItemsWaiting
+ * \ingroup PubSubManagement
+ */
+UBaseType_t uxPubSubItemsWaiting( const PubSubSubscriber_t * const pxSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * pubsub.h
+ *
+ * @code{c}
+ * void vPubSubDelete( PubSubHandle_t xChannel );
+ * @endcode
+ *
+ * Deletes a channel that was previously created using xPubSubCreate() or
+ * xPubSubCreateStatic().  If the channel was created using dynamic memory
+ * then the memory is freed.  No task can be blocked on the channel when it is
+ * deleted, and its subscribers must not be used again.
+ *
+ * \defgroup vPubSubDelete vPubSubDelete
+ * \ingroup PubSubManagement
+ */
+void vPubSubDelete( PubSubHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( PUBSUB_H ) */
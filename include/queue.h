@@ -64,6 +64,36 @@ typedef struct QueueDefinition   * QueueSetHandle_t;
  */
 typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 
+/**
+ * Used with vQueueGetStatistics() and uxQueueGetRegistryStatistics() to
+ * report how a queue, semaphore or mutex has been used since it was created.
+ * Only available when configGENERATE_QUEUE_STATS is set to 1 in
+ * FreeRTOSConfig.h.  Block times are measured in ticks, from the time the
+ * calling task first found it had to wait to the time the call returned,
+ * whether or not the call then succeeded.  The counts wrap on overflow.
+ */
+typedef struct xQUEUE_STATISTICS
+{
+    UBaseType_t uxPeakMessagesWaiting; /* The largest number of items the queue has held, or the highest count of a semaphore. */
+    uint32_t ulSendCount;              /* The number of items sent to the queue, or semaphore gives. */
+    uint32_t ulReceiveCount;           /* The number of items received from the queue, or semaphore takes. */
+    uint32_t ulBlockedSendCount;       /* The number of sends that had to wait for space in the queue. */
+    uint32_t ulBlockedSendTicks;       /* The total time spent waiting by those sends. */
+    uint32_t ulBlockedReceiveCount;    /* The number of receives and peeks that had to wait for an item. */
+    uint32_t ulBlockedReceiveTicks;    /* The total time spent waiting by those receives and peeks. */
+} QueueStatistics_t;
+
+/**
+ * Used with uxQueueGetRegistryStatistics() to report the statistics of every
+ * queue in the queue registry.
+ */
+typedef struct xQUEUE_REGISTRY_STATISTICS
+{
+    const char * pcQueueName; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    QueueHandle_t xHandle;
+    QueueStatistics_t xStatistics;
+} QueueRegistryStatistics_t;
+
 /* For internal use only. */
 #define queueSEND_TO_BACK                     ( ( BaseType_t ) 0 )
 #define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
@@ -76,6 +106,7 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE    ( ( uint8_t ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE      ( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX       ( ( uint8_t ) 4U )
+#define queueQUEUE_TYPE_PRIORITY              ( ( uint8_t ) 5U )
 
 /**
  * queue. h
@@ -235,6 +266,115 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
     #define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_BASE ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreatePriority(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize
+ *                        );
+ * @endcode
+ *
+ * Creates a new priority queue and returns a handle by which it can be
+ * referenced.  A priority queue is used with the same API as any other queue,
+ * but items are received highest priority first rather than in the order they
+ * were sent.  Items of equal priority are received in the order they were sent.
+ *
+ * The priority of an item is the UBaseType_t value at the start of the item,
+ * so items are normally structures that have a UBaseType_t as their first
+ * member.  Higher values are received first, as with task priorities.
+ *
+ * The items are kept in a binary heap within the queue storage area, so
+ * sending and receiving cost O(log n) in the number of items in the queue.
+ * Blocking works exactly as it does for other queues.  queueSEND_TO_FRONT has
+ * no special meaning for a priority queue - an item is always placed by its
+ * priority.  The zero copy functions (pvQueueReserve() etc.) and the functions
+ * that send or receive multiple items cannot be used with a priority queue.
+ *
+ * configUSE_PRIORITY_QUEUES must be set to 1 in FreeRTOSConfig.h for
+ * xQueueCreatePriority() to be available.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must be at least sizeof( UBaseType_t ).
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * Example usage:
+ * @code{c}
+ * typedef struct
+ * {
+ *  UBaseType_t uxPriority; // Must be the first member.
+ *  uint8_t ucCommand;
+ *  uint32_t ulParameter;
+ * } Command_t;
+ *
+ * void vDispatcherTask( void *pvParameters )
+ * {
+ * QueueHandle_t xCommandQueue;
+ * Command_t xCommand;
+ *
+ *  xCommandQueue = xQueueCreatePriority( 20, sizeof( Command_t ) );
+ *
+ *  for( ;; )
+ *  {
+ *      // Urgent commands are received before routine commands that were
+ *      // sent before them.
+ *      if( xQueueReceive( xCommandQueue, &xCommand, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          vProcessCommand( &xCommand );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueCreatePriority xQueueCreatePriority
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    #define xQueueCreatePriority( uxQueueLength, uxItemSize )    xQueueGenericCreate( ( uxQueueLength ), ( uxItemSize ), ( queueQUEUE_TYPE_PRIORITY ) )
+#endif
+
+/**
+ * queue. h
+ *
+ * The number of bytes of storage a priority queue that holds uxQueueLength
+ * items of uxItemSize bytes each needs when it is created with
+ * xQueueCreatePriorityStatic().  As well as the items themselves a priority
+ * queue stores a sequence number for each item, which keeps items of equal
+ * priority in the order they were sent.
+ */
+#define queuePRIORITY_QUEUE_STORAGE_BYTES( uxQueueLength, uxItemSize )    ( ( size_t ) ( uxQueueLength ) * ( ( size_t ) ( uxItemSize ) + sizeof( UBaseType_t ) ) )
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreatePriorityStatic(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            uint8_t *pucQueueStorage,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * As xQueueCreatePriority(), but the memory used by the queue is provided by
+ * the application writer, as for xQueueCreateStatic().  pucQueueStorage must
+ * point to a uint8_t array that is at least
+ * queuePRIORITY_QUEUE_STORAGE_BYTES( uxQueueLength, uxItemSize ) bytes long.
+ *
+ * configUSE_PRIORITY_QUEUES and configSUPPORT_STATIC_ALLOCATION must both be
+ * set to 1 in FreeRTOSConfig.h for xQueueCreatePriorityStatic() to be
+ * available.
+ *
+ * \defgroup xQueueCreatePriorityStatic xQueueCreatePriorityStatic
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    #define xQueueCreatePriorityStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_PRIORITY ) )
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -1418,6 +1558,426 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultiple(
+ *                                   QueueHandle_t xQueue,
+ *                                   const void *pvItemsToQueue,
+ *                                   UBaseType_t uxItemCount,
+ *                                   TickType_t xTicksToWait
+ *                                 );
+ * @endcode
+ *
+ * Post up to uxItemCount items to the back of a queue.  The items are copied
+ * from consecutive elements of the pvItemsToQueue array, in order.  As many as
+ * there is space for are posted in one critical section, and the tasks they
+ * unblock are unblocked in the same critical section, so posting a burst of
+ * items costs much less than calling xQueueSend() for each item.
+ *
+ * If the queue cannot hold all the items the calling task blocks until there
+ * is space for more, posting them as space becomes available, until either all
+ * the items are posted or xTicksToWait expires.  The block time covers the
+ * whole call, not each item.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ * The queue must not be a semaphore.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items, each the
+ * size the queue was created to hold.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to post all the items.
+ *
+ * @return The number of items posted, which is less than uxItemCount if the
+ * block time expired first.  The items posted are always the first ones in
+ * the array.
+ *
+ * Example usage:
+ * @code{c}
+ * void vADmaCompleteTask( void *pvParameters )
+ * {
+ * QueueHandle_t xQueue = ( QueueHandle_t ) pvParameters;
+ * uint16_t usSamples[ 64 ];
+ * UBaseType_t uxSent;
+ *
+ *  for( ;; )
+ *  {
+ *      vWaitForSamples( usSamples );
+ *
+ *      // Post the whole burst, waiting up to 10 ticks for space.
+ *      uxSent = uxQueueSendMultiple( xQueue, usSamples, 64, ( TickType_t ) 10 );
+ *
+ *      if( uxSent < 64 )
+ *      {
+ *          // The last 64 - uxSent samples were dropped.
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * const pvItemsToQueue,
+                                 const UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultipleFromISR(
+ *                                          QueueHandle_t xQueue,
+ *                                          const void *pvItemsToQueue,
+ *                                          UBaseType_t uxItemCount,
+ *                                          BaseType_t *pxHigherPriorityTaskWoken
+ *                                        );
+ * @endcode
+ *
+ * A version of uxQueueSendMultiple() that can be called from an interrupt
+ * service routine (ISR).  It does not block, so posts as many of the items as
+ * there is space for and returns.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the items
+ * unblocked a task with a priority higher than the currently running task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup uxQueueSendMultipleFromISR uxQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                        const void * const pvItemsToQueue,
+                                        const UBaseType_t uxItemCount,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultiple(
+ *                                      QueueHandle_t xQueue,
+ *                                      void *pvBuffer,
+ *                                      UBaseType_t uxItemCount,
+ *                                      TickType_t xTicksToWait
+ *                                    );
+ * @endcode
+ *
+ * Receive up to uxItemCount items from a queue into consecutive elements of
+ * the pvBuffer array, oldest first.  As many as the queue holds are removed in
+ * one critical section, and the tasks waiting for the space freed are
+ * unblocked in the same critical section.
+ *
+ * If the queue holds fewer items the calling task blocks until more arrive,
+ * receiving them as they do, until either uxItemCount items have been
+ * received or xTicksToWait expires.  The block time covers the whole call, not
+ * each item.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.  The queue must not be a semaphore.
+ *
+ * @param pvBuffer A pointer to an array with room for uxItemCount items.
+ *
+ * @param uxItemCount The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for uxItemCount items to be received.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * const pvBuffer,
+                                    const UBaseType_t uxItemCount,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultipleFromISR(
+ *                                             QueueHandle_t xQueue,
+ *                                             void *pvBuffer,
+ *                                             UBaseType_t uxItemCount,
+ *                                             BaseType_t *pxHigherPriorityTaskWoken
+ *                                           );
+ * @endcode
+ *
+ * A version of uxQueueReceiveMultiple() that can be called from an interrupt
+ * service routine (ISR).  It does not block, so receives as many of the items
+ * as the queue holds and returns.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the items
+ * unblocked a task with a priority higher than the currently running task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup uxQueueReceiveMultipleFromISR uxQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                           void * const pvBuffer,
+                                           const UBaseType_t uxItemCount,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * configUSE_QUEUE_ZERO_COPY must be defined as 1 for this function to be
+ * available.
+ *
+ * Reserve the slot at the back of a queue so the next item can be written
+ * directly into the queue storage area instead of being copied in by
+ * xQueueSend().  The item is not visible to readers until xQueueCommit() is
+ * called.  Only one slot can be reserved at a time, so while a slot is reserved
+ * the queue appears full to other writers, including xQueueSend().  The
+ * reserved slot cannot be overwritten by xQueueOverwrite().
+ *
+ * The item is written in place, so it should be written as quickly as possible
+ * then committed, as other writers cannot post to the queue in the meantime.
+ *
+ * @param xQueue The handle to the queue into which the item will be written.
+ * The queue must not be a semaphore.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot to become free, should the queue be full or a slot
+ * already be reserved.
+ *
+ * @return A pointer to uxItemSize bytes of queue storage into which the item
+ * must be written, or NULL if no slot could be reserved before xTicksToWait
+ * expired.
+ *
+ * Example usage:
+ * @code{c}
+ * struct AFrame
+ * {
+ *  uint16_t usLength;
+ *  uint8_t ucData[ 512 ];
+ * };
+ *
+ * void vAProducerTask( void *pvParameters )
+ * {
+ * QueueHandle_t xQueue = ( QueueHandle_t ) pvParameters;
+ * struct AFrame *pxFrame;
+ *
+ *  for( ;; )
+ *  {
+ *      // Wait up to 10 ticks for a free slot, then fill it in place.
+ *      pxFrame = ( struct AFrame * ) pvQueueReserve( xQueue, ( TickType_t ) 10 );
+ *
+ *      if( pxFrame != NULL )
+ *      {
+ *          pxFrame->usLength = usReadSensor( pxFrame->ucData );
+ *
+ *          // Make the frame available to the consumer.
+ *          xQueueCommit( xQueue );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup pvQueueReserve pvQueueReserve
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    void * pvQueueReserve( QueueHandle_t xQueue,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * void *pvQueueReserveFromISR( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * A version of pvQueueReserve() that can be called from an interrupt service
+ * routine (ISR).  It does not block, so returns NULL immediately if the queue
+ * is full or a slot is already reserved.
+ *
+ * \defgroup pvQueueReserveFromISR pvQueueReserveFromISR
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    void * pvQueueReserveFromISR( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommit( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * configUSE_QUEUE_ZERO_COPY must be defined as 1 for this function to be
+ * available.
+ *
+ * Post the item written into the slot returned by pvQueueReserve() or
+ * pvQueueReserveFromISR() to the back of the queue, exactly as if it had been
+ * sent with xQueueSendToBack().  A task blocked waiting to receive from the
+ * queue is unblocked.  The slot does not have to be committed by the task or
+ * interrupt that reserved it.
+ *
+ * @param xQueue The handle to the queue on which the slot was reserved.
+ *
+ * @return pdPASS if the item was posted, or pdFAIL if no slot was reserved.
+ *
+ * \defgroup xQueueCommit xQueueCommit
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xQueueCommit() that can be called from an interrupt service
+ * routine (ISR).
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if committing the item
+ * unblocked a task with a priority higher than the currently running task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * \defgroup xQueueCommitFromISR xQueueCommitFromISR
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * const void *pvQueueAcquire( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * configUSE_QUEUE_ZERO_COPY must be defined as 1 for this function to be
+ * available.
+ *
+ * Acquire the item at the front of a queue so it can be read directly from
+ * the queue storage area instead of being copied out by xQueueReceive().  The
+ * item stays in the queue, and its slot cannot be reused, until xQueueRelease()
+ * is called.  Only one item can be acquired at a time, so while an item is
+ * acquired the queue appears empty to other readers, including xQueueReceive()
+ * and xQueuePeek().  It also appears full to xQueueSendToFront(), and
+ * xQueueOverwrite() must not be used on the queue, as both would write into
+ * the slot of the acquired item.
+ *
+ * @param xQueue The handle to the queue from which the item will be read.  The
+ * queue must not be a semaphore.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item, should the queue be empty or an item already be
+ * acquired.
+ *
+ * @return A pointer to the item in the queue storage area, or NULL if no item
+ * could be acquired before xTicksToWait expired.  The pointer is only valid
+ * until xQueueRelease() is called.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAConsumerTask( void *pvParameters )
+ * {
+ * QueueHandle_t xQueue = ( QueueHandle_t ) pvParameters;
+ * const struct AFrame *pxFrame;
+ *
+ *  for( ;; )
+ *  {
+ *      pxFrame = ( const struct AFrame * ) pvQueueAcquire( xQueue, portMAX_DELAY );
+ *
+ *      if( pxFrame != NULL )
+ *      {
+ *          vProcessFrame( pxFrame->ucData, pxFrame->usLength );
+ *
+ *          // The frame's slot can now be reused by the producer.
+ *          xQueueRelease( xQueue );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup pvQueueAcquire pvQueueAcquire
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    const void * pvQueueAcquire( QueueHandle_t xQueue,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * const void *pvQueueAcquireFromISR( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * A version of pvQueueAcquire() that can be called from an interrupt service
+ * routine (ISR).  It does not block, so returns NULL immediately if the queue
+ * is empty or an item is already acquired.
+ *
+ * \defgroup pvQueueAcquireFromISR pvQueueAcquireFromISR
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    const void * pvQueueAcquireFromISR( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueRelease( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * configUSE_QUEUE_ZERO_COPY must be defined as 1 for this function to be
+ * available.
+ *
+ * Remove the item returned by pvQueueAcquire() or pvQueueAcquireFromISR() from
+ * the queue, exactly as if it had been read with xQueueReceive().  A task
+ * blocked waiting to send to the queue is unblocked.
+ *
+ * @param xQueue The handle to the queue from which the item was acquired.
+ *
+ * @return pdPASS if the item was removed, or pdFAIL if no item was acquired.
+ *
+ * \defgroup xQueueRelease xQueueRelease
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueRelease( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xQueueRelease() that can be called from an interrupt service
+ * routine (ISR).
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if releasing the item
+ * unblocked a task with a priority higher than the currently running task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * \defgroup xQueueReleaseFromISR xQueueReleaseFromISR
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue,
+                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from within an ISR, or within a critical section.
@@ -1540,6 +2100,62 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
     const char * pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 #endif
 
+/*
+ * The inverse of pcQueueGetName().  Returns the handle of the queue that was
+ * added to the queue registry with the name pcQueueName.  Names are compared
+ * as strings, so pcQueueName need not be the pointer the queue was registered
+ * with.
+ *
+ * The registry is a hash table indexed by both handle and name, so the time
+ * taken by pcQueueGetName() and xQueueGetHandleFromName() does not depend on
+ * how many queues are registered, provided configQUEUE_REGISTRY_SIZE leaves
+ * some free entries.
+ *
+ * @param pcQueueName The name to look up.
+ * @return If a queue with the name pcQueueName is in the registry then its
+ * handle is returned.  If more than one queue was registered with the same
+ * name then the handle of any one of them is returned.  If no queue in the
+ * registry has the name then NULL is returned.
+ */
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+    QueueHandle_t xQueueGetHandleFromName( const char * pcQueueName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+#endif
+
+/*
+ * Copies the usage statistics of a queue, semaphore or mutex into
+ * *pxStatistics.  See the definition of QueueStatistics_t for a description
+ * of each statistic.  configGENERATE_QUEUE_STATS must be set to 1 in
+ * FreeRTOSConfig.h for vQueueGetStatistics() to be available.
+ *
+ * The statistics can be used to size queues from measurements of a running
+ * system - for example, a queue whose peak occupancy is well below its length
+ * and whose sends never block is larger than it needs to be.
+ *
+ * @param xQueue The handle of the queue, semaphore or mutex.
+ * @param pxStatistics The structure into which the statistics are copied.
+ */
+#if ( configGENERATE_QUEUE_STATS == 1 )
+    void vQueueGetStatistics( QueueHandle_t xQueue,
+                              QueueStatistics_t * const pxStatistics ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Fills pxRegistryStatistics with the name, handle and usage statistics of
+ * each queue in the queue registry, in no particular order.  Both
+ * configGENERATE_QUEUE_STATS must be set to 1 and configQUEUE_REGISTRY_SIZE
+ * must be greater than 0 in FreeRTOSConfig.h for this function to be
+ * available.
+ *
+ * @param pxRegistryStatistics An array of uxArraySize structures.
+ * @param uxArraySize The number of structures in pxRegistryStatistics.
+ * @return The number of structures filled in, which is zero if uxArraySize is
+ * smaller than the number of queues in the registry.
+ */
+#if ( ( configGENERATE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+    UBaseType_t uxQueueGetRegistryStatistics( QueueRegistryStatistics_t * const pxRegistryStatistics,
+                                              const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Generic version of the function used to create a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
@@ -1614,6 +2230,37 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  */
 QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength ) PRIVILEGED_FUNCTION;
 
+/*
+ * Creates a queue set that holds a ready list of its members, rather than an
+ * event for every item sent to its members.
+ *
+ * A member of a set created by xQueueCreateSet() posts its handle to the set
+ * each time it receives an item, so every send is paid for twice and a busy
+ * member can appear in the set many times.  A member of a set created by
+ * xQueueCreateReadySet() posts its handle only when it is not already in the
+ * ready list.  Further sends to the member do not touch the set until the
+ * member has been selected from it, so the cost of the set is proportional to
+ * the number of members that become ready, not the number of items sent.
+ * uxQueueSelectAllFromSet() returns every ready member in a single call.
+ *
+ * The ready list is edge triggered.  Selecting a member removes it from the
+ * ready list, and it is not added again until the next item is sent to it -
+ * so when a member is selected the task should read from it until it is
+ * empty, or until a read with a zero block time fails.  As items sent while
+ * the task is reading will add the member to the ready list again, a member
+ * that is selected can occasionally be found to be empty already.
+ *
+ * The notes for xQueueCreateSet() otherwise apply, except that Note 3 does not
+ * as the set stores one handle per member regardless of the member length.
+ *
+ * @param uxMaxMembers The maximum number of queues and semaphores that can be
+ * added to the set.  xQueueAddToSet() fails once the set holds this many.
+ *
+ * @return If the queue set is created successfully then a handle to the created
+ * queue set is returned.  Otherwise NULL is returned.
+ */
+QueueSetHandle_t xQueueCreateReadySet( const UBaseType_t uxMaxMembers ) PRIVILEGED_FUNCTION;
+
 /*
  * Adds a queue or semaphore to a queue set that was previously created by a
  * call to xQueueCreateSet().
@@ -1633,8 +2280,9 @@ QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength ) PRIVILE
  *
  * @return If the queue or semaphore was successfully added to the queue set
  * then pdPASS is returned.  If the queue could not be successfully added to the
- * queue set because it is already a member of a different queue set then pdFAIL
- * is returned.
+ * queue set because it is already a member of a different queue set, or because
+ * the set was created by xQueueCreateReadySet() and already holds uxMaxMembers
+ * members, then pdFAIL is returned.
  */
 BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
                            QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
@@ -1701,6 +2349,40 @@ QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
  */
 QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 
+/*
+ * Selects up to uxMaxMembers members of a queue set in one call, blocking until
+ * at least one is ready if none are.  When used on a set created by
+ * xQueueCreateReadySet() each ready member is returned once, and leaves the
+ * ready list of the set, as described in the documentation for that function.
+ * When used on a set created by xQueueCreateSet() a member is returned once for
+ * each event held in the set, just as if xQueueSelectFromSet() had been called
+ * repeatedly.
+ *
+ * @param xQueueSet The queue set on which the task will (potentially) block.
+ *
+ * @param pxMembers An array into which the handles of the selected members are
+ * written.
+ *
+ * @param uxMaxMembers The length of the pxMembers array.
+ *
+ * @param xTicksToWait The maximum time, in ticks, that the calling task will
+ * remain in the Blocked state to wait for a member of the set to become ready.
+ *
+ * @return The number of member handles written to pxMembers, which is zero if
+ * no member became ready before the block time expired.
+ */
+UBaseType_t uxQueueSelectAllFromSet( QueueSetHandle_t xQueueSet,
+                                     QueueSetMemberHandle_t * const pxMembers,
+                                     const UBaseType_t uxMaxMembers,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of uxQueueSelectAllFromSet() that can be used from an ISR.
+ */
+UBaseType_t uxQueueSelectAllFromSetFromISR( QueueSetHandle_t xQueueSet,
+                                            QueueSetMemberHandle_t * const pxMembers,
+                                            const UBaseType_t uxMaxMembers ) PRIVILEGED_FUNCTION;
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
                                      TickType_t xTicksToWait,
@@ -1711,6 +2393,8 @@ void vQueueSetQueueNumber( QueueHandle_t xQueue,
                            UBaseType_t uxQueueNumber ) PRIVILEGED_FUNCTION;
 UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 uint8_t ucQueueGetQueueType( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueRegisterMultiWaitTask( QueueHandle_t xQueue,
+                                        TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
 
 /* *INDENT-OFF* */
@@ -0,0 +1,304 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A reader-writer lock protects data that many tasks read but few tasks
+ * write.  Any number of tasks, up to configRWLOCK_MAX_READERS, can hold the
+ * lock for reading at the same time, while a task that holds the lock for
+ * writing holds it exclusively.  Taking the lock for reading never blocks
+ * while no task holds, or (if the lock prefers writers) is waiting to take,
+ * the lock for writing - it only enters a short critical section to record the
+ * calling task as a reader.
+ *
+ * A task that blocks on the lock raises the priority of every task that holds
+ * it, reader or writer, using the same priority inheritance as a standard
+ * mutex, and a holder disinherits the priority when it gives the lock back
+ * and holds no other mutexes.  When the lock is given the tasks waiting for it
+ * are granted it directly, without having to compete with tasks that have not
+ * waited.
+ *
+ * A lock created to prefer writers stops granting new readers as soon as a
+ * writer is waiting, so writers cannot be starved by a stream of readers.  A
+ * lock created to prefer readers grants new readers whenever no writer holds
+ * it, so readers never wait for a writer that is itself waiting, but a writer
+ * can wait indefinitely while readers keep overlapping.
+ *
+ * A reader-writer lock must only be used from tasks, is not recursive, and
+ * must be given by the task that took it.
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include rwlock.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which reader-writer locks are referenced.  For example, a call to
+ * xRwLockCreate() returns an RwLockHandle_t variable that can then be used as
+ * a parameter to xRwLockTakeRead(), xRwLockTakeWrite(), etc.
+ */
+struct RwLockDef_t;
+typedef struct RwLockDef_t * RwLockHandle_t;
+
+/**
+ * rwlock.h
+ *
+ * @code{c}
+ * RwLockHandle_t xRwLockCreate( BaseType_t xPreferWriters );
+ * @endcode
+ *
+ * Creates a new reader-writer lock using dynamically allocated memory.  See
+ * xRwLockCreateStatic() for a version that uses statically allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xRwLockCreate() to be available.
+ *
+ * @param xPreferWriters pdTRUE if new readers should wait while a writer is
+ * waiting, or pdFALSE if new readers should only wait while a writer holds
+ * the lock.
+ *
+ * @return If the lock is created successfully then a handle to the created
+ * lock is returned.  If there was not enough heap memory available to create
+ * the lock then NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * RwLockHandle_t xConfigLock;
+ *
+ * uint32_t ulReadSetting( size_t xIndex )
+ * {
+ * uint32_t ulValue = 0;
+ *
+ *  // Any number of tasks can read the table at the same time.
+ *  if( xRwLockTakeRead( xConfigLock, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      ulValue = ulConfigTable[ xIndex ];
+ *      xRwLockGiveRead( xConfigLock );
+ *  }
+ *
+ *  return ulValue;
+ * }
+ *
+ * void vWriteSetting( size_t xIndex, uint32_t ulValue )
+ * {
+ *  // Waits for the tasks that are reading the table to finish.
+ *  if( xRwLockTakeWrite( xConfigLock, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      ulConfigTable[ xIndex ] = ulValue;
+ *      xRwLockGiveWrite( xConfigLock );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xRwLockCreate xRwLockCreate
+ * \ingroup RwLockManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    RwLockHandle_t xRwLockCreate( const BaseType_t xPreferWriters ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rwlock.h
+ *
+ * @code{c}
+ * RwLockHandle_t xRwLockCreateStatic( BaseType_t xPreferWriters,
+ *                                     StaticRwLock_t *pxStaticLock );
+ * @endcode
+ *
+ * Creates a new reader-writer lock using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xRwLockCreateStatic() to be available.
+ *
+ * @param xPreferWriters See xRwLockCreate().
+ *
+ * @param pxStaticLock Must point to a variable of type StaticRwLock_t, which
+ * will be used to hold the lock's data structure.
+ *
+ * @return If pxStaticLock is not NULL then a handle to the created lock is
+ * returned, otherwise NULL is returned.
+ *
+ * \defgroup xRwLockCreateStatic xRwLockCreateStatic
+ * \ingroup RwLockManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    RwLockHandle_t xRwLockCreateStatic( const BaseType_t xPreferWriters,
+                                        StaticRwLock_t * const pxStaticLock ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rwlock.h
+ *
+ * @code{c}
+ * BaseType_t xRwLockTakeRead( RwLockHandle_t xLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a reader-writer lock for reading.  The calling task waits if a task
+ * holds the lock for writing, if the lock prefers writers and a task is
+ * waiting to take it for writing, or if configRWLOCK_MAX_READERS tasks
+ * already hold it for reading.
+ *
+ * @param xLock The handle of the lock to take.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for the lock.  Setting xTicksToWait to
+ * portMAX_DELAY causes the task to wait indefinitely, provided
+ * INCLUDE_vTaskSuspend is set to 1 in FreeRTOSConfig.h.
+ *
+ * @return pdPASS if the lock was taken, or pdFAIL if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xRwLockTakeRead xRwLockTakeRead
+ * \ingroup RwLockManagement
+ */
+BaseType_t xRwLockTakeRead( RwLockHandle_t xLock,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+ * @code{c}
+ * BaseType_t xRwLockGiveRead( RwLockHandle_t xLock );
+ * @endcode
+ *
+ * Gives a reader-writer lock the calling task took for reading.
+ *
+ * @param xLock The handle of the lock to give.
+ *
+ * @return pdPASS if the lock was given, or pdFAIL if the calling task did not
+ * hold the lock for reading.
+ *
+ * \defgroup xRwLockGiveRead xRwLockGiveRead
+ * \ingroup RwLockManagement
+ */
+BaseType_t xRwLockGiveRead( RwLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+ * @code{c}
+ * BaseType_t xRwLockTakeWrite( RwLockHandle_t xLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a reader-writer lock for writing.  The calling task waits until no
+ * other task holds the lock, for reading or for writing.
+ *
+ * @param xLock The handle of the lock to take.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for the lock.
+ *
+ * @return pdPASS if the lock was taken, or pdFAIL if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xRwLockTakeWrite xRwLockTakeWrite
+ * \ingroup RwLockManagement
+ */
+BaseType_t xRwLockTakeWrite( RwLockHandle_t xLock,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+ * @code{c}
+ * BaseType_t xRwLockGiveWrite( RwLockHandle_t xLock );
+ * @endcode
+ *
+ * Gives a reader-writer lock the calling task took for writing.
+ *
+ * @param xLock The handle of the lock to give.
+ *
+ * @return pdPASS if the lock was given, or pdFAIL if the calling task did not
+ * hold the lock for writing.
+ *
+ * \defgroup xRwLockGiveWrite xRwLockGiveWrite
+ * \ingroup RwLockManagement
+ */
+BaseType_t xRwLockGiveWrite( RwLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+ * @code{c}
+ * UBaseType_t uxRwLockGetReaderCount( RwLockHandle_t xLock );
+ * @endcode
+ *
+ * Returns the number of tasks that hold a reader-writer lock for reading.
+ *
+ * \defgroup uxRwLockGetReaderCount uxRwLockGetReaderCount
+ * \ingroup RwLockManagement
+ */
+UBaseType_t uxRwLockGetReaderCount( RwLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+ * @code{c}
+ * TaskHandle_t xRwLockGetWriter( RwLockHandle_t xLock );
+ * @endcode
+ *
+ * Returns the handle of the task that holds a reader-writer lock for writing,
+ * or NULL if no task holds it for writing.
+ *
+ * \defgroup xRwLockGetWriter xRwLockGetWriter
+ * \ingroup RwLockManagement
+ */
+TaskHandle_t xRwLockGetWriter( RwLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+ * @code{c}
+ * void vRwLockDelete( RwLockHandle_t xLock );
+ * @endcode
+ *
+ * Deletes a reader-writer lock that was previously created using
+ * xRwLockCreate() or xRwLockCreateStatic().  If the lock was created using
+ * dynamic memory then the memory is freed.  A lock must not be deleted while
+ * it is held.
+ *
+ * \defgroup vRwLockDelete vRwLockDelete
+ * \ingroup RwLockManagement
+ */
+void vRwLockDelete( RwLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( RWLOCK_H ) */
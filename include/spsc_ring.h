@@ -0,0 +1,335 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A single producer single consumer (SPSC) ring passes fixed size items, by
+ * copy, from one task or interrupt to another.  Unlike a queue, sending to and
+ * receiving from a ring that is neither full nor empty never enters a critical
+ * section or suspends the scheduler: the producer only writes the ring's head
+ * index and the consumer only writes its tail index, and the two indexes are
+ * kept in separate cache lines (see configSPSC_RING_CACHE_LINE_BYTES) so the
+ * two sides do not contend for the same line.  The kernel is only involved when
+ * a task has to block because the ring is full or empty, in which case the
+ * other side wakes it with a direct to task notification at index
+ * configSPSC_RING_NOTIFICATION_INDEX.  That index must not be used for anything
+ * else by a task that blocks on a ring.
+ *
+ * ***NOTE***:  Like stream buffers, a ring assumes there is only one task or
+ * interrupt that writes to it (the producer) and only one task or interrupt
+ * that reads from it (the consumer).  It is not safe to have more than one of
+ * either, even if each call is placed inside a critical section.
+ *
+ * The lock free paths use the compiler's __atomic builtins, so spsc_ring.c
+ * must be built with GCC or a compiler that provides them (such as Clang).
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spsc_ring.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which rings are referenced.  For example, a call to
+ * xSpscRingCreate() returns an SpscRingHandle_t variable that can then be used
+ * as a parameter to xSpscRingSend(), xSpscRingReceive(), etc.
+ */
+struct SpscRingDef_t;
+typedef struct SpscRingDef_t * SpscRingHandle_t;
+
+/**
+ * spsc_ring.h
+ *
+ * The number of bytes of storage area a ring that holds uxLength items of
+ * uxItemSize bytes each needs when it is created with xSpscRingCreateStatic().
+ * One slot more than uxLength is needed so a full ring can be told apart from
+ * an empty ring without a shared item count.
+ */
+#define spscRING_STORAGE_BYTES( uxLength, uxItemSize )    ( ( ( size_t ) ( uxLength ) + ( size_t ) 1 ) * ( size_t ) ( uxItemSize ) )
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new ring using dynamically allocated memory.  See
+ * xSpscRingCreateStatic() for a version that uses statically allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xSpscRingCreate() to be available.
+ *
+ * @param uxLength The maximum number of items the ring can hold at any one
+ * time.
+ *
+ * @param uxItemSize The size, in bytes, of each item.  Items are copied into
+ * and out of the ring.
+ *
+ * @return If the ring is created successfully then a handle to the created
+ * ring is returned.  If there was not enough heap memory available to create
+ * the ring then NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * SpscRingHandle_t xSampleRing;
+ *
+ * void vAnInterruptServiceRoutine( void )
+ * {
+ * uint16_t usSample = usReadADC();
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  // Never enters a critical section unless the consumer task is blocked
+ *  // waiting for a sample.
+ *  if( xSpscRingSendFromISR( xSampleRing, &usSample, &xHigherPriorityTaskWoken ) != pdPASS )
+ *  {
+ *      // The ring was full and the sample was dropped.
+ *  }
+ *
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vAConsumerTask( void *pvParameters )
+ * {
+ * uint16_t usSample;
+ *
+ *  xSampleRing = xSpscRingCreate( 256, sizeof( uint16_t ) );
+ *
+ *  for( ;; )
+ *  {
+ *      if( xSpscRingReceive( xSampleRing, &usSample, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          vProcessSample( usSample );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSpscRingCreate xSpscRingCreate
+ * \ingroup SpscRingManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    SpscRingHandle_t xSpscRingCreate( const UBaseType_t uxLength,
+                                      const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * SpscRingHandle_t xSpscRingCreateStatic( UBaseType_t uxLength,
+ *                                         UBaseType_t uxItemSize,
+ *                                         uint8_t *pucRingStorageArea,
+ *                                         StaticSpscRing_t *pxStaticRing );
+ * @endcode
+ *
+ * Creates a new ring using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xSpscRingCreateStatic() to be available.
+ *
+ * @param uxLength The maximum number of items the ring can hold at any one
+ * time.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @param pucRingStorageArea Must point to a uint8_t array that is at least
+ * spscRING_STORAGE_BYTES( uxLength, uxItemSize ) bytes big.
+ *
+ * @param pxStaticRing Must point to a variable of type StaticSpscRing_t, which
+ * will be used to hold the ring's data structure.
+ *
+ * @return If neither pucRingStorageArea nor pxStaticRing are NULL then a
+ * handle to the created ring is returned, otherwise NULL is returned.
+ *
+ * \defgroup xSpscRingCreateStatic xSpscRingCreateStatic
+ * \ingroup SpscRingManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    SpscRingHandle_t xSpscRingCreateStatic( const UBaseType_t uxLength,
+                                            const UBaseType_t uxItemSize,
+                                            uint8_t * const pucRingStorageArea,
+                                            StaticSpscRing_t * const pxStaticRing ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingSend( SpscRingHandle_t xRing, const void *pvItemToSend, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies an item into a ring.  Must only be called by the ring's producer.
+ *
+ * If the ring has space the item is copied in and published with a single
+ * atomic store, and the kernel is only called if the consumer is blocked
+ * waiting for an item.
+ *
+ * @param xRing The handle of the ring to which the item is being sent.
+ *
+ * @param pvItemToSend A pointer to the item to copy into the ring.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for space to become available if the
+ * ring is full.
+ *
+ * @return pdPASS if the item was sent, or errQUEUE_FULL if the ring was still
+ * full when xTicksToWait expired.
+ *
+ * \defgroup xSpscRingSend xSpscRingSend
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingSend( SpscRingHandle_t xRing,
+                          const void * pvItemToSend,
+                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingSendFromISR( SpscRingHandle_t xRing,
+ *                                  const void *pvItemToSend,
+ *                                  BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xSpscRingSend().
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item unblocked
+ * a consumer task that has a priority higher than the currently running task,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return pdPASS if the item was sent, or errQUEUE_FULL if the ring was full.
+ *
+ * \defgroup xSpscRingSendFromISR xSpscRingSendFromISR
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingSendFromISR( SpscRingHandle_t xRing,
+                                 const void * pvItemToSend,
+                                 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingReceive( SpscRingHandle_t xRing, void *pvBuffer, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the oldest item out of a ring.  Must only be called by the ring's
+ * consumer.
+ *
+ * @param xRing The handle of the ring from which the item is being received.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for an item if the ring is empty.
+ *
+ * @return pdPASS if an item was received, or errQUEUE_EMPTY if the ring was
+ * still empty when xTicksToWait expired.
+ *
+ * \defgroup xSpscRingReceive xSpscRingReceive
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+                             void * pvBuffer,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingReceiveFromISR( SpscRingHandle_t xRing,
+ *                                     void *pvBuffer,
+ *                                     BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xSpscRingReceive().
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the item
+ * unblocked a producer task that has a priority higher than the currently
+ * running task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * @return pdPASS if an item was received, or errQUEUE_EMPTY if the ring was
+ * empty.
+ *
+ * \defgroup xSpscRingReceiveFromISR xSpscRingReceiveFromISR
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingReceiveFromISR( SpscRingHandle_t xRing,
+                                    void * pvBuffer,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing );
+ * @endcode
+ *
+ * Queries the number of items in a ring.  The value is a snapshot that can be
+ * out of date by the time it is returned if the producer or consumer is
+ * running concurrently.  Can be called from an interrupt.
+ *
+ * \defgroup uxSpscRingItemsWaiting uxSpscRingItemsWaiting
+ * \ingroup SpscRingManagement
+ */
+UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * void vSpscRingDelete( SpscRingHandle_t xRing );
+ * @endcode
+ *
+ * Deletes a ring that was previously created using xSpscRingCreate() or
+ * xSpscRingCreateStatic().  If the ring was created using dynamic memory then
+ * the memory is freed.  A ring must not be deleted while a task is blocked on
+ * it.
+ *
+ * \defgroup vSpscRingDelete vSpscRingDelete
+ * \ingroup SpscRingManagement
+ */
+void vSpscRingDelete( SpscRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SPSC_RING_H ) */
@@ -62,6 +62,8 @@
 #endif
 /* *INDENT-ON* */
 
+#include "task.h"
+
 /**
  * Type by which stream buffers are referenced.  For example, a call to
  * xStreamBufferCreate() returns an StreamBufferHandle_t variable that can
@@ -897,6 +899,9 @@ StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
 
 size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 
+BaseType_t xStreamBufferRegisterMultiWaitTask( StreamBufferHandle_t xStreamBuffer,
+                                               TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_TRACE_FACILITY == 1 )
     void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer,
                                              UBaseType_t uxStreamBufferNumber ) PRIVILEGED_FUNCTION;
@@ -73,6 +73,10 @@
  * array. */
 #define tskDEFAULT_INDEX_TO_NOTIFY     ( 0 )
 
+/* Core affinity mask that allows a task to run on any core.  Only used when
+ * configNUMBER_OF_CORES is greater than 1 and configUSE_CORE_AFFINITY is 1. */
+#define tskNO_AFFINITY                 ( ( UBaseType_t ) -1 )
+
 /**
  * task. h
  *
@@ -166,6 +170,9 @@ typedef struct xTASK_STATUS
         StackType_t * pxEndOfStack;               /* Points to the end address of the task's stack area. */
     #endif
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+    #if ( configUSE_WAKE_LATENCY_HISTOGRAMS == 1 )
+        uint32_t ulWakeLatencyHistogram[ configWAKE_LATENCY_HISTOGRAM_BUCKETS ]; /* The number of times the task has waited, in run time counter units, between being made ready after being blocked or suspended and running.  Element 0 counts waits of 0, and element n counts waits of at least 2^(n-1) and less than 2^n, with the last element also counting all longer waits.  Only valid when configUSE_WAKE_LATENCY_HISTOGRAMS is defined as 1 in FreeRTOSConfig.h. */
+    #endif
 } TaskStatus_t;
 
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
@@ -208,7 +215,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskENTER_CRITICAL()               portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR()      portSET_INTERRUPT_MASK_FROM_ISR()
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskENTER_CRITICAL_FROM_ISR()    portSET_INTERRUPT_MASK_FROM_ISR()
+#else
+    #define taskENTER_CRITICAL_FROM_ISR()    portENTER_CRITICAL_FROM_ISR()
+#endif
 
 /**
  * task. h
@@ -223,7 +234,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#else
+    #define taskEXIT_CRITICAL_FROM_ISR( x )    portEXIT_CRITICAL_FROM_ISR( x )
+#endif
 
 /**
  * task. h
@@ -1088,6 +1103,140 @@ void vTaskGetInfo( TaskHandle_t xTask,
 void vTaskPrioritySet( TaskHandle_t xTask,
                        UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );
+ * @endcode
+ *
+ * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+ * must be defined as 1 for this function to be available.
+ *
+ * Sets the cores on which a task is allowed to run.  If the task is running on
+ * a core that is no longer in the mask then that core is made to yield, and if
+ * the task is ready then it is placed on an allowed core should that core be
+ * running a lower priority task.
+ *
+ * @param xTask Handle of the task for which the core affinity is being set.
+ * Passing a NULL handle results in the core affinity of the calling task being
+ * set.
+ *
+ * @param uxCoreAffinityMask A bitwise value that indicates the cores on which
+ * the task can run.  Bit n is set if the task can run on core n.  Pass
+ * tskNO_AFFINITY to allow the task to run on any core.  Tasks are created with
+ * tskNO_AFFINITY.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAFunction( void )
+ * {
+ * TaskHandle_t xHandle;
+ *
+ *   // Create a task, storing the handle.
+ *   xTaskCreate( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle );
+ *
+ *   // Only allow the task to run on cores 0 and 2.
+ *   vTaskCoreAffinitySet( xHandle, ( 1 << 0 ) | ( 1 << 2 ) );
+ * }
+ * @endcode
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup TaskCtrl
+ */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+ * must be defined as 1 for this function to be available.
+ *
+ * @param xTask Handle of the task being queried.  Passing a NULL handle
+ * results in the core affinity of the calling task being returned.
+ *
+ * @return The core affinity mask of the task - bit n is set if the task can
+ * run on core n.
+ * \defgroup uxTaskCoreAffinityGet uxTaskCoreAffinityGet
+ * \ingroup TaskCtrl
+ */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+    UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Sets the relative deadline of a task.  Ready tasks at priority
+ * configEDF_PRIORITY are not shared in turn but selected earliest deadline
+ * first (EDF).  Each time such a task leaves the Blocked or Suspended state it
+ * starts a new job, the absolute deadline of which is the tick count at that
+ * time plus the relative deadline.  The job completes when the task next
+ * blocks, and traceTASK_DEADLINE_MISSED() is called if that is after the
+ * absolute deadline.  Tasks at other priorities are scheduled as normal.
+ *
+ * Setting the deadline also starts a new job of the task from the current tick
+ * count.
+ *
+ * @param xTask Handle of the task for which the deadline is being set.
+ * Passing a NULL handle results in the deadline of the calling task being set.
+ *
+ * @param xRelativeDeadline The deadline, in ticks, of each job of the task
+ * relative to the time the job is released.  Tasks are created with a deadline
+ * of 0, meaning no deadline, and a task without a deadline only runs in the EDF
+ * band when no task with a deadline is ready.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAFunction( void )
+ * {
+ * TaskHandle_t xHandle;
+ *
+ *   // Create a task in the EDF band, storing the handle.
+ *   xTaskCreate( vTaskCode, "NAME", STACK_SIZE, NULL, configEDF_PRIORITY, &xHandle );
+ *
+ *   // Each time the task is unblocked it must block again within 5ms.
+ *   vTaskSetDeadline( xHandle, pdMS_TO_TICKS( 5 ) );
+ * }
+ * @endcode
+ * \defgroup vTaskSetDeadline vTaskSetDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    void vTaskSetDeadline( TaskHandle_t xTask,
+                           TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * TickType_t xTaskGetDeadline( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task being queried.  Passing a NULL handle
+ * results in the deadline of the calling task being returned.
+ *
+ * @return The relative deadline of the task, or 0 if the task has no deadline.
+ * \defgroup xTaskGetDeadline xTaskGetDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    TickType_t xTaskGetDeadline( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1708,6 +1857,19 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * xTaskGetIdleTaskHandleForCore() is only available if
+ * INCLUDE_xTaskGetIdleTaskHandle is set to 1 in FreeRTOSConfig.h and
+ * configNUMBER_OF_CORES is greater than 1.
+ *
+ * Returns the handle of the idle task created for core xCoreID.  The idle task
+ * created for a core is not bound to that core.  xTaskGetIdleTaskHandle()
+ * returns the handle of the idle task created for core 0.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -2889,6 +3051,16 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
  * tasks may have to be removed from the blocked state as the tick count is
  * moved.
  *
+ * The time taken depends on the number of tasks that leave the blocked state,
+ * not on xTicksToCatchUp, as the ticks between one task leaving the blocked
+ * state and the next are added to the tick count in one step.  The same is true
+ * of the ticks that are processed when the scheduler is resumed after having
+ * been suspended, as xTaskCatchUpTicks() is implemented using the same
+ * mechanism.  Tasks unblocked during the catch up are unblocked in order of
+ * their wake time.  The tick hook is not called for the caught up ticks, and at
+ * most one context switch occurs due to time slicing however many ticks are
+ * caught up.
+ *
  * @param xTicksToCatchUp The number of tick interrupts that have been missed due to
  * interrupts being disabled.  Its value is not computed automatically, so must be
  * computed by the application writer.
@@ -3003,6 +3175,22 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEG
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * A version of vTaskRemoveFromUnorderedEventList() that is called from a
+ * critical section, including a critical section within an interrupt, rather
+ * than with the scheduler suspended.  If the scheduler is suspended the task
+ * is held on the pending ready list until the scheduler is resumed.  Used by
+ * event groups when configUSE_EVENT_GROUP_DIRECT_ISR_SET is 1.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * making the call, otherwise pdFALSE.
+ */
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                     const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -3011,7 +3199,11 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
  * Sets the pointer to the current TCB to the TCB of the highest priority task
  * that is ready to run.
  */
-portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+#else
+    portDONT_DISCARD void vTaskSwitchContext( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
@@ -3024,6 +3216,33 @@ TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * Return the handle of the task running on core xCoreID.
+ */
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE PROVIDED
+ * FOR USE BY PORTS THAT SUPPORT MORE THAN ONE CORE.
+ *
+ * Critical sections that take the kernel locks so the calling core has
+ * exclusive access to the kernel data structures.  The FROM_ISR versions only
+ * take the lock that is used to serialise interrupts.
+ */
+    void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+    UBaseType_t vTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+
+/*
+ * Yield the calling core, or hold the yield pending until the calling task
+ * exits its critical section if it is inside one.
+ */
+    void vTaskYieldWithinAPI( void ) PRIVILEGED_FUNCTION;
+#endif /* configNUMBER_OF_CORES */
+
 /*
  * Shortcut used by the queue implementation to prevent unnecessary call to
  * taskYIELD();
@@ -3103,6 +3322,23 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Increment the mutex held count of pxMutexHolder.
+ * Only a task updates its own count outside of a critical section, so
+ * pxMutexHolder must either be the calling task, or a task that is blocked
+ * and the caller must be in a critical section.
+ */
+void vTaskIncrementMutexHeldCount( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Decrement the mutex held count of the calling task,
+ * whose handle is pxMutexHolder, without a critical section.  Returns pdFALSE,
+ * and leaves the count unchanged, if the task has inherited a priority, in
+ * which case xTaskPriorityDisinherit() must be called from a critical section
+ * instead.
+ */
+BaseType_t xTaskDecrementMutexHeldCount( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
@@ -0,0 +1,586 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mpsc_queue.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build mpsc_queue.c
+#endif
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+    #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build mpsc_queue.c
+#endif
+
+#if !defined( __GNUC__ )
+    #error mpsc_queue.c requires a compiler that provides the __atomic builtins
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* The atomic operations used by the lock free paths.  As in spsc_ring.c, the
+ * compiler's builtins are used rather than atomic.h, which implements compare
+ * and swap with a critical section on ports that do not have a native
+ * instruction.  A slot's sequence number is published with release semantics
+ * after the slot's item has been copied, and read with acquire semantics before
+ * the item is copied.  The full barrier orders the publication of a slot before
+ * the read of the waiting consumer's handle, and the consumer's handle store
+ * before its second look at the slot, so a consumer cannot block on an item
+ * that has already been published without being notified. */
+#define mpscLOAD_RELAXED( pxVariable )                            __atomic_load_n( ( pxVariable ), __ATOMIC_RELAXED )
+#define mpscLOAD_ACQUIRE( pxVariable )                            __atomic_load_n( ( pxVariable ), __ATOMIC_ACQUIRE )
+#define mpscSTORE_RELAXED( pxVariable, xValue )                   __atomic_store_n( ( pxVariable ), ( xValue ), __ATOMIC_RELAXED )
+#define mpscSTORE_RELEASE( pxVariable, xValue )                   __atomic_store_n( ( pxVariable ), ( xValue ), __ATOMIC_RELEASE )
+#define mpscEXCHANGE( pxVariable, xValue )                        __atomic_exchange_n( ( pxVariable ), ( xValue ), __ATOMIC_RELAXED )
+#define mpscCOMPARE_AND_SWAP( pxVariable, pxExpected, xValue )    __atomic_compare_exchange_n( ( pxVariable ), ( pxExpected ), ( xValue ), pdTRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED )
+#define mpscFULL_BARRIER()                                        __atomic_thread_fence( __ATOMIC_SEQ_CST )
+
+/* Bits that can be set in MpscQueue_t.ucFlags. */
+#define mpscFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 ) /* Set if the queue was created using statically allocated memory. */
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the queue.  Each slot in the
+ * storage area starts with a sequence number.  A slot at position uxPosition
+ * (the count of sends, of which the slot index is the low bits) is free for
+ * the producer that claims uxPosition when its sequence number equals
+ * uxPosition, and holds a published item when its sequence number equals
+ * uxPosition + 1.  Receiving the item sets the sequence number to
+ * uxPosition + uxLength, which frees the slot for the next lap. */
+typedef struct MpscQueueDef_t                 /*lint !e9058 Style convention uses tag. */
+{
+    /* Written by the producers. */
+    volatile UBaseType_t uxEnqueuePosition;      /*< The position the next producer will claim. */
+    uint8_t ucProducerPadding[ configMPSC_QUEUE_CACHE_LINE_BYTES ];
+
+    /* Written by the consumer only. */
+    volatile UBaseType_t uxDequeuePosition;      /*< The position of the next item to receive. */
+    volatile TaskHandle_t xTaskWaitingToReceive; /*< Holds the handle of the consumer task while it is waiting for an item, or NULL. */
+    uint8_t ucConsumerPadding[ configMPSC_QUEUE_CACHE_LINE_BYTES ];
+
+    /* Set when the queue is created and not written again. */
+    UBaseType_t * puxSlots;                      /*< Points to the first slot. */
+    UBaseType_t uxLength;                        /*< The number of slots, which is a power of two. */
+    UBaseType_t uxItemSize;                      /*< The size of each item. */
+    UBaseType_t uxSlotWords;                     /*< The size of each slot, in words, including its sequence number. */
+    uint8_t ucFlags;
+} MpscQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both xMpscQueueCreate() and xMpscQueueCreateStatic() to
+ * initialise the contents of a queue.
+ */
+static void prvInitialiseNewMpscQueue( MpscQueue_t * const pxQueue,
+                                       UBaseType_t * const puxSlots,
+                                       UBaseType_t uxLength,
+                                       UBaseType_t uxItemSize,
+                                       uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Claims a slot, copies an item into it and publishes it, without entering a
+ * critical section.  Returns pdTRUE if the item was written, or pdFALSE if the
+ * queue was full.  Can be called by any producer.  If the consumer was waiting
+ * for an item then its handle is returned in *pxTaskToNotify, otherwise
+ * *pxTaskToNotify is set to NULL.
+ */
+static BaseType_t prvWriteItem( MpscQueue_t * const pxQueue,
+                                const void * pvItemToQueue,
+                                TaskHandle_t * const pxTaskToNotify ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the next item out of the queue if it has been published.  Returns
+ * pdTRUE if an item was read.  Must only be called by the consumer.
+ */
+static BaseType_t prvReadItem( MpscQueue_t * const pxQueue,
+                               void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns a pointer to the slot for uxPosition.
+ */
+static UBaseType_t * prvGetSlot( const MpscQueue_t * const pxQueue,
+                                 UBaseType_t uxPosition ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    MpscQueueHandle_t xMpscQueueCreate( const UBaseType_t uxLength,
+                                        const UBaseType_t uxItemSize )
+    {
+        uint8_t * pucAllocatedMemory;
+        size_t xStorageSizeBytes;
+
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( ( uxLength & ( uxLength - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        /* Check for multiplication overflow. */
+        if( ( uxItemSize < ( UBaseType_t ) ( SIZE_MAX / 2U ) ) &&
+            ( mpscQUEUE_STORAGE_WORDS( 1U, uxItemSize ) < ( ( SIZE_MAX - sizeof( MpscQueue_t ) ) / sizeof( UBaseType_t ) / uxLength ) ) )
+        {
+            /* The MpscQueue_t structure is placed at the start of the
+             * allocated memory and the slots follow immediately after.  The
+             * size of the structure is a multiple of the size of a pointer, so
+             * the slots are aligned for a UBaseType_t. */
+            xStorageSizeBytes = mpscQUEUE_STORAGE_WORDS( uxLength, uxItemSize ) * sizeof( UBaseType_t );
+            pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( MpscQueue_t ) + xStorageSizeBytes ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            pucAllocatedMemory = NULL;
+        }
+
+        if( pucAllocatedMemory != NULL )
+        {
+            prvInitialiseNewMpscQueue( ( MpscQueue_t * ) pucAllocatedMemory,                       /* Structure at the start of the allocated memory. */ /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+                                       ( UBaseType_t * ) ( pucAllocatedMemory + sizeof( MpscQueue_t ) ), /* Slots follow. */ /*lint !e9087 !e826 Safe cast as the structure size keeps the slots aligned. */
+                                       uxLength,
+                                       uxItemSize,
+                                       0 );
+
+            traceMPSC_QUEUE_CREATE( ( ( MpscQueue_t * ) pucAllocatedMemory ) );
+        }
+        else
+        {
+            traceMPSC_QUEUE_CREATE_FAILED();
+        }
+
+        return ( MpscQueueHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    MpscQueueHandle_t xMpscQueueCreateStatic( const UBaseType_t uxLength,
+                                              const UBaseType_t uxItemSize,
+                                              UBaseType_t * const puxQueueStorageArea,
+                                              StaticMpscQueue_t * const pxStaticQueue )
+    {
+        MpscQueue_t * const pxQueue = ( MpscQueue_t * ) pxStaticQueue; /*lint !e740 !e9087 Safe cast as StaticMpscQueue_t is opaque MpscQueue_t. */
+        MpscQueueHandle_t xReturn;
+
+        configASSERT( puxQueueStorageArea );
+        configASSERT( pxStaticQueue );
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( ( uxLength & ( uxLength - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticMpscQueue_t equals the size of the real
+             * queue structure. */
+            volatile size_t xSize = sizeof( StaticMpscQueue_t );
+            configASSERT( xSize == sizeof( MpscQueue_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( puxQueueStorageArea != NULL ) && ( pxStaticQueue != NULL ) )
+        {
+            prvInitialiseNewMpscQueue( pxQueue,
+                                       puxQueueStorageArea,
+                                       uxLength,
+                                       uxItemSize,
+                                       mpscFLAGS_IS_STATICALLY_ALLOCATED );
+
+            traceMPSC_QUEUE_CREATE( pxQueue );
+
+            xReturn = ( MpscQueueHandle_t ) pxStaticQueue; /*lint !e9087 Data hiding requires cast to opaque type. */
+        }
+        else
+        {
+            xReturn = NULL;
+            traceMPSC_QUEUE_CREATE_FAILED();
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vMpscQueueDelete( MpscQueueHandle_t xQueue )
+{
+    MpscQueue_t * pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    /* The consumer must not be blocked on a queue that is being deleted. */
+    configASSERT( pxQueue->xTaskWaitingToReceive == NULL );
+
+    traceMPSC_QUEUE_DELETE( xQueue );
+
+    if( ( pxQueue->ucFlags & mpscFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* Both the structure and the slots were allocated using a single
+             * call to pvPortMalloc(), hence only one call to vPortFree() is
+             * required. */
+            vPortFree( ( void * ) pxQueue ); /*lint !e9087 Standard free() semantics require void *, plus pxQueue was allocated by pvPortMalloc(). */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xQueue == ( MpscQueueHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure and slots were not allocated dynamically and cannot
+         * be freed - just scrub the structure so future use will assert. */
+        ( void ) memset( pxQueue, 0x00, sizeof( MpscQueue_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMpscQueueSend( MpscQueueHandle_t xQueue,
+                           const void * pvItemToQueue )
+{
+    MpscQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemToQueue );
+
+    if( prvWriteItem( pxQueue, pvItemToQueue, &xTaskToNotify ) != pdFALSE )
+    {
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyIndexed( xTaskToNotify, configMPSC_QUEUE_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        traceMPSC_QUEUE_SEND_FAILED( xQueue );
+        xReturn = errQUEUE_FULL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMpscQueueSendFromISR( MpscQueueHandle_t xQueue,
+                                  const void * pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    MpscQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemToQueue );
+
+    if( prvWriteItem( pxQueue, pvItemToQueue, &xTaskToNotify ) != pdFALSE )
+    {
+        /* Interrupts are only masked, inside the notify function, if the
+         * consumer was waiting for this item. */
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyIndexedFromISR( xTaskToNotify, configMPSC_QUEUE_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        traceMPSC_QUEUE_SEND_FAILED( xQueue );
+        xReturn = errQUEUE_FULL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMpscQueueReceive( MpscQueueHandle_t xQueue,
+                              void * pvBuffer,
+                              TickType_t xTicksToWait )
+{
+    MpscQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxPosition;
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        xReturn = prvReadItem( pxQueue, pvBuffer );
+
+        if( xReturn != pdFALSE )
+        {
+            break;
+        }
+
+        /* The timeout state is only captured once the call has to block, so
+         * the path that does not block never enters a critical section. */
+        if( xTicksToWait == ( TickType_t ) 0 )
+        {
+            xReturn = errQUEUE_EMPTY;
+            break;
+        }
+        else if( xEntryTimeSet == pdFALSE )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+            xEntryTimeSet = pdTRUE;
+        }
+        else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+        {
+            xReturn = errQUEUE_EMPTY;
+            break;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Discard any notification left over from a producer that published
+         * an item the consumer then received without blocking. */
+        ( void ) xTaskNotifyStateClearIndexed( NULL, configMPSC_QUEUE_NOTIFICATION_INDEX );
+
+        /* Publish the handle, then look at the next slot again.  A producer
+         * publishes its slot before it reads the handle, so either it sees
+         * the handle and notifies this task, or this task sees the item here
+         * and does not block.  The slot may also still be claimed by a
+         * producer that has not published it, in which case that producer
+         * will notify this task when it does. */
+        mpscSTORE_RELAXED( &( pxQueue->xTaskWaitingToReceive ), xTaskGetCurrentTaskHandle() );
+        mpscFULL_BARRIER();
+
+        uxPosition = pxQueue->uxDequeuePosition;
+
+        if( mpscLOAD_RELAXED( prvGetSlot( pxQueue, uxPosition ) ) != ( uxPosition + ( UBaseType_t ) 1 ) )
+        {
+            traceBLOCKING_ON_MPSC_QUEUE_RECEIVE( xQueue );
+            ( void ) xTaskNotifyWaitIndexed( configMPSC_QUEUE_NOTIFICATION_INDEX, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* A producer clears the handle when it notifies this task, but not if
+         * the wait timed out or was not needed. */
+        mpscSTORE_RELAXED( &( pxQueue->xTaskWaitingToReceive ), NULL );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMpscQueueItemsWaiting( MpscQueueHandle_t xQueue )
+{
+    const MpscQueue_t * const pxQueue = xQueue;
+    UBaseType_t uxDequeuePosition, uxEnqueuePosition;
+
+    configASSERT( pxQueue );
+
+    /* The positions only ever increase, so the difference is correct even
+     * when the enqueue position has wrapped and the dequeue position has not.
+     * The dequeue position is read first so the result cannot be negative. */
+    uxDequeuePosition = mpscLOAD_ACQUIRE( &( pxQueue->uxDequeuePosition ) );
+    uxEnqueuePosition = mpscLOAD_ACQUIRE( &( pxQueue->uxEnqueuePosition ) );
+
+    return uxEnqueuePosition - uxDequeuePosition;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteItem( MpscQueue_t * const pxQueue,
+                                const void * pvItemToQueue,
+                                TaskHandle_t * const pxTaskToNotify )
+{
+    UBaseType_t uxPosition, uxSequence;
+    UBaseType_t * puxSlot;
+    BaseType_t xDifference, xReturn;
+
+    *pxTaskToNotify = NULL;
+    uxPosition = mpscLOAD_RELAXED( &( pxQueue->uxEnqueuePosition ) );
+
+    for( ; ; )
+    {
+        puxSlot = prvGetSlot( pxQueue, uxPosition );
+
+        /* The acquire ensures the consumer has finished copying out of the
+         * slot before it is overwritten. */
+        uxSequence = mpscLOAD_ACQUIRE( puxSlot );
+        xDifference = ( BaseType_t ) ( uxSequence - uxPosition );
+
+        if( xDifference == ( BaseType_t ) 0 )
+        {
+            /* The slot is free.  Try to claim it.  If another producer claimed
+             * it first then uxPosition is updated to the position that
+             * producer left, and the loop tries again. */
+            if( mpscCOMPARE_AND_SWAP( &( pxQueue->uxEnqueuePosition ), &uxPosition, uxPosition + ( UBaseType_t ) 1 ) != pdFALSE )
+            {
+                xReturn = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( xDifference < ( BaseType_t ) 0 )
+        {
+            /* The slot still holds the item from the previous lap, so the
+             * queue is full. */
+            xReturn = pdFALSE;
+            break;
+        }
+        else
+        {
+            /* Another producer claimed the position since it was read. */
+            uxPosition = mpscLOAD_RELAXED( &( pxQueue->uxEnqueuePosition ) );
+        }
+    }
+
+    if( xReturn != pdFALSE )
+    {
+        ( void ) memcpy( ( void * ) &( puxSlot[ 1 ] ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        /* Publish the item, then wake the consumer if it is waiting.  The
+         * handle is exchanged rather than read so, of all the producers that
+         * see it, only one notifies the consumer. */
+        mpscSTORE_RELEASE( puxSlot, uxPosition + ( UBaseType_t ) 1 );
+        mpscFULL_BARRIER();
+
+        if( mpscLOAD_RELAXED( &( pxQueue->xTaskWaitingToReceive ) ) != NULL )
+        {
+            *pxTaskToNotify = mpscEXCHANGE( &( pxQueue->xTaskWaitingToReceive ), NULL );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReadItem( MpscQueue_t * const pxQueue,
+                               void * pvBuffer )
+{
+    UBaseType_t uxPosition;
+    UBaseType_t * puxSlot;
+    BaseType_t xReturn;
+
+    /* Only the consumer writes the dequeue position. */
+    uxPosition = pxQueue->uxDequeuePosition;
+    puxSlot = prvGetSlot( pxQueue, uxPosition );
+
+    /* The acquire ensures the producer has finished copying into the slot
+     * before it is read. */
+    if( mpscLOAD_ACQUIRE( puxSlot ) == ( uxPosition + ( UBaseType_t ) 1 ) )
+    {
+        ( void ) memcpy( pvBuffer, ( void * ) &( puxSlot[ 1 ] ), ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        /* Hand the slot to the producer that claims it on the next lap. */
+        mpscSTORE_RELEASE( puxSlot, uxPosition + pxQueue->uxLength );
+        mpscSTORE_RELAXED( &( pxQueue->uxDequeuePosition ), uxPosition + ( UBaseType_t ) 1 );
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t * prvGetSlot( const MpscQueue_t * const pxQueue,
+                                 UBaseType_t uxPosition )
+{
+    /* The length is a power of two, so the position wraps onto the slots
+     * correctly when it overflows. */
+    return &( pxQueue->puxSlots[ ( uxPosition & ( pxQueue->uxLength - ( UBaseType_t ) 1 ) ) * pxQueue->uxSlotWords ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewMpscQueue( MpscQueue_t * const pxQueue,
+                                       UBaseType_t * const puxSlots,
+                                       UBaseType_t uxLength,
+                                       UBaseType_t uxItemSize,
+                                       uint8_t ucFlags )
+{
+    UBaseType_t uxPosition;
+
+    ( void ) memset( ( void * ) pxQueue, 0x00, sizeof( MpscQueue_t ) ); /*lint !e9087 memset() requires void *. */
+    pxQueue->puxSlots = puxSlots;
+    pxQueue->uxLength = uxLength;
+    pxQueue->uxItemSize = uxItemSize;
+    pxQueue->uxSlotWords = ( UBaseType_t ) mpscQUEUE_STORAGE_WORDS( 1U, uxItemSize );
+    pxQueue->ucFlags = ucFlags;
+
+    /* Every slot starts free for the first lap. */
+    for( uxPosition = 0; uxPosition < uxLength; uxPosition++ )
+    {
+        *prvGetSlot( pxQueue, uxPosition ) = uxPosition;
+    }
+}
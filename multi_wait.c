@@ -0,0 +1,262 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "multi_wait.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the multi object wait functionality.  If you want to include it
+ * then ensure configUSE_MULTI_WAIT is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_MULTI_WAIT == 1 )
+
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+        #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build multi_wait.c when configUSE_MULTI_WAIT is 1
+    #endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Records xTask as the task to notify when pxObject becomes ready, or clears
+ * the record if xTask is NULL.  Returns pdFAIL if another task is already
+ * recorded.
+ */
+static BaseType_t prvRegisterObject( const MultiWaitObject_t * const pxObject,
+                                     TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pxObject is ready, otherwise pdFALSE.
+ */
+static BaseType_t prvIsObjectReady( const MultiWaitObject_t * const pxObject ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRegisterObject( const MultiWaitObject_t * const pxObject,
+                                     TaskHandle_t xTask )
+{
+    BaseType_t xReturn;
+
+    switch( pxObject->eObjectType )
+    {
+        case eMultiWaitQueue:
+            xReturn = xQueueRegisterMultiWaitTask( ( QueueHandle_t ) pxObject->pvObject, xTask );
+            break;
+
+        case eMultiWaitEventGroup:
+            xReturn = xEventGroupRegisterMultiWaitTask( ( EventGroupHandle_t ) pxObject->pvObject, xTask, pxObject->uxBitsToWaitFor );
+            break;
+
+        case eMultiWaitStreamBuffer:
+            xReturn = xStreamBufferRegisterMultiWaitTask( ( StreamBufferHandle_t ) pxObject->pvObject, xTask );
+            break;
+
+        case eMultiWaitNotification:
+
+            /* The task's own notification needs no registration. */
+            xReturn = pdPASS;
+            break;
+
+        default:
+            configASSERT( pdFALSE );
+            xReturn = pdFAIL;
+            break;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsObjectReady( const MultiWaitObject_t * const pxObject )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    switch( pxObject->eObjectType )
+    {
+        case eMultiWaitQueue:
+
+            if( uxQueueMessagesWaiting( ( QueueHandle_t ) pxObject->pvObject ) != ( UBaseType_t ) 0 )
+            {
+                xReturn = pdTRUE;
+            }
+
+            break;
+
+        case eMultiWaitEventGroup:
+
+            if( ( xEventGroupGetBits( ( EventGroupHandle_t ) pxObject->pvObject ) & pxObject->uxBitsToWaitFor ) != ( EventBits_t ) 0 )
+            {
+                xReturn = pdTRUE;
+            }
+
+            break;
+
+        case eMultiWaitStreamBuffer:
+
+            if( xStreamBufferIsEmpty( ( StreamBufferHandle_t ) pxObject->pvObject ) == pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+
+            break;
+
+        case eMultiWaitNotification:
+
+            /* Clearing no bits returns the notification value unchanged. */
+            if( ulTaskNotifyValueClearIndexed( NULL, configMULTI_WAIT_NOTIFICATION_INDEX, 0UL ) != 0UL )
+            {
+                xReturn = pdTRUE;
+            }
+
+            break;
+
+        default:
+            configASSERT( pdFALSE );
+            break;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMultiWaitForAny( MultiWaitObject_t * const pxObjects,
+                               const UBaseType_t uxObjectCount,
+                               TickType_t xTicksToWait )
+{
+    TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+    TimeOut_t xTimeOut;
+    UBaseType_t uxReady = 0, uxRegistered, ux;
+
+    configASSERT( pxObjects );
+    configASSERT( uxObjectCount > ( UBaseType_t ) 0 );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    vTaskSetTimeOutState( &xTimeOut );
+
+    /* Record this task in each object so the object notifies it when it
+     * becomes ready.  This is done before the objects are first looked at so an
+     * object that becomes ready after it has been looked at cannot be missed. */
+    for( uxRegistered = 0; uxRegistered < uxObjectCount; uxRegistered++ )
+    {
+        pxObjects[ uxRegistered ].xReady = pdFALSE;
+
+        if( prvRegisterObject( &( pxObjects[ uxRegistered ] ), xCurrentTask ) == pdFAIL )
+        {
+            break;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    if( uxRegistered == uxObjectCount )
+    {
+        for( ; ; )
+        {
+            /* Discard any notification left over from an earlier call, or from
+             * an object that was ready the last time the objects were looked
+             * at.  A notification sent after this point stays pending, so the
+             * wait below returns immediately if an object becomes ready while
+             * the objects are being looked at. */
+            ( void ) xTaskNotifyStateClearIndexed( NULL, configMULTI_WAIT_NOTIFICATION_INDEX );
+
+            for( ux = 0; ux < uxObjectCount; ux++ )
+            {
+                pxObjects[ ux ].xReady = prvIsObjectReady( &( pxObjects[ ux ] ) );
+
+                if( pxObjects[ ux ].xReady != pdFALSE )
+                {
+                    uxReady++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( uxReady != ( UBaseType_t ) 0 )
+            {
+                break;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                break;
+            }
+            else
+            {
+                /* Nothing is ready yet.  Block until an object notifies this
+                 * task or the remaining block time expires, then look again. */
+                ( void ) xTaskNotifyWaitIndexed( configMULTI_WAIT_NOTIFICATION_INDEX, 0UL, 0UL, NULL, xTicksToWait );
+            }
+        }
+    }
+    else
+    {
+        /* Another task is already waiting for one of the objects.  Returning 0
+         * would look like a timeout to a caller that then calls again straight
+         * away, so return a value that cannot be a count of ready objects. */
+        configASSERT( uxRegistered == uxObjectCount );
+        uxReady = multiwaitOBJECT_BUSY;
+    }
+
+    /* Remove this task from the objects it was recorded in.  An object that
+     * appears more than once is removed by its first entry, which is harmless
+     * as the others are being removed too. */
+    for( ux = 0; ux < uxRegistered; ux++ )
+    {
+        ( void ) prvRegisterObject( &( pxObjects[ ux ] ), NULL );
+    }
+
+    return uxReady;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the multi object wait functionality.  If you want to include it
+ * then ensure configUSE_MULTI_WAIT is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_MULTI_WAIT == 1 */
@@ -0,0 +1,131 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+* Kernel configuration for the Posix port benchmark.  Any of the settings
+* guarded by #ifndef can be overridden from the compiler command line, for
+* example to compare the same benchmark with a kernel option on and off.
+*----------------------------------------------------------*/
+
+#include <limits.h>
+
+#ifndef configUSE_PREEMPTION
+    #define configUSE_PREEMPTION                1
+#endif
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#ifndef configTICK_RATE_HZ
+    #define configTICK_RATE_HZ                  1000
+#endif
+#ifndef configMAX_PRIORITIES
+    #define configMAX_PRIORITIES                8
+#endif
+#define configMINIMAL_STACK_SIZE                ( ( unsigned short ) PTHREAD_STACK_MIN )
+#define configTOTAL_HEAP_SIZE                   ( ( size_t ) ( 16 * 1024 * 1024 ) )
+#define configMAX_TASK_NAME_LEN                 12
+#define configUSE_TRACE_FACILITY                0
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             0
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configQUEUE_REGISTRY_SIZE               0
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY           1
+#endif
+#ifndef configEVENT_GROUP_WAITER_BUCKETS
+    #define configEVENT_GROUP_WAITER_BUCKETS    24
+#endif
+#ifndef configUSE_EVENT_GROUP_DIRECT_ISR_SET
+    #define configUSE_EVENT_GROUP_DIRECT_ISR_SET    0
+#endif
+#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configUSE_MALLOC_FAILED_HOOK            0
+#define configUSE_CO_ROUTINES                   0
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES               1
+#endif
+
+/* Software timer definitions.  The timer service task runs at the highest
+ * priority so each timer command is processed as soon as it is sent. */
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                16
+#define configTIMER_TASK_STACK_DEPTH            configMINIMAL_STACK_SIZE
+
+/* Set the following definitions to 1 to include the API function, or zero
+ * to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_eTaskGetState                   1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+#define INCLUDE_xTimerPendFunctionCall          1
+
+/* freertos_tasks_c_additions.h is built into tasks.c so the benchmark can time
+ * task selection on its own. */
+#define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H    1
+
+/* Every task switch is counted so the benchmark can report context switches
+ * per second. */
+extern volatile unsigned long ulBenchmarkContextSwitches;
+#define traceTASK_SWITCHED_IN()    ulBenchmarkContextSwitches++
+
+/* The builds that set benchTRACE_CRITICAL_SECTIONS to 1 also count the task
+ * level critical sections entered, and the time spent in them, so the frame
+ * benchmarks can report how long each transfer keeps interrupts masked.  The
+ * other builds leave the hooks out so they add nothing to the timings. */
+#ifndef benchTRACE_CRITICAL_SECTIONS
+    #define benchTRACE_CRITICAL_SECTIONS    0
+#endif
+
+#if ( benchTRACE_CRITICAL_SECTIONS == 1 )
+    extern void vBenchmarkCriticalSectionEntered( void );
+    extern void vBenchmarkCriticalSectionExited( void );
+    #define traceCRITICAL_SECTION_ENTERED()    vBenchmarkCriticalSectionEntered()
+    #define traceCRITICAL_SECTION_EXITED()     vBenchmarkCriticalSectionExited()
+#endif
+
+/* Benchmarks are only meaningful if the kernel is behaving, so assertions are
+ * left enabled. */
+extern void vAssertCalled( const char * const pcFileName,
+                           unsigned long ulLine );
+#define configASSERT( x )    if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,77 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Included at the end of tasks.c when configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H
+ * is 1, so the benchmark can time kernel internals that are not reachable
+ * through the API.
+ */
+
+#ifndef FREERTOS_TASKS_C_ADDITIONS_H
+#define FREERTOS_TASKS_C_ADDITIONS_H
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+/*
+ * Runs taskSELECT_HIGHEST_PRIORITY_TASK() ulIterations times in a critical
+ * section, so the time taken is that of the selection alone rather than that
+ * of a host thread switch.  The calling task must be the only ready task at its
+ * priority, so every selection selects the calling task again.
+ *
+ * When the ready lists are walked, uxTopReadyPriority is first left where a
+ * task at the highest priority leaves it when it blocks, so each selection
+ * walks down from the top priority to that of the calling task.  That is the
+ * case that grows with configMAX_PRIORITIES.  The ready priority bitmap has no
+ * such state, so it is timed as it is.
+ */
+    void vBenchmarkSelectHighestPriorityTask( uint32_t ulIterations )
+    {
+        TCB_t * const pxCallingTCB = pxCurrentTCB;
+        uint32_t x;
+
+        taskENTER_CRITICAL();
+        {
+            for( x = 0; x < ulIterations; x++ )
+            {
+                #if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 0 ) )
+                {
+                    uxTopReadyPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+                }
+                #endif
+
+                taskSELECT_HIGHEST_PRIORITY_TASK();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        configASSERT( pxCurrentTCB == pxCallingTCB );
+    }
+
+#endif /* configNUMBER_OF_CORES */
+
+#endif /* FREERTOS_TASKS_C_ADDITIONS_H */
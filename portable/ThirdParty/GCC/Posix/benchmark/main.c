@@ -0,0 +1,1364 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Benchmarks a fixed set of kernel operations on the Posix port.
+ *
+ * Each benchmark runs a number of operations from a measuring task, most of
+ * them as a ping-pong with a partner task so every operation unblocks the other
+ * task.  The time taken and the number of context switches made are reported
+ * as one JSON object per line on stdout:
+ *
+ * {"benchmark":"queue_ping_pong","heap":"heap_4","cores":1,"priorities":8,
+ *  "events":"condvar","iterations":100000,"ns_per_op":812.4,
+ *  "context_switches_per_sec":2461841}
+ *
+ * so the results of two kernel versions can be compared by a script.  The
+ * number of iterations can be given as the first argument, and the name of the
+ * only benchmark to run as the second.  See the Makefile in this directory for
+ * how the benchmark is built once for each heap implementation, and once for
+ * each of a range of priority counts.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "spsc_ring.h"
+#include "mpsc_queue.h"
+#include "fast_mutex.h"
+#include "rwlock.h"
+
+/* The heap implementation the benchmark is linked with, set by the Makefile. */
+#ifndef benchHEAP
+    #error benchHEAP must be defined as the number of the heap_n.c file that is built into the benchmark.
+#endif
+
+#define benchSTRINGIFY( x )           #x
+#define benchHEAP_NAME( x )           "heap_" benchSTRINGIFY( x )
+
+/* How the port suspends and resumes the threads of the tasks, which sets the
+ * cost of a context switch. */
+#if ( configUSE_FUTEX_EVENTS == 1 )
+    #define benchEVENTS_NAME          "futex"
+#else
+    #define benchEVENTS_NAME          "condvar"
+#endif
+
+#define benchDEFAULT_ITERATIONS       100000UL
+
+/* The task that runs the benchmarks is below the priority of the tasks being
+ * measured, so it only runs again once a benchmark has completed. */
+#define benchCONTROL_PRIORITY         ( tskIDLE_PRIORITY + 1 )
+#define benchMEASURE_PRIORITY         ( tskIDLE_PRIORITY + 2 )
+#define benchHIGH_PRIORITY            ( tskIDLE_PRIORITY + 3 )
+
+/* Size of each stream buffer or message buffer transfer. */
+#define benchTRANSFER_BYTES           sizeof( uint32_t )
+
+/* Size of each item sent by the frame benchmarks, and the number of items each
+ * frame queue holds.  The frames are streamed rather than ping-ponged so the
+ * cost of moving the data is not hidden behind a context switch per item.  The
+ * frame size can be overridden from the compiler command line to find where
+ * zero copy transfers start to pay off on the host. */
+#ifndef benchFRAME_BYTES
+    #define benchFRAME_BYTES          1024U
+#endif
+#define benchFRAME_QUEUE_LENGTH       8U
+
+/* Number of items moved by each call in the batch benchmarks, and the number
+ * of items each burst queue holds. */
+#define benchBURST_ITEMS              32U
+#define benchBURST_QUEUE_LENGTH       ( benchBURST_ITEMS * 2U )
+
+/* Number of items the queues and the ring used by the stream benchmarks hold. */
+#define benchSTREAM_LENGTH            64U
+
+#define benchPING_BIT                 ( ( EventBits_t ) 0x01 )
+#define benchPONG_BIT                 ( ( EventBits_t ) 0x02 )
+
+/* Number of tasks that wait, for the duration of the run, on bits of a second
+ * event group that are never set, and the number of different bits they wait
+ * on.  The idle waiters benchmark ping pongs through that event group to
+ * measure how much they slow down setting the bits the partner waits for. */
+#define benchIDLE_WAITERS             16U
+#define benchIDLE_WAITER_BITS         22U
+
+/* The heap benchmark allocates blocks in batches of this many so the heap
+ * holds more than one block when blocks are freed. */
+#define benchHEAP_BATCH               16U
+
+/* heap_1 cannot free memory, so it is benchmarked with a fixed number of
+ * allocations that fits in the heap alongside the kernel objects. */
+#define benchHEAP_1_ALLOCATIONS       20000UL
+/*-----------------------------------------------------------*/
+
+typedef struct BENCHMARK
+{
+    const char * pcName;
+    void ( * pvOperations )( uint32_t ulIterations ); /* Run by the measuring task. */
+    TaskFunction_t pxPartnerTask;                    /* Run by the partner task, or NULL if there is no partner. */
+    UBaseType_t uxPartnerPriority;
+    void ( * pvReset )( void );                      /* Run once the tasks are suspended, or NULL if there is nothing to reset. */
+} Benchmark_t;
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvMeasureTask( void * pvParameters );
+static void prvRunBenchmark( const Benchmark_t * pxBenchmark );
+static void prvWaitForPartnerToSettle( void );
+static uint64_t prvGetTimeNs( void );
+
+#if ( configNUMBER_OF_CORES == 1 )
+    static void prvTaskSelectOperations( uint32_t ulIterations );
+#endif
+static void prvYieldOperations( uint32_t ulIterations );
+static void prvYieldPartnerTask( void * pvParameters );
+static void prvYieldReset( void );
+static void prvQueueOperations( uint32_t ulIterations );
+static void prvQueuePartnerTask( void * pvParameters );
+static void prvQueueReset( void );
+static void prvSemaphoreOperations( uint32_t ulIterations );
+static void prvSemaphorePartnerTask( void * pvParameters );
+static void prvSemaphoreReset( void );
+static void prvNotifyOperations( uint32_t ulIterations );
+static void prvNotifyPartnerTask( void * pvParameters );
+static void prvStreamBufferOperations( uint32_t ulIterations );
+static void prvStreamBufferPartnerTask( void * pvParameters );
+static void prvStreamBufferReset( void );
+static void prvMessageBufferOperations( uint32_t ulIterations );
+static void prvMessageBufferPartnerTask( void * pvParameters );
+static void prvMessageBufferReset( void );
+static void prvEventGroupOperations( uint32_t ulIterations );
+static void prvEventGroupPartnerTask( void * pvParameters );
+static void prvEventGroupReset( void );
+static void prvIdleWaitersOperations( uint32_t ulIterations );
+static void prvIdleWaitersPartnerTask( void * pvParameters );
+static void prvIdleWaitersReset( void );
+static void prvIdleWaiterTask( void * pvParameters );
+static void prvIsrNotifyOperations( uint32_t ulIterations );
+static void prvIsrNotifyPartnerTask( void * pvParameters );
+static void prvIsrEventGroupOperations( uint32_t ulIterations );
+static void prvIsrEventGroupPartnerTask( void * pvParameters );
+static void prvIsrEventGroupReset( void );
+static void prvMutexOperations( uint32_t ulIterations );
+static void prvMutexPartnerTask( void * pvParameters );
+static void prvFastMutexOperations( uint32_t ulIterations );
+static void prvFastMutexPartnerTask( void * pvParameters );
+static void prvMutexUncontendedOperations( uint32_t ulIterations );
+static void prvFastMutexUncontendedOperations( uint32_t ulIterations );
+static void prvRwLockReadOperations( uint32_t ulIterations );
+static void prvFrameCopyOperations( uint32_t ulIterations );
+static void prvFrameCopyPartnerTask( void * pvParameters );
+static void prvFrameCopyReset( void );
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    static void prvFrameZeroCopyOperations( uint32_t ulIterations );
+    static void prvFrameZeroCopyPartnerTask( void * pvParameters );
+    static void prvFrameZeroCopyReset( void );
+#endif
+static void prvBurstSingleOperations( uint32_t ulIterations );
+static void prvBurstSinglePartnerTask( void * pvParameters );
+static void prvBurstSingleReset( void );
+static void prvBurstMultipleOperations( uint32_t ulIterations );
+static void prvBurstMultiplePartnerTask( void * pvParameters );
+static void prvBurstMultipleReset( void );
+static void prvQueueStreamOperations( uint32_t ulIterations );
+static void prvQueueStreamPartnerTask( void * pvParameters );
+static void prvQueueStreamReset( void );
+static void prvRingStreamOperations( uint32_t ulIterations );
+static void prvRingStreamPartnerTask( void * pvParameters );
+static void prvMpscStreamOperations( uint32_t ulIterations );
+static void prvMpscStreamPartnerTask( void * pvParameters );
+static void prvTimerOperations( uint32_t ulIterations );
+static void prvTimerCallback( TimerHandle_t xExpiredTimer );
+static void prvHeapOperations( uint32_t ulIterations );
+
+/* Defined in freertos_tasks_c_additions.h, which is built into tasks.c. */
+#if ( configNUMBER_OF_CORES == 1 )
+    extern void vBenchmarkSelectHighestPriorityTask( uint32_t ulIterations );
+#endif
+/*-----------------------------------------------------------*/
+
+static const Benchmark_t xBenchmarks[] =
+{
+    #if ( configNUMBER_OF_CORES == 1 )
+        #if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+            { "task_select_bitmap", prvTaskSelectOperations,          NULL,                        0,                     NULL                  },
+        #else
+            { "task_select_walk",   prvTaskSelectOperations,          NULL,                        0,                     NULL                  },
+        #endif
+    #endif
+    { "yield_switch",              prvYieldOperations,                prvYieldPartnerTask,         benchMEASURE_PRIORITY, prvYieldReset         },
+    { "queue_ping_pong",           prvQueueOperations,                prvQueuePartnerTask,         benchMEASURE_PRIORITY, prvQueueReset         },
+    { "semaphore_ping_pong",       prvSemaphoreOperations,            prvSemaphorePartnerTask,     benchMEASURE_PRIORITY, prvSemaphoreReset     },
+    { "notify_ping_pong",          prvNotifyOperations,               prvNotifyPartnerTask,        benchMEASURE_PRIORITY, NULL                  },
+    { "stream_buffer_ping_pong",   prvStreamBufferOperations,         prvStreamBufferPartnerTask,  benchMEASURE_PRIORITY, prvStreamBufferReset  },
+    { "message_buffer_ping_pong",  prvMessageBufferOperations,        prvMessageBufferPartnerTask, benchMEASURE_PRIORITY, prvMessageBufferReset },
+    { "event_group_ping_pong",     prvEventGroupOperations,           prvEventGroupPartnerTask,    benchMEASURE_PRIORITY, prvEventGroupReset    },
+    { "event_group_idle_waiters",  prvIdleWaitersOperations,          prvIdleWaitersPartnerTask,   benchMEASURE_PRIORITY, prvIdleWaitersReset   },
+    { "isr_notify_wake",           prvIsrNotifyOperations,            prvIsrNotifyPartnerTask,     benchHIGH_PRIORITY,    NULL                  },
+    #if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+        { "isr_group_direct_wake", prvIsrEventGroupOperations,        prvIsrEventGroupPartnerTask, benchHIGH_PRIORITY,    prvIsrEventGroupReset },
+    #else
+        { "isr_group_defer_wake",  prvIsrEventGroupOperations,        prvIsrEventGroupPartnerTask, benchHIGH_PRIORITY,    prvIsrEventGroupReset },
+    #endif
+    { "mutex_handoff",             prvMutexOperations,                prvMutexPartnerTask,         benchHIGH_PRIORITY,    NULL                  },
+    { "fast_mutex_handoff",        prvFastMutexOperations,            prvFastMutexPartnerTask,     benchHIGH_PRIORITY,    NULL                  },
+    { "mutex_uncontended",         prvMutexUncontendedOperations,     NULL,                        0,                     NULL                  },
+    { "fast_mutex_uncontended",    prvFastMutexUncontendedOperations, NULL,                        0,                     NULL                  },
+    { "rwlock_read_uncontended",   prvRwLockReadOperations,           NULL,                        0,                     NULL                  },
+    { "queue_frame_copy",          prvFrameCopyOperations,            prvFrameCopyPartnerTask,     benchMEASURE_PRIORITY, prvFrameCopyReset     },
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        { "queue_frame_zero_copy", prvFrameZeroCopyOperations,        prvFrameZeroCopyPartnerTask, benchMEASURE_PRIORITY, prvFrameZeroCopyReset },
+    #endif
+    { "queue_burst_single",        prvBurstSingleOperations,          prvBurstSinglePartnerTask,   benchMEASURE_PRIORITY, prvBurstSingleReset   },
+    { "queue_burst_multiple",      prvBurstMultipleOperations,        prvBurstMultiplePartnerTask, benchMEASURE_PRIORITY, prvBurstMultipleReset },
+    { "queue_stream",              prvQueueStreamOperations,          prvQueueStreamPartnerTask,   benchMEASURE_PRIORITY, prvQueueStreamReset   },
+    { "spsc_ring_stream",          prvRingStreamOperations,           prvRingStreamPartnerTask,    benchMEASURE_PRIORITY, NULL                  },
+    { "mpsc_queue_stream",         prvMpscStreamOperations,           prvMpscStreamPartnerTask,    benchMEASURE_PRIORITY, NULL                  },
+    { "timer_start_stop",          prvTimerOperations,                NULL,                        0,                     NULL                  },
+    #if ( benchHEAP == 1 )
+        { "heap_alloc",            prvHeapOperations,                 NULL,                        0,                     NULL                  },
+    #else
+        { "heap_alloc_free",       prvHeapOperations,                 NULL,                        0,                     NULL                  },
+    #endif
+};
+
+/* Incremented by traceTASK_SWITCHED_IN(), see FreeRTOSConfig.h. */
+volatile unsigned long ulBenchmarkContextSwitches = 0;
+
+/* The number of critical sections entered, the time spent in them, and the
+ * time the one being timed was entered, kept by the critical section trace
+ * hooks, see FreeRTOSConfig.h.  Critical sections are entered with interrupts
+ * masked, so nothing else updates them while a hook runs. */
+#if ( benchTRACE_CRITICAL_SECTIONS == 1 )
+    static volatile unsigned long ulCriticalSectionsEntered = 0;
+    static volatile uint64_t ullCriticalSectionNs = 0;
+    static uint64_t ullCriticalSectionStartNs;
+#endif
+
+static uint32_t ulRequestedIterations = benchDEFAULT_ITERATIONS;
+static const char * pcRequestedBenchmark = NULL; /* NULL to run every benchmark. */
+static TaskHandle_t xControlTask = NULL;
+static TaskHandle_t xMeasureTask = NULL;
+static TaskHandle_t xPartnerTask = NULL;
+
+/* Results of the benchmark that has just run, written by the measuring task
+ * before it notifies the control task. */
+static uint64_t ullElapsedNs;
+static unsigned long ulContextSwitches;
+static uint32_t ulOperations;
+#if ( benchTRACE_CRITICAL_SECTIONS == 1 )
+    static unsigned long ulCriticalSections;
+    static uint64_t ullCriticalNs;
+#endif
+
+/* Set when the yield benchmark has finished, so its partner task stops
+ * yielding and lets the control task run. */
+static volatile BaseType_t xYieldFinished = pdFALSE;
+
+/* The objects used by the benchmarks.  They are never deleted so the same
+ * benchmarks can run with heap_1. */
+static QueueHandle_t xPingQueue, xPongQueue;
+static QueueHandle_t xFrameCopyQueue, xFrameZeroCopyQueue;
+static QueueHandle_t xBurstSingleQueue, xBurstMultipleQueue;
+static QueueHandle_t xStreamQueue;
+static SpscRingHandle_t xStreamRing;
+static MpscQueueHandle_t xStreamMpscQueue;
+static SemaphoreHandle_t xPingSemaphore, xPongSemaphore;
+static SemaphoreHandle_t xMutex;
+static FastMutexHandle_t xFastMutex;
+static RwLockHandle_t xRwLock;
+static StreamBufferHandle_t xPingStreamBuffer, xPongStreamBuffer;
+static MessageBufferHandle_t xPingMessageBuffer, xPongMessageBuffer;
+static EventGroupHandle_t xEventGroup;
+static EventGroupHandle_t xIdleWaitersEventGroup;
+static EventGroupHandle_t xIsrEventGroup;
+static TimerHandle_t xTimer;
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char * argv[] )
+{
+    uint32_t x;
+
+    if( argc > 1 )
+    {
+        ulRequestedIterations = ( uint32_t ) strtoul( argv[ 1 ], NULL, 10 );
+
+        if( ulRequestedIterations == 0UL )
+        {
+            fprintf( stderr, "usage: %s [iterations [benchmark]]\n", argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if( argc > 2 )
+    {
+        pcRequestedBenchmark = argv[ 2 ];
+    }
+
+    #if ( benchHEAP == 5 )
+    {
+        static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+        const HeapRegion_t xHeapRegions[] =
+        {
+            { ucHeap, sizeof( ucHeap ) },
+            { NULL,   0                }
+        };
+
+        vPortDefineHeapRegions( xHeapRegions );
+    }
+    #endif /* benchHEAP */
+
+    xPingQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    xPongQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    xFrameCopyQueue = xQueueCreate( benchFRAME_QUEUE_LENGTH, benchFRAME_BYTES );
+    xFrameZeroCopyQueue = xQueueCreate( benchFRAME_QUEUE_LENGTH, benchFRAME_BYTES );
+    xBurstSingleQueue = xQueueCreate( benchBURST_QUEUE_LENGTH, sizeof( uint32_t ) );
+    xBurstMultipleQueue = xQueueCreate( benchBURST_QUEUE_LENGTH, sizeof( uint32_t ) );
+    xStreamQueue = xQueueCreate( benchSTREAM_LENGTH, sizeof( uint32_t ) );
+    xStreamRing = xSpscRingCreate( benchSTREAM_LENGTH, sizeof( uint32_t ) );
+    xStreamMpscQueue = xMpscQueueCreate( benchSTREAM_LENGTH, sizeof( uint32_t ) );
+    xPingSemaphore = xSemaphoreCreateBinary();
+    xPongSemaphore = xSemaphoreCreateBinary();
+    xMutex = xSemaphoreCreateMutex();
+    xFastMutex = xFastMutexCreate();
+    xRwLock = xRwLockCreate( pdFALSE );
+    xPingStreamBuffer = xStreamBufferCreate( benchTRANSFER_BYTES * 4U, benchTRANSFER_BYTES );
+    xPongStreamBuffer = xStreamBufferCreate( benchTRANSFER_BYTES * 4U, benchTRANSFER_BYTES );
+    xPingMessageBuffer = xMessageBufferCreate( ( benchTRANSFER_BYTES + sizeof( size_t ) ) * 4U );
+    xPongMessageBuffer = xMessageBufferCreate( ( benchTRANSFER_BYTES + sizeof( size_t ) ) * 4U );
+    xEventGroup = xEventGroupCreate();
+    xIdleWaitersEventGroup = xEventGroupCreate();
+    xIsrEventGroup = xEventGroupCreate();
+    xTimer = xTimerCreate( "Bench", pdMS_TO_TICKS( 1000 ), pdFALSE, NULL, prvTimerCallback );
+
+    configASSERT( xPingQueue && xPongQueue && xFrameCopyQueue && xFrameZeroCopyQueue && xBurstSingleQueue && xBurstMultipleQueue && xPingSemaphore && xPongSemaphore && xMutex && xFastMutex && xRwLock );
+    configASSERT( xPingStreamBuffer && xPongStreamBuffer && xPingMessageBuffer && xPongMessageBuffer );
+    configASSERT( xStreamQueue && xStreamRing && xStreamMpscQueue && xEventGroup && xIdleWaitersEventGroup && xIsrEventGroup && xTimer );
+
+    /* The idle waiters have a higher priority than the control task, so they
+     * have all blocked before the first benchmark starts. */
+    for( x = 0; x < benchIDLE_WAITERS; x++ )
+    {
+        xTaskCreate( prvIdleWaiterTask, "Idle waiter", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, benchHIGH_PRIORITY, NULL );
+    }
+
+    xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, &xControlTask );
+
+    vTaskStartScheduler();
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    size_t x;
+
+    ( void ) pvParameters;
+
+    for( x = 0; x < sizeof( xBenchmarks ) / sizeof( xBenchmarks[ 0 ] ); x++ )
+    {
+        if( ( pcRequestedBenchmark == NULL ) || ( strcmp( pcRequestedBenchmark, xBenchmarks[ x ].pcName ) == 0 ) )
+        {
+            prvRunBenchmark( &( xBenchmarks[ x ] ) );
+        }
+    }
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunBenchmark( const Benchmark_t * pxBenchmark )
+{
+    double dNsPerOp, dSwitchesPerSec;
+
+    /* The partner task is created first, so it is already waiting for the
+     * measuring task when the measuring task starts. */
+    if( pxBenchmark->pxPartnerTask != NULL )
+    {
+        xTaskCreate( pxBenchmark->pxPartnerTask, "Partner", configMINIMAL_STACK_SIZE, NULL, pxBenchmark->uxPartnerPriority, &xPartnerTask );
+    }
+
+    xTaskCreate( prvMeasureTask, "Measure", configMINIMAL_STACK_SIZE, ( void * ) pxBenchmark, benchMEASURE_PRIORITY, &xMeasureTask );
+
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+    /* The tasks are suspended rather than deleted as heap_1 cannot free
+     * them. */
+    vTaskSuspend( xMeasureTask );
+
+    if( pxBenchmark->pxPartnerTask != NULL )
+    {
+        prvWaitForPartnerToSettle();
+        vTaskSuspend( xPartnerTask );
+    }
+
+    /* Leave the objects the benchmark used as the next benchmark to use them
+     * expects to find them. */
+    if( pxBenchmark->pvReset != NULL )
+    {
+        pxBenchmark->pvReset();
+    }
+
+    dNsPerOp = ( double ) ullElapsedNs / ( double ) ulOperations;
+    dSwitchesPerSec = ( ( double ) ulContextSwitches * 1e9 ) / ( double ) ullElapsedNs;
+
+    #if ( benchTRACE_CRITICAL_SECTIONS == 1 )
+    {
+        /* The same object as the other builds, with the frame size and the
+         * critical section counts added. */
+        printf( "{\"benchmark\":\"%s\",\"heap\":\"%s\",\"cores\":%d,\"priorities\":%d,\"events\":\"%s\",\"iterations\":%lu,\"ns_per_op\":%.1f,\"context_switches_per_sec\":%.0f,"
+                "\"frame_bytes\":%u,\"critical_sections_per_op\":%.2f,\"critical_ns_per_op\":%.1f}\n",
+                pxBenchmark->pcName, benchHEAP_NAME( benchHEAP ), configNUMBER_OF_CORES, configMAX_PRIORITIES, benchEVENTS_NAME,
+                ( unsigned long ) ulOperations, dNsPerOp, dSwitchesPerSec, ( unsigned ) benchFRAME_BYTES,
+                ( double ) ulCriticalSections / ( double ) ulOperations, ( double ) ullCriticalNs / ( double ) ulOperations );
+    }
+    #else
+    {
+        printf( "{\"benchmark\":\"%s\",\"heap\":\"%s\",\"cores\":%d,\"priorities\":%d,\"events\":\"%s\",\"iterations\":%lu,\"ns_per_op\":%.1f,\"context_switches_per_sec\":%.0f}\n",
+                pxBenchmark->pcName, benchHEAP_NAME( benchHEAP ), configNUMBER_OF_CORES, configMAX_PRIORITIES, benchEVENTS_NAME,
+                ( unsigned long ) ulOperations, dNsPerOp, dSwitchesPerSec );
+    }
+    #endif /* benchTRACE_CRITICAL_SECTIONS */
+    fflush( stdout );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForPartnerToSettle( void )
+{
+    eTaskState eState;
+
+    /* On a multicore build the partner task runs alongside the control task,
+     * so can still be working through what the measuring task left it, or be
+     * holding an object the measuring task used.  It is only suspended once it
+     * has blocked waiting for more work, or has suspended itself. */
+    for( ; ; )
+    {
+        eState = eTaskGetState( xPartnerTask );
+
+        if( ( eState == eBlocked ) || ( eState == eSuspended ) )
+        {
+            break;
+        }
+
+        vTaskDelay( 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureTask( void * pvParameters )
+{
+    const Benchmark_t * pxBenchmark = ( const Benchmark_t * ) pvParameters;
+    unsigned long ulSwitchesAtStart;
+    uint64_t ullStartNs;
+
+    #if ( benchTRACE_CRITICAL_SECTIONS == 1 )
+        unsigned long ulCriticalSectionsAtStart = ulCriticalSectionsEntered;
+        uint64_t ullCriticalNsAtStart = ullCriticalSectionNs;
+    #endif
+
+    ulOperations = ulRequestedIterations;
+
+    ulSwitchesAtStart = ulBenchmarkContextSwitches;
+    ullStartNs = prvGetTimeNs();
+
+    pxBenchmark->pvOperations( ulRequestedIterations );
+
+    ullElapsedNs = prvGetTimeNs() - ullStartNs;
+    ulContextSwitches = ulBenchmarkContextSwitches - ulSwitchesAtStart;
+
+    #if ( benchTRACE_CRITICAL_SECTIONS == 1 )
+    {
+        ulCriticalSections = ulCriticalSectionsEntered - ulCriticalSectionsAtStart;
+        ullCriticalNs = ullCriticalSectionNs - ullCriticalNsAtStart;
+    }
+    #endif
+
+    xTaskNotifyGive( xControlTask );
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+#if ( benchTRACE_CRITICAL_SECTIONS == 1 )
+
+    void vBenchmarkCriticalSectionEntered( void )
+    {
+        ulCriticalSectionsEntered++;
+        ullCriticalSectionStartNs = prvGetTimeNs();
+    }
+/*-----------------------------------------------------------*/
+
+    void vBenchmarkCriticalSectionExited( void )
+    {
+        /* Includes the time taken by any switch to another task made from
+         * inside the critical section, as interrupts stay masked during it. */
+        ullCriticalSectionNs += prvGetTimeNs() - ullCriticalSectionStartNs;
+    }
+
+#endif /* benchTRACE_CRITICAL_SECTIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+    static void prvTaskSelectOperations( uint32_t ulIterations )
+    {
+        /* Measures the selection of the next task to run on its own, without
+         * the switch to it, so the cost can be compared across builds with
+         * different values of configMAX_PRIORITIES. */
+        vBenchmarkSelectHighestPriorityTask( ulIterations );
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+static void prvYieldOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    /* The partner task has the same priority, so each yield is a context
+     * switch to the partner and the partner's yield is a switch back.  This
+     * measures the cost of a context switch on its own. */
+    xTaskNotifyGive( xPartnerTask );
+
+    for( x = 0; x < ulIterations; x++ )
+    {
+        taskYIELD();
+    }
+
+    xYieldFinished = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldPartnerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    /* Yielding to no other task of the same priority would starve the
+     * control task before it creates the measuring task. */
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+    while( xYieldFinished == pdFALSE )
+    {
+        taskYIELD();
+    }
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldReset( void )
+{
+    xYieldFinished = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueOperations( uint32_t ulIterations )
+{
+    uint32_t ulValue;
+
+    for( ulValue = 0; ulValue < ulIterations; ulValue++ )
+    {
+        xQueueSend( xPingQueue, &ulValue, portMAX_DELAY );
+        xQueueReceive( xPongQueue, &ulValue, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueuePartnerTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xQueueReceive( xPingQueue, &ulValue, portMAX_DELAY );
+        xQueueSend( xPongQueue, &ulValue, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueReset( void )
+{
+    ( void ) xQueueReset( xPingQueue );
+    ( void ) xQueueReset( xPongQueue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSemaphoreOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xSemaphoreGive( xPingSemaphore );
+        xSemaphoreTake( xPongSemaphore, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSemaphorePartnerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xSemaphoreTake( xPingSemaphore, portMAX_DELAY );
+        xSemaphoreGive( xPongSemaphore );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSemaphoreReset( void )
+{
+    /* Binary semaphores are queues of length one. */
+    ( void ) xQueueReset( xPingSemaphore );
+    ( void ) xQueueReset( xPongSemaphore );
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xTaskNotifyGive( xPartnerTask );
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyPartnerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        xTaskNotifyGive( xMeasureTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamBufferOperations( uint32_t ulIterations )
+{
+    uint32_t ulValue;
+
+    for( ulValue = 0; ulValue < ulIterations; ulValue++ )
+    {
+        ( void ) xStreamBufferSend( xPingStreamBuffer, &ulValue, benchTRANSFER_BYTES, portMAX_DELAY );
+        ( void ) xStreamBufferReceive( xPongStreamBuffer, &ulValue, benchTRANSFER_BYTES, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamBufferPartnerTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xStreamBufferReceive( xPingStreamBuffer, &ulValue, benchTRANSFER_BYTES, portMAX_DELAY );
+        ( void ) xStreamBufferSend( xPongStreamBuffer, &ulValue, benchTRANSFER_BYTES, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamBufferReset( void )
+{
+    ( void ) xStreamBufferReset( xPingStreamBuffer );
+    ( void ) xStreamBufferReset( xPongStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMessageBufferOperations( uint32_t ulIterations )
+{
+    uint32_t ulValue;
+
+    for( ulValue = 0; ulValue < ulIterations; ulValue++ )
+    {
+        ( void ) xMessageBufferSend( xPingMessageBuffer, &ulValue, benchTRANSFER_BYTES, portMAX_DELAY );
+        ( void ) xMessageBufferReceive( xPongMessageBuffer, &ulValue, benchTRANSFER_BYTES, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMessageBufferPartnerTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xMessageBufferReceive( xPingMessageBuffer, &ulValue, benchTRANSFER_BYTES, portMAX_DELAY );
+        ( void ) xMessageBufferSend( xPongMessageBuffer, &ulValue, benchTRANSFER_BYTES, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMessageBufferReset( void )
+{
+    ( void ) xMessageBufferReset( xPingMessageBuffer );
+    ( void ) xMessageBufferReset( xPongMessageBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventGroupOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    for( x = 0; x < ulIterations; x++ )
+    {
+        ( void ) xEventGroupSetBits( xEventGroup, benchPING_BIT );
+        ( void ) xEventGroupWaitBits( xEventGroup, benchPONG_BIT, pdTRUE, pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventGroupPartnerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xEventGroupWaitBits( xEventGroup, benchPING_BIT, pdTRUE, pdTRUE, portMAX_DELAY );
+        ( void ) xEventGroupSetBits( xEventGroup, benchPONG_BIT );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventGroupReset( void )
+{
+    ( void ) xEventGroupClearBits( xEventGroup, benchPING_BIT | benchPONG_BIT );
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleWaitersOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    for( x = 0; x < ulIterations; x++ )
+    {
+        ( void ) xEventGroupSetBits( xIdleWaitersEventGroup, benchPING_BIT );
+        ( void ) xEventGroupWaitBits( xIdleWaitersEventGroup, benchPONG_BIT, pdTRUE, pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleWaitersPartnerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xEventGroupWaitBits( xIdleWaitersEventGroup, benchPING_BIT, pdTRUE, pdTRUE, portMAX_DELAY );
+        ( void ) xEventGroupSetBits( xIdleWaitersEventGroup, benchPONG_BIT );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleWaitersReset( void )
+{
+    /* The idle waiters are left waiting for their bits. */
+    ( void ) xEventGroupClearBits( xIdleWaitersEventGroup, benchPING_BIT | benchPONG_BIT );
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleWaiterTask( void * pvParameters )
+{
+    const EventBits_t uxBit = ( benchPONG_BIT << 1 ) << ( ( uintptr_t ) pvParameters % benchIDLE_WAITER_BITS );
+
+    /* The bit is never set, so the task stays in the event group's list of
+     * waiting tasks for the whole run. */
+    for( ; ; )
+    {
+        ( void ) xEventGroupWaitBits( xIdleWaitersEventGroup, uxBit, pdFALSE, pdFALSE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvIsrNotifyOperations( uint32_t ulIterations )
+{
+    BaseType_t xHigherPriorityTaskWoken;
+    uint32_t x;
+
+    /* The measuring task stands in for an interrupt that wakes a higher
+     * priority task, so each operation is the time from the interrupt to the
+     * woken task running, plus the woken task blocking again.  It is the
+     * baseline for the event group version below. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xHigherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR( xPartnerTask, &xHigherPriorityTaskWoken );
+        portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvIsrNotifyPartnerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvIsrEventGroupOperations( uint32_t ulIterations )
+{
+    BaseType_t xHigherPriorityTaskWoken;
+    uint32_t x;
+
+    /* As prvIsrNotifyOperations(), but the interrupt sets an event group bit.
+     * Unless configUSE_EVENT_GROUP_DIRECT_ISR_SET is 1 the bit is set by the
+     * timer task, which the Makefile's bench_event_group_direct build avoids. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xHigherPriorityTaskWoken = pdFALSE;
+        ( void ) xEventGroupSetBitsFromISR( xIsrEventGroup, benchPING_BIT, &xHigherPriorityTaskWoken );
+        portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvIsrEventGroupPartnerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xEventGroupWaitBits( xIsrEventGroup, benchPING_BIT, pdTRUE, pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvIsrEventGroupReset( void )
+{
+    ( void ) xEventGroupClearBits( xIsrEventGroup, benchPING_BIT );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    /* The partner task has the higher priority.  Once woken it blocks on the
+     * mutex held by this task, which inherits its priority until the mutex is
+     * given, at which point the mutex is handed to the partner task. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xSemaphoreTake( xMutex, portMAX_DELAY );
+        xTaskNotifyGive( xPartnerTask );
+        xSemaphoreGive( xMutex );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexPartnerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        xSemaphoreTake( xMutex, portMAX_DELAY );
+        xSemaphoreGive( xMutex );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFastMutexOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    /* As prvMutexOperations(), but every take and give is contended, so
+     * measures the fast mutex's fallback to the kernel. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xFastMutexTake( xFastMutex, portMAX_DELAY );
+        xTaskNotifyGive( xPartnerTask );
+        xFastMutexGive( xFastMutex );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFastMutexPartnerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        xFastMutexTake( xFastMutex, portMAX_DELAY );
+        xFastMutexGive( xFastMutex );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexUncontendedOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    /* No other task uses the mutex, so neither call blocks. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xSemaphoreTake( xMutex, portMAX_DELAY );
+        xSemaphoreGive( xMutex );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFastMutexUncontendedOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    /* No other task uses the mutex, so each call is a single compare and
+     * swap. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xFastMutexTake( xFastMutex, portMAX_DELAY );
+        xFastMutexGive( xFastMutex );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRwLockReadOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    /* No task takes the lock for writing, so neither call blocks. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xRwLockTakeRead( xRwLock, portMAX_DELAY );
+        xRwLockGiveRead( xRwLock );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFrameCopyOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+    uint32_t ulFrame[ benchFRAME_BYTES / sizeof( uint32_t ) ];
+
+    /* The partner task has the same priority, so the queue fills before the
+     * partner drains it.  Each frame is built in a local buffer then copied
+     * into the queue. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        memset( ulFrame, ( int ) x, sizeof( ulFrame ) );
+        ulFrame[ 0 ] = x;
+        xQueueSend( xFrameCopyQueue, ulFrame, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFrameCopyPartnerTask( void * pvParameters )
+{
+    uint32_t ulFrame[ benchFRAME_BYTES / sizeof( uint32_t ) ];
+    uint32_t ulExpected = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xQueueReceive( xFrameCopyQueue, ulFrame, portMAX_DELAY );
+        configASSERT( ulFrame[ 0 ] == ulExpected );
+        ulExpected++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFrameCopyReset( void )
+{
+    ( void ) xQueueReset( xFrameCopyQueue );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static void prvFrameZeroCopyOperations( uint32_t ulIterations )
+    {
+        uint32_t x;
+        uint32_t * pulFrame;
+
+        /* As prvFrameCopyOperations(), but each frame is built directly in
+         * the queue storage area. */
+        for( x = 0; x < ulIterations; x++ )
+        {
+            pulFrame = ( uint32_t * ) pvQueueReserve( xFrameZeroCopyQueue, portMAX_DELAY );
+            memset( pulFrame, ( int ) x, benchFRAME_BYTES );
+            pulFrame[ 0 ] = x;
+            xQueueCommit( xFrameZeroCopyQueue );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFrameZeroCopyPartnerTask( void * pvParameters )
+    {
+        const uint32_t * pulFrame;
+        uint32_t ulExpected = 0;
+
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            pulFrame = ( const uint32_t * ) pvQueueAcquire( xFrameZeroCopyQueue, portMAX_DELAY );
+            configASSERT( pulFrame[ 0 ] == ulExpected );
+            ulExpected++;
+            xQueueRelease( xFrameZeroCopyQueue );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFrameZeroCopyReset( void )
+    {
+        ( void ) xQueueReset( xFrameZeroCopyQueue );
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+static void prvBurstSingleOperations( uint32_t ulIterations )
+{
+    uint32_t x, ulItem;
+    uint32_t ulBurst[ benchBURST_ITEMS ];
+
+    /* Each operation moves one item.  The items are produced in bursts, as by
+     * a DMA completion, but posted one call at a time. */
+    ulIterations -= ulIterations % benchBURST_ITEMS;
+    ulOperations = ulIterations;
+
+    for( x = 0; x < ulIterations; x += benchBURST_ITEMS )
+    {
+        for( ulItem = 0; ulItem < benchBURST_ITEMS; ulItem++ )
+        {
+            ulBurst[ ulItem ] = x + ulItem;
+        }
+
+        for( ulItem = 0; ulItem < benchBURST_ITEMS; ulItem++ )
+        {
+            xQueueSend( xBurstSingleQueue, &( ulBurst[ ulItem ] ), portMAX_DELAY );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBurstSinglePartnerTask( void * pvParameters )
+{
+    uint32_t ulItem, ulExpected = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xQueueReceive( xBurstSingleQueue, &ulItem, portMAX_DELAY );
+        configASSERT( ulItem == ulExpected );
+        ulExpected++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBurstSingleReset( void )
+{
+    ( void ) xQueueReset( xBurstSingleQueue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBurstMultipleOperations( uint32_t ulIterations )
+{
+    uint32_t x, ulItem;
+    uint32_t ulBurst[ benchBURST_ITEMS ];
+
+    /* As prvBurstSingleOperations(), but each burst is posted with one
+     * call. */
+    ulIterations -= ulIterations % benchBURST_ITEMS;
+    ulOperations = ulIterations;
+
+    for( x = 0; x < ulIterations; x += benchBURST_ITEMS )
+    {
+        for( ulItem = 0; ulItem < benchBURST_ITEMS; ulItem++ )
+        {
+            ulBurst[ ulItem ] = x + ulItem;
+        }
+
+        ( void ) uxQueueSendMultiple( xBurstMultipleQueue, ulBurst, benchBURST_ITEMS, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBurstMultiplePartnerTask( void * pvParameters )
+{
+    uint32_t ulBurst[ benchBURST_ITEMS ];
+    uint32_t ulExpected = 0;
+    UBaseType_t uxItem, uxReceived;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        uxReceived = uxQueueReceiveMultiple( xBurstMultipleQueue, ulBurst, benchBURST_ITEMS, portMAX_DELAY );
+
+        for( uxItem = 0; uxItem < uxReceived; uxItem++ )
+        {
+            configASSERT( ulBurst[ uxItem ] == ulExpected );
+            ulExpected++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBurstMultipleReset( void )
+{
+    ( void ) xQueueReset( xBurstMultipleQueue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueStreamOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    /* Items are streamed one at a time to a partner task of the same
+     * priority, as from a high rate producer such as a sampling interrupt. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xQueueSend( xStreamQueue, &x, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueStreamPartnerTask( void * pvParameters )
+{
+    uint32_t ulItem, ulExpected = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xQueueReceive( xStreamQueue, &ulItem, portMAX_DELAY );
+        configASSERT( ulItem == ulExpected );
+        ulExpected++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueStreamReset( void )
+{
+    ( void ) xQueueReset( xStreamQueue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRingStreamOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    /* As prvQueueStreamOperations(), but through a single producer single
+     * consumer ring. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xSpscRingSend( xStreamRing, &x, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRingStreamPartnerTask( void * pvParameters )
+{
+    uint32_t ulItem, ulExpected = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xSpscRingReceive( xStreamRing, &ulItem, portMAX_DELAY );
+        configASSERT( ulItem == ulExpected );
+        ulExpected++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMpscStreamOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    /* As prvQueueStreamOperations(), but through a multiple producer single
+     * consumer queue.  Producers to such a queue never block, so the
+     * measuring task yields to the partner task when the queue is full. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        while( xMpscQueueSend( xStreamMpscQueue, &x ) != pdPASS )
+        {
+            taskYIELD();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMpscStreamPartnerTask( void * pvParameters )
+{
+    uint32_t ulItem, ulExpected = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xMpscQueueReceive( xStreamMpscQueue, &ulItem, portMAX_DELAY );
+        configASSERT( ulItem == ulExpected );
+        ulExpected++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerOperations( uint32_t ulIterations )
+{
+    uint32_t x;
+
+    /* The timer service task has the highest priority, so runs to process
+     * each command as it is sent.  The timer never expires. */
+    for( x = 0; x < ulIterations; x++ )
+    {
+        xTimerStart( xTimer, portMAX_DELAY );
+        xTimerStop( xTimer, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xExpiredTimer )
+{
+    ( void ) xExpiredTimer;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapOperations( uint32_t ulIterations )
+{
+    /* Block sizes are varied so the heaps that coalesce free blocks have
+     * some work to do. */
+    static const size_t xSizes[ benchHEAP_BATCH ] =
+    {
+        16, 100, 24, 512, 64, 32, 200, 48, 1024, 16, 80, 256, 40, 128, 24, 384
+    };
+    void * pvBlocks[ benchHEAP_BATCH ];
+    uint32_t x;
+
+    #if ( benchHEAP == 1 )
+    {
+        /* Only allocations can be measured. */
+        if( ulIterations > benchHEAP_1_ALLOCATIONS )
+        {
+            ulIterations = benchHEAP_1_ALLOCATIONS;
+        }
+
+        for( x = 0; x < ulIterations; x++ )
+        {
+            pvBlocks[ 0 ] = pvPortMalloc( xSizes[ x % benchHEAP_BATCH ] );
+            configASSERT( pvBlocks[ 0 ] );
+        }
+    }
+    #else /* benchHEAP */
+    {
+        UBaseType_t uxBlock;
+
+        /* Each operation is one allocation and one free, made in whole
+         * batches. */
+        if( ulIterations < benchHEAP_BATCH )
+        {
+            ulIterations = benchHEAP_BATCH;
+        }
+
+        ulIterations -= ulIterations % benchHEAP_BATCH;
+
+        for( x = 0; x < ulIterations; x += benchHEAP_BATCH )
+        {
+            for( uxBlock = 0; uxBlock < benchHEAP_BATCH; uxBlock++ )
+            {
+                pvBlocks[ uxBlock ] = pvPortMalloc( xSizes[ uxBlock ] );
+                configASSERT( pvBlocks[ uxBlock ] );
+            }
+
+            /* Free every other block first so freed blocks are not always
+             * adjacent to each other. */
+            for( uxBlock = 0; uxBlock < benchHEAP_BATCH; uxBlock += 2U )
+            {
+                vPortFree( pvBlocks[ uxBlock ] );
+            }
+
+            for( uxBlock = 1; uxBlock < benchHEAP_BATCH; uxBlock += 2U )
+            {
+                vPortFree( pvBlocks[ uxBlock ] );
+            }
+        }
+    }
+    #endif /* benchHEAP */
+
+    ulOperations = ulIterations;
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * const pcFileName,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "ASSERT! Line %lu, file %s\n", ulLine, pcFileName );
+    abort();
+}
+/*-----------------------------------------------------------*/
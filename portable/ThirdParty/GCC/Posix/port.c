@@ -48,11 +48,33 @@
 * stdio (printf() and friends) should be called from a single task
 * only or serialized with a FreeRTOS primitive such as a binary
 * semaphore or mutex.
+*
+* When configNUMBER_OF_CORES is greater than 1 a thread runs on each
+* simulated core at the same time.  The kernel's task and ISR locks are
+* spinlocks owned by a core, and a core is made to reschedule by
+* sending SIG_YIELD_CORE to the thread of the task it is running.  The
+* core a thread is running on is passed to it when it is resumed.
+*
+* When configUSE_SOFTWARE_INTERRUPT_MASK is 1 critical sections set a
+* flag instead of changing the thread's signal mask, which avoids a
+* system call on every entry to and exit from a critical section.  A
+* tick that arrives while the flag is set is held pending and run when
+* interrupts are next enabled.  Only threads that are suspended block
+* signals.
+*
+* When configUSE_GREEN_THREADS is 1 all the tasks run on the thread that
+* started the scheduler instead of on a pthread each.  Each task runs on
+* the stack allocated for it by the kernel and a context switch only
+* saves and restores registers, with a small assembly routine on x86-64
+* or with swapcontext() elsewhere.  The tick is handled on the stack of
+* the task it interrupts, which may switch to another task from within
+* the signal handler, so interrupts are masked with a flag as above and
+* signals are never blocked while tasks run.  Task stacks must be large
+* enough for a signal frame.
 *----------------------------------------------------------*/
-#include "portmacro.h"
-
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -66,19 +88,65 @@
 #include "task.h"
 #include "timers.h"
 #include "utils/wait_for_event.h"
+
+#if ( configUSE_GREEN_THREADS == 1 ) && !defined( __x86_64__ )
+    #include <ucontext.h>
+#endif
 /*-----------------------------------------------------------*/
 
-#define SIG_RESUME    SIGUSR1
+#define SIG_RESUME        SIGUSR1
+#define SIG_YIELD_CORE    SIGUSR2
+
+/* The most ticks suppressed in one sleep, about 24 days at a 1ms tick. */
+#ifndef portMAX_SUPPRESSED_TICKS
+    #define portMAX_SUPPRESSED_TICKS    ( ( TickType_t ) 0x7fffffffUL )
+#endif
+
+#if ( configUSE_GREEN_THREADS == 1 )
+
+/*
+ * The registers of a task that is not running.  On x86-64 the callee saved
+ * registers are pushed onto the task's own stack, so only the stack pointer
+ * is held here.
+ */
+    #if defined( __x86_64__ )
+        typedef void * Context_t;
+    #else
+        typedef ucontext_t Context_t;
+    #endif
+#endif
 
 typedef struct THREAD
 {
-    pthread_t pthread;
+    #if ( configUSE_GREEN_THREADS == 1 )
+        Context_t xContext;
+    #else
+        pthread_t pthread;
+        struct event * ev;
+    #endif
     pdTASK_CODE pxCode;
     void * pvParams;
     BaseType_t xDying;
-    struct event * ev;
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xCoreID;
+    #endif
 } Thread_t;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * A lock held by a core.  It can be taken recursively by the core that
+ * holds it.
+ */
+    typedef struct SPIN_LOCK
+    {
+        BaseType_t xOwnerCoreID;
+        UBaseType_t uxRecursionCount;
+    } SpinLock_t;
+
+    #define portSPIN_LOCK_UNOWNED    ( ( BaseType_t ) -1 )
+#endif
+
 /*
  * The additional per-thread data is stored at the beginning of the
  * task's stack.
@@ -96,22 +164,74 @@ static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
 static sigset_t xAllSignals;
 static sigset_t xSchedulerOriginalSignalMask;
 static pthread_t hMainThread = ( pthread_t ) NULL;
-static volatile portBASE_TYPE uxCriticalNesting;
+
+#if ( configNUMBER_OF_CORES == 1 )
+    static volatile portBASE_TYPE uxCriticalNesting;
+#else
+
+/* A thread only runs on one core at a time, so the critical nesting
+ * count and ID of the core the calling thread is running on are held
+ * per thread. */
+    static __thread portBASE_TYPE uxCriticalNesting;
+    static __thread BaseType_t xCurrentCoreID;
+
+    static SpinLock_t xTaskLock = { portSPIN_LOCK_UNOWNED, 0 };
+    static SpinLock_t xISRLock = { portSPIN_LOCK_UNOWNED, 0 };
+
+/* The number of cores that have stopped running tasks since the
+ * scheduler was ended. */
+    static BaseType_t xCoresStopped = 0;
+#endif
 /*-----------------------------------------------------------*/
 
 static portBASE_TYPE xSchedulerEnd = pdFALSE;
+
+#if ( configUSE_GREEN_THREADS == 1 )
+    /* Context of the thread that started the scheduler, returned to when
+     * the scheduler is ended. */
+    static Context_t xSchedulerContext;
+#endif
+
+#if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+
+/* Only the thread of the running task handles signals, so a single flag
+ * masks interrupts.  Every task switch is made with interrupts masked,
+ * so the flag does not need saving with the task. */
+    static volatile BaseType_t xInterruptsMasked = pdTRUE;
+
+/* Set when a tick arrives while interrupts are masked. */
+    static volatile BaseType_t xTickPending = pdFALSE;
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void );
-static void prvSetupTimerInterrupt( void );
-static void * prvWaitForStart( void * pvParams );
+#if ( configUSE_VIRTUAL_TIME == 0 )
+    static void prvSetupTimerInterrupt( void );
+#endif
 static void prvSwitchThread( Thread_t * xThreadToResume,
                              Thread_t * xThreadToSuspend );
-static void prvSuspendSelf( Thread_t * thread );
-static void prvResumeThread( Thread_t * xThreadId );
+#if ( configUSE_GREEN_THREADS == 1 )
+    static void prvInitialiseContext( Context_t * pxContext,
+                                      portSTACK_TYPE * pxTopOfStack,
+                                      portSTACK_TYPE * pxEndOfStack );
+    static void prvSwitchContext( Context_t * pxContextToSave,
+                                  Context_t * pxContextToRestore );
+    static void prvTaskEntry( void );
+#else
+    static void * prvWaitForStart( void * pvParams );
+    static void prvSuspendSelf( Thread_t * thread );
+    static void prvResumeThread( Thread_t * xThreadId );
+#endif
 static void vPortSystemTickHandler( int sig );
 static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
+#if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+    static void prvRunPendingTick( void );
+#endif
+#if ( configNUMBER_OF_CORES > 1 )
+    static void prvYieldCoreHandler( int sig );
+    static void prvStopCore( Thread_t * pxThread );
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvFatalError( const char * pcCall,
@@ -124,6 +244,35 @@ static void prvFatalError( const char * pcCall,
 /*
  * See header file for description.
  */
+#if ( configUSE_GREEN_THREADS == 1 )
+
+portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
+                                        portSTACK_TYPE * pxEndOfStack,
+                                        pdTASK_CODE pxCode,
+                                        void * pvParameters )
+{
+    Thread_t * thread;
+
+    ( void ) pthread_once( &hSigSetupThread, prvSetupSignalsAndSchedulerPolicy );
+
+    /*
+     * Store the additional thread data at the start of the stack.  The
+     * task runs on the rest of the stack.
+     */
+    thread = ( Thread_t * ) ( pxTopOfStack + 1 ) - 1;
+    pxTopOfStack = ( portSTACK_TYPE * ) thread - 1;
+
+    thread->pxCode = pxCode;
+    thread->pvParams = pvParameters;
+    thread->xDying = pdFALSE;
+
+    prvInitialiseContext( &( thread->xContext ), pxTopOfStack, pxEndOfStack );
+
+    return pxTopOfStack;
+}
+
+#else /* configUSE_GREEN_THREADS */
+
 portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
                                         portSTACK_TYPE * pxEndOfStack,
                                         pdTASK_CODE pxCode,
@@ -155,10 +304,12 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
         fprintf( stderr, "[WARN] Increase the stack size to PTHREAD_STACK_MIN.\n" );
     }
 
-    thread->ev = event_create();
-
+    /* The C library takes locks internally, so the thread must not be
+     * switched out while creating the new thread. */
     vPortEnterCritical();
 
+    thread->ev = event_create();
+
     iRet = pthread_create( &thread->pthread, &xThreadAttributes,
                            prvWaitForStart, thread );
 
@@ -171,14 +322,41 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
 
     return pxTopOfStack;
 }
+
+#endif /* configUSE_GREEN_THREADS */
 /*-----------------------------------------------------------*/
 
 void vPortStartFirstTask( void )
 {
-    Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    #if ( configUSE_GREEN_THREADS == 1 )
+    {
+        Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        /* Run the first task on this thread.  This returns when the
+         * scheduler is ended. */
+        prvSwitchContext( &xSchedulerContext, &( pxFirstThread->xContext ) );
+    }
+    #elif ( configNUMBER_OF_CORES == 1 )
+    {
+        Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        /* Start the first task. */
+        prvResumeThread( pxFirstThread );
+    }
+    #else
+    {
+        Thread_t * pxFirstThread;
+        BaseType_t xCoreID;
 
-    /* Start the first task. */
-    prvResumeThread( pxFirstThread );
+        /* Start the first task on each core. */
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+            pxFirstThread->xCoreID = xCoreID;
+            prvResumeThread( pxFirstThread );
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -187,36 +365,73 @@ void vPortStartFirstTask( void )
  */
 portBASE_TYPE xPortStartScheduler( void )
 {
-    int iSignal;
-    sigset_t xSignals;
-
     hMainThread = pthread_self();
 
     /* Start the timer that generates the tick ISR(SIGALRM).
-     * Interrupts are disabled here already. */
-    prvSetupTimerInterrupt();
+     * Interrupts are disabled here already.  With virtual time there is no
+     * tick, the idle task moves time forward instead. */
+    #if ( configUSE_VIRTUAL_TIME == 0 )
+        prvSetupTimerInterrupt();
+    #endif
 
-    /*
-     * Block SIG_RESUME before starting any tasks so the main thread can sigwait on it.
-     * To sigwait on an unblocked signal is undefined.
-     * https://pubs.opengroup.org/onlinepubs/009604499/functions/sigwait.html
-     */
-    sigemptyset( &xSignals );
-    sigaddset( &xSignals, SIG_RESUME );
-    ( void ) pthread_sigmask( SIG_BLOCK, &xSignals, NULL );
+    #if ( configUSE_GREEN_THREADS == 1 )
+    {
+        /* The tasks run on this thread, so it handles the tick.  Interrupts
+         * are still masked by the flag until the first task starts. */
+        ( void ) pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+
+        vPortStartFirstTask();
+    }
+    #else /* configUSE_GREEN_THREADS */
+    {
+        int iSignal;
+        sigset_t xSignals;
+
+        /*
+         * Block SIG_RESUME before starting any tasks so the main thread can sigwait on it.
+         * To sigwait on an unblocked signal is undefined.
+         * https://pubs.opengroup.org/onlinepubs/009604499/functions/sigwait.html
+         */
+        sigemptyset( &xSignals );
+        sigaddset( &xSignals, SIG_RESUME );
+        ( void ) pthread_sigmask( SIG_BLOCK, &xSignals, NULL );
 
-    /* Start the first task. */
-    vPortStartFirstTask();
+        /* Start the first task. */
+        vPortStartFirstTask();
 
-    /* Wait until signaled by vPortEndScheduler(). */
-    while( xSchedulerEnd != pdTRUE )
+        /* Wait until signaled by vPortEndScheduler(). */
+        while( xSchedulerEnd != pdTRUE )
+        {
+            sigwait( &xSignals, &iSignal );
+        }
+    }
+    #endif /* configUSE_GREEN_THREADS */
+
+    #if ( configNUMBER_OF_CORES > 1 )
     {
-        sigwait( &xSignals, &iSignal );
+        /* The threads cannot be cancelled while any core is still switching
+         * between them. */
+        while( __atomic_load_n( &xCoresStopped, __ATOMIC_ACQUIRE ) < ( BaseType_t ) configNUMBER_OF_CORES )
+        {
+            ( void ) sched_yield();
+        }
     }
+    #endif
 
     /* Cancel the Idle task and free its resources */
     #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
-        vPortCancelThread( xTaskGetIdleTaskHandle() );
+        #if ( configNUMBER_OF_CORES == 1 )
+            vPortCancelThread( xTaskGetIdleTaskHandle() );
+        #else
+        {
+            BaseType_t xCoreID;
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                vPortCancelThread( xTaskGetIdleTaskHandleForCore( xCoreID ) );
+            }
+        }
+        #endif
     #endif
 
     #if ( configUSE_TIMERS == 1 )
@@ -253,10 +468,55 @@ void vPortEndScheduler( void )
 
     /* Signal the scheduler to exit its loop. */
     xSchedulerEnd = pdTRUE;
-    ( void ) pthread_kill( hMainThread, SIG_RESUME );
 
     xCurrentThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
-    prvSuspendSelf( xCurrentThread );
+
+    #if ( configUSE_GREEN_THREADS == 1 )
+    {
+        /* Return to the thread that started the scheduler.  The task is
+         * never switched back to. */
+        prvSwitchContext( &( xCurrentThread->xContext ), &xSchedulerContext );
+    }
+    #else /* configUSE_GREEN_THREADS */
+    {
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            BaseType_t xCoreID;
+
+            /* The other cores stop running tasks when they next handle
+             * SIG_YIELD_CORE.  The kernel locks are held so that no core can
+             * switch to another task, whose thread would then not be signalled,
+             * while the signals are sent. */
+            vPortGetTaskLock();
+            vPortGetISRLock();
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                if( xCoreID != xCurrentCoreID )
+                {
+                    vPortYieldCore( xCoreID );
+                }
+            }
+
+            vPortReleaseISRLock();
+            vPortReleaseTaskLock();
+        }
+        #endif
+
+        ( void ) pthread_kill( hMainThread, SIG_RESUME );
+
+        #if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+            /* A suspended thread must not handle signals. */
+            ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+        #endif
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            prvSuspendSelf( xCurrentThread );
+        #else
+            prvStopCore( xCurrentThread );
+        #endif
+    }
+    #endif /* configUSE_GREEN_THREADS */
 }
 /*-----------------------------------------------------------*/
 
@@ -265,6 +525,7 @@ void vPortEnterCritical( void )
     if( uxCriticalNesting == 0 )
     {
         vPortDisableInterrupts();
+        traceCRITICAL_SECTION_ENTERED();
     }
 
     uxCriticalNesting++;
@@ -278,6 +539,7 @@ void vPortExitCritical( void )
     /* If we have reached 0 then re-enable the interrupts. */
     if( uxCriticalNesting == 0 )
     {
+        traceCRITICAL_SECTION_EXITED();
         vPortEnableInterrupts();
     }
 }
@@ -290,7 +552,11 @@ static void prvPortYieldFromISR( void )
 
     xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-    vTaskSwitchContext();
+    #if ( configNUMBER_OF_CORES == 1 )
+        vTaskSwitchContext();
+    #else
+        vTaskSwitchContext( xCurrentCoreID );
+    #endif
 
     xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
@@ -300,40 +566,238 @@ static void prvPortYieldFromISR( void )
 
 void vPortYield( void )
 {
-    vPortEnterCritical();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        vPortEnterCritical();
 
-    prvPortYieldFromISR();
+        prvPortYieldFromISR();
 
-    vPortExitCritical();
+        vPortExitCritical();
+    }
+    #else
+    {
+        sigset_t xOriginalSignals;
+
+        /* The critical nesting count belongs to the kernel, so signals are
+         * blocked directly.  The calling thread's signal mask is restored
+         * when it is next switched in. */
+        ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xOriginalSignals );
+
+        prvPortYieldFromISR();
+
+        ( void ) pthread_sigmask( SIG_SETMASK, &xOriginalSignals, NULL );
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
-void vPortDisableInterrupts( void )
-{
-    pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
-}
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vPortYieldCore( BaseType_t xCoreID )
+    {
+        Thread_t * pxThread;
+
+        /* Called with the kernel locks held, so the task running on the
+         * core cannot change.  If its thread has not yet been resumed the
+         * signal is held pending until it is. */
+        pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+
+        ( void ) pthread_kill( pxThread->pthread, SIG_YIELD_CORE );
+    }
 /*-----------------------------------------------------------*/
 
-void vPortEnableInterrupts( void )
-{
-    pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
-}
+    static void prvYieldCoreHandler( int sig )
+    {
+        ( void ) sig;
+
+        if( xSchedulerEnd != pdFALSE )
+        {
+            prvStopCore( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ) );
+        }
+        else
+        {
+            prvPortYieldFromISR();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStopCore( Thread_t * pxThread )
+    {
+        /* The scheduler has been ended, so this core stops running tasks.
+         * The thread is never resumed. */
+        ( void ) __atomic_add_fetch( &xCoresStopped, 1, __ATOMIC_RELEASE );
+
+        prvSuspendSelf( pxThread );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPortGetCoreID( void )
+    {
+        return xCurrentCoreID;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetCriticalNesting( void )
+    {
+        return ( UBaseType_t ) uxCriticalNesting;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortSetCriticalNesting( UBaseType_t uxNewCriticalNesting )
+    {
+        uxCriticalNesting = ( portBASE_TYPE ) uxNewCriticalNesting;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSpinLockGet( SpinLock_t * pxLock )
+    {
+        BaseType_t xUnowned;
+
+        if( __atomic_load_n( &( pxLock->xOwnerCoreID ), __ATOMIC_RELAXED ) == xCurrentCoreID )
+        {
+            pxLock->uxRecursionCount++;
+        }
+        else
+        {
+            for( ; ; )
+            {
+                xUnowned = portSPIN_LOCK_UNOWNED;
+
+                if( __atomic_compare_exchange_n( &( pxLock->xOwnerCoreID ), &xUnowned, xCurrentCoreID,
+                                                 pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+                {
+                    break;
+                }
+
+                /* Let the thread of the core that holds the lock run. */
+                ( void ) sched_yield();
+            }
+
+            pxLock->uxRecursionCount = 1;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSpinLockRelease( SpinLock_t * pxLock )
+    {
+        pxLock->uxRecursionCount--;
+
+        if( pxLock->uxRecursionCount == 0 )
+        {
+            __atomic_store_n( &( pxLock->xOwnerCoreID ), portSPIN_LOCK_UNOWNED, __ATOMIC_RELEASE );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetTaskLock( void )
+    {
+        prvSpinLockGet( &xTaskLock );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortReleaseTaskLock( void )
+    {
+        prvSpinLockRelease( &xTaskLock );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetISRLock( void )
+    {
+        prvSpinLockGet( &xISRLock );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortReleaseISRLock( void )
+    {
+        prvSpinLockRelease( &xISRLock );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configNUMBER_OF_CORES */
+
+#if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+
+    void vPortDisableInterrupts( void )
+    {
+        xInterruptsMasked = pdTRUE;
+        portMEMORY_BARRIER();
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortEnableInterrupts( void )
+    {
+        portMEMORY_BARRIER();
+        xInterruptsMasked = pdFALSE;
+        portMEMORY_BARRIER();
+
+        tracePORT_INTERRUPTS_UNMASKED();
+
+        /* Run any tick that arrived while interrupts were masked.  Another
+         * tick can arrive while it is being run. */
+        while( xTickPending != pdFALSE )
+        {
+            prvRunPendingTick();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_SOFTWARE_INTERRUPT_MASK */
+
+    void vPortDisableInterrupts( void )
+    {
+        pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+    }
 /*-----------------------------------------------------------*/
 
+    void vPortEnableInterrupts( void )
+    {
+        pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_SOFTWARE_INTERRUPT_MASK */
+
 portBASE_TYPE xPortSetInterruptMask( void )
 {
-    /* Interrupts are always disabled inside ISRs (signals
-     * handlers). */
-    return pdTRUE;
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* Interrupts are always disabled inside ISRs (signals
+         * handlers). */
+        return pdTRUE;
+    }
+    #else
+    {
+        sigset_t xOriginalSignals;
+
+        /* The kernel also masks interrupts from tasks when more than one
+         * core is used, so return whether they were already masked. */
+        ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xOriginalSignals );
+
+        return ( sigismember( &xOriginalSignals, SIGALRM ) == 1 ) ? pdTRUE : pdFALSE;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
 void vPortClearInterruptMask( portBASE_TYPE xMask )
 {
-    ( void ) xMask;
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        ( void ) xMask;
+    }
+    #else
+    {
+        if( xMask == pdFALSE )
+        {
+            vPortEnableInterrupts();
+        }
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_VIRTUAL_TIME == 0 )
+
 static uint64_t prvGetTimeNs( void )
 {
     struct timespec t;
@@ -384,8 +848,229 @@ void prvSetupTimerInterrupt( void )
 
     prvStartTimeNs = prvGetTimeNs();
 }
+
+#endif /* configUSE_VIRTUAL_TIME */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+static uint64_t prvTimevalToNs( const struct timeval * pxTime )
+{
+    return ( ( uint64_t ) pxTime->tv_sec * 1000000000ULL ) + ( ( uint64_t ) pxTime->tv_usec * 1000ULL );
+}
+
+static void prvNsToTimeval( uint64_t ullNs,
+                            struct timeval * pxTime )
+{
+    pxTime->tv_sec = ( time_t ) ( ullNs / 1000000000ULL );
+    pxTime->tv_usec = ( suseconds_t ) ( ( ullNs % 1000000000ULL ) / 1000ULL );
+}
+
+/*
+ * Called by the idle task, with the scheduler suspended, when no task is
+ * expected to run for xExpectedIdleTime ticks.  The periodic tick is replaced
+ * by a single timer that expires when the next task is due to unblock, and the
+ * idle task's thread sleeps until then rather than taking a SIGALRM every
+ * tick.  Can be overridden by the application.
+ */
+__attribute__( ( weak ) ) void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+    const uint64_t ullTickPeriodNs = ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL;
+    struct itimerval xTimer;
+    struct itimerval xStoppedTimer;
+    sigset_t xTickSignal;
+    sigset_t xPendingSignals;
+    sigset_t xOriginalSignals;
+    uint64_t ullRemainingNs, ullSleptNs, ullStartNs;
+    TickType_t xCompleteTickPeriods;
+    eSleepModeStatus eSleepStatus;
+    int iSignal;
+
+    /* Keep the length of the sleep in nanoseconds well within range. */
+    if( xExpectedIdleTime > portMAX_SUPPRESSED_TICKS )
+    {
+        xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+    }
+
+    /* The tick is blocked as well as masked so the idle task can wait for
+     * it with sigwait() below, whichever way interrupts are masked. */
+    sigemptyset( &xTickSignal );
+    sigaddset( &xTickSignal, SIGALRM );
+
+    vPortEnterCritical();
+    ( void ) pthread_sigmask( SIG_BLOCK, &xTickSignal, &xOriginalSignals );
+
+    /* Stop the periodic timer, noting how long was left until the next
+     * tick.  The timer is restarted from the same point if sleep is
+     * abandoned, so no time is lost. */
+    memset( &xTimer, 0, sizeof( xTimer ) );
+    ( void ) setitimer( ITIMER_REAL, &xTimer, &xStoppedTimer );
+    ullStartNs = prvGetTimeNs();
+    ullRemainingNs = prvTimevalToNs( &( xStoppedTimer.it_value ) );
+
+    /* A tick that arrived before the timer was stopped has yet to be
+     * handled. */
+    ( void ) sigpending( &xPendingSignals );
+
+    eSleepStatus = eTaskConfirmSleepModeStatus();
+
+    #if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+        if( xTickPending != pdFALSE )
+        {
+            eSleepStatus = eAbortSleep;
+        }
+    #endif
+
+    if( ( sigismember( &xPendingSignals, SIGALRM ) == 1 ) || ( ullRemainingNs == 0ULL ) )
+    {
+        eSleepStatus = eAbortSleep;
+    }
+
+    if( eSleepStatus == eAbortSleep )
+    {
+        /* Restart the tick where it was stopped.  Any pending tick is
+         * handled when the critical section is exited. */
+        xStoppedTimer.it_interval.tv_sec = 0;
+        xStoppedTimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+
+        if( ullRemainingNs == 0ULL )
+        {
+            xStoppedTimer.it_value = xStoppedTimer.it_interval;
+        }
+
+        ( void ) setitimer( ITIMER_REAL, &xStoppedTimer, NULL );
+    }
+    else
+    {
+        configPRE_SLEEP_PROCESSING( xExpectedIdleTime );
+
+        if( xExpectedIdleTime > 0 )
+        {
+            /* Expire when the next task is due to unblock.  With no task
+             * waiting for a timeout the timer is still started, for the
+             * longest sleep allowed, as SIGALRM is the only signal that can
+             * end the sleep, and the tick hook must still be called. */
+            memset( &xTimer, 0, sizeof( xTimer ) );
+            prvNsToTimeval( ullRemainingNs + ( ( uint64_t ) ( xExpectedIdleTime - 1 ) * ullTickPeriodNs ), &( xTimer.it_value ) );
+            ( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+
+            ( void ) sigwait( &xTickSignal, &iSignal );
+        }
+
+        configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+        /* Work out how many whole tick periods passed while asleep and how
+         * far through the current tick period the sleep ended. */
+        ullSleptNs = prvGetTimeNs() - ullStartNs;
+
+        if( ullSleptNs >= ullRemainingNs )
+        {
+            ullSleptNs -= ullRemainingNs;
+            xCompleteTickPeriods = ( TickType_t ) ( 1U + ( ullSleptNs / ullTickPeriodNs ) );
+            ullRemainingNs = ullTickPeriodNs - ( ullSleptNs % ullTickPeriodNs );
+        }
+        else
+        {
+            xCompleteTickPeriods = 0;
+            ullRemainingNs -= ullSleptNs;
+        }
+
+        /* The kernel cannot be stepped beyond the time the next task is due
+         * to unblock. */
+        if( xCompleteTickPeriods > xExpectedIdleTime )
+        {
+            xCompleteTickPeriods = xExpectedIdleTime;
+        }
+
+        /* Restart the periodic tick in phase with the ticks that passed. */
+        xTimer.it_interval.tv_sec = 0;
+        xTimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+        prvNsToTimeval( ullRemainingNs, &( xTimer.it_value ) );
+
+        if( ( xTimer.it_value.tv_sec == 0 ) && ( xTimer.it_value.tv_usec == 0 ) )
+        {
+            xTimer.it_value = xTimer.it_interval;
+        }
+
+        ( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+
+        /* The tick that ended the sleep was taken by sigwait(), so raise it
+         * again and step the kernel over the ticks before it.  The raised
+         * tick runs once the tick is unmasked below, so, as for any other
+         * tick, it unblocks the task that was due and calls the tick hook. */
+        if( xCompleteTickPeriods > 0 )
+        {
+            vTaskStepTick( xCompleteTickPeriods - 1 );
+            ( void ) pthread_kill( pthread_self(), SIGALRM );
+        }
+    }
+
+    ( void ) pthread_sigmask( SIG_SETMASK, &xOriginalSignals, NULL );
+    vPortExitCritical();
+}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+#if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+
+static void vPortSystemTickHandler( int sig )
+{
+    ( void ) sig;
+
+    xTickPending = pdTRUE;
+
+    /* Inside a critical section the tick is left pending until the
+     * critical section is exited. */
+    if( xInterruptsMasked == pdFALSE )
+    {
+        prvRunPendingTick();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunPendingTick( void )
+{
+    Thread_t * pxThreadToSuspend;
+    Thread_t * pxThreadToResume;
+
+    xInterruptsMasked = pdTRUE;
+    portMEMORY_BARRIER();
+
+    /* The tick may already have been run by the signal handler if it
+     * interrupted vPortEnableInterrupts(). */
+    if( xTickPending != pdFALSE )
+    {
+        xTickPending = pdFALSE;
+
+        uxCriticalNesting++;
+
+        #if ( configUSE_PREEMPTION == 1 )
+            pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        #endif
+
+        xTaskIncrementTick();
+
+        #if ( configUSE_PREEMPTION == 1 )
+            /* Select Next Task. */
+            vTaskSwitchContext();
+
+            pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+            prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+        #endif
+
+        uxCriticalNesting--;
+    }
+
+    portMEMORY_BARRIER();
+    xInterruptsMasked = pdFALSE;
+}
+
+#else /* configUSE_SOFTWARE_INTERRUPT_MASK */
+
 static void vPortSystemTickHandler( int sig )
 {
     Thread_t * pxThreadToSuspend;
@@ -426,8 +1111,197 @@ static void vPortSystemTickHandler( int sig )
 
     uxCriticalNesting--;
 }
+
+#endif /* configUSE_SOFTWARE_INTERRUPT_MASK */
+
+#else /* configNUMBER_OF_CORES */
+
+static void vPortSystemTickHandler( int sig )
+{
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xSwitchRequired;
+
+    ( void ) sig;
+
+    /* The tick is handled on whichever core's thread receives SIGALRM.
+     * Other cores are made to reschedule by the kernel if required. */
+    uxSavedInterruptStatus = portENTER_CRITICAL_FROM_ISR();
+    {
+        xSwitchRequired = xTaskIncrementTick();
+    }
+    portEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    #if ( configUSE_PREEMPTION == 1 )
+        if( xSwitchRequired != pdFALSE )
+        {
+            prvPortYieldFromISR();
+        }
+    #else
+        ( void ) xSwitchRequired;
+    #endif
+}
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_GREEN_THREADS == 1 )
+
+void vPortThreadDying( void * pxTaskToDelete,
+                       volatile BaseType_t * pxPendYield )
+{
+    /* A task that deletes itself is simply never switched back to. */
+    ( void ) pxTaskToDelete;
+    ( void ) pxPendYield;
+}
+
+void vPortCancelThread( void * pxTaskToDelete )
+{
+    /* There is no thread to cancel.  The task's stack is freed by the
+     * kernel. */
+    ( void ) pxTaskToDelete;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( void )
+{
+    Thread_t * pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    /* Switched to for the first time, with interrupts masked. */
+    uxCriticalNesting = 0;
+    vPortEnableInterrupts();
+
+    /* Call the task's entry point. */
+    pxThread->pxCode( pxThread->pvParams );
+
+    /* A function that implements a task must not exit or attempt to return to
+     * its caller as there is nothing to return to. If a task wants to exit it
+     * should instead call vTaskDelete( NULL ). Artificially force an assert()
+     * to be triggered if configASSERT() is defined, so application writers can
+     * catch the error. */
+    configASSERT( pdFALSE );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t * pxThreadToResume,
+                             Thread_t * pxThreadToSuspend )
+{
+    BaseType_t uxSavedCriticalNesting;
+
+    if( pxThreadToSuspend != pxThreadToResume )
+    {
+        /* The critical section nesting is per-task, so save it on the
+         * stack of the task being switched out. */
+        uxSavedCriticalNesting = uxCriticalNesting;
+
+        prvSwitchContext( &( pxThreadToSuspend->xContext ), &( pxThreadToResume->xContext ) );
+
+        uxCriticalNesting = uxSavedCriticalNesting;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if defined( __x86_64__ )
+
+/*
+ * Pushes the callee saved registers onto the current stack, saves the stack
+ * pointer to *ppvStackPointerToSave, then loads pvStackPointerToRestore and
+ * pops the registers saved there.  Returns to wherever the task being
+ * restored called this from.
+ */
+static void __attribute__( ( naked, noinline ) ) prvSwitchStack( void ** ppvStackPointerToSave,
+                                                                 void * pvStackPointerToRestore )
+{
+    ( void ) ppvStackPointerToSave;
+    ( void ) pvStackPointerToRestore;
+
+    __asm volatile (
+        "    pushq %rbp              \n"
+        "    pushq %rbx              \n"
+        "    pushq %r12              \n"
+        "    pushq %r13              \n"
+        "    pushq %r14              \n"
+        "    pushq %r15              \n"
+        "    movq  %rsp, (%rdi)      \n"
+        "    movq  %rsi, %rsp        \n"
+        "    popq  %r15              \n"
+        "    popq  %r14              \n"
+        "    popq  %r13              \n"
+        "    popq  %r12              \n"
+        "    popq  %rbx              \n"
+        "    popq  %rbp              \n"
+        "    ret                     \n"
+        );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseContext( Context_t * pxContext,
+                                  portSTACK_TYPE * pxTopOfStack,
+                                  portSTACK_TYPE * pxEndOfStack )
+{
+    portSTACK_TYPE * pxStack;
+
+    ( void ) pxEndOfStack;
+
+    /* Build the frame prvSwitchStack() restores: zeroed callee saved
+     * registers and a return address of prvTaskEntry(), above which is a
+     * null return address for prvTaskEntry() itself.  The stack is 16 byte
+     * aligned at the call, as the ABI requires. */
+    pxStack = ( portSTACK_TYPE * ) ( ( ( uintptr_t ) ( pxTopOfStack + 1 ) ) & ~( ( uintptr_t ) 15U ) );
+
+    *( --pxStack ) = 0;
+    *( --pxStack ) = ( portSTACK_TYPE ) prvTaskEntry;
+    pxStack -= 6;
+    memset( pxStack, 0, 6 * sizeof( portSTACK_TYPE ) );
+
+    *pxContext = pxStack;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( Context_t * pxContextToSave,
+                              Context_t * pxContextToRestore )
+{
+    prvSwitchStack( pxContextToSave, *pxContextToRestore );
+}
+
+#else /* __x86_64__ */
+
+static void prvInitialiseContext( Context_t * pxContext,
+                                  portSTACK_TYPE * pxTopOfStack,
+                                  portSTACK_TYPE * pxEndOfStack )
+{
+    if( getcontext( pxContext ) == -1 )
+    {
+        prvFatalError( "getcontext", errno );
+    }
+
+    pxContext->uc_stack.ss_sp = pxEndOfStack;
+    pxContext->uc_stack.ss_size = ( size_t ) ( pxTopOfStack + 1 - pxEndOfStack ) * sizeof( *pxTopOfStack );
+    pxContext->uc_link = NULL;
+
+    /* Signals are never blocked while tasks run. */
+    sigemptyset( &( pxContext->uc_sigmask ) );
+
+    makecontext( pxContext, prvTaskEntry, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( Context_t * pxContextToSave,
+                              Context_t * pxContextToRestore )
+{
+    if( swapcontext( pxContextToSave, pxContextToRestore ) == -1 )
+    {
+        prvFatalError( "swapcontext", errno );
+    }
+}
+
+#endif /* __x86_64__ */
+
+#else /* configUSE_GREEN_THREADS */
+
 void vPortThreadDying( void * pxTaskToDelete,
                        volatile BaseType_t * pxPendYield )
 {
@@ -444,10 +1318,16 @@ void vPortCancelThread( void * pxTaskToDelete )
 
     /*
      * The thread has already been suspended so it can be safely cancelled.
+     * As when it was created, the calling thread must not be switched out
+     * while inside the C library.
      */
+    vPortEnterCritical();
+
     pthread_cancel( pxThreadToCancel->pthread );
     pthread_join( pxThreadToCancel->pthread, NULL );
     event_delete( pxThreadToCancel->ev );
+
+    vPortExitCritical();
 }
 /*-----------------------------------------------------------*/
 
@@ -457,10 +1337,27 @@ static void * prvWaitForStart( void * pvParams )
 
     prvSuspendSelf( pxThread );
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        xCurrentCoreID = pxThread->xCoreID;
+
+        /* As in prvSwitchThread(), the task is not started if the
+         * scheduler was ended while its thread was being resumed. */
+        if( xSchedulerEnd != pdFALSE )
+        {
+            prvStopCore( pxThread );
+        }
+    }
+    #endif
+
     /* Resumed for the first time, unblocks all signals. */
     uxCriticalNesting = 0;
     vPortEnableInterrupts();
 
+    #if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+        ( void ) pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+    #endif
+
     /* Call the task's entry point. */
     pxThread->pxCode( pxThread->pvParams );
 
@@ -480,6 +1377,10 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
 {
     BaseType_t uxSavedCriticalNesting;
 
+    #if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+        sigset_t xOriginalSignals;
+    #endif
+
     if( pxThreadToSuspend != pxThreadToResume )
     {
         /*
@@ -491,16 +1392,53 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
          */
         uxSavedCriticalNesting = uxCriticalNesting;
 
+        /* The thread being resumed takes over the core from this
+         * thread, which learns the core it is next to run on when it is
+         * itself resumed. */
+        #if ( configNUMBER_OF_CORES > 1 )
+            pxThreadToResume->xCoreID = xCurrentCoreID;
+        #endif
+
+        /* Interrupts are only masked by a flag, so this thread must block
+         * signals itself before the thread being resumed can handle them. */
+        #if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+            ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xOriginalSignals );
+        #endif
+
         prvResumeThread( pxThreadToResume );
 
-        if( pxThreadToSuspend->xDying == pdTRUE )
-        {
-            pthread_exit( NULL );
-        }
+        /* With more than one core the task can be selected by another
+         * core, and then deleted while running there, before its thread
+         * gets here.  The thread instead waits to be cancelled when the
+         * deleted task is cleaned up. */
+        #if ( configNUMBER_OF_CORES == 1 )
+            if( pxThreadToSuspend->xDying == pdTRUE )
+            {
+                pthread_exit( NULL );
+            }
+        #endif
 
         prvSuspendSelf( pxThreadToSuspend );
 
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            xCurrentCoreID = pxThreadToSuspend->xCoreID;
+
+            /* A core that switched task while vPortEndScheduler() was
+             * signalling the cores may have passed SIG_YIELD_CORE on to the
+             * thread it resumed, so that thread stops here instead. */
+            if( xSchedulerEnd != pdFALSE )
+            {
+                prvStopCore( pxThreadToSuspend );
+            }
+        }
+        #endif
+
         uxCriticalNesting = uxSavedCriticalNesting;
+
+        #if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+            ( void ) pthread_sigmask( SIG_SETMASK, &xOriginalSignals, NULL );
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -532,6 +1470,8 @@ static void prvResumeThread( Thread_t * xThreadId )
         event_signal( xThreadId->ev );
     }
 }
+
+#endif /* configUSE_GREEN_THREADS */
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void )
@@ -559,9 +1499,22 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
                               &xAllSignals,
                               &xSchedulerOriginalSignalMask );
 
-    sigtick.sa_flags = 0;
+    #if ( configUSE_GREEN_THREADS == 1 )
+    {
+        /* The handler can switch to another task, which may run for a long
+         * time before the handler returns, so the tick is not blocked while
+         * the handler runs.  The interrupt mask flag defers a tick that
+         * arrives while a tick is being handled. */
+        sigtick.sa_flags = SA_NODEFER;
+        sigemptyset( &sigtick.sa_mask );
+    }
+    #else
+    {
+        sigtick.sa_flags = 0;
+        sigfillset( &sigtick.sa_mask );
+    }
+    #endif
     sigtick.sa_handler = vPortSystemTickHandler;
-    sigfillset( &sigtick.sa_mask );
 
     iRet = sigaction( SIGALRM, &sigtick, NULL );
 
@@ -569,6 +1522,23 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
     {
         prvFatalError( "sigaction", errno );
     }
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        struct sigaction sigyield;
+
+        sigyield.sa_flags = 0;
+        sigyield.sa_handler = prvYieldCoreHandler;
+        sigfillset( &sigyield.sa_mask );
+
+        iRet = sigaction( SIG_YIELD_CORE, &sigyield, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
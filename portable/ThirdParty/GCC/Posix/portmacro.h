@@ -84,7 +84,58 @@ extern void vPortYield( void );
 #define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
 /*-----------------------------------------------------------*/
 
+/* Set configUSE_FUTEX_EVENTS to 1 in FreeRTOSConfig.h to suspend and resume
+ * the threads of tasks with a futex each, rather than with a mutex and
+ * condition variable each, which makes context switches cheaper.  Linux
+ * only. */
+#ifndef configUSE_FUTEX_EVENTS
+	#define configUSE_FUTEX_EVENTS	0
+#endif
+
+#if ( ( configUSE_FUTEX_EVENTS == 1 ) && !defined( __linux__ ) )
+	#error configUSE_FUTEX_EVENTS can only be used on Linux.
+#endif
+
+/* Set configUSE_GREEN_THREADS to 1 in FreeRTOSConfig.h to run every task on
+ * the thread that starts the scheduler, switching between tasks without
+ * going through the host's scheduler.  Each task runs on the stack the kernel
+ * allocates for it, so many more tasks can be created, but their stacks must
+ * be large enough to also hold the frame of the tick signal handler.  Single
+ * core only. */
+#ifndef configUSE_GREEN_THREADS
+	#define configUSE_GREEN_THREADS	0
+#endif
+
+#if ( ( configUSE_GREEN_THREADS == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+	#error configUSE_GREEN_THREADS can only be used when configNUMBER_OF_CORES is 1.
+#endif
+/*-----------------------------------------------------------*/
+
 /* Critical section management. */
+
+/* Set configUSE_SOFTWARE_INTERRUPT_MASK to 1 in FreeRTOSConfig.h to mask
+ * interrupts with a flag rather than the thread's signal mask, so entering
+ * and exiting a critical section does not need a system call.  Green threads
+ * always mask interrupts with the flag. */
+#ifndef configUSE_SOFTWARE_INTERRUPT_MASK
+	#define configUSE_SOFTWARE_INTERRUPT_MASK	configUSE_GREEN_THREADS
+#endif
+
+#if ( ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+	#error configUSE_SOFTWARE_INTERRUPT_MASK can only be used when configNUMBER_OF_CORES is 1.
+#endif
+
+#if ( ( configUSE_GREEN_THREADS == 1 ) && ( configUSE_SOFTWARE_INTERRUPT_MASK == 0 ) )
+	#error configUSE_SOFTWARE_INTERRUPT_MASK must be 1 when configUSE_GREEN_THREADS is 1.
+#endif
+
+/* Called when a flag that masked interrupts has been cleared, before any tick
+ * that arrived while it was set is run, so a test can make a tick arrive
+ * there. */
+#ifndef tracePORT_INTERRUPTS_UNMASKED
+	#define tracePORT_INTERRUPTS_UNMASKED()
+#endif
+
 extern void vPortDisableInterrupts( void );
 extern void vPortEnableInterrupts( void );
 #define portSET_INTERRUPT_MASK()        ( vPortDisableInterrupts() )
@@ -99,9 +150,49 @@ extern void vPortExitCritical( void );
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
 #define portDISABLE_INTERRUPTS()				portSET_INTERRUPT_MASK()
 #define portENABLE_INTERRUPTS()					portCLEAR_INTERRUPT_MASK()
-#define portENTER_CRITICAL()					vPortEnterCritical()
-#define portEXIT_CRITICAL()						vPortExitCritical()
 
+#if ( configNUMBER_OF_CORES == 1 )
+	#define portENTER_CRITICAL()				vPortEnterCritical()
+	#define portEXIT_CRITICAL()					vPortExitCritical()
+#else
+	/* The kernel implements the critical sections as it owns the locks. */
+	extern void vTaskEnterCritical( void );
+	extern void vTaskExitCritical( void );
+	extern UBaseType_t vTaskEnterCriticalFromISR( void );
+	extern void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
+	#define portENTER_CRITICAL()				vTaskEnterCritical()
+	#define portEXIT_CRITICAL()					vTaskExitCritical()
+	#define portENTER_CRITICAL_FROM_ISR()		vTaskEnterCriticalFromISR()
+	#define portEXIT_CRITICAL_FROM_ISR( x )		vTaskExitCriticalFromISR( x )
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* Multi-core (SMP) support.  Each core is simulated by the threads of
+ * the tasks it runs. */
+extern BaseType_t xPortGetCoreID( void );
+extern void vPortYieldCore( BaseType_t xCoreID );
+#define portGET_CORE_ID()						xPortGetCoreID()
+#define portYIELD_CORE( xCoreID )				vPortYieldCore( xCoreID )
+
+extern void vPortGetTaskLock( void );
+extern void vPortReleaseTaskLock( void );
+extern void vPortGetISRLock( void );
+extern void vPortReleaseISRLock( void );
+#define portGET_TASK_LOCK()						vPortGetTaskLock()
+#define portRELEASE_TASK_LOCK()					vPortReleaseTaskLock()
+#define portGET_ISR_LOCK()						vPortGetISRLock()
+#define portRELEASE_ISR_LOCK()					vPortReleaseISRLock()
+
+extern UBaseType_t uxPortGetCriticalNesting( void );
+extern void vPortSetCriticalNesting( UBaseType_t uxNewCriticalNesting );
+#define portGET_CRITICAL_NESTING_COUNT()		uxPortGetCriticalNesting()
+#define portINCREMENT_CRITICAL_NESTING_COUNT()	vPortSetCriticalNesting( uxPortGetCriticalNesting() + 1U )
+#define portDECREMENT_CRITICAL_NESTING_COUNT()	vPortSetCriticalNesting( uxPortGetCriticalNesting() - 1U )
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 extern void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield );
@@ -114,6 +205,13 @@ extern void vPortCancelThread( void *pxTaskToDelete );
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
 /*-----------------------------------------------------------*/
 
+/* Tickless idle/low power functionality. */
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+/*-----------------------------------------------------------*/
+
 /*
  * Tasks run in their own pthreads and context switches between them
  * are always a full memory barrier. ISRs are emulated as signals
@@ -0,0 +1,207 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+* Kernel configuration for the Posix port kernel tests.  Any of the settings
+* guarded by #ifndef can be overridden from the compiler command line, which is
+* how the Makefile builds the tests once for each kernel variant.
+*----------------------------------------------------------*/
+
+#include <limits.h>
+
+#define configUSE_PREEMPTION                    1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     1
+#define configTICK_RATE_HZ                      1000
+#define configMINIMAL_STACK_SIZE                ( ( unsigned short ) PTHREAD_STACK_MIN )
+#define configTOTAL_HEAP_SIZE                   ( ( size_t ) ( 8 * 1024 * 1024 ) )
+#define configMAX_TASK_NAME_LEN                 12
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_MUTEXES                       1
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   2
+#define configQUEUE_REGISTRY_SIZE               8
+#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configUSE_MALLOC_FAILED_HOOK            0
+#define configUSE_CO_ROUTINES                   0
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configUSE_PRIORITY_QUEUES               1
+#define configUSE_MULTI_WAIT                    1
+#define configUSE_QUEUE_ZERO_COPY               1
+#define configUSE_QUEUE_SETS                    1
+#define configGENERATE_QUEUE_STATS              1
+
+/* Tasks waiting for event group bits are spread over four lists, so the bits
+ * the event group tests wait for share the lists in turn. */
+#define configEVENT_GROUP_WAITER_BUCKETS        4
+
+/* Priority queues start their sequence count just before it wraps, so the
+ * order of items of equal priority is tested across the wrap.  UBaseType_t is
+ * not defined yet, but is only used where this is expanded. */
+#define configPRIORITY_QUEUE_INITIAL_SEQUENCE   ( ( UBaseType_t ) 0 - ( UBaseType_t ) 20 )
+
+/* The bitmap variants select the highest priority ready task from a two level
+ * bitmap spanning several 32 bit words, both with the compiler's count leading
+ * zeros builtin and with the portable C version. */
+#ifndef configMAX_PRIORITIES
+    #define configMAX_PRIORITIES                8
+#endif
+#ifndef configUSE_READY_PRIORITY_BITMAP
+    #define configUSE_READY_PRIORITY_BITMAP     0
+#endif
+
+/* The smp variant runs the tests on more than one core, where a task can be
+ * restricted to a set of cores. */
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES               1
+#endif
+#ifndef configUSE_CORE_AFFINITY
+    #define configUSE_CORE_AFFINITY             0
+#endif
+
+#ifndef configUSE_DELAYED_TASK_WHEEL
+    #define configUSE_DELAYED_TASK_WHEEL        0
+#endif
+
+/* In the EDF variant the tasks at configEDF_PRIORITY are selected earliest
+ * deadline first.  The band is above the tasks the other tests delay and below
+ * the timer task. */
+#ifndef configUSE_EDF_SCHEDULING
+    #define configUSE_EDF_SCHEDULING            0
+#endif
+#define configEDF_PRIORITY                      3
+
+/* In the tickless variant the idle task sleeps for no more than
+ * portMAX_SUPPRESSED_TICKS ticks at a time, so a sleep with no task waiting
+ * for a timeout still ends within the time a test waits. */
+#ifndef configUSE_TICKLESS_IDLE
+    #define configUSE_TICKLESS_IDLE             0
+#endif
+#define portMAX_SUPPRESSED_TICKS                ( ( TickType_t ) 20 )
+
+/* In the direct_isr variant interrupts set event group bits themselves, and
+ * pass a set that would look at more than two waiting tasks to the timer
+ * task. */
+#ifndef configUSE_EVENT_GROUP_DIRECT_ISR_SET
+    #define configUSE_EVENT_GROUP_DIRECT_ISR_SET    0
+#endif
+#define configEVENT_GROUP_ISR_MAX_WAITERS       2
+
+/* Each task keeps a histogram of the time it waits to run once made ready.
+ * The run time counter is the tick count, so a test can make a task wait a
+ * known number of ticks.  xTickCount is only visible where this is
+ * expanded. */
+#define configGENERATE_RUN_TIME_STATS           1
+#define configUSE_WAKE_LATENCY_HISTOGRAMS       1
+#define portALT_GET_RUN_TIME_COUNTER_VALUE( ulCountValue )    ( ulCountValue ) = ( configRUN_TIME_COUNTER_TYPE ) xTickCount
+
+/* The tick count starts shortly before a multiple of 4096 ticks, so the tests
+ * that wait for such a multiple do not wait long.  When
+ * testSTART_NEAR_TICK_OVERFLOW is defined that multiple is the tick count
+ * overflow. */
+#ifdef testSTART_NEAR_TICK_OVERFLOW
+    #define configINITIAL_TICK_COUNT            ( ( TickType_t ) 0 - ( TickType_t ) 300 )
+#else
+    #define configINITIAL_TICK_COUNT            ( ( TickType_t ) 3800 )
+#endif
+
+/* Software timer definitions. */
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                16
+#define configTIMER_TASK_STACK_DEPTH            configMINIMAL_STACK_SIZE
+
+/* Set the following definitions to 1 to include the API function, or zero
+ * to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_xTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_xTimerPendFunctionCall          1
+
+/* The tick at which each task is moved to the Ready state is recorded, so the
+ * tests can check tasks unblock on exactly the tick they should.  TickType_t
+ * is not defined yet, but is an unsigned long on the Posix port. */
+extern void vTestTaskMovedToReady( void * pvTask,
+                                   unsigned long ulTickCount );
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )    vTestTaskMovedToReady( ( void * ) ( pxTCB ), xTickCount )
+
+/* The MPSC queue stress test counts the times its consumer blocks. */
+extern volatile unsigned long ulMpscReceiveBlocks;
+#define traceBLOCKING_ON_MPSC_QUEUE_RECEIVE( xQueue )    ulMpscReceiveBlocks++
+
+/* The SPSC ring tests count the task notifications sent, and can make a ring
+ * usable again just before a task blocks on it, as an interrupt could. */
+extern volatile unsigned long ulTaskNotifications;
+extern void vTestSpscRingBlocking( void );
+#define traceTASK_NOTIFY( uxIndexToNotify )            ulTaskNotifications++
+#define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )   ulTaskNotifications++
+#define traceBLOCKING_ON_SPSC_RING_SEND( xRing )       vTestSpscRingBlocking()
+#define traceBLOCKING_ON_SPSC_RING_RECEIVE( xRing )    vTestSpscRingBlocking()
+
+/* The queue set test counts the handles members post to sets. */
+extern volatile unsigned long ulQueueSetPosts;
+#define traceQUEUE_SET_SEND( pxQueueSet )    ulQueueSetPosts++
+
+/* The event group tests count the lists of waiting tasks that are searched
+ * when bits are set, and those the tick hook searched. */
+extern void vTestEventGroupSearched( void );
+#define traceEVENT_GROUP_SEARCH_WAITERS( xEventGroup, uxBucket )    vTestEventGroupSearched()
+
+/* In the soft_mask variant interrupts are masked with a flag, and the pending
+ * tick test can make a tick arrive just after the flag is cleared. */
+extern void vTestInterruptsUnmasked( void );
+#define tracePORT_INTERRUPTS_UNMASKED()    vTestInterruptsUnmasked()
+
+/* In the virtual_time variant the times at which the idle task moves time
+ * forward are recorded. */
+extern void vTestVirtualTimeAdvanced( unsigned long ulTicks,
+                                      unsigned long ulTickCount );
+#define traceVIRTUAL_TIME_ADVANCE( x )    vTestVirtualTimeAdvanced( ( unsigned long ) ( x ), xTickCount )
+
+/* Late jobs in the EDF band are recorded. */
+extern void vTestDeadlineMissed( void * pvTask );
+#define traceTASK_DEADLINE_MISSED( pxTCB )         vTestDeadlineMissed( ( void * ) ( pxTCB ) )
+
+extern void vAssertCalled( const char * const pcFileName,
+                           unsigned long ulLine );
+#define configASSERT( x )    if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,5453 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Kernel tests that run on the Posix port with the real tick interrupt.
+ *
+ * Each test runs from a control task and prints one line on stdout:
+ *
+ * PASS tick_catch_up
+ *
+ * or a FAIL line saying what went wrong.  The exit status is the number of
+ * tests that failed.  See the Makefile in this directory for the kernel
+ * variants the tests are built for.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "mpsc_queue.h"
+#include "spsc_ring.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+#include "multi_wait.h"
+#include "pubsub.h"
+#include "fast_mutex.h"
+#include "rwlock.h"
+
+/* The control task runs below the tasks it tests, so it only runs again once
+ * they have all blocked. */
+#define testCONTROL_PRIORITY        ( tskIDLE_PRIORITY + 1 )
+#define testHIGH_PRIORITY           ( tskIDLE_PRIORITY + 2 )
+
+/* Tests that wait for the tick count to cross a boundary wait for a multiple
+ * of testBOUNDARY_TICKS, which is a boundary of every level of the delayed task
+ * wheel for every supported slot width.  The tasks are delayed from
+ * testBOUNDARY_LEAD ticks before the boundary. */
+#define testBOUNDARY_TICKS          ( ( TickType_t ) 4096 )
+#define testBOUNDARY_LEAD           ( ( TickType_t ) 5 )
+
+/* Tasks are never delayed for less than this, so the time they take to block
+ * after being started cannot make their wake time pass before they block. */
+#define testMIN_DELAY               ( ( TickType_t ) 3 )
+
+#define testMAX_DELAYED_TASKS       24U
+#define testNOT_READY               portMAX_DELAY
+
+/* The MPSC queue stress test runs for testMPSC_TEST_TICKS ticks, with
+ * testMPSC_TASK_PRODUCERS tasks sending to the queue without pause, and
+ * testMPSC_TICK_HOOK_PRODUCERS producers in the tick hook, which runs in the
+ * SIGALRM handler, so it interrupts the task producers part way through their
+ * sends.  The consumer blocks for up to testMPSC_RECEIVE_TIMEOUT ticks each
+ * time the queue is empty, which is long enough for every task producer to
+ * finish a send it was part way through, and far longer than the tick hook
+ * producers leave it without an item.  The queue is long enough that the
+ * producers do not fill it.  Each item holds the index of the producer that
+ * sent it in its top byte and a sequence number below that. */
+#define testMPSC_TASK_PRODUCERS         3U
+#define testMPSC_TICK_HOOK_PRODUCERS    2U
+#define testMPSC_PRODUCERS              ( testMPSC_TASK_PRODUCERS + testMPSC_TICK_HOOK_PRODUCERS )
+#define testMPSC_PRODUCER_PRIORITY      tskIDLE_PRIORITY
+#define testMPSC_QUEUE_LENGTH           32768U
+#define testMPSC_TEST_TICKS             ( ( TickType_t ) 1500 )
+#define testMPSC_RECEIVE_TIMEOUT        ( ( TickType_t ) 20 )
+#define testMPSC_PRODUCER_SHIFT         24U
+#define testMPSC_SEQUENCE_MASK          ( ( 1UL << testMPSC_PRODUCER_SHIFT ) - 1UL )
+
+/* The priority queue test fills a queue of testPRIORITY_QUEUE_LENGTH items
+ * testPRIORITY_QUEUE_ROUNDS times, emptying it after every other fill and only
+ * half emptying it in between, so the items received are a mix of those sent
+ * before and after other items were received.  Keys are sent in runs of up to
+ * testPRIORITY_QUEUE_MAX_RUN equal keys, drawn from testPRIORITY_QUEUE_KEYS
+ * values, so most keys are shared by items sent at different times. */
+#define testPRIORITY_QUEUE_LENGTH       16U
+#define testPRIORITY_QUEUE_ROUNDS       8U
+#define testPRIORITY_QUEUE_KEYS         5UL
+#define testPRIORITY_QUEUE_MAX_RUN      4UL
+
+/* The zero copy tests use a queue of testZERO_COPY_LENGTH items, and pass
+ * testZERO_COPY_ITEMS items through it with no more than one slot free, so
+ * the read and write positions wrap many times.  A task blocked on the queue
+ * waits for up to testZERO_COPY_TIMEOUT ticks, and its result is
+ * testZERO_COPY_WAITING until it returns. */
+#define testZERO_COPY_LENGTH            3U
+#define testZERO_COPY_ITEMS             20UL
+#define testZERO_COPY_TIMEOUT           ( ( TickType_t ) 100 )
+#define testZERO_COPY_WAITING           ( ( BaseType_t ) -1 )
+
+/* The batch tests move items through a queue of testBATCH_LENGTH items, and
+ * ask for testBATCH_EXTRA items more than fit when a transfer should be
+ * partial.  A transfer that cannot complete waits testBATCH_TIMEOUT ticks. */
+#define testBATCH_LENGTH                4U
+#define testBATCH_EXTRA                 2U
+#define testBATCH_TIMEOUT               ( ( TickType_t ) 5 )
+
+/* The SPSC ring tests use a ring of testSPSC_LENGTH items and pass
+ * testSPSC_ITEMS items through it, filling it and then emptying it part way,
+ * so the head and tail wrap many times.  A task blocked on the ring waits for
+ * up to testSPSC_TIMEOUT ticks, or testSPSC_SHORT_TIMEOUT ticks when it is
+ * meant to time out, and its result is testSPSC_WAITING until it returns. */
+#define testSPSC_LENGTH                 3U
+#define testSPSC_ITEMS                  20UL
+#define testSPSC_TIMEOUT                ( ( TickType_t ) 100 )
+#define testSPSC_SHORT_TIMEOUT          ( ( TickType_t ) 5 )
+#define testSPSC_WAITING                ( ( BaseType_t ) -1 )
+#define testSPSC_HOOK_ITEM              0x5a5aUL
+
+/* The queue set test adds testQUEUE_SET_MEMBERS queues of
+ * testQUEUE_SET_LENGTH items to a set with a ready list, and tries to add one
+ * more.  A select from the set with nothing ready waits testQUEUE_SET_TIMEOUT
+ * ticks. */
+#define testQUEUE_SET_MEMBERS           4U
+#define testQUEUE_SET_LENGTH            3U
+#define testQUEUE_SET_TIMEOUT           ( ( TickType_t ) 5 )
+
+/* The registry test fills the registry with queues whose names start with a
+ * chain of testREGISTRY_COLLISIONS names that hash to the same position.  The
+ * names are at most testREGISTRY_NAME_LENGTH characters, including the
+ * terminator. */
+#define testREGISTRY_COLLISIONS         3U
+#define testREGISTRY_NAME_LENGTH        8U
+
+/* The queue statistics test uses a queue of testSTATS_LENGTH items, and waits
+ * testSTATS_TIMEOUT ticks for sends and receives that are meant to fail. */
+#define testSTATS_LENGTH                3U
+#define testSTATS_TIMEOUT               ( ( TickType_t ) 5 )
+
+/* The multi object wait tests wait for a queue, an event group that appears
+ * twice with different bits, a stream buffer and the waiting task's own
+ * notification, at these indexes in the array of objects.  The object being
+ * tested is made ready testMULTI_WAIT_SIGNAL_DELAY ticks after the wait
+ * starts, well within testMULTI_WAIT_TIMEOUT. */
+#define testMULTI_WAIT_QUEUE            0U
+#define testMULTI_WAIT_EVENT_GROUP_A    1U
+#define testMULTI_WAIT_EVENT_GROUP_B    2U
+#define testMULTI_WAIT_STREAM_BUFFER    3U
+#define testMULTI_WAIT_NOTIFICATION     4U
+#define testMULTI_WAIT_OBJECTS          5U
+#define testMULTI_WAIT_BITS_A           ( ( EventBits_t ) 0x01 )
+#define testMULTI_WAIT_BITS_B           ( ( EventBits_t ) 0x06 )
+#define testMULTI_WAIT_SIGNAL_DELAY     ( ( TickType_t ) 3 )
+#define testMULTI_WAIT_TIMEOUT          ( ( TickType_t ) 100 )
+
+/* The publish/subscribe tests use a channel of testPUBSUB_LENGTH items with
+ * testPUBSUB_SUBSCRIBERS subscriber tasks, and publish testPUBSUB_ITEMS items,
+ * enough to wrap the ring more than once. */
+#define testPUBSUB_LENGTH               4U
+#define testPUBSUB_SUBSCRIBERS          4U
+#define testPUBSUB_ITEMS                11U
+#define testPUBSUB_TIMEOUT              ( ( TickType_t ) 100 )
+
+/* The lock tests hold a lock in the control task while tasks of the two
+ * priorities below wait for it, the urgent one for up to testLOCK_TIMEOUT
+ * ticks.  Both are above configEDF_PRIORITY, so are never scheduled earliest
+ * deadline first.  testLOCK_WAITING is a waiter's result, and
+ * testLOCK_NOT_TAKEN its take order, until its take returns. */
+#define testLOCK_WAITER_PRIORITY        ( tskIDLE_PRIORITY + 4 )
+#define testLOCK_URGENT_PRIORITY        ( tskIDLE_PRIORITY + 5 )
+#define testLOCK_TIMEOUT                ( ( TickType_t ) 5 )
+#define testLOCK_WAITING                ( ( BaseType_t ) -1 )
+#define testLOCK_NOT_TAKEN              ( ~( ( UBaseType_t ) 0U ) )
+
+/* The event group tests wait for all of testEVENT_WAIT_ALL_BITS bits, and
+ * sync testEVENT_SYNC_TASKS tasks, more than there are lists of waiting tasks,
+ * testEVENT_SYNC_ROUNDS times. */
+#define testEVENT_WAIT_ALL_BITS         5U
+#define testEVENT_SYNC_TASKS            6U
+#define testEVENT_SYNC_ROUNDS           4U
+#define testEVENT_SYNC_TIMEOUT          ( ( TickType_t ) 100 )
+
+/* The EDF tests run up to testEDF_MAX_TASKS tasks in the EDF band, each of
+ * which runs one job each time it is notified. */
+#define testEDF_MAX_TASKS               5U
+
+/* The tickless test waits for this many calls to the tick hook while every
+ * other task is blocked without a timeout. */
+#define testTICKLESS_HOOK_CALLS         5UL
+
+/* The wake latency test keeps a task from running for testWAKE_LATENCY_TICKS
+ * ticks after it is made ready, which is counted in bucket
+ * testWAKE_LATENCY_BUCKET of its histogram whether or not a tick also occurs
+ * while it is being made ready or switched in. */
+#define testWAKE_LATENCY_TICKS          ( ( TickType_t ) 5 )
+#define testWAKE_LATENCY_BUCKET         3U
+#define testWAKE_HOG_PRIORITY           ( tskIDLE_PRIORITY + 4 )
+
+/* The ready priority bitmap test runs its tasks at priorities in several of
+ * the bitmap's 32 bit words, raising the control task above them all while it
+ * readies them so none runs until it lowers its priority again. */
+#define testBITMAP_TASKS                8U
+#define testBITMAP_CONTROL_PRIORITY     ( configMAX_PRIORITIES - 2U )
+#define testBITMAP_MOVED_PRIORITY       ( ( UBaseType_t ) 200U )
+
+/* The SMP tests run up to testSMP_TASKS tasks that keep a core busy for
+ * testSMP_BUSY_TICKS ticks at testSMP_BUSY_PRIORITY, and preempt a task
+ * spinning at that priority with a task at testSMP_PREEMPT_PRIORITY
+ * testSMP_PREEMPT_ATTEMPTS times. */
+#define testSMP_TASKS                   ( configNUMBER_OF_CORES + 1U )
+#define testSMP_BUSY_PRIORITY           testHIGH_PRIORITY
+#define testSMP_BUSY_TICKS              ( ( TickType_t ) 50 )
+#define testSMP_PREEMPT_PRIORITY        ( tskIDLE_PRIORITY + 3 )
+#define testSMP_PREEMPT_ATTEMPTS        4U
+#define testSMP_TIMEOUT                 ( ( TickType_t ) 500 )
+
+/* The pending tick test raises ticks itself, and repeats its checks up to
+ * testPENDING_TICK_ATTEMPTS times until no tick from the timer arrives while
+ * they are made. */
+#define testPENDING_TICK_ATTEMPTS       10U
+
+/* The green threads test passes a notification around a ring of
+ * testGREEN_RING_TASKS tasks testGREEN_RING_ROUNDS times. */
+#define testGREEN_RING_TASKS            32U
+#define testGREEN_RING_ROUNDS           10U
+
+/* The virtual time tests delay for testVIRTUAL_DELAY ticks while another task
+ * delays for testVIRTUAL_SHORT_DELAY ticks, spin for testVIRTUAL_SPIN_NS
+ * nanoseconds of host time, and run a workload of testVIRTUAL_TASKS tasks and
+ * a timer for testVIRTUAL_WORKLOAD_TICKS ticks, recording up to
+ * testVIRTUAL_MAX_EVENTS events each time. */
+#define testVIRTUAL_DELAY               ( ( TickType_t ) 1000 )
+#define testVIRTUAL_SHORT_DELAY         ( ( TickType_t ) 300 )
+#define testVIRTUAL_SPIN_NS             20000000ULL
+#define testVIRTUAL_TASKS               3U
+#define testVIRTUAL_WORKLOAD_TICKS      ( ( TickType_t ) 500 )
+#define testVIRTUAL_MAX_EVENTS          1024U
+#define testVIRTUAL_RECEIVE_TIMEOUT     ( ( TickType_t ) 5 )
+#define testVIRTUAL_TIMER_PERIOD        ( ( TickType_t ) 17 )
+
+/* The sources of the virtual time tests' events after the tasks, which are
+ * numbered from 0. */
+#define testVIRTUAL_TIMER_EVENT         testVIRTUAL_TASKS
+#define testVIRTUAL_ADVANCE_EVENT       ( testVIRTUAL_TASKS + 1U )
+
+#define testARRAY_LENGTH( x )       ( sizeof( x ) / sizeof( ( x )[ 0 ] ) )
+/*-----------------------------------------------------------*/
+
+typedef struct TEST
+{
+    const char * pcName;
+    BaseType_t ( * pxTest )( void ); /* Returns pdPASS or pdFAIL. */
+} Test_t;
+
+typedef struct LOCK_WAITER
+{
+    BaseType_t ( * pxTake )( TickType_t xTicksToWait );
+    void ( * pxGive )( void );
+    TickType_t xTicksToWait;
+    volatile BaseType_t xResult;      /* testLOCK_WAITING, or the value returned by pxTake. */
+    volatile UBaseType_t uxTakeOrder; /* testLOCK_NOT_TAKEN, or the number of waiters that took a lock before this one. */
+} LockWaiter_t;
+
+typedef struct EVENT_WAITER
+{
+    EventBits_t uxBitsToWaitFor;
+    BaseType_t xWaitForAllBits;
+    TickType_t xTicksToWait;
+    volatile EventBits_t uxReturnedBits;
+    volatile BaseType_t xReturned; /* pdFALSE until xEventGroupWaitBits() returns. */
+} EventWaiter_t;
+
+typedef struct VIRTUAL_EVENT
+{
+    TickType_t xTick;   /* Ticks since recording started. */
+    UBaseType_t uxSource;
+    uint32_t ulValue;
+} VirtualEvent_t;
+
+typedef struct PRIORITY_ITEM
+{
+    UBaseType_t uxKey; /* Must be the first member. */
+    uint32_t ulSendIndex;
+} PriorityItem_t;
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvDelayedTask( void * pvParameters );
+static void prvMpscProducerTask( void * pvParameters );
+static void prvMpscTickHookProducers( void );
+static void prvZeroCopySenderTask( void * pvParameters );
+static void prvZeroCopyReceiverTask( void * pvParameters );
+static void prvBatchSenderTask( void * pvParameters );
+static void prvBatchReceiverTask( void * pvParameters );
+static void prvSpscProducerTask( void * pvParameters );
+static void prvSpscConsumerTask( void * pvParameters );
+static TaskHandle_t prvStartSpscPeer( TaskFunction_t pxTaskCode,
+                                      TickType_t xTicksToWait );
+static BaseType_t prvCheckSelectedMembers( QueueSetHandle_t xQueueSet,
+                                           const QueueHandle_t * pxExpected,
+                                           UBaseType_t uxExpected,
+                                           UBaseType_t uxMaxMembers,
+                                           const char * pcWhen );
+static UBaseType_t prvRegistryNamePosition( const char * pcName );
+static BaseType_t prvCheckRegistered( QueueHandle_t xQueue,
+                                      const char * pcName,
+                                      BaseType_t xRegistered );
+static void prvStatsSenderTask( void * pvParameters );
+static void prvMultiWaitSignalTask( void * pvParameters );
+static void prvMultiWaitOtherTask( void * pvParameters );
+static void prvPubSubSubscriberTask( void * pvParameters );
+static void prvPubSubPublisherTask( void * pvParameters );
+static void prvPubSubTickHookPublisher( void );
+static void prvStartPubSubSubscribers( void );
+static void prvStopPubSubSubscribers( void );
+static BaseType_t prvCheckPubSubSubscribers( UBaseType_t uxItemsPublished,
+                                             uint32_t ulLastItem );
+static void prvLockWaiterTask( void * pvParameters );
+static TaskHandle_t prvStartLockWaiter( LockWaiter_t * pxWaiter,
+                                        UBaseType_t uxPriority );
+static BaseType_t prvCheckHolderPriority( UBaseType_t uxExpected,
+                                          const char * pcWhen );
+static BaseType_t prvCheckLockInheritance( LockWaiter_t * pxWaiter,
+                                           LockWaiter_t * pxUrgentWaiter,
+                                           void ( * pxHolderGive )( void ) );
+static BaseType_t prvFastMutexTake( TickType_t xTicksToWait );
+static void prvFastMutexGive( void );
+static BaseType_t prvRwLockTakeRead( TickType_t xTicksToWait );
+static void prvRwLockGiveRead( void );
+static BaseType_t prvRwLockTakeWrite( TickType_t xTicksToWait );
+static void prvRwLockGiveWrite( void );
+static void prvEventWaiterTask( void * pvParameters );
+static TaskHandle_t prvStartEventWaiter( EventWaiter_t * pxWaiter );
+static void prvEventSyncTask( void * pvParameters );
+static void prvWakeLatencyTask( void * pvParameters );
+static void prvWakeHogTask( void * pvParameters );
+static BaseType_t prvCheckWakeLatency( UBaseType_t uxBucket,
+                                       const char * pcWhen );
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+    static void prvEventGroupTickHook( void );
+#endif
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    static void prvEdfTask( void * pvParameters );
+    static BaseType_t prvRunEdfJobs( const TickType_t * pxDeadlines,
+                                     const TickType_t * pxBusyTicks,
+                                     UBaseType_t uxTasks );
+#endif
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    static void prvTicklessTickHook( void );
+#endif
+#if ( configUSE_GREEN_THREADS == 1 )
+    static void prvGreenRingTask( void * pvParameters );
+#endif
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    static void prvVirtualSleeperTask( void * pvParameters );
+    static void prvVirtualWorkloadTask( void * pvParameters );
+    static void prvVirtualTimerCallback( TimerHandle_t xTimer );
+    static void prvRecordVirtualEvent( UBaseType_t uxSource,
+                                       TickType_t xTick,
+                                       uint32_t ulValue );
+    static BaseType_t prvRunVirtualWorkload( void );
+#endif
+#if ( configNUMBER_OF_CORES > 1 )
+    static void prvSmpBusyTask( void * pvParameters );
+    static void prvSmpSpinTask( void * pvParameters );
+    static void prvSmpPreemptTask( void * pvParameters );
+    static void prvStartSmpBusyTasks( UBaseType_t uxTasks );
+    static BaseType_t prvRunSmpBusyTasks( UBaseType_t uxTasks );
+    static void prvDeleteSmpTasks( UBaseType_t uxTasks );
+#endif
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+    static void prvBitmapTask( void * pvParameters );
+    static BaseType_t prvCheckBitmapRunOrder( const UBaseType_t * puxExpectedOrder,
+                                              UBaseType_t uxTasks );
+#endif
+static BaseType_t prvFail( const char * pcFormat,
+                           ... );
+static TickType_t prvWaitForBoundary( void );
+static void prvStartDelayedTasks( const TickType_t * pxDelays,
+                                 UBaseType_t uxTasks );
+static BaseType_t prvCheckWakeTimes( UBaseType_t uxTasks,
+                                     TickType_t xTicksToWait );
+
+static BaseType_t prvTickCatchUpTest( void );
+static BaseType_t prvDelayedTaskWakeTimesTest( void );
+static BaseType_t prvMpscQueueInterruptStressTest( void );
+static BaseType_t prvPriorityQueueOrderTest( void );
+static BaseType_t prvQueueZeroCopySlotsTest( void );
+static BaseType_t prvQueueZeroCopyOrderTest( void );
+static BaseType_t prvQueueSendMultipleTest( void );
+static BaseType_t prvQueueReceiveMultipleTest( void );
+static BaseType_t prvSpscRingOrderTest( void );
+static BaseType_t prvSpscRingBlockingTest( void );
+static BaseType_t prvQueueSetReadyEdgeTest( void );
+static BaseType_t prvQueueRegistryLookupTest( void );
+static BaseType_t prvQueueStatisticsTest( void );
+static BaseType_t prvMultiWaitReadyTest( void );
+static BaseType_t prvMultiWaitBusyTest( void );
+static BaseType_t prvPubSubFanOutTest( void );
+static BaseType_t prvPubSubSlowSubscriberTest( void );
+static BaseType_t prvPubSubPublishFromISRTest( void );
+static BaseType_t prvFastMutexInheritanceTest( void );
+static BaseType_t prvRwLockInheritanceTest( void );
+static BaseType_t prvRwLockPreferWritersTest( void );
+static BaseType_t prvEventGroupWaitAllTest( void );
+static BaseType_t prvEventGroupTimeoutTest( void );
+static BaseType_t prvEventGroupSyncTest( void );
+static BaseType_t prvWakeLatencyHistogramTest( void );
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+    static BaseType_t prvEventGroupIsrOrderTest( void );
+    static BaseType_t prvEventGroupIsrDeferTest( void );
+    static BaseType_t prvEventGroupIsrPendingTest( void );
+#endif
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    static BaseType_t prvTicklessNoTimeoutTest( void );
+#endif
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    static BaseType_t prvEdfDeadlineOrderTest( void );
+    static BaseType_t prvEdfDeadlineMissedTest( void );
+#endif
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+    static BaseType_t prvReadyPriorityBitmapTest( void );
+#endif
+#if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+    static BaseType_t prvPendingTickTest( void );
+#endif
+#if ( configUSE_GREEN_THREADS == 1 )
+    static BaseType_t prvGreenThreadRingTest( void );
+#endif
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    static BaseType_t prvVirtualTimeIdleJumpTest( void );
+    static BaseType_t prvVirtualTimeRepeatTest( void );
+#endif
+#if ( configNUMBER_OF_CORES > 1 )
+    static BaseType_t prvSmpCoreAffinityTest( void );
+    static BaseType_t prvSmpAllCoresBusyTest( void );
+    static BaseType_t prvSmpYieldCoreTest( void );
+#endif
+/*-----------------------------------------------------------*/
+
+static const Test_t xTests[] =
+{
+    { "tick_catch_up",           prvTickCatchUpTest              },
+    { "delayed_task_wake_times", prvDelayedTaskWakeTimesTest     },
+    { "mpsc_queue_interrupts",   prvMpscQueueInterruptStressTest },
+    { "priority_queue_order",    prvPriorityQueueOrderTest       },
+    { "queue_zero_copy_slots",   prvQueueZeroCopySlotsTest       },
+    { "queue_zero_copy_order",   prvQueueZeroCopyOrderTest       },
+    { "queue_send_multiple",     prvQueueSendMultipleTest        },
+    { "queue_receive_multiple",  prvQueueReceiveMultipleTest     },
+    { "spsc_ring_order",         prvSpscRingOrderTest            },
+    { "spsc_ring_blocking",      prvSpscRingBlockingTest         },
+    { "queue_set_ready_edges",   prvQueueSetReadyEdgeTest        },
+    { "queue_registry_lookup",   prvQueueRegistryLookupTest      },
+    { "queue_statistics",        prvQueueStatisticsTest          },
+    { "multi_wait_ready",        prvMultiWaitReadyTest           },
+    { "multi_wait_busy",         prvMultiWaitBusyTest            },
+    { "pubsub_fan_out",          prvPubSubFanOutTest             },
+    { "pubsub_slow_subscriber",  prvPubSubSlowSubscriberTest     },
+    { "pubsub_publish_from_isr", prvPubSubPublishFromISRTest     },
+    { "fast_mutex_inheritance",  prvFastMutexInheritanceTest     },
+    { "rwlock_inheritance",      prvRwLockInheritanceTest        },
+    { "rwlock_prefer_writers",   prvRwLockPreferWritersTest      },
+    { "event_group_wait_all",    prvEventGroupWaitAllTest        },
+    { "event_group_timeouts",    prvEventGroupTimeoutTest        },
+    { "event_group_sync",        prvEventGroupSyncTest           },
+    { "wake_latency_histogram",  prvWakeLatencyHistogramTest     },
+    #if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+        { "event_group_isr_order",   prvEventGroupIsrOrderTest       },
+        { "event_group_isr_defer",   prvEventGroupIsrDeferTest       },
+        { "event_group_isr_pending", prvEventGroupIsrPendingTest     },
+    #endif
+    #if ( configUSE_TICKLESS_IDLE == 1 )
+        { "tickless_no_timeout",     prvTicklessNoTimeoutTest        },
+    #endif
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        { "edf_deadline_order",      prvEdfDeadlineOrderTest         },
+        { "edf_deadline_missed",     prvEdfDeadlineMissedTest        },
+    #endif
+    #if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+        { "ready_priority_bitmap",   prvReadyPriorityBitmapTest      },
+    #endif
+    #if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+        { "pending_tick",            prvPendingTickTest              },
+    #endif
+    #if ( configUSE_GREEN_THREADS == 1 )
+        { "green_thread_ring",       prvGreenThreadRingTest          },
+    #endif
+};
+
+/* The tests above rely on a task readied by a higher priority task not
+ * running until that task blocks, which only holds with one core, so builds
+ * with more than one core run these tests instead. */
+#if ( configNUMBER_OF_CORES > 1 )
+    static const Test_t xSmpTests[] =
+    {
+        { "smp_core_affinity",       prvSmpCoreAffinityTest          },
+        { "smp_all_cores_busy",      prvSmpAllCoresBusyTest          },
+        { "smp_yield_core",          prvSmpYieldCoreTest             },
+    };
+#endif
+
+/* Without a tick, time only passes while every task is blocked, so builds
+ * with virtual time run these tests instead. */
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    static const Test_t xVirtualTimeTests[] =
+    {
+        { "delayed_task_wake_times", prvDelayedTaskWakeTimesTest     },
+        { "virtual_time_idle_jump",  prvVirtualTimeIdleJumpTest      },
+        { "virtual_time_repeat",     prvVirtualTimeRepeatTest        },
+    };
+#endif
+
+static TaskHandle_t xControlTask = NULL;
+static const char * pcRunningTest = NULL;
+
+/* The number of failed configASSERT()s a test expects, which vAssertCalled()
+ * lets the kernel carry on past rather than aborting. */
+static volatile UBaseType_t uxAssertsExpected = 0;
+
+/* The delayed tasks, the delay each is given, the tick they are delayed from,
+ * and the tick at which each was last moved to the Ready state. */
+static TaskHandle_t xDelayedTasks[ testMAX_DELAYED_TASKS ];
+static TickType_t xDelays[ testMAX_DELAYED_TASKS ];
+static TickType_t xDelayBaseTick;
+static volatile TickType_t xReadyTicks[ testMAX_DELAYED_TASKS ];
+
+/* Incremented by vApplicationTickHook(). */
+static volatile unsigned long ulTickHookCalls = 0;
+
+/* The MPSC queue stress test's producer tasks, the queue they send to, the
+ * same queue but only set while the tick hook producers are sending, the
+ * number of items each producer has sent, which task producers are part way
+ * through a send, the number of task producers still sending, and the number
+ * of ticks that occurred while a task producer was part way through a send. */
+static TaskHandle_t xMpscProducerTasks[ testMPSC_TASK_PRODUCERS ];
+static MpscQueueHandle_t xMpscQueue = NULL;
+static volatile MpscQueueHandle_t xMpscTickHookQueue = NULL;
+static volatile uint32_t ulMpscItemsSent[ testMPSC_PRODUCERS ];
+static volatile BaseType_t xMpscTaskSending[ testMPSC_TASK_PRODUCERS ];
+static volatile UBaseType_t uxMpscTaskProducersRunning = 0;
+static volatile unsigned long ulMpscInterruptedSends = 0;
+static TickType_t xMpscStartTick;
+
+/* Incremented by traceBLOCKING_ON_MPSC_QUEUE_RECEIVE(), see FreeRTOSConfig.h. */
+volatile unsigned long ulMpscReceiveBlocks = 0;
+
+/* The queue the zero copy tests use, and the result of the send or receive
+ * made by the task blocked on it and the item that task received. */
+static QueueHandle_t xZeroCopyQueue = NULL;
+static volatile BaseType_t xZeroCopyPeerResult;
+static volatile uint32_t ulZeroCopyPeerItem;
+
+/* The queue the batch tests use, the next item the task on the other side of
+ * it sends or expects to receive, the number of times that task has been
+ * unblocked, and the number of items (or spaces) it found in the queue when it
+ * was last unblocked. */
+static QueueHandle_t xBatchQueue = NULL;
+static volatile uint32_t ulBatchNextItem;
+static volatile UBaseType_t uxBatchWakes;
+static volatile UBaseType_t uxBatchLeftOnWake;
+static volatile BaseType_t xBatchOutOfOrder;
+
+/* The ring the SPSC ring tests use, and the result of the send or receive made
+ * by the task blocked on it and the item that task sent or received. */
+static SpscRingHandle_t xSpscRing = NULL;
+static volatile BaseType_t xSpscPeerResult;
+static volatile uint32_t ulSpscPeerItem;
+
+/* Set for vTestSpscRingBlocking() to send an item to the ring if it is empty,
+ * or receive one if it is full, the next time a task is about to block on it,
+ * and the item it received. */
+static volatile BaseType_t xSpscMakeUsable = pdFALSE;
+static volatile uint32_t ulSpscHookItem;
+
+/* Incremented by traceTASK_NOTIFY() and traceTASK_NOTIFY_FROM_ISR(), see
+ * FreeRTOSConfig.h. */
+volatile unsigned long ulTaskNotifications = 0;
+
+/* Incremented by traceQUEUE_SET_SEND(), see FreeRTOSConfig.h. */
+volatile unsigned long ulQueueSetPosts = 0;
+
+/* The names the registry test gives its queues, one more than the registry
+ * can hold, and the queue the statistics test sends to from another task. */
+static char cRegistryNames[ configQUEUE_REGISTRY_SIZE + 1U ][ testREGISTRY_NAME_LENGTH ];
+static QueueHandle_t xStatsQueue = NULL;
+
+/* The objects the multi object wait tests wait for, the object
+ * prvMultiWaitSignalTask() makes ready next, and the value returned by the
+ * uxMultiWaitForAny() call made by prvMultiWaitOtherTask(). */
+static QueueHandle_t xMultiWaitQueue = NULL;
+static EventGroupHandle_t xMultiWaitEventGroup = NULL;
+static StreamBufferHandle_t xMultiWaitStreamBuffer = NULL;
+static volatile UBaseType_t uxMultiWaitSignal;
+static volatile UBaseType_t uxMultiWaitOtherReady;
+
+/* The publish/subscribe tests' channel, subscriber tasks, the number of items
+ * each subscriber has received, the last item each received and the number
+ * of items each was told it lost.  Also the channel and item the tick hook
+ * publishes, the channel only being set until the item is published, and
+ * whether publishing the item woke a task of a higher priority than the task
+ * it interrupted. */
+static PubSubHandle_t xPubSubChannel = NULL;
+static TaskHandle_t xPubSubSubscriberTasks[ testPUBSUB_SUBSCRIBERS ];
+static volatile UBaseType_t uxPubSubItemsReceived[ testPUBSUB_SUBSCRIBERS ];
+static volatile uint32_t ulPubSubLastItem[ testPUBSUB_SUBSCRIBERS ];
+static volatile UBaseType_t uxPubSubItemsLost[ testPUBSUB_SUBSCRIBERS ];
+static volatile PubSubHandle_t xPubSubTickHookChannel = NULL;
+static uint32_t ulPubSubTickHookItem;
+static volatile BaseType_t xPubSubTickHookWoken;
+
+/* The locks the lock tests' waiters take, and the number of times a waiter
+ * has taken one. */
+static FastMutexHandle_t xTestFastMutex = NULL;
+static RwLockHandle_t xTestRwLock = NULL;
+static volatile UBaseType_t uxLockTakes = 0;
+
+/* The event group the event group tests wait on, and the number of syncs that
+ * returned before every task had reached them. */
+static EventGroupHandle_t xTestEventGroup = NULL;
+static volatile UBaseType_t uxEventSyncFailures = 0;
+
+/* Incremented by vTestEventGroupSearched(), see FreeRTOSConfig.h. */
+static volatile unsigned long ulEventGroupSearches = 0;
+
+/* The wake latency test's task whose histogram is checked, the task that
+ * keeps it from running, and the histogram as it was before the task was
+ * last made ready. */
+static TaskHandle_t xWakeLatencyTask = NULL;
+static TaskHandle_t xWakeHogTask = NULL;
+static uint32_t ulWakeLatencyBefore[ configWAKE_LATENCY_HISTOGRAM_BUCKETS ];
+
+/* The bits the tick hook sets and clears in the event group, and whether it
+ * clears them first, the tick hook only acting while xEventIsrPending is set.
+ * Also whether the tick hook is running and the lists it searched, whether
+ * the next task to search a list holds the event group locked until the tick
+ * hook has run, and whether the tick hook ran while it did. */
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+    static volatile EventBits_t uxEventIsrBitsToSet;
+    static volatile EventBits_t uxEventIsrBitsToClear;
+    static volatile BaseType_t xEventIsrClearFirst;
+    static volatile BaseType_t xEventIsrPending = pdFALSE;
+    static volatile BaseType_t xEventIsrRunning = pdFALSE;
+    static volatile unsigned long ulEventIsrSearches = 0;
+    static volatile BaseType_t xEventGroupHoldLock = pdFALSE;
+    static volatile BaseType_t xEventGroupHoldingLock = pdFALSE;
+    static volatile BaseType_t xEventIsrRanWhileLocked;
+#endif
+
+/* The task the tickless test's tick hook notifies, and the value
+ * ulTickHookCalls reaches when it does. */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    static volatile TaskHandle_t xTicklessWaitingTask = NULL;
+    static volatile unsigned long ulTicklessNotifyAtCall;
+#endif
+
+/* The EDF tests' tasks, the number of ticks each spends running its job, the
+ * order in which the jobs ran, and the number of each task's jobs reported as
+ * late by traceTASK_DEADLINE_MISSED(). */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    static TaskHandle_t xEdfTasks[ testEDF_MAX_TASKS ];
+    static TickType_t xEdfBusyTicks[ testEDF_MAX_TASKS ];
+    static volatile UBaseType_t uxEdfRunOrder[ testEDF_MAX_TASKS ];
+    static volatile UBaseType_t uxEdfJobsRun = 0;
+    static volatile UBaseType_t uxEdfMissedDeadlines[ testEDF_MAX_TASKS ];
+#endif
+
+/* The ready priority bitmap test's tasks, the priority each runs at, and the
+ * order in which they ran. */
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+    static TaskHandle_t xBitmapTasks[ testBITMAP_TASKS ];
+    static const UBaseType_t uxBitmapPriorities[ testBITMAP_TASKS ] = { 2, 31, 32, 63, 64, 95, 130, 250 };
+    static volatile UBaseType_t uxBitmapRunOrder[ testBITMAP_TASKS ];
+    static volatile UBaseType_t uxBitmapTasksRun = 0;
+#endif
+
+/* Whether vTestInterruptsUnmasked() is to raise a tick, and the number of
+ * calls to the tick hook once the tick it raised had been handled. */
+#if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+    static volatile BaseType_t xRaiseTickWhenUnmasked = pdFALSE;
+    static volatile unsigned long ulTickHookCallsAfterRaise;
+#endif
+
+/* The green threads test's tasks, the number of times the notification has
+ * been passed on, and the number of tasks that found themselves running on a
+ * stack other than the one the kernel allocated for them. */
+#if ( configUSE_GREEN_THREADS == 1 )
+    static TaskHandle_t xGreenRingTasks[ testGREEN_RING_TASKS ];
+    static volatile UBaseType_t uxGreenRingPasses = 0;
+    static volatile UBaseType_t uxGreenOffStack = 0;
+#endif
+
+/* The events recorded by the virtual time tests, those recorded by the first
+ * run of the workload, and the tick recording started from.  Also the
+ * workload's tasks, timer and queue. */
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    static VirtualEvent_t xVirtualEvents[ testVIRTUAL_MAX_EVENTS ];
+    static VirtualEvent_t xVirtualFirstRun[ testVIRTUAL_MAX_EVENTS ];
+    static volatile UBaseType_t uxVirtualEvents = 0;
+    static volatile BaseType_t xVirtualRecording = pdFALSE;
+    static TickType_t xVirtualStartTick;
+    static TaskHandle_t xVirtualTasks[ testVIRTUAL_TASKS ];
+    static const TickType_t xVirtualPeriods[ testVIRTUAL_TASKS ] = { 7, 0, 13 };
+    static TimerHandle_t xVirtualTimer = NULL;
+    static QueueHandle_t xVirtualQueue = NULL;
+#endif
+
+/* The SMP tests' busy tasks, the tick they are busy from and the number of
+ * ticks they are busy for, and for each task the number of times it checked
+ * the core it runs on, the cores it ran on, and the number of times it found
+ * itself on a core outside its affinity mask.  Also whether a task found
+ * every core running one of the busy tasks, the number of ticks handled on
+ * each core, whether the spinning task is to keep spinning and the number of
+ * times it has, and the core the preempting task ran on and the ticks that
+ * core had handled when it did. */
+#if ( configNUMBER_OF_CORES > 1 )
+    static TaskHandle_t xSmpTasks[ testSMP_TASKS ];
+    static volatile TickType_t xSmpStartTick;
+    static volatile TickType_t xSmpBusyTicks;
+    static volatile UBaseType_t uxSmpChecks[ testSMP_TASKS ];
+    static volatile UBaseType_t uxSmpCoresUsed[ testSMP_TASKS ];
+    static volatile UBaseType_t uxSmpWrongCore[ testSMP_TASKS ];
+    static volatile BaseType_t xSmpAllCoresBusy;
+    static volatile unsigned long ulSmpCoreTicks[ configNUMBER_OF_CORES ];
+    static volatile BaseType_t xSmpSpinning;
+    static volatile unsigned long ulSmpSpins;
+    static volatile BaseType_t xSmpPreemptCore;
+    static volatile unsigned long ulSmpPreemptCoreTicks;
+#endif
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    UBaseType_t x;
+
+    for( x = 0; x < testMAX_DELAYED_TASKS; x++ )
+    {
+        xTaskCreate( prvDelayedTask, "Delayed", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, testHIGH_PRIORITY, &( xDelayedTasks[ x ] ) );
+    }
+
+    xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, testCONTROL_PRIORITY, &xControlTask );
+
+    vTaskStartScheduler();
+
+    return EXIT_FAILURE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    const Test_t * pxTests;
+    size_t x, uxTests;
+    int iFailures = 0;
+
+    ( void ) pvParameters;
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        ( void ) xTests;
+        pxTests = xSmpTests;
+        uxTests = testARRAY_LENGTH( xSmpTests );
+    #elif ( configUSE_VIRTUAL_TIME == 1 )
+        ( void ) xTests;
+        pxTests = xVirtualTimeTests;
+        uxTests = testARRAY_LENGTH( xVirtualTimeTests );
+    #else
+        pxTests = xTests;
+        uxTests = testARRAY_LENGTH( xTests );
+    #endif
+
+    for( x = 0; x < uxTests; x++ )
+    {
+        pcRunningTest = pxTests[ x ].pcName;
+
+        if( pxTests[ x ].pxTest() == pdPASS )
+        {
+            printf( "PASS %s\n", pcRunningTest );
+        }
+        else
+        {
+            iFailures++;
+        }
+
+        fflush( stdout );
+    }
+
+    exit( iFailures );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFail( const char * pcFormat,
+                           ... )
+{
+    va_list xArgs;
+
+    printf( "FAIL %s: ", pcRunningTest );
+    va_start( xArgs, pcFormat );
+    vprintf( pcFormat, xArgs );
+    va_end( xArgs );
+    printf( "\n" );
+
+    return pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvWaitForBoundary( void )
+{
+    TickType_t xNow = xTaskGetTickCount();
+    TickType_t xToGo;
+
+    /* Delay until testBOUNDARY_LEAD ticks before the next multiple of
+     * testBOUNDARY_TICKS. */
+    xToGo = ( ( ( testBOUNDARY_TICKS - testBOUNDARY_LEAD ) - ( xNow % testBOUNDARY_TICKS ) ) + testBOUNDARY_TICKS ) % testBOUNDARY_TICKS;
+
+    if( xToGo != 0U )
+    {
+        ( void ) xTaskDelayUntil( &xNow, xToGo );
+    }
+
+    return xNow;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartDelayedTasks( const TickType_t * pxDelays,
+                                 UBaseType_t uxTasks )
+{
+    UBaseType_t x;
+
+    configASSERT( uxTasks <= testMAX_DELAYED_TASKS );
+
+    /* The delayed tasks have the higher priority, so they have all blocked
+     * by the time the scheduler is resumed. */
+    vTaskSuspendAll();
+    {
+        xDelayBaseTick = xTaskGetTickCount();
+
+        for( x = 0; x < uxTasks; x++ )
+        {
+            xDelays[ x ] = pxDelays[ x ];
+            xReadyTicks[ x ] = testNOT_READY;
+            xTaskNotifyGive( xDelayedTasks[ x ] );
+        }
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvDelayedTask( void * pvParameters )
+{
+    const UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+    TickType_t xWakeTime;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        /* Being notified moved this task to the Ready state, so the time at
+         * which the delay ends is only recorded from here on. */
+        xReadyTicks[ uxIndex ] = testNOT_READY;
+        xWakeTime = xDelayBaseTick;
+
+        if( xTaskDelayUntil( &xWakeTime, xDelays[ uxIndex ] ) == pdFALSE )
+        {
+            /* The wake time had already passed, so the task did not block. */
+            xReadyTicks[ uxIndex ] = ( TickType_t ) 0 - ( TickType_t ) 2;
+        }
+
+        xTaskNotifyGive( xControlTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckWakeTimes( UBaseType_t uxTasks,
+                                     TickType_t xTicksToWait )
+{
+    UBaseType_t x;
+    BaseType_t xResult = pdPASS;
+
+    /* Every task notifies the control task once it has woken. */
+    for( x = 0; x < uxTasks; x++ )
+    {
+        if( ulTaskNotifyTake( pdFALSE, xTicksToWait ) == 0U )
+        {
+            return prvFail( "only %u of %u tasks woke", ( unsigned ) x, ( unsigned ) uxTasks );
+        }
+    }
+
+    for( x = 0; ( x < uxTasks ) && ( xResult == pdPASS ); x++ )
+    {
+        if( xReadyTicks[ x ] != ( TickType_t ) ( xDelayBaseTick + xDelays[ x ] ) )
+        {
+            xResult = prvFail( "task delayed by %lu ticks from tick %lu became ready at tick %lu",
+                               ( unsigned long ) xDelays[ x ], ( unsigned long ) xDelayBaseTick,
+                               ( unsigned long ) xReadyTicks[ x ] );
+        }
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTickCatchUpTest( void )
+{
+    /* Wake times spread over the caught up ticks, either side of the boundary
+     * of every level of the delayed task wheel, and, in the builds that start
+     * near the tick count overflow, either side of the overflow. */
+    static const TickType_t xCatchUpDelays[] =
+    {
+        testMIN_DELAY, 4,   5,    6,    7,    16,   100,  255,  256,  257,  1000, 2048,
+        4091,          4095, 4096, 4097, 4101, 5000, 6144, 8191, 8192, 8193, 9000, 9999
+    };
+    const UBaseType_t uxTasks = testARRAY_LENGTH( xCatchUpDelays );
+    const TickType_t xTicksToCatchUp = 10000;
+    unsigned long ulTickHookCallsBefore, ulTickHookCallsDuring;
+    BaseType_t xSwitched, xResult;
+
+    ( void ) prvWaitForBoundary();
+    prvStartDelayedTasks( xCatchUpDelays, uxTasks );
+
+    /* The delayed tasks have the higher priority, so every one of them has
+     * woken, and notified this task, by the time xTaskCatchUpTicks() returns. */
+    ulTickHookCallsBefore = ulTickHookCalls;
+    xSwitched = xTaskCatchUpTicks( xTicksToCatchUp );
+    ulTickHookCallsDuring = ulTickHookCalls - ulTickHookCallsBefore;
+
+    xResult = prvCheckWakeTimes( uxTasks, 0 );
+
+    if( xResult == pdPASS )
+    {
+        if( xSwitched != pdTRUE )
+        {
+            xResult = prvFail( "xTaskCatchUpTicks() unblocked higher priority tasks without switching to them" );
+        }
+        else if( ulTickHookCallsDuring >= ( xTicksToCatchUp / 100U ) )
+        {
+            /* Only ticks that really occurred while the ticks were being
+             * caught up call the hook. */
+            xResult = prvFail( "the tick hook was called %lu times while %lu ticks were caught up",
+                               ulTickHookCallsDuring, ( unsigned long ) xTicksToCatchUp );
+        }
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvDelayedTaskWakeTimesTest( void )
+{
+    /* The delays end either side of the boundary of every level of the
+     * delayed task wheel, so tasks are woken from the bottom level, or after
+     * being moved down from one or more levels above it.  In the builds that
+     * start near the tick count overflow the boundary is also the overflow. */
+    static const TickType_t xWakeTimeDelays[] =
+    {
+        testMIN_DELAY, 4,   5,   6,   7,   9,   16,  21,   37,   64,   69,   251,
+        256,           261, 267, 517, 1029, 2053, 4091, 4095, 4096, 4100, 4101, 4106
+    };
+
+    const UBaseType_t uxTasks = testARRAY_LENGTH( xWakeTimeDelays );
+
+    ( void ) prvWaitForBoundary();
+    prvStartDelayedTasks( xWakeTimeDelays, uxTasks );
+
+    /* The longest delay is the last. */
+    return prvCheckWakeTimes( uxTasks, xWakeTimeDelays[ uxTasks - 1U ] + pdMS_TO_TICKS( 1000 ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMpscProducerTask( void * pvParameters )
+{
+    const uint32_t ulProducer = ( uint32_t ) ( uintptr_t ) pvParameters;
+    uint32_t ulItem;
+
+    while( ( TickType_t ) ( xTaskGetTickCount() - xMpscStartTick ) < testMPSC_TEST_TICKS )
+    {
+        ulItem = ( ulProducer << testMPSC_PRODUCER_SHIFT ) | ( ulMpscItemsSent[ ulProducer ] & testMPSC_SEQUENCE_MASK );
+
+        /* Flag the send so the tick hook can tell when it is interrupting
+         * one.  An item that does not fit is sent again. */
+        xMpscTaskSending[ ulProducer ] = pdTRUE;
+
+        if( xMpscQueueSend( xMpscQueue, &ulItem ) == pdPASS )
+        {
+            xMpscTaskSending[ ulProducer ] = pdFALSE;
+            ulMpscItemsSent[ ulProducer ]++;
+        }
+        else
+        {
+            xMpscTaskSending[ ulProducer ] = pdFALSE;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    {
+        uxMpscTaskProducersRunning--;
+    }
+    taskEXIT_CRITICAL();
+
+    /* The test deletes the task once it has finished with the queue. */
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMpscTickHookProducers( void )
+{
+    const MpscQueueHandle_t xQueue = xMpscTickHookQueue;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t ulProducer, ulItem;
+
+    /* Runs in the SIGALRM handler, so it can interrupt a task producer at any
+     * point in xMpscQueueSend() that is not in a critical section. */
+    if( xQueue != NULL )
+    {
+        for( ulProducer = 0; ulProducer < testMPSC_TASK_PRODUCERS; ulProducer++ )
+        {
+            if( xMpscTaskSending[ ulProducer ] != pdFALSE )
+            {
+                ulMpscInterruptedSends++;
+                break;
+            }
+        }
+
+        for( ulProducer = testMPSC_TASK_PRODUCERS; ulProducer < testMPSC_PRODUCERS; ulProducer++ )
+        {
+            ulItem = ( ulProducer << testMPSC_PRODUCER_SHIFT ) | ( ulMpscItemsSent[ ulProducer ] & testMPSC_SEQUENCE_MASK );
+
+            /* An item that does not fit is sent again on the next tick. */
+            if( xMpscQueueSendFromISR( xQueue, &ulItem, &xHigherPriorityTaskWoken ) == pdPASS )
+            {
+                ulMpscItemsSent[ ulProducer ]++;
+            }
+        }
+
+        /* The tick interrupt switches task itself if one is needed. */
+        ( void ) xHigherPriorityTaskWoken;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMpscQueueInterruptStressTest( void )
+{
+    uint32_t ulItemsReceived[ testMPSC_PRODUCERS ] = { 0 };
+    uint32_t ulItem, ulProducer;
+    MpscQueueHandle_t xQueue;
+    BaseType_t xResult = pdPASS, xReturned;
+    TickType_t xTicksToWait, xReceiveStartTick, xTicksWaited;
+    UBaseType_t uxItemsWaiting;
+
+    xQueue = xMpscQueueCreate( testMPSC_QUEUE_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xQueue );
+
+    for( ulProducer = 0; ulProducer < testMPSC_PRODUCERS; ulProducer++ )
+    {
+        ulMpscItemsSent[ ulProducer ] = 0;
+    }
+
+    ulMpscInterruptedSends = 0;
+    ulMpscReceiveBlocks = 0;
+
+    /* The producer tasks have a lower priority than this task, so they only
+     * run, time sliced by the tick, while this task is blocked on the queue. */
+    vTaskSuspendAll();
+    {
+        xMpscStartTick = xTaskGetTickCount();
+        uxMpscTaskProducersRunning = testMPSC_TASK_PRODUCERS;
+        xMpscQueue = xQueue;
+        xMpscTickHookQueue = xQueue;
+
+        for( ulProducer = 0; ulProducer < testMPSC_TASK_PRODUCERS; ulProducer++ )
+        {
+            xReturned = xTaskCreate( prvMpscProducerTask, "Producer", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) ulProducer, testMPSC_PRODUCER_PRIORITY, &( xMpscProducerTasks[ ulProducer ] ) );
+            configASSERT( xReturned == pdPASS );
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    /* Receive until the task producers have stopped, blocking whenever the
+     * queue is empty, then stop the tick hook producers and empty the queue
+     * without blocking.  The tick hook runs to completion before this task
+     * runs again, so no item is sent once xMpscTickHookQueue has been
+     * cleared. */
+    while( xResult == pdPASS )
+    {
+        if( uxMpscTaskProducersRunning == 0U )
+        {
+            xMpscTickHookQueue = NULL;
+            xTicksToWait = 0;
+        }
+        else if( ( TickType_t ) ( xTaskGetTickCount() - xMpscStartTick ) > ( testMPSC_TEST_TICKS * 2U ) )
+        {
+            /* A producer is stuck in xMpscQueueSend(). */
+            xResult = prvFail( "%u producer tasks did not stop", ( unsigned ) uxMpscTaskProducersRunning );
+            break;
+        }
+        else
+        {
+            xTicksToWait = testMPSC_RECEIVE_TIMEOUT;
+        }
+
+        xReceiveStartTick = xTaskGetTickCount();
+
+        if( xMpscQueueReceive( xQueue, &ulItem, xTicksToWait ) != pdPASS )
+        {
+            uxItemsWaiting = uxMpscQueueItemsWaiting( xQueue );
+
+            if( xTicksToWait == 0U )
+            {
+                /* The queue has been emptied. */
+                break;
+            }
+            else if( uxItemsWaiting != 0U )
+            {
+                /* A producer published an item while this task was blocked
+                 * without notifying it, or this task blocked after an item was
+                 * published without seeing it. */
+                xResult = prvFail( "a receive timed out after %lu ticks with %u items waiting",
+                                   ( unsigned long ) testMPSC_RECEIVE_TIMEOUT, ( unsigned ) uxItemsWaiting );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            continue;
+        }
+
+        /* A receive that waits out its timeout before finding an item missed
+         * the notification from the producer that published it.  That is only
+         * known while the task producers are still running, as once they have
+         * stopped a tickless idle task can sleep through the ticks on which
+         * the tick hook would have sent. */
+        xTicksWaited = xTaskGetTickCount() - xReceiveStartTick;
+
+        if( ( xTicksToWait != 0U ) && ( uxMpscTaskProducersRunning != 0U ) && ( xTicksWaited >= testMPSC_RECEIVE_TIMEOUT ) )
+        {
+            xResult = prvFail( "a receive waited %lu ticks for an item the tick hook sends every tick", ( unsigned long ) xTicksWaited );
+            break;
+        }
+
+        ulProducer = ulItem >> testMPSC_PRODUCER_SHIFT;
+
+        /* Each producer's items are received in the order it sent them, so an
+         * item is either the next one expected, or items from that producer
+         * were lost or duplicated. */
+        if( ulProducer >= testMPSC_PRODUCERS )
+        {
+            xResult = prvFail( "received item 0x%08lx from an unknown producer", ( unsigned long ) ulItem );
+        }
+        else if( ( ulItem & testMPSC_SEQUENCE_MASK ) != ( ulItemsReceived[ ulProducer ] & testMPSC_SEQUENCE_MASK ) )
+        {
+            xResult = prvFail( "received item %lu from producer %lu when item %lu was expected",
+                               ( unsigned long ) ( ulItem & testMPSC_SEQUENCE_MASK ), ( unsigned long ) ulProducer,
+                               ( unsigned long ) ( ulItemsReceived[ ulProducer ] & testMPSC_SEQUENCE_MASK ) );
+        }
+        else
+        {
+            ulItemsReceived[ ulProducer ]++;
+        }
+    }
+
+    /* Stop the producers if the loop above was left early.  A producer task
+     * deleted part way through a send leaves a slot claimed, which does not
+     * matter as the queue is deleted next. */
+    xMpscTickHookQueue = NULL;
+
+    for( ulProducer = 0; ulProducer < testMPSC_TASK_PRODUCERS; ulProducer++ )
+    {
+        vTaskDelete( xMpscProducerTasks[ ulProducer ] );
+    }
+
+    for( ulProducer = 0; ( ulProducer < testMPSC_PRODUCERS ) && ( xResult == pdPASS ); ulProducer++ )
+    {
+        if( ulItemsReceived[ ulProducer ] != ulMpscItemsSent[ ulProducer ] )
+        {
+            xResult = prvFail( "producer %lu sent %lu items but %lu were received", ( unsigned long ) ulProducer,
+                               ( unsigned long ) ulMpscItemsSent[ ulProducer ], ( unsigned long ) ulItemsReceived[ ulProducer ] );
+        }
+    }
+
+    if( ( xResult == pdPASS ) && ( ulMpscInterruptedSends == 0U ) )
+    {
+        xResult = prvFail( "the tick hook never interrupted a task part way through a send" );
+    }
+
+    if( ( xResult == pdPASS ) && ( ulMpscReceiveBlocks == 0U ) )
+    {
+        xResult = prvFail( "the consumer never blocked on an empty queue" );
+    }
+
+    vMpscQueueDelete( xQueue );
+
+    /* Let the idle task free the producer tasks. */
+    vTaskDelay( 2 );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPriorityQueueOrderTest( void )
+{
+    PriorityItem_t xSent[ testPRIORITY_QUEUE_LENGTH ], xItem;
+    UBaseType_t uxItemsInQueue = 0, uxRound, x, uxExpected, uxToReceive;
+    UBaseType_t uxKey = 0, uxRunLeft = 0;
+    uint32_t ulRandom = 0x2545f491UL, ulSendIndex = 0;
+    QueueHandle_t xQueue;
+    BaseType_t xResult = pdPASS;
+
+    xQueue = xQueueCreatePriority( testPRIORITY_QUEUE_LENGTH, sizeof( PriorityItem_t ) );
+    configASSERT( xQueue );
+
+    /* xSent[] holds the items in the queue, in no particular order. */
+    for( uxRound = 0; ( uxRound <= testPRIORITY_QUEUE_ROUNDS ) && ( xResult == pdPASS ); uxRound++ )
+    {
+        /* Fill the queue, other than after the last round. */
+        while( ( uxRound < testPRIORITY_QUEUE_ROUNDS ) && ( uxItemsInQueue < testPRIORITY_QUEUE_LENGTH ) && ( xResult == pdPASS ) )
+        {
+            if( uxRunLeft == 0U )
+            {
+                ulRandom = ( ulRandom * 1103515245UL ) + 12345UL;
+                uxKey = ( UBaseType_t ) ( ( ulRandom >> 16 ) % testPRIORITY_QUEUE_KEYS );
+                uxRunLeft = ( UBaseType_t ) ( ( ( ulRandom >> 8 ) % testPRIORITY_QUEUE_MAX_RUN ) + 1UL );
+            }
+
+            uxRunLeft--;
+            xItem.uxKey = uxKey;
+            xItem.ulSendIndex = ulSendIndex++;
+
+            if( xQueueSend( xQueue, &xItem, 0 ) != pdPASS )
+            {
+                xResult = prvFail( "a queue holding %u of %u items was full", ( unsigned ) uxItemsInQueue, testPRIORITY_QUEUE_LENGTH );
+            }
+            else
+            {
+                xSent[ uxItemsInQueue ] = xItem;
+                uxItemsInQueue++;
+            }
+        }
+
+        if( ( xResult == pdPASS ) && ( uxRound < testPRIORITY_QUEUE_ROUNDS ) && ( xQueueSend( xQueue, &xItem, 0 ) != errQUEUE_FULL ) )
+        {
+            xResult = prvFail( "an item was sent to a full queue" );
+        }
+
+        uxToReceive = ( ( uxRound % 2U ) == 0U ) ? ( uxItemsInQueue / 2U ) : uxItemsInQueue;
+
+        while( ( uxToReceive > 0U ) && ( xResult == pdPASS ) )
+        {
+            /* The item expected is the one with the highest key, and of those
+             * the one sent first. */
+            uxExpected = 0;
+
+            for( x = 1; x < uxItemsInQueue; x++ )
+            {
+                if( ( xSent[ x ].uxKey > xSent[ uxExpected ].uxKey ) ||
+                    ( ( xSent[ x ].uxKey == xSent[ uxExpected ].uxKey ) && ( xSent[ x ].ulSendIndex < xSent[ uxExpected ].ulSendIndex ) ) )
+                {
+                    uxExpected = x;
+                }
+            }
+
+            if( xQueueReceive( xQueue, &xItem, 0 ) != pdPASS )
+            {
+                xResult = prvFail( "a queue holding %u items was empty", ( unsigned ) uxItemsInQueue );
+            }
+            else if( ( xItem.uxKey != xSent[ uxExpected ].uxKey ) || ( xItem.ulSendIndex != xSent[ uxExpected ].ulSendIndex ) )
+            {
+                xResult = prvFail( "received item %lu with key %lu when item %lu with key %lu was expected",
+                                   ( unsigned long ) xItem.ulSendIndex, ( unsigned long ) xItem.uxKey,
+                                   ( unsigned long ) xSent[ uxExpected ].ulSendIndex, ( unsigned long ) xSent[ uxExpected ].uxKey );
+            }
+            else
+            {
+                uxItemsInQueue--;
+                xSent[ uxExpected ] = xSent[ uxItemsInQueue ];
+                uxToReceive--;
+            }
+        }
+    }
+
+    if( ( xResult == pdPASS ) && ( uxQueueMessagesWaiting( xQueue ) != 0U ) )
+    {
+        xResult = prvFail( "%u items were left in the queue", ( unsigned ) uxQueueMessagesWaiting( xQueue ) );
+    }
+
+    vQueueDelete( xQueue );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopySenderTask( void * pvParameters )
+{
+    const uint32_t ulItem = ( uint32_t ) ( uintptr_t ) pvParameters;
+
+    xZeroCopyPeerResult = xQueueSend( xZeroCopyQueue, &ulItem, testZERO_COPY_TIMEOUT );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopyReceiverTask( void * pvParameters )
+{
+    uint32_t ulItem = 0;
+
+    ( void ) pvParameters;
+
+    xZeroCopyPeerResult = xQueueReceive( xZeroCopyQueue, &ulItem, testZERO_COPY_TIMEOUT );
+    ulZeroCopyPeerItem = ulItem;
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueZeroCopySlotsTest( void )
+{
+    uint32_t * pulSlot;
+    const uint32_t * pulItem;
+    uint32_t ulItem = 0;
+    TaskHandle_t xSender, xReceiver;
+    BaseType_t xReturned, xResult = pdPASS;
+
+    xZeroCopyQueue = xQueueCreate( testZERO_COPY_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xZeroCopyQueue );
+
+    /* A reserved slot counts as full to every other writer, and its item
+     * cannot be read until it is committed. */
+    pulSlot = ( uint32_t * ) pvQueueReserve( xZeroCopyQueue, 0 );
+
+    if( pulSlot == NULL )
+    {
+        xResult = prvFail( "no slot of an empty queue could be reserved" );
+    }
+    else if( xQueueSend( xZeroCopyQueue, &ulItem, 0 ) != errQUEUE_FULL )
+    {
+        xResult = prvFail( "an item was sent while a slot was reserved" );
+    }
+    else if( ( pvQueueReserve( xZeroCopyQueue, 0 ) != NULL ) || ( pvQueueReserveFromISR( xZeroCopyQueue ) != NULL ) )
+    {
+        xResult = prvFail( "a second slot was reserved" );
+    }
+    else if( ( uxQueueMessagesWaiting( xZeroCopyQueue ) != 0U ) || ( xQueueReceive( xZeroCopyQueue, &ulItem, 0 ) != errQUEUE_EMPTY ) )
+    {
+        xResult = prvFail( "the item in a reserved slot could be received before it was committed" );
+    }
+
+    /* A writer blocked only because the slot is reserved can send once it is
+     * committed. */
+    if( xResult == pdPASS )
+    {
+        xZeroCopyPeerResult = testZERO_COPY_WAITING;
+        xReturned = xTaskCreate( prvZeroCopySenderTask, "Sender", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) 2U, testHIGH_PRIORITY, &xSender );
+        configASSERT( xReturned == pdPASS );
+
+        if( xZeroCopyPeerResult != testZERO_COPY_WAITING )
+        {
+            xResult = prvFail( "a task sent to the queue while a slot was reserved" );
+        }
+        else
+        {
+            *pulSlot = 1U;
+
+            if( xQueueCommit( xZeroCopyQueue ) != pdPASS )
+            {
+                xResult = prvFail( "the reserved slot could not be committed" );
+            }
+            else if( xZeroCopyPeerResult != pdPASS )
+            {
+                xResult = prvFail( "committing the slot did not let the blocked task send" );
+            }
+            else if( uxQueueMessagesWaiting( xZeroCopyQueue ) != 2U )
+            {
+                xResult = prvFail( "the queue held %u items after the commit and send, expected 2", ( unsigned ) uxQueueMessagesWaiting( xZeroCopyQueue ) );
+            }
+            else if( xQueueCommit( xZeroCopyQueue ) != pdFAIL )
+            {
+                xResult = prvFail( "a slot was committed twice" );
+            }
+        }
+
+        vTaskDelete( xSender );
+    }
+
+    /* An acquired item counts as empty to every other reader, and as full to
+     * writers that send to the front, but not to those that send to the
+     * back. */
+    if( xResult == pdPASS )
+    {
+        pulItem = ( const uint32_t * ) pvQueueAcquire( xZeroCopyQueue, 0 );
+        ulItem = 3U;
+
+        if( ( pulItem == NULL ) || ( *pulItem != 1U ) )
+        {
+            xResult = prvFail( "the committed item was not acquired first" );
+        }
+        else if( ( xQueueReceive( xZeroCopyQueue, &ulItem, 0 ) != errQUEUE_EMPTY ) || ( xQueuePeek( xZeroCopyQueue, &ulItem, 0 ) != errQUEUE_EMPTY ) )
+        {
+            xResult = prvFail( "an item was received while another was acquired" );
+        }
+        else if( ( pvQueueAcquire( xZeroCopyQueue, 0 ) != NULL ) || ( pvQueueAcquireFromISR( xZeroCopyQueue ) != NULL ) )
+        {
+            xResult = prvFail( "a second item was acquired" );
+        }
+        else if( xQueueSendToFront( xZeroCopyQueue, &ulItem, 0 ) != errQUEUE_FULL )
+        {
+            xResult = prvFail( "an item was sent to the front while an item was acquired" );
+        }
+        else if( xQueueSendToBack( xZeroCopyQueue, &ulItem, 0 ) != pdPASS )
+        {
+            xResult = prvFail( "an item could not be sent to the back while an item was acquired" );
+        }
+    }
+
+    /* A reader blocked only because the item is acquired can receive once it
+     * is released. */
+    if( xResult == pdPASS )
+    {
+        xZeroCopyPeerResult = testZERO_COPY_WAITING;
+        xReturned = xTaskCreate( prvZeroCopyReceiverTask, "Receiver", configMINIMAL_STACK_SIZE, NULL, testHIGH_PRIORITY, &xReceiver );
+        configASSERT( xReturned == pdPASS );
+
+        if( xZeroCopyPeerResult != testZERO_COPY_WAITING )
+        {
+            xResult = prvFail( "a task received from the queue while an item was acquired" );
+        }
+        else if( xQueueRelease( xZeroCopyQueue ) != pdPASS )
+        {
+            xResult = prvFail( "the acquired item could not be released" );
+        }
+        else if( ( xZeroCopyPeerResult != pdPASS ) || ( ulZeroCopyPeerItem != 2U ) )
+        {
+            xResult = prvFail( "releasing the item did not let the blocked task receive the item after it" );
+        }
+        else if( xQueueRelease( xZeroCopyQueue ) != pdFAIL )
+        {
+            xResult = prvFail( "an item was released twice" );
+        }
+        else if( ( xQueueReceive( xZeroCopyQueue, &ulItem, 0 ) != pdPASS ) || ( ulItem != 3U ) || ( uxQueueMessagesWaiting( xZeroCopyQueue ) != 0U ) )
+        {
+            xResult = prvFail( "the item sent while an item was acquired was not left in the queue on its own" );
+        }
+
+        vTaskDelete( xReceiver );
+    }
+
+    /* Let the idle task free the tasks. */
+    vTaskDelay( 2 );
+
+    vQueueDelete( xZeroCopyQueue );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueZeroCopyOrderTest( void )
+{
+    uint32_t * pulSlot;
+    const uint32_t * pulItem;
+    uint32_t ulSent, ulReceived = 0, ulItem;
+    BaseType_t xResult = pdPASS;
+
+    xZeroCopyQueue = xQueueCreate( testZERO_COPY_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xZeroCopyQueue );
+
+    /* Items written in place and copied in alternate, as do items read in
+     * place and copied out, so each way of writing and reading an item is
+     * used in every slot, including the slot before the positions wrap. */
+    for( ulSent = 0; ( ulSent < testZERO_COPY_ITEMS ) && ( xResult == pdPASS ); ulSent++ )
+    {
+        if( ( ulSent % 2UL ) == 0UL )
+        {
+            pulSlot = ( uint32_t * ) pvQueueReserve( xZeroCopyQueue, 0 );
+
+            if( pulSlot == NULL )
+            {
+                xResult = prvFail( "no slot could be reserved for item %lu", ( unsigned long ) ulSent );
+            }
+            else
+            {
+                *pulSlot = ulSent;
+                ( void ) xQueueCommit( xZeroCopyQueue );
+            }
+        }
+        else if( xQueueSend( xZeroCopyQueue, &ulSent, 0 ) != pdPASS )
+        {
+            xResult = prvFail( "item %lu could not be sent", ( unsigned long ) ulSent );
+        }
+
+        /* Read an item whenever the queue fills, and every item once all of
+         * them have been sent. */
+        while( ( xResult == pdPASS ) &&
+               ( ( uxQueueMessagesWaiting( xZeroCopyQueue ) == testZERO_COPY_LENGTH ) ||
+                 ( ( ulSent == ( testZERO_COPY_ITEMS - 1UL ) ) && ( ulReceived <= ulSent ) ) ) )
+        {
+            if( ( ulReceived % 2UL ) == 0UL )
+            {
+                pulItem = ( const uint32_t * ) pvQueueAcquire( xZeroCopyQueue, 0 );
+                ulItem = ( pulItem != NULL ) ? *pulItem : UINT32_MAX;
+
+                if( ( pulItem != NULL ) && ( xQueueRelease( xZeroCopyQueue ) != pdPASS ) )
+                {
+                    xResult = prvFail( "item %lu could not be released", ( unsigned long ) ulItem );
+                }
+            }
+            else if( xQueueReceive( xZeroCopyQueue, &ulItem, 0 ) != pdPASS )
+            {
+                ulItem = UINT32_MAX;
+            }
+
+            if( ( xResult == pdPASS ) && ( ulItem != ulReceived ) )
+            {
+                xResult = prvFail( "read item %lu when item %lu was expected", ( unsigned long ) ulItem, ( unsigned long ) ulReceived );
+            }
+
+            ulReceived++;
+        }
+    }
+
+    if( ( xResult == pdPASS ) && ( uxQueueMessagesWaiting( xZeroCopyQueue ) != 0U ) )
+    {
+        xResult = prvFail( "%u items were left in the queue", ( unsigned ) uxQueueMessagesWaiting( xZeroCopyQueue ) );
+    }
+
+    vQueueDelete( xZeroCopyQueue );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchSenderTask( void * pvParameters )
+{
+    uint32_t ulItem;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ulItem = ulBatchNextItem;
+
+        if( uxQueueSpacesAvailable( xBatchQueue ) == 0U )
+        {
+            ( void ) xQueueSend( xBatchQueue, &ulItem, portMAX_DELAY );
+            uxBatchWakes++;
+            uxBatchLeftOnWake = uxQueueSpacesAvailable( xBatchQueue );
+        }
+        else
+        {
+            ( void ) xQueueSend( xBatchQueue, &ulItem, 0 );
+        }
+
+        ulBatchNextItem = ulItem + 1UL;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchReceiverTask( void * pvParameters )
+{
+    uint32_t ulItem = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        if( uxQueueMessagesWaiting( xBatchQueue ) == 0U )
+        {
+            ( void ) xQueueReceive( xBatchQueue, &ulItem, portMAX_DELAY );
+            uxBatchWakes++;
+            uxBatchLeftOnWake = uxQueueMessagesWaiting( xBatchQueue );
+        }
+        else
+        {
+            ( void ) xQueueReceive( xBatchQueue, &ulItem, 0 );
+        }
+
+        if( ulItem != ulBatchNextItem )
+        {
+            xBatchOutOfOrder = pdTRUE;
+        }
+
+        ulBatchNextItem = ulItem + 1UL;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueSendMultipleTest( void )
+{
+    uint32_t ulItems[ testBATCH_LENGTH + testBATCH_EXTRA ], ulItem;
+    UBaseType_t uxSent, x;
+    TickType_t xStart, xElapsed;
+    TaskHandle_t xReceiver;
+    BaseType_t xHigherPriorityTaskWoken, xReturned, xResult = pdPASS;
+
+    xBatchQueue = xQueueCreate( testBATCH_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xBatchQueue );
+
+    for( x = 0; x < testARRAY_LENGTH( ulItems ); x++ )
+    {
+        ulItems[ x ] = ( uint32_t ) x;
+    }
+
+    /* With no receiver, a send of more items than there is space for posts
+     * the items that fit, waits out its block time, and reports only the
+     * items it posted. */
+    ( void ) xQueueSend( xBatchQueue, &ulItems[ 0 ], 0 );
+    xStart = xTaskGetTickCount();
+    uxSent = uxQueueSendMultiple( xBatchQueue, &ulItems[ 1 ], testBATCH_LENGTH + testBATCH_EXTRA - 1U, testBATCH_TIMEOUT );
+    xElapsed = xTaskGetTickCount() - xStart;
+
+    if( uxSent != ( testBATCH_LENGTH - 1U ) )
+    {
+        xResult = prvFail( "a send that timed out with space for %u items reported %u", ( unsigned ) ( testBATCH_LENGTH - 1U ), ( unsigned ) uxSent );
+    }
+    else if( xElapsed < testBATCH_TIMEOUT )
+    {
+        xResult = prvFail( "a partial send returned after %lu ticks, before its %lu tick block time", ( unsigned long ) xElapsed, ( unsigned long ) testBATCH_TIMEOUT );
+    }
+    else if( uxQueueSendMultipleFromISR( xBatchQueue, &ulItems[ testBATCH_LENGTH ], testBATCH_EXTRA, NULL ) != 0U )
+    {
+        xResult = prvFail( "items were sent from an interrupt to a full queue" );
+    }
+
+    for( x = 0; ( x < testBATCH_LENGTH ) && ( xResult == pdPASS ); x++ )
+    {
+        if( ( xQueueReceive( xBatchQueue, &ulItem, 0 ) != pdPASS ) || ( ulItem != ulItems[ x ] ) )
+        {
+            xResult = prvFail( "item %u of the partial send was not received in order", ( unsigned ) x );
+        }
+    }
+
+    if( ( xResult == pdPASS ) && ( uxQueueMessagesWaiting( xBatchQueue ) != 0U ) )
+    {
+        xResult = prvFail( "the queue held more items than the partial send reported" );
+    }
+
+    /* A higher priority task blocked on the empty queue is unblocked once per
+     * batch, with every item of the batch already in the queue, whether the
+     * batch is sent from a task or an interrupt. */
+    if( xResult == pdPASS )
+    {
+        ulBatchNextItem = 0;
+        uxBatchWakes = 0;
+        xBatchOutOfOrder = pdFALSE;
+        xReturned = xTaskCreate( prvBatchReceiverTask, "Receiver", configMINIMAL_STACK_SIZE, NULL, testHIGH_PRIORITY, &xReceiver );
+        configASSERT( xReturned == pdPASS );
+
+        uxSent = uxQueueSendMultiple( xBatchQueue, ulItems, testBATCH_LENGTH, 0 );
+
+        if( uxSent != testBATCH_LENGTH )
+        {
+            xResult = prvFail( "a send to an empty queue reported %u of %u items", ( unsigned ) uxSent, ( unsigned ) testBATCH_LENGTH );
+        }
+        else if( ( uxBatchWakes != 1U ) || ( uxBatchLeftOnWake != ( testBATCH_LENGTH - 1U ) ) )
+        {
+            xResult = prvFail( "the receiver was unblocked %u times, finding %u items left, expected once finding %u",
+                               ( unsigned ) uxBatchWakes, ( unsigned ) uxBatchLeftOnWake, ( unsigned ) ( testBATCH_LENGTH - 1U ) );
+        }
+
+        if( xResult == pdPASS )
+        {
+            for( x = 0; x < testARRAY_LENGTH( ulItems ); x++ )
+            {
+                ulItems[ x ] = ( uint32_t ) ( x + testBATCH_LENGTH );
+            }
+
+            /* Suspending the scheduler holds the receiver off until the
+             * send has returned, as an interrupt would. */
+            xHigherPriorityTaskWoken = pdFALSE;
+            vTaskSuspendAll();
+            {
+                uxSent = uxQueueSendMultipleFromISR( xBatchQueue, ulItems, testARRAY_LENGTH( ulItems ), &xHigherPriorityTaskWoken );
+            }
+            ( void ) xTaskResumeAll();
+
+            if( uxSent != testBATCH_LENGTH )
+            {
+                xResult = prvFail( "a send from an interrupt reported %u items, expected the %u that fit", ( unsigned ) uxSent, ( unsigned ) testBATCH_LENGTH );
+            }
+            else if( xHigherPriorityTaskWoken == pdFALSE )
+            {
+                xResult = prvFail( "a send from an interrupt did not report that it woke a higher priority task" );
+            }
+            else if( ( uxBatchWakes != 2U ) || ( uxBatchLeftOnWake != ( testBATCH_LENGTH - 1U ) ) )
+            {
+                xResult = prvFail( "the receiver was unblocked %u times, finding %u items left, expected twice finding %u",
+                                   ( unsigned ) uxBatchWakes, ( unsigned ) uxBatchLeftOnWake, ( unsigned ) ( testBATCH_LENGTH - 1U ) );
+            }
+        }
+
+        if( ( xResult == pdPASS ) && ( ( xBatchOutOfOrder != pdFALSE ) || ( ulBatchNextItem != ( 2U * testBATCH_LENGTH ) ) ) )
+        {
+            xResult = prvFail( "the receiver did not receive items 0 to %u in order", ( unsigned ) ( ( 2U * testBATCH_LENGTH ) - 1U ) );
+        }
+
+        vTaskDelete( xReceiver );
+
+        /* Let the idle task free the task. */
+        vTaskDelay( 2 );
+    }
+
+    vQueueDelete( xBatchQueue );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueReceiveMultipleTest( void )
+{
+    uint32_t ulItems[ testBATCH_LENGTH + testBATCH_EXTRA ];
+    UBaseType_t uxReceived, x;
+    TickType_t xStart, xElapsed;
+    TaskHandle_t xSender;
+    BaseType_t xHigherPriorityTaskWoken, xReturned, xResult = pdPASS;
+
+    xBatchQueue = xQueueCreate( testBATCH_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xBatchQueue );
+
+    /* With no sender, a receive of more items than the queue holds returns
+     * the items there are, oldest first, once its block time has passed. */
+    for( x = 0; x < ( testBATCH_LENGTH - 1U ); x++ )
+    {
+        ulItems[ 0 ] = ( uint32_t ) x;
+        ( void ) xQueueSend( xBatchQueue, &ulItems[ 0 ], 0 );
+    }
+
+    ( void ) memset( ulItems, 0xff, sizeof( ulItems ) );
+    xStart = xTaskGetTickCount();
+    uxReceived = uxQueueReceiveMultiple( xBatchQueue, ulItems, testARRAY_LENGTH( ulItems ), testBATCH_TIMEOUT );
+    xElapsed = xTaskGetTickCount() - xStart;
+
+    if( uxReceived != ( testBATCH_LENGTH - 1U ) )
+    {
+        xResult = prvFail( "a receive that timed out with %u items queued reported %u", ( unsigned ) ( testBATCH_LENGTH - 1U ), ( unsigned ) uxReceived );
+    }
+    else if( xElapsed < testBATCH_TIMEOUT )
+    {
+        xResult = prvFail( "a partial receive returned after %lu ticks, before its %lu tick block time", ( unsigned long ) xElapsed, ( unsigned long ) testBATCH_TIMEOUT );
+    }
+    else if( ulItems[ uxReceived ] != UINT32_MAX )
+    {
+        xResult = prvFail( "a partial receive wrote past the items it reported" );
+    }
+    else if( uxQueueReceiveMultipleFromISR( xBatchQueue, ulItems, testARRAY_LENGTH( ulItems ), NULL ) != 0U )
+    {
+        xResult = prvFail( "items were received from an empty queue in an interrupt" );
+    }
+
+    for( x = 0; ( x < uxReceived ) && ( xResult == pdPASS ); x++ )
+    {
+        if( ulItems[ x ] != ( uint32_t ) x )
+        {
+            xResult = prvFail( "received item %lu when item %u was expected", ( unsigned long ) ulItems[ x ], ( unsigned ) x );
+        }
+    }
+
+    /* A higher priority task blocked on the full queue is unblocked once per
+     * batch, with every item of the batch already removed, whether the batch
+     * is received by a task or an interrupt.  The sender fills the queue
+     * again each time, so the items are numbered on from those before. */
+    if( xResult == pdPASS )
+    {
+        ulBatchNextItem = 0;
+        uxBatchWakes = 0;
+        xReturned = xTaskCreate( prvBatchSenderTask, "Sender", configMINIMAL_STACK_SIZE, NULL, testHIGH_PRIORITY, &xSender );
+        configASSERT( xReturned == pdPASS );
+
+        uxReceived = uxQueueReceiveMultiple( xBatchQueue, ulItems, testBATCH_LENGTH, 0 );
+
+        if( uxReceived != testBATCH_LENGTH )
+        {
+            xResult = prvFail( "a receive from a full queue reported %u of %u items", ( unsigned ) uxReceived, ( unsigned ) testBATCH_LENGTH );
+        }
+        else if( ( uxBatchWakes != 1U ) || ( uxBatchLeftOnWake != ( testBATCH_LENGTH - 1U ) ) )
+        {
+            xResult = prvFail( "the sender was unblocked %u times, finding %u spaces left, expected once finding %u",
+                               ( unsigned ) uxBatchWakes, ( unsigned ) uxBatchLeftOnWake, ( unsigned ) ( testBATCH_LENGTH - 1U ) );
+        }
+
+        if( xResult == pdPASS )
+        {
+            /* Suspending the scheduler holds the sender off until the
+             * receive has returned, as an interrupt would. */
+            xHigherPriorityTaskWoken = pdFALSE;
+            vTaskSuspendAll();
+            {
+                uxReceived = uxQueueReceiveMultipleFromISR( xBatchQueue, &ulItems[ testBATCH_LENGTH ], testBATCH_EXTRA, &xHigherPriorityTaskWoken );
+                uxReceived += uxQueueReceiveMultipleFromISR( xBatchQueue, ulItems, testBATCH_LENGTH, &xHigherPriorityTaskWoken );
+            }
+            ( void ) xTaskResumeAll();
+
+            if( uxReceived != testBATCH_LENGTH )
+            {
+                xResult = prvFail( "receives from an interrupt reported %u items, expected the %u queued", ( unsigned ) uxReceived, ( unsigned ) testBATCH_LENGTH );
+            }
+            else if( xHigherPriorityTaskWoken == pdFALSE )
+            {
+                xResult = prvFail( "a receive from an interrupt did not report that it woke a higher priority task" );
+            }
+            else if( ( uxBatchWakes != 2U ) || ( uxBatchLeftOnWake != ( testBATCH_LENGTH - 1U ) ) )
+            {
+                xResult = prvFail( "the sender was unblocked %u times, finding %u spaces left, expected twice finding %u",
+                                   ( unsigned ) uxBatchWakes, ( unsigned ) uxBatchLeftOnWake, ( unsigned ) ( testBATCH_LENGTH - 1U ) );
+            }
+        }
+
+        for( x = 0; ( x < testBATCH_LENGTH ) && ( xResult == pdPASS ); x++ )
+        {
+            /* The first receive from the interrupt took the first
+             * testBATCH_EXTRA items, into the end of the buffer. */
+            uxReceived = ( x < testBATCH_EXTRA ) ? ( testBATCH_LENGTH + x ) : ( x - testBATCH_EXTRA );
+
+            if( ulItems[ uxReceived ] != ( uint32_t ) ( testBATCH_LENGTH + x ) )
+            {
+                xResult = prvFail( "received item %lu when item %u was expected", ( unsigned long ) ulItems[ uxReceived ], ( unsigned ) ( testBATCH_LENGTH + x ) );
+            }
+        }
+
+        if( ( xResult == pdPASS ) && ( ulBatchNextItem != ( 3U * testBATCH_LENGTH ) ) )
+        {
+            xResult = prvFail( "the sender sent %lu items, expected %u", ( unsigned long ) ulBatchNextItem, ( unsigned ) ( 3U * testBATCH_LENGTH ) );
+        }
+
+        vTaskDelete( xSender );
+
+        /* Let the idle task free the task. */
+        vTaskDelay( 2 );
+    }
+
+    vQueueDelete( xBatchQueue );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpscProducerTask( void * pvParameters )
+{
+    const uint32_t ulItem = ulSpscPeerItem;
+
+    xSpscPeerResult = xSpscRingSend( xSpscRing, &ulItem, ( TickType_t ) ( uintptr_t ) pvParameters );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpscConsumerTask( void * pvParameters )
+{
+    uint32_t ulItem = 0;
+
+    xSpscPeerResult = xSpscRingReceive( xSpscRing, &ulItem, ( TickType_t ) ( uintptr_t ) pvParameters );
+    ulSpscPeerItem = ulItem;
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvStartSpscPeer( TaskFunction_t pxTaskCode,
+                                      TickType_t xTicksToWait )
+{
+    TaskHandle_t xPeer;
+    BaseType_t xReturned;
+
+    /* The peer runs straight away, and blocks if the ring is full or empty. */
+    xSpscPeerResult = testSPSC_WAITING;
+    xReturned = xTaskCreate( pxTaskCode, "SpscPeer", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) xTicksToWait, testHIGH_PRIORITY, &xPeer );
+    configASSERT( xReturned == pdPASS );
+
+    return xPeer;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSpscRingOrderTest( void )
+{
+    uint32_t ulSent = 0, ulReceived = 0, ulItem;
+    UBaseType_t uxToReceive, uxRound;
+    BaseType_t xReturned, xHigherPriorityTaskWoken = pdFALSE, xResult = pdPASS;
+
+    xSpscRing = xSpscRingCreate( testSPSC_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xSpscRing );
+
+    /* Fill the ring, then empty it by a different number of items each round,
+     * so items are written and read at every slot, including the slot before
+     * the head and tail wrap.  Tasks and interrupts send and receive in
+     * turn. */
+    for( uxRound = 0; ( ulReceived < testSPSC_ITEMS ) && ( xResult == pdPASS ); uxRound++ )
+    {
+        while( ( ulSent < testSPSC_ITEMS ) && ( xResult == pdPASS ) )
+        {
+            if( ( ulSent % 2UL ) == 0UL )
+            {
+                xReturned = xSpscRingSend( xSpscRing, &ulSent, 0 );
+            }
+            else
+            {
+                xReturned = xSpscRingSendFromISR( xSpscRing, &ulSent, &xHigherPriorityTaskWoken );
+            }
+
+            if( xReturned == pdPASS )
+            {
+                ulSent++;
+            }
+            else if( uxSpscRingItemsWaiting( xSpscRing ) != testSPSC_LENGTH )
+            {
+                xResult = prvFail( "item %lu could not be sent to a ring holding %u of %u items",
+                                   ( unsigned long ) ulSent, ( unsigned ) uxSpscRingItemsWaiting( xSpscRing ), ( unsigned ) testSPSC_LENGTH );
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        uxToReceive = ( ulSent == testSPSC_ITEMS ) ? testSPSC_LENGTH : ( ( uxRound % testSPSC_LENGTH ) + 1U );
+
+        for( ; ( uxToReceive > 0U ) && ( ulReceived < ulSent ) && ( xResult == pdPASS ); uxToReceive-- )
+        {
+            if( ( ulReceived % 2UL ) == 0UL )
+            {
+                xReturned = xSpscRingReceiveFromISR( xSpscRing, &ulItem, &xHigherPriorityTaskWoken );
+            }
+            else
+            {
+                xReturned = xSpscRingReceive( xSpscRing, &ulItem, 0 );
+            }
+
+            if( xReturned != pdPASS )
+            {
+                xResult = prvFail( "a ring holding %lu items was empty", ( unsigned long ) ( ulSent - ulReceived ) );
+            }
+            else if( ulItem != ulReceived )
+            {
+                xResult = prvFail( "received item %lu when item %lu was expected", ( unsigned long ) ulItem, ( unsigned long ) ulReceived );
+            }
+            else
+            {
+                ulReceived++;
+            }
+        }
+
+        if( ( xResult == pdPASS ) && ( uxSpscRingItemsWaiting( xSpscRing ) != ( UBaseType_t ) ( ulSent - ulReceived ) ) )
+        {
+            xResult = prvFail( "the ring reported %u items when it held %lu", ( unsigned ) uxSpscRingItemsWaiting( xSpscRing ), ( unsigned long ) ( ulSent - ulReceived ) );
+        }
+    }
+
+    if( xResult == pdPASS )
+    {
+        if( ( xSpscRingReceive( xSpscRing, &ulItem, 0 ) != errQUEUE_EMPTY ) || ( xSpscRingReceiveFromISR( xSpscRing, &ulItem, &xHigherPriorityTaskWoken ) != errQUEUE_EMPTY ) )
+        {
+            xResult = prvFail( "an item was received from an empty ring" );
+        }
+        else if( xHigherPriorityTaskWoken != pdFALSE )
+        {
+            xResult = prvFail( "a task was reported woken when none was blocked on the ring" );
+        }
+    }
+
+    vSpscRingDelete( xSpscRing );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSpscRingBlockingTest( void )
+{
+    uint32_t ulItem, ulReceived = 0;
+    unsigned long ulNotifications;
+    TickType_t xStart, xElapsed;
+    TaskHandle_t xPeer;
+    BaseType_t xHigherPriorityTaskWoken, xResult = pdPASS;
+
+    xSpscRing = xSpscRingCreate( testSPSC_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xSpscRing );
+
+    /* A receive from an empty ring times out. */
+    xStart = xTaskGetTickCount();
+
+    if( xSpscRingReceive( xSpscRing, &ulItem, testSPSC_SHORT_TIMEOUT ) != errQUEUE_EMPTY )
+    {
+        xResult = prvFail( "an item was received from an empty ring" );
+    }
+    else if( ( xElapsed = xTaskGetTickCount() - xStart ) < testSPSC_SHORT_TIMEOUT )
+    {
+        xResult = prvFail( "a receive from an empty ring returned after %lu ticks, before its %lu tick block time",
+                           ( unsigned long ) xElapsed, ( unsigned long ) testSPSC_SHORT_TIMEOUT );
+    }
+
+    /* A consumer blocked on the empty ring is notified by the first send, and
+     * only by the first, as the send takes its handle. */
+    if( xResult == pdPASS )
+    {
+        xPeer = prvStartSpscPeer( prvSpscConsumerTask, testSPSC_TIMEOUT );
+        ulItem = 1U;
+
+        if( xSpscPeerResult != testSPSC_WAITING )
+        {
+            xResult = prvFail( "the consumer did not block on an empty ring" );
+        }
+        else if( xSpscRingSend( xSpscRing, &ulItem, 0 ) != pdPASS )
+        {
+            xResult = prvFail( "an item could not be sent to an empty ring" );
+        }
+        else if( ( xSpscPeerResult != pdPASS ) || ( ulSpscPeerItem != 1U ) )
+        {
+            xResult = prvFail( "sending did not wake the blocked consumer with the item" );
+        }
+        else if( ( xSpscRingSend( xSpscRing, &ulItem, 0 ) != pdPASS ) || ( xTaskNotifyStateClearIndexed( xPeer, configSPSC_RING_NOTIFICATION_INDEX ) != pdFALSE ) )
+        {
+            xResult = prvFail( "a second send notified the consumer after it had been woken" );
+        }
+        else if( ( xSpscRingReceive( xSpscRing, &ulItem, 0 ) != pdPASS ) || ( uxSpscRingItemsWaiting( xSpscRing ) != 0U ) )
+        {
+            xResult = prvFail( "the second item was not left in the ring on its own" );
+        }
+
+        vTaskDelete( xPeer );
+    }
+
+    /* A consumer that timed out clears its handle, so is not notified by the
+     * next send. */
+    if( xResult == pdPASS )
+    {
+        xPeer = prvStartSpscPeer( prvSpscConsumerTask, testSPSC_SHORT_TIMEOUT );
+        vTaskDelay( testSPSC_SHORT_TIMEOUT + testMIN_DELAY );
+        ulItem = 2U;
+
+        if( xSpscPeerResult != errQUEUE_EMPTY )
+        {
+            xResult = prvFail( "the consumer did not time out on an empty ring" );
+        }
+        else if( ( xSpscRingSend( xSpscRing, &ulItem, 0 ) != pdPASS ) || ( xTaskNotifyStateClearIndexed( xPeer, configSPSC_RING_NOTIFICATION_INDEX ) != pdFALSE ) )
+        {
+            xResult = prvFail( "a send notified a consumer that had timed out" );
+        }
+        else if( ( xSpscRingReceive( xSpscRing, &ulItem, 0 ) != pdPASS ) || ( ulItem != 2U ) )
+        {
+            xResult = prvFail( "the item sent after the consumer timed out was not received" );
+        }
+
+        vTaskDelete( xPeer );
+    }
+
+    /* A send to a full ring times out, and a producer blocked on the full
+     * ring is notified by the first receive, and only by the first. */
+    for( ulItem = 0; ( ulItem < testSPSC_LENGTH ) && ( xResult == pdPASS ); ulItem++ )
+    {
+        ( void ) xSpscRingSend( xSpscRing, &ulItem, 0 );
+    }
+
+    if( xResult == pdPASS )
+    {
+        xStart = xTaskGetTickCount();
+
+        if( xSpscRingSend( xSpscRing, &ulItem, testSPSC_SHORT_TIMEOUT ) != errQUEUE_FULL )
+        {
+            xResult = prvFail( "an item was sent to a full ring" );
+        }
+        else if( ( xElapsed = xTaskGetTickCount() - xStart ) < testSPSC_SHORT_TIMEOUT )
+        {
+            xResult = prvFail( "a send to a full ring returned after %lu ticks, before its %lu tick block time",
+                               ( unsigned long ) xElapsed, ( unsigned long ) testSPSC_SHORT_TIMEOUT );
+        }
+    }
+
+    if( xResult == pdPASS )
+    {
+        ulSpscPeerItem = testSPSC_LENGTH;
+        xPeer = prvStartSpscPeer( prvSpscProducerTask, testSPSC_TIMEOUT );
+
+        if( xSpscPeerResult != testSPSC_WAITING )
+        {
+            xResult = prvFail( "the producer did not block on a full ring" );
+        }
+        else if( ( xSpscRingReceive( xSpscRing, &ulItem, 0 ) != pdPASS ) || ( ulItem != 0U ) )
+        {
+            xResult = prvFail( "the oldest item was not received from a full ring" );
+        }
+        else if( ( xSpscPeerResult != pdPASS ) || ( uxSpscRingItemsWaiting( xSpscRing ) != testSPSC_LENGTH ) )
+        {
+            xResult = prvFail( "receiving did not wake the blocked producer to fill the ring" );
+        }
+        else if( ( xSpscRingReceive( xSpscRing, &ulItem, 0 ) != pdPASS ) || ( xTaskNotifyStateClearIndexed( xPeer, configSPSC_RING_NOTIFICATION_INDEX ) != pdFALSE ) )
+        {
+            xResult = prvFail( "a second receive notified the producer after it had been woken" );
+        }
+
+        vTaskDelete( xPeer );
+    }
+
+    for( ulItem = 2U; ( ulItem <= testSPSC_LENGTH ) && ( xResult == pdPASS ); ulItem++ )
+    {
+        if( ( xSpscRingReceive( xSpscRing, &ulReceived, 0 ) != pdPASS ) || ( ulReceived != ulItem ) )
+        {
+            xResult = prvFail( "item %lu was not received in order after the producer was woken", ( unsigned long ) ulItem );
+        }
+    }
+
+    /* Sending and receiving from an interrupt wake a task blocked on the other
+     * side.  Suspending the scheduler holds the task off until the interrupt
+     * has returned. */
+    if( xResult == pdPASS )
+    {
+        xPeer = prvStartSpscPeer( prvSpscConsumerTask, testSPSC_TIMEOUT );
+        xHigherPriorityTaskWoken = pdFALSE;
+        ulNotifications = ulTaskNotifications;
+        vTaskSuspendAll();
+        {
+            /* The consumer does not run between the sends, so the second
+             * send only finds its handle if the first did not take it. */
+            for( ulItem = 4U; ulItem < 6U; ulItem++ )
+            {
+                ( void ) xSpscRingSendFromISR( xSpscRing, &ulItem, &xHigherPriorityTaskWoken );
+            }
+        }
+        ( void ) xTaskResumeAll();
+        ulNotifications = ulTaskNotifications - ulNotifications;
+
+        if( ( xHigherPriorityTaskWoken == pdFALSE ) || ( xSpscPeerResult != pdPASS ) || ( ulSpscPeerItem != 4U ) )
+        {
+            xResult = prvFail( "sending from an interrupt did not wake the blocked consumer with the item" );
+        }
+        else if( ulNotifications != 1UL )
+        {
+            xResult = prvFail( "two sends notified the blocked consumer %lu times", ulNotifications );
+        }
+        else if( ( xSpscRingReceive( xSpscRing, &ulReceived, 0 ) != pdPASS ) || ( ulReceived != 5U ) )
+        {
+            xResult = prvFail( "the second item sent from an interrupt was not left in the ring" );
+        }
+
+        vTaskDelete( xPeer );
+    }
+
+    for( ulItem = 0; ( ulItem < testSPSC_LENGTH ) && ( xResult == pdPASS ); ulItem++ )
+    {
+        ( void ) xSpscRingSend( xSpscRing, &ulItem, 0 );
+    }
+
+    if( xResult == pdPASS )
+    {
+        ulSpscPeerItem = testSPSC_LENGTH;
+        xPeer = prvStartSpscPeer( prvSpscProducerTask, testSPSC_TIMEOUT );
+        xHigherPriorityTaskWoken = pdFALSE;
+        vTaskSuspendAll();
+        {
+            ( void ) xSpscRingReceiveFromISR( xSpscRing, &ulItem, &xHigherPriorityTaskWoken );
+        }
+        ( void ) xTaskResumeAll();
+
+        if( ( xHigherPriorityTaskWoken == pdFALSE ) || ( xSpscPeerResult != pdPASS ) || ( uxSpscRingItemsWaiting( xSpscRing ) != testSPSC_LENGTH ) )
+        {
+            xResult = prvFail( "receiving from an interrupt did not wake the blocked producer to fill the ring" );
+        }
+
+        vTaskDelete( xPeer );
+    }
+
+    /* A task about to block on a full ring, or on an empty ring, does not
+     * block if the other side makes the ring usable before the task's handle
+     * is published, so cannot see that it should notify the task. */
+    if( xResult == pdPASS )
+    {
+        xSpscMakeUsable = pdTRUE;
+        xStart = xTaskGetTickCount();
+        ulItem = testSPSC_LENGTH + 1U;
+
+        if( xSpscRingSend( xSpscRing, &ulItem, testSPSC_TIMEOUT ) != pdPASS )
+        {
+            xResult = prvFail( "an item could not be sent once the ring had space" );
+        }
+        else if( ( xSpscMakeUsable != pdFALSE ) || ( ulSpscHookItem != 1U ) )
+        {
+            xResult = prvFail( "the send did not get as far as blocking on the full ring" );
+        }
+        else if( ( xElapsed = xTaskGetTickCount() - xStart ) >= testSPSC_SHORT_TIMEOUT )
+        {
+            xResult = prvFail( "the send blocked for %lu ticks after the ring had space", ( unsigned long ) xElapsed );
+        }
+    }
+
+    for( ulItem = 2U; ( ulItem <= ( testSPSC_LENGTH + 1U ) ) && ( xResult == pdPASS ); ulItem++ )
+    {
+        if( ( xSpscRingReceive( xSpscRing, &ulReceived, 0 ) != pdPASS ) || ( ulReceived != ulItem ) )
+        {
+            xResult = prvFail( "item %lu was not received in order after the ring was made usable", ( unsigned long ) ulItem );
+        }
+    }
+
+    if( xResult == pdPASS )
+    {
+        xSpscMakeUsable = pdTRUE;
+        xStart = xTaskGetTickCount();
+
+        if( ( xSpscRingReceive( xSpscRing, &ulReceived, testSPSC_TIMEOUT ) != pdPASS ) || ( ulReceived != testSPSC_HOOK_ITEM ) )
+        {
+            xResult = prvFail( "the item sent to the empty ring was not received" );
+        }
+        else if( xSpscMakeUsable != pdFALSE )
+        {
+            xResult = prvFail( "the receive did not get as far as blocking on the empty ring" );
+        }
+        else if( ( xElapsed = xTaskGetTickCount() - xStart ) >= testSPSC_SHORT_TIMEOUT )
+        {
+            xResult = prvFail( "the receive blocked for %lu ticks after an item was sent", ( unsigned long ) xElapsed );
+        }
+    }
+
+    xSpscMakeUsable = pdFALSE;
+
+    /* Let the idle task free the tasks. */
+    vTaskDelay( 2 );
+
+    vSpscRingDelete( xSpscRing );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckSelectedMembers( QueueSetHandle_t xQueueSet,
+                                           const QueueHandle_t * pxExpected,
+                                           UBaseType_t uxExpected,
+                                           UBaseType_t uxMaxMembers,
+                                           const char * pcWhen )
+{
+    QueueSetMemberHandle_t xSelected[ testQUEUE_SET_MEMBERS + 1U ];
+    UBaseType_t uxSelected, x;
+    BaseType_t xResult = pdPASS;
+
+    uxSelected = uxQueueSelectAllFromSet( xQueueSet, xSelected, uxMaxMembers, 0 );
+
+    if( uxSelected != uxExpected )
+    {
+        xResult = prvFail( "%u members were selected %s, expected %u", ( unsigned ) uxSelected, pcWhen, ( unsigned ) uxExpected );
+    }
+
+    for( x = 0; ( x < uxSelected ) && ( xResult == pdPASS ); x++ )
+    {
+        if( xSelected[ x ] != ( QueueSetMemberHandle_t ) pxExpected[ x ] )
+        {
+            xResult = prvFail( "member %u selected %s was not the one expected", ( unsigned ) x, pcWhen );
+        }
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueSetReadyEdgeTest( void )
+{
+    QueueSetHandle_t xQueueSet;
+    QueueHandle_t xMembers[ testQUEUE_SET_MEMBERS + 1U ], xExpected[ testQUEUE_SET_MEMBERS ];
+    QueueSetMemberHandle_t xSelected;
+    const uint32_t ulItem = 0;
+    uint32_t ulReceived;
+    unsigned long ulPostsBefore;
+    TickType_t xStart, xElapsed;
+    UBaseType_t x;
+    BaseType_t xResult = pdPASS;
+
+    xQueueSet = xQueueCreateReadySet( testQUEUE_SET_MEMBERS );
+    configASSERT( xQueueSet );
+
+    for( x = 0; x < testARRAY_LENGTH( xMembers ); x++ )
+    {
+        xMembers[ x ] = xQueueCreate( testQUEUE_SET_LENGTH, sizeof( uint32_t ) );
+        configASSERT( xMembers[ x ] );
+    }
+
+    /* The set holds as many members as it was created for, and no more, and
+     * a member removed makes space for another. */
+    for( x = 0; ( x < testQUEUE_SET_MEMBERS ) && ( xResult == pdPASS ); x++ )
+    {
+        if( xQueueAddToSet( xMembers[ x ], xQueueSet ) != pdPASS )
+        {
+            xResult = prvFail( "member %u could not be added to a set for %u members", ( unsigned ) x, ( unsigned ) testQUEUE_SET_MEMBERS );
+        }
+    }
+
+    if( xResult == pdPASS )
+    {
+        if( xQueueAddToSet( xMembers[ testQUEUE_SET_MEMBERS ], xQueueSet ) != pdFAIL )
+        {
+            xResult = prvFail( "a member was added to a full set" );
+        }
+        else if( ( xQueueRemoveFromSet( xMembers[ 0 ], xQueueSet ) != pdPASS ) ||
+                 ( xQueueAddToSet( xMembers[ testQUEUE_SET_MEMBERS ], xQueueSet ) != pdPASS ) )
+        {
+            xResult = prvFail( "a member could not be added in place of one removed" );
+        }
+        else if( xQueueAddToSet( xMembers[ 0 ], xQueueSet ) != pdFAIL )
+        {
+            xResult = prvFail( "a member was added to a full set after another was replaced" );
+        }
+        else if( ( xQueueRemoveFromSet( xMembers[ testQUEUE_SET_MEMBERS ], xQueueSet ) != pdPASS ) ||
+                 ( xQueueAddToSet( xMembers[ 0 ], xQueueSet ) != pdPASS ) )
+        {
+            xResult = prvFail( "the first member could not be added back" );
+        }
+    }
+
+    /* A member is posted to the set once when it goes from empty to holding
+     * items, however many items are sent, and a select returns every ready
+     * member in the order they became ready. */
+    if( xResult == pdPASS )
+    {
+        ulPostsBefore = ulQueueSetPosts;
+
+        for( x = 0; x < testQUEUE_SET_LENGTH; x++ )
+        {
+            ( void ) xQueueSend( xMembers[ 2 ], &ulItem, 0 );
+            ( void ) xQueueSend( xMembers[ 0 ], &ulItem, 0 );
+        }
+
+        xExpected[ 0 ] = xMembers[ 2 ];
+        xExpected[ 1 ] = xMembers[ 0 ];
+
+        if( ( ulQueueSetPosts - ulPostsBefore ) != 2UL )
+        {
+            xResult = prvFail( "filling two members posted to the set %lu times", ulQueueSetPosts - ulPostsBefore );
+        }
+        else
+        {
+            xResult = prvCheckSelectedMembers( xQueueSet, xExpected, 2U, testQUEUE_SET_MEMBERS, "after two members were filled" );
+        }
+    }
+
+    /* A selected member is not ready again, even though it still holds
+     * items, until another item is sent to it. */
+    if( xResult == pdPASS )
+    {
+        xResult = prvCheckSelectedMembers( xQueueSet, xExpected, 0U, testQUEUE_SET_MEMBERS, "when no item had been sent since the last select" );
+    }
+
+    if( xResult == pdPASS )
+    {
+        ( void ) xQueueReceive( xMembers[ 0 ], &ulReceived, 0 );
+        ulPostsBefore = ulQueueSetPosts;
+        ( void ) xQueueSend( xMembers[ 0 ], &ulItem, 0 );
+        xExpected[ 0 ] = xMembers[ 0 ];
+
+        if( ( ulQueueSetPosts - ulPostsBefore ) != 1UL )
+        {
+            xResult = prvFail( "sending to a selected member posted to the set %lu times", ulQueueSetPosts - ulPostsBefore );
+        }
+        else
+        {
+            xResult = prvCheckSelectedMembers( xQueueSet, xExpected, 1U, testQUEUE_SET_MEMBERS, "after a selected member was sent to" );
+        }
+    }
+
+    /* With every member ready, selects that return fewer members than are
+     * ready leave the rest for the next select. */
+    if( xResult == pdPASS )
+    {
+        ulPostsBefore = ulQueueSetPosts;
+
+        for( x = 0; x < testQUEUE_SET_MEMBERS; x++ )
+        {
+            xExpected[ x ] = xMembers[ testQUEUE_SET_MEMBERS - 1U - x ];
+            ( void ) xQueueReset( xExpected[ x ] );
+            ( void ) xQueueSend( xExpected[ x ], &ulItem, 0 );
+            ( void ) xQueueSend( xExpected[ x ], &ulItem, 0 );
+        }
+
+        if( ( ulQueueSetPosts - ulPostsBefore ) != testQUEUE_SET_MEMBERS )
+        {
+            xResult = prvFail( "making %u members ready posted to the set %lu times", ( unsigned ) testQUEUE_SET_MEMBERS, ulQueueSetPosts - ulPostsBefore );
+        }
+        else if( prvCheckSelectedMembers( xQueueSet, xExpected, testQUEUE_SET_MEMBERS / 2U, testQUEUE_SET_MEMBERS / 2U, "first of all the ready members" ) != pdPASS )
+        {
+            xResult = pdFAIL;
+        }
+        else
+        {
+            xResult = prvCheckSelectedMembers( xQueueSet, &xExpected[ testQUEUE_SET_MEMBERS / 2U ], testQUEUE_SET_MEMBERS / 2U, testQUEUE_SET_MEMBERS, "second of all the ready members" );
+        }
+    }
+
+    /* A select with nothing ready waits out its block time. */
+    if( xResult == pdPASS )
+    {
+        xStart = xTaskGetTickCount();
+
+        if( uxQueueSelectAllFromSet( xQueueSet, &xSelected, 1U, testQUEUE_SET_TIMEOUT ) != 0U )
+        {
+            xResult = prvFail( "a member was selected when none was ready" );
+        }
+        else if( ( xElapsed = xTaskGetTickCount() - xStart ) < testQUEUE_SET_TIMEOUT )
+        {
+            xResult = prvFail( "a select with nothing ready returned after %lu ticks, before its %lu tick block time",
+                               ( unsigned long ) xElapsed, ( unsigned long ) testQUEUE_SET_TIMEOUT );
+        }
+    }
+
+    for( x = 0; x < testARRAY_LENGTH( xMembers ); x++ )
+    {
+        ( void ) xQueueReset( xMembers[ x ] );
+        ( void ) xQueueRemoveFromSet( xMembers[ x ], xQueueSet );
+        vQueueDelete( xMembers[ x ] );
+    }
+
+    vQueueDelete( xQueueSet );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvRegistryNamePosition( const char * pcName )
+{
+    uint32_t ulHash = 2166136261UL;
+
+    /* The position prvRegistryHashName() in queue.c gives the name. */
+    while( *pcName != ( char ) 0x00 )
+    {
+        ulHash ^= ( uint32_t ) ( ( uint8_t ) *pcName );
+        ulHash *= 16777619UL;
+        pcName++;
+    }
+
+    return ( UBaseType_t ) ( ulHash % ( uint32_t ) configQUEUE_REGISTRY_SIZE );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckRegistered( QueueHandle_t xQueue,
+                                      const char * pcName,
+                                      BaseType_t xRegistered )
+{
+    char cName[ testREGISTRY_NAME_LENGTH ];
+    const char * pcFound;
+    QueueHandle_t xFound;
+    BaseType_t xResult = pdPASS;
+
+    /* Look the name up from a copy, so names are compared rather than
+     * pointers. */
+    ( void ) strcpy( cName, pcName );
+    pcFound = pcQueueGetName( xQueue );
+    xFound = xQueueGetHandleFromName( cName );
+
+    if( xRegistered != pdFALSE )
+    {
+        if( ( pcFound == NULL ) || ( strcmp( pcFound, pcName ) != 0 ) )
+        {
+            xResult = prvFail( "the queue named %s was not found by its handle", pcName );
+        }
+        else if( xFound != xQueue )
+        {
+            xResult = prvFail( "the queue named %s was not found by its name", pcName );
+        }
+    }
+    else if( ( pcFound != NULL ) && ( strcmp( pcFound, pcName ) == 0 ) )
+    {
+        xResult = prvFail( "the handle of the queue named %s was still registered with that name", pcName );
+    }
+    else if( xFound != NULL )
+    {
+        xResult = prvFail( "the name %s was still registered", pcName );
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueRegistryLookupTest( void )
+{
+    QueueHandle_t xQueues[ configQUEUE_REGISTRY_SIZE + 1U ];
+    QueueRegistryStatistics_t xRegistryStatistics[ configQUEUE_REGISTRY_SIZE ];
+    UBaseType_t uxAlreadyRegistered, uxQueues, uxCollisions = 1U, uxCandidate, x;
+    BaseType_t xResult = pdPASS;
+
+    /* The kernel registers some queues of its own, such as the timer
+     * queue. */
+    uxAlreadyRegistered = uxQueueGetRegistryStatistics( xRegistryStatistics, configQUEUE_REGISTRY_SIZE );
+    configASSERT( ( uxAlreadyRegistered + testREGISTRY_COLLISIONS ) <= configQUEUE_REGISTRY_SIZE );
+    uxQueues = configQUEUE_REGISTRY_SIZE - uxAlreadyRegistered;
+
+    /* The first names hash to the same position, so each is stored after
+     * the one before.  The rest, and the name of the queue that does not
+     * fit, hash to wherever they do. */
+    ( void ) snprintf( cRegistryNames[ 0 ], testREGISTRY_NAME_LENGTH, "Q0" );
+
+    for( uxCandidate = 1U; uxCollisions < testREGISTRY_COLLISIONS; uxCandidate++ )
+    {
+        ( void ) snprintf( cRegistryNames[ uxCollisions ], testREGISTRY_NAME_LENGTH, "Q%u", ( unsigned ) uxCandidate );
+
+        if( prvRegistryNamePosition( cRegistryNames[ uxCollisions ] ) == prvRegistryNamePosition( cRegistryNames[ 0 ] ) )
+        {
+            uxCollisions++;
+        }
+    }
+
+    for( x = testREGISTRY_COLLISIONS; x <= uxQueues; x++ )
+    {
+        ( void ) snprintf( cRegistryNames[ x ], testREGISTRY_NAME_LENGTH, "R%u", ( unsigned ) x );
+    }
+
+    for( x = 0; x <= uxQueues; x++ )
+    {
+        xQueues[ x ] = xQueueCreate( 1U, sizeof( uint32_t ) );
+        configASSERT( xQueues[ x ] );
+    }
+
+    /* Fill the registry, so every search has to step past other entries to
+     * find a vacant position.  The queue that does not fit is not
+     * registered. */
+    for( x = 0; x <= uxQueues; x++ )
+    {
+        vQueueAddToRegistry( xQueues[ x ], cRegistryNames[ x ] );
+    }
+
+    for( x = 0; ( x < uxQueues ) && ( xResult == pdPASS ); x++ )
+    {
+        xResult = prvCheckRegistered( xQueues[ x ], cRegistryNames[ x ], pdTRUE );
+    }
+
+    if( xResult == pdPASS )
+    {
+        xResult = prvCheckRegistered( xQueues[ uxQueues ], cRegistryNames[ uxQueues ], pdFALSE );
+    }
+
+    /* Unregistering the first of the names that collide must leave the
+     * others reachable.  The queue that did not fit can then be registered,
+     * and unregistered again, and the first queue registered again in its
+     * place. */
+    if( xResult == pdPASS )
+    {
+        vQueueUnregisterQueue( xQueues[ 0 ] );
+        xResult = prvCheckRegistered( xQueues[ 0 ], cRegistryNames[ 0 ], pdFALSE );
+    }
+
+    for( x = 1; ( x < uxQueues ) && ( xResult == pdPASS ); x++ )
+    {
+        xResult = prvCheckRegistered( xQueues[ x ], cRegistryNames[ x ], pdTRUE );
+    }
+
+    if( xResult == pdPASS )
+    {
+        vQueueAddToRegistry( xQueues[ uxQueues ], cRegistryNames[ uxQueues ] );
+        xResult = prvCheckRegistered( xQueues[ uxQueues ], cRegistryNames[ uxQueues ], pdTRUE );
+    }
+
+    if( xResult == pdPASS )
+    {
+        vQueueUnregisterQueue( xQueues[ uxQueues ] );
+        vQueueAddToRegistry( xQueues[ 0 ], cRegistryNames[ 0 ] );
+
+        for( x = 0; ( x <= uxQueues ) && ( xResult == pdPASS ); x++ )
+        {
+            xResult = prvCheckRegistered( xQueues[ x ], cRegistryNames[ x ], ( x < uxQueues ) ? pdTRUE : pdFALSE );
+        }
+    }
+
+    /* Registering a queue again under another name replaces its name.  The
+     * second of the names that collide is renamed to the name of the queue
+     * that did not fit, and back again. */
+    if( xResult == pdPASS )
+    {
+        vQueueAddToRegistry( xQueues[ 1 ], cRegistryNames[ uxQueues ] );
+
+        if( ( xQueueGetHandleFromName( cRegistryNames[ 1 ] ) != NULL ) || ( xQueueGetHandleFromName( cRegistryNames[ uxQueues ] ) != xQueues[ 1 ] ) )
+        {
+            xResult = prvFail( "renaming queue %s did not replace its name", cRegistryNames[ 1 ] );
+        }
+        else
+        {
+            vQueueAddToRegistry( xQueues[ 1 ], cRegistryNames[ 1 ] );
+        }
+    }
+
+    for( x = 0; ( x < uxQueues ) && ( xResult == pdPASS ); x++ )
+    {
+        xResult = prvCheckRegistered( xQueues[ x ], cRegistryNames[ x ], pdTRUE );
+    }
+
+    for( x = 0; x <= uxQueues; x++ )
+    {
+        vQueueUnregisterQueue( xQueues[ x ] );
+        vQueueDelete( xQueues[ x ] );
+    }
+
+    if( ( xResult == pdPASS ) && ( uxQueueGetRegistryStatistics( xRegistryStatistics, configQUEUE_REGISTRY_SIZE ) != uxAlreadyRegistered ) )
+    {
+        xResult = prvFail( "queues were left in the registry" );
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStatsSenderTask( void * pvParameters )
+{
+    const uint32_t ulItem = 0;
+
+    ( void ) pvParameters;
+
+    vTaskDelay( testMIN_DELAY );
+    ( void ) xQueueSend( xStatsQueue, &ulItem, 0 );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueStatisticsTest( void )
+{
+    QueueStatistics_t xStatistics;
+    QueueRegistryStatistics_t xRegistryStatistics[ configQUEUE_REGISTRY_SIZE ];
+    UBaseType_t uxRegistered, x;
+    uint32_t ulItem = 0;
+    TaskHandle_t xSender;
+    BaseType_t xReturned, xResult = pdPASS;
+
+    xStatsQueue = xQueueCreate( testSTATS_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xStatsQueue );
+    vQueueAddToRegistry( xStatsQueue, "Stats" );
+
+    /* Fill the queue, then fail to send one more item, once without waiting
+     * and once after waiting. */
+    for( x = 0; x < testSTATS_LENGTH; x++ )
+    {
+        ( void ) xQueueSend( xStatsQueue, &ulItem, 0 );
+    }
+
+    ( void ) xQueueSend( xStatsQueue, &ulItem, 0 );
+    ( void ) xQueueSend( xStatsQueue, &ulItem, testSTATS_TIMEOUT );
+
+    /* Send one more item part way through emptying the queue, which does not
+     * raise the high-water mark, then fail to receive one more item, once
+     * without waiting and once after waiting. */
+    ( void ) xQueueReceive( xStatsQueue, &ulItem, 0 );
+    ( void ) xQueueReceive( xStatsQueue, &ulItem, 0 );
+    ( void ) xQueueSend( xStatsQueue, &ulItem, 0 );
+
+    for( x = 0; x < 2U; x++ )
+    {
+        ( void ) xQueueReceive( xStatsQueue, &ulItem, 0 );
+    }
+
+    ( void ) xQueueReceive( xStatsQueue, &ulItem, 0 );
+    ( void ) xQueueReceive( xStatsQueue, &ulItem, testSTATS_TIMEOUT );
+
+    /* Wait for an item another task sends a few ticks later. */
+    xReturned = xTaskCreate( prvStatsSenderTask, "Sender", configMINIMAL_STACK_SIZE, NULL, testHIGH_PRIORITY, &xSender );
+    configASSERT( xReturned == pdPASS );
+    xReturned = xQueueReceive( xStatsQueue, &ulItem, testSTATS_TIMEOUT * 10U );
+
+    vQueueGetStatistics( xStatsQueue, &xStatistics );
+
+    if( xReturned != pdPASS )
+    {
+        xResult = prvFail( "the item sent by another task was not received" );
+    }
+    else if( xStatistics.uxPeakMessagesWaiting != testSTATS_LENGTH )
+    {
+        xResult = prvFail( "the high-water mark was %u, expected %u", ( unsigned ) xStatistics.uxPeakMessagesWaiting, ( unsigned ) testSTATS_LENGTH );
+    }
+    else if( ( xStatistics.ulSendCount != ( testSTATS_LENGTH + 2UL ) ) || ( xStatistics.ulReceiveCount != ( testSTATS_LENGTH + 2UL ) ) )
+    {
+        xResult = prvFail( "%lu sends and %lu receives were counted, expected %lu of each",
+                           ( unsigned long ) xStatistics.ulSendCount, ( unsigned long ) xStatistics.ulReceiveCount, ( unsigned long ) ( testSTATS_LENGTH + 2UL ) );
+    }
+    else if( ( xStatistics.ulBlockedSendCount != 1UL ) || ( xStatistics.ulBlockedSendTicks < testSTATS_TIMEOUT ) )
+    {
+        xResult = prvFail( "%lu blocked sends were counted, blocked for %lu ticks, expected 1 blocked for at least %lu",
+                           ( unsigned long ) xStatistics.ulBlockedSendCount, ( unsigned long ) xStatistics.ulBlockedSendTicks, ( unsigned long ) testSTATS_TIMEOUT );
+    }
+    else if( ( xStatistics.ulBlockedReceiveCount != 2UL ) ||
+             ( xStatistics.ulBlockedReceiveTicks < ( testSTATS_TIMEOUT + testMIN_DELAY - 1U ) ) ||
+             ( xStatistics.ulBlockedReceiveTicks >= ( testSTATS_TIMEOUT * 10U ) ) )
+    {
+        xResult = prvFail( "%lu blocked receives were counted, blocked for %lu ticks, expected 2 blocked for about %lu",
+                           ( unsigned long ) xStatistics.ulBlockedReceiveCount, ( unsigned long ) xStatistics.ulBlockedReceiveTicks, ( unsigned long ) ( testSTATS_TIMEOUT + testMIN_DELAY ) );
+    }
+
+    /* The registry reports the same statistics for the queue. */
+    if( xResult == pdPASS )
+    {
+        uxRegistered = uxQueueGetRegistryStatistics( xRegistryStatistics, configQUEUE_REGISTRY_SIZE );
+
+        for( x = 0; x < uxRegistered; x++ )
+        {
+            if( xRegistryStatistics[ x ].xHandle == xStatsQueue )
+            {
+                break;
+            }
+        }
+
+        if( x == uxRegistered )
+        {
+            xResult = prvFail( "the registry did not report the statistics of the queue" );
+        }
+        else if( ( strcmp( xRegistryStatistics[ x ].pcQueueName, "Stats" ) != 0 ) ||
+                 ( memcmp( &( xRegistryStatistics[ x ].xStatistics ), &xStatistics, sizeof( xStatistics ) ) != 0 ) )
+        {
+            xResult = prvFail( "the registry reported different statistics for the queue" );
+        }
+    }
+
+    vTaskDelete( xSender );
+
+    /* Let the idle task free the task. */
+    vTaskDelay( 2 );
+
+    vQueueUnregisterQueue( xStatsQueue );
+    vQueueDelete( xStatsQueue );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMultiWaitSignalTask( void * pvParameters )
+{
+    const uint32_t ulItem = 0;
+    const uint8_t ucByte = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        /* Leave the control task time to block before making the object
+         * ready. */
+        vTaskDelay( testMULTI_WAIT_SIGNAL_DELAY );
+
+        switch( uxMultiWaitSignal )
+        {
+            case testMULTI_WAIT_QUEUE:
+                ( void ) xQueueSend( xMultiWaitQueue, &ulItem, 0 );
+                break;
+
+            case testMULTI_WAIT_EVENT_GROUP_A:
+                ( void ) xEventGroupSetBits( xMultiWaitEventGroup, testMULTI_WAIT_BITS_A );
+                break;
+
+            case testMULTI_WAIT_EVENT_GROUP_B:
+
+                /* Only one of the entry's bits. */
+                ( void ) xEventGroupSetBits( xMultiWaitEventGroup, ( EventBits_t ) 0x04 );
+                break;
+
+            case testMULTI_WAIT_STREAM_BUFFER:
+                ( void ) xStreamBufferSend( xMultiWaitStreamBuffer, &ucByte, sizeof( ucByte ), 0 );
+                break;
+
+            case testMULTI_WAIT_NOTIFICATION:
+                ( void ) xTaskNotifyIndexed( xControlTask, configMULTI_WAIT_NOTIFICATION_INDEX, 1UL, eSetBits );
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMultiWaitReadyTest( void )
+{
+    MultiWaitObject_t xObjects[ testMULTI_WAIT_OBJECTS ];
+    TaskHandle_t xSignalTask;
+    TickType_t xStartTick, xTicksPassed;
+    UBaseType_t uxSignal, uxReady, x;
+    BaseType_t xResult = pdPASS, xReturned;
+
+    xMultiWaitQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    xMultiWaitEventGroup = xEventGroupCreate();
+    xMultiWaitStreamBuffer = xStreamBufferCreate( 8, 1 );
+    configASSERT( xMultiWaitQueue && xMultiWaitEventGroup && xMultiWaitStreamBuffer );
+
+    xReturned = xTaskCreate( prvMultiWaitSignalTask, "Signal", configMINIMAL_STACK_SIZE, NULL, testHIGH_PRIORITY, &xSignalTask );
+    configASSERT( xReturned == pdPASS );
+
+    for( x = 0; x < testMULTI_WAIT_OBJECTS; x++ )
+    {
+        xObjects[ x ].pvObject = NULL;
+        xObjects[ x ].uxBitsToWaitFor = 0;
+    }
+
+    xObjects[ testMULTI_WAIT_QUEUE ].eObjectType = eMultiWaitQueue;
+    xObjects[ testMULTI_WAIT_QUEUE ].pvObject = xMultiWaitQueue;
+    xObjects[ testMULTI_WAIT_EVENT_GROUP_A ].eObjectType = eMultiWaitEventGroup;
+    xObjects[ testMULTI_WAIT_EVENT_GROUP_A ].pvObject = xMultiWaitEventGroup;
+    xObjects[ testMULTI_WAIT_EVENT_GROUP_A ].uxBitsToWaitFor = testMULTI_WAIT_BITS_A;
+    xObjects[ testMULTI_WAIT_EVENT_GROUP_B ].eObjectType = eMultiWaitEventGroup;
+    xObjects[ testMULTI_WAIT_EVENT_GROUP_B ].pvObject = xMultiWaitEventGroup;
+    xObjects[ testMULTI_WAIT_EVENT_GROUP_B ].uxBitsToWaitFor = testMULTI_WAIT_BITS_B;
+    xObjects[ testMULTI_WAIT_STREAM_BUFFER ].eObjectType = eMultiWaitStreamBuffer;
+    xObjects[ testMULTI_WAIT_STREAM_BUFFER ].pvObject = xMultiWaitStreamBuffer;
+    xObjects[ testMULTI_WAIT_NOTIFICATION ].eObjectType = eMultiWaitNotification;
+
+    /* Nothing is ready yet, so the wait times out. */
+    xStartTick = xTaskGetTickCount();
+    uxReady = uxMultiWaitForAny( xObjects, testMULTI_WAIT_OBJECTS, testMIN_DELAY );
+    xTicksPassed = xTaskGetTickCount() - xStartTick;
+
+    if( uxReady != 0U )
+    {
+        xResult = prvFail( "%u objects were ready before any was made ready", ( unsigned ) uxReady );
+    }
+    else if( xTicksPassed < testMIN_DELAY )
+    {
+        xResult = prvFail( "a wait of %lu ticks timed out after %lu ticks", ( unsigned long ) testMIN_DELAY, ( unsigned long ) xTicksPassed );
+    }
+
+    /* Make each object ready in turn while this task is blocked waiting for
+     * all of them.  The event group's first entry is registered before its
+     * second, so setting its bits only wakes this task if the bits of both
+     * entries are recorded. */
+    for( uxSignal = 0; ( uxSignal < testMULTI_WAIT_OBJECTS ) && ( xResult == pdPASS ); uxSignal++ )
+    {
+        uxMultiWaitSignal = uxSignal;
+        xStartTick = xTaskGetTickCount();
+        xTaskNotifyGive( xSignalTask );
+
+        uxReady = uxMultiWaitForAny( xObjects, testMULTI_WAIT_OBJECTS, testMULTI_WAIT_TIMEOUT );
+        xTicksPassed = xTaskGetTickCount() - xStartTick;
+
+        if( uxReady != 1U )
+        {
+            xResult = prvFail( "%u objects were ready after object %u was made ready", ( unsigned ) uxReady, ( unsigned ) uxSignal );
+        }
+        else if( xTicksPassed < testMULTI_WAIT_SIGNAL_DELAY )
+        {
+            xResult = prvFail( "the wait returned after %lu ticks, before object %u was made ready", ( unsigned long ) xTicksPassed, ( unsigned ) uxSignal );
+        }
+        else if( xTicksPassed >= testMULTI_WAIT_TIMEOUT )
+        {
+            /* The objects are looked at again when the wait times out. */
+            xResult = prvFail( "object %u was made ready but only found when the wait timed out", ( unsigned ) uxSignal );
+        }
+
+        for( x = 0; ( x < testMULTI_WAIT_OBJECTS ) && ( xResult == pdPASS ); x++ )
+        {
+            if( ( xObjects[ x ].xReady != pdFALSE ) != ( x == uxSignal ) )
+            {
+                xResult = prvFail( "object %u was %sreported ready after object %u was made ready", ( unsigned ) x,
+                                   ( xObjects[ x ].xReady != pdFALSE ) ? "" : "not ", ( unsigned ) uxSignal );
+            }
+        }
+
+        ( void ) xQueueReset( xMultiWaitQueue );
+        ( void ) xEventGroupClearBits( xMultiWaitEventGroup, testMULTI_WAIT_BITS_A | testMULTI_WAIT_BITS_B );
+        ( void ) xStreamBufferReset( xMultiWaitStreamBuffer );
+        ( void ) ulTaskNotifyTakeIndexed( configMULTI_WAIT_NOTIFICATION_INDEX, pdTRUE, 0 );
+    }
+
+    vTaskDelete( xSignalTask );
+
+    /* Let the idle task free the task. */
+    vTaskDelay( 2 );
+
+    vQueueDelete( xMultiWaitQueue );
+    vEventGroupDelete( xMultiWaitEventGroup );
+    vStreamBufferDelete( xMultiWaitStreamBuffer );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMultiWaitOtherTask( void * pvParameters )
+{
+    MultiWaitObject_t xObject;
+
+    ( void ) pvParameters;
+
+    xObject.eObjectType = eMultiWaitQueue;
+    xObject.pvObject = xMultiWaitQueue;
+    xObject.uxBitsToWaitFor = 0;
+
+    uxMultiWaitOtherReady = uxMultiWaitForAny( &xObject, 1, portMAX_DELAY );
+    xTaskNotifyGive( xControlTask );
+
+    /* Wait to be deleted. */
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMultiWaitBusyTest( void )
+{
+    MultiWaitObject_t xObjects[ 2 ];
+    TaskHandle_t xOtherTask;
+    const uint32_t ulItem = 0;
+    UBaseType_t uxReady;
+    BaseType_t xResult = pdPASS, xReturned;
+
+    xMultiWaitQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    xMultiWaitStreamBuffer = xStreamBufferCreate( 8, 1 );
+    configASSERT( xMultiWaitQueue && xMultiWaitStreamBuffer );
+
+    /* The other task has the higher priority, so it is already waiting for
+     * the queue by the time it is created. */
+    uxMultiWaitOtherReady = 0;
+    xReturned = xTaskCreate( prvMultiWaitOtherTask, "Other", configMINIMAL_STACK_SIZE, NULL, testHIGH_PRIORITY, &xOtherTask );
+    configASSERT( xReturned == pdPASS );
+
+    /* The stream buffer is registered before the queue is found to be busy,
+     * so has to be released again. */
+    xObjects[ 0 ].eObjectType = eMultiWaitStreamBuffer;
+    xObjects[ 0 ].pvObject = xMultiWaitStreamBuffer;
+    xObjects[ 0 ].uxBitsToWaitFor = 0;
+    xObjects[ 1 ].eObjectType = eMultiWaitQueue;
+    xObjects[ 1 ].pvObject = xMultiWaitQueue;
+    xObjects[ 1 ].uxBitsToWaitFor = 0;
+
+    uxAssertsExpected = 1;
+    uxReady = uxMultiWaitForAny( xObjects, 2, testMULTI_WAIT_TIMEOUT );
+
+    if( uxReady != multiwaitOBJECT_BUSY )
+    {
+        xResult = prvFail( "waiting for a queue another task was waiting for returned %lu", ( unsigned long ) uxReady );
+    }
+    else if( uxAssertsExpected != 0U )
+    {
+        xResult = prvFail( "waiting for a queue another task was waiting for did not fail configASSERT()" );
+    }
+    else if( uxMultiWaitForAny( xObjects, 1, 0 ) != 0U )
+    {
+        xResult = prvFail( "the stream buffer was not released after the queue was found to be busy" );
+    }
+    else
+    {
+        /* The other task is still recorded by the queue, so sending to it
+         * wakes the other task. */
+        ( void ) xQueueSend( xMultiWaitQueue, &ulItem, 0 );
+
+        if( ulTaskNotifyTake( pdTRUE, testMULTI_WAIT_TIMEOUT ) == 0U )
+        {
+            xResult = prvFail( "the task already waiting for the queue was not woken by a send" );
+        }
+        else if( uxMultiWaitOtherReady != 1U )
+        {
+            xResult = prvFail( "the task already waiting for the queue found %lu objects ready", ( unsigned long ) uxMultiWaitOtherReady );
+        }
+    }
+
+    uxAssertsExpected = 0;
+    vTaskDelete( xOtherTask );
+
+    /* Let the idle task free the task. */
+    vTaskDelay( 2 );
+
+    vQueueDelete( xMultiWaitQueue );
+    vStreamBufferDelete( xMultiWaitStreamBuffer );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPubSubSubscriberTask( void * pvParameters )
+{
+    const UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+    PubSubSubscriber_t xSubscriber;
+    UBaseType_t uxLost;
+    uint32_t ulItem;
+
+    vPubSubSubscribe( xPubSubChannel, &xSubscriber );
+
+    for( ; ; )
+    {
+        if( xPubSubReceive( &xSubscriber, &ulItem, &uxLost, portMAX_DELAY ) == pdPASS )
+        {
+            ulPubSubLastItem[ uxIndex ] = ulItem;
+            uxPubSubItemsLost[ uxIndex ] += uxLost;
+            uxPubSubItemsReceived[ uxIndex ]++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartPubSubSubscribers( void )
+{
+    UBaseType_t x;
+    BaseType_t xReturned;
+
+    xPubSubChannel = xPubSubCreate( testPUBSUB_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xPubSubChannel );
+
+    /* The subscribers have the higher priority, so have subscribed and
+     * blocked waiting for the first item by the time they are created. */
+    for( x = 0; x < testPUBSUB_SUBSCRIBERS; x++ )
+    {
+        uxPubSubItemsReceived[ x ] = 0;
+        ulPubSubLastItem[ x ] = 0;
+        uxPubSubItemsLost[ x ] = 0;
+        xReturned = xTaskCreate( prvPubSubSubscriberTask, "Subscriber", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, testHIGH_PRIORITY, &( xPubSubSubscriberTasks[ x ] ) );
+        configASSERT( xReturned == pdPASS );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopPubSubSubscribers( void )
+{
+    UBaseType_t x;
+
+    for( x = 0; x < testPUBSUB_SUBSCRIBERS; x++ )
+    {
+        vTaskDelete( xPubSubSubscriberTasks[ x ] );
+    }
+
+    /* Let the idle task free the tasks.  The channel can only be deleted once
+     * no task is blocked on it. */
+    vTaskDelay( 2 );
+
+    vPubSubDelete( xPubSubChannel );
+    xPubSubChannel = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckPubSubSubscribers( UBaseType_t uxItemsPublished,
+                                             uint32_t ulLastItem )
+{
+    UBaseType_t x;
+    BaseType_t xResult = pdPASS;
+
+    for( x = 0; ( x < testPUBSUB_SUBSCRIBERS ) && ( xResult == pdPASS ); x++ )
+    {
+        if( uxPubSubItemsReceived[ x ] != uxItemsPublished )
+        {
+            xResult = prvFail( "subscriber %u received %u items when %u were published", ( unsigned ) x,
+                               ( unsigned ) uxPubSubItemsReceived[ x ], ( unsigned ) uxItemsPublished );
+        }
+        else if( ( uxItemsPublished != 0U ) && ( ulPubSubLastItem[ x ] != ulLastItem ) )
+        {
+            xResult = prvFail( "subscriber %u received item %lu when item %lu was published", ( unsigned ) x,
+                               ( unsigned long ) ulPubSubLastItem[ x ], ( unsigned long ) ulLastItem );
+        }
+        else if( uxPubSubItemsLost[ x ] != 0U )
+        {
+            xResult = prvFail( "subscriber %u was told it lost %u items", ( unsigned ) x, ( unsigned ) uxPubSubItemsLost[ x ] );
+        }
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPubSubFanOutTest( void )
+{
+    uint32_t ulItem;
+    BaseType_t xResult = pdPASS;
+
+    prvStartPubSubSubscribers();
+
+    /* Each publish unblocks every subscriber, all of which have a higher
+     * priority than this task, so each has received the item, and blocked
+     * again, by the time the publish returns. */
+    for( ulItem = 0; ( ulItem < testPUBSUB_ITEMS ) && ( xResult == pdPASS ); ulItem++ )
+    {
+        vPubSubPublish( xPubSubChannel, &ulItem );
+        xResult = prvCheckPubSubSubscribers( ( UBaseType_t ) ulItem + 1U, ulItem );
+    }
+
+    prvStopPubSubSubscribers();
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPubSubPublisherTask( void * pvParameters )
+{
+    uint32_t ulItem;
+
+    ( void ) pvParameters;
+
+    for( ulItem = 0; ulItem < testPUBSUB_ITEMS; ulItem++ )
+    {
+        vPubSubPublish( xPubSubChannel, &ulItem );
+    }
+
+    xTaskNotifyGive( xControlTask );
+
+    /* Wait to be deleted. */
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPubSubSlowSubscriberTest( void )
+{
+    PubSubSubscriber_t xSubscriber;
+    TaskHandle_t xPublisherTask;
+    UBaseType_t uxLost, uxWaiting;
+    uint32_t ulItem, ulExpected;
+    BaseType_t xResult = pdPASS, xReturned;
+
+    xPubSubChannel = xPubSubCreate( testPUBSUB_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xPubSubChannel );
+
+    /* This task subscribes but receives nothing until the publisher, which
+     * has the higher priority, has published every item, so the publisher
+     * overwrites items this task has not received.  The publisher never
+     * waits for this task, so it notifies this task once it is done. */
+    vPubSubSubscribe( xPubSubChannel, &xSubscriber );
+    xReturned = xTaskCreate( prvPubSubPublisherTask, "Publisher", configMINIMAL_STACK_SIZE, NULL, testHIGH_PRIORITY, &xPublisherTask );
+    configASSERT( xReturned == pdPASS );
+
+    if( ulTaskNotifyTake( pdTRUE, testPUBSUB_TIMEOUT ) == 0U )
+    {
+        xResult = prvFail( "the publisher blocked while the subscriber was behind" );
+    }
+    else if( ( uxWaiting = uxPubSubItemsWaiting( &xSubscriber ) ) != testPUBSUB_LENGTH )
+    {
+        xResult = prvFail( "%u items were waiting in a channel of %u items", ( unsigned ) uxWaiting, testPUBSUB_LENGTH );
+    }
+
+    /* The oldest item still in the channel is received first, along with the
+     * number of items overwritten before it, then the rest in order. */
+    for( ulExpected = testPUBSUB_ITEMS - testPUBSUB_LENGTH; ( ulExpected < testPUBSUB_ITEMS ) && ( xResult == pdPASS ); ulExpected++ )
+    {
+        if( xPubSubReceive( &xSubscriber, &ulItem, &uxLost, 0 ) != pdPASS )
+        {
+            xResult = prvFail( "item %lu could not be received", ( unsigned long ) ulExpected );
+        }
+        else if( ulItem != ulExpected )
+        {
+            xResult = prvFail( "received item %lu when item %lu was expected", ( unsigned long ) ulItem, ( unsigned long ) ulExpected );
+        }
+        else if( uxLost != ( ( ulExpected == ( testPUBSUB_ITEMS - testPUBSUB_LENGTH ) ) ? ( testPUBSUB_ITEMS - testPUBSUB_LENGTH ) : 0U ) )
+        {
+            xResult = prvFail( "told %u items were lost when receiving item %lu", ( unsigned ) uxLost, ( unsigned long ) ulItem );
+        }
+    }
+
+    if( ( xResult == pdPASS ) && ( xPubSubReceive( &xSubscriber, &ulItem, &uxLost, 0 ) != errQUEUE_EMPTY ) )
+    {
+        xResult = prvFail( "item %lu was received after every item was received", ( unsigned long ) ulItem );
+    }
+
+    vTaskDelete( xPublisherTask );
+
+    /* Let the idle task free the task. */
+    vTaskDelay( 2 );
+
+    vPubSubDelete( xPubSubChannel );
+    xPubSubChannel = NULL;
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPubSubTickHookPublisher( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if( xPubSubTickHookChannel != NULL )
+    {
+        vPubSubPublishFromISR( xPubSubTickHookChannel, &ulPubSubTickHookItem, &xHigherPriorityTaskWoken );
+        xPubSubTickHookWoken = xHigherPriorityTaskWoken;
+        xPubSubTickHookChannel = NULL;
+
+        /* The tick interrupt switches task itself if one is needed. */
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPubSubPublishFromISRTest( void )
+{
+    UBaseType_t uxPublished;
+    BaseType_t xResult = pdPASS;
+
+    prvStartPubSubSubscribers();
+
+    /* The tick hook interrupts the idle task while every subscriber is
+     * blocked, so publishing wakes tasks of a higher priority. */
+    for( uxPublished = 1; ( uxPublished <= testPUBSUB_ITEMS ) && ( xResult == pdPASS ); uxPublished++ )
+    {
+        taskENTER_CRITICAL();
+        {
+            ulPubSubTickHookItem = ( uint32_t ) uxPublished * 3UL;
+            xPubSubTickHookWoken = pdFALSE;
+            xPubSubTickHookChannel = xPubSubChannel;
+        }
+        taskEXIT_CRITICAL();
+
+        vTaskDelay( testMIN_DELAY );
+
+        if( xPubSubTickHookChannel != NULL )
+        {
+            xResult = prvFail( "the tick hook did not publish within %lu ticks", ( unsigned long ) testMIN_DELAY );
+        }
+        else if( xPubSubTickHookWoken == pdFALSE )
+        {
+            xResult = prvFail( "publishing from the tick hook did not report that it woke a higher priority task" );
+        }
+        else
+        {
+            xResult = prvCheckPubSubSubscribers( uxPublished, ulPubSubTickHookItem );
+        }
+    }
+
+    xPubSubTickHookChannel = NULL;
+    prvStopPubSubSubscribers();
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLockWaiterTask( void * pvParameters )
+{
+    LockWaiter_t * const pxWaiter = ( LockWaiter_t * ) pvParameters;
+    BaseType_t xResult;
+
+    xResult = pxWaiter->pxTake( pxWaiter->xTicksToWait );
+
+    if( xResult == pdPASS )
+    {
+        pxWaiter->uxTakeOrder = uxLockTakes;
+        uxLockTakes++;
+        pxWaiter->pxGive();
+    }
+
+    pxWaiter->xResult = xResult;
+
+    /* Wait to be deleted. */
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvStartLockWaiter( LockWaiter_t * pxWaiter,
+                                        UBaseType_t uxPriority )
+{
+    TaskHandle_t xWaiterTask;
+    BaseType_t xReturned;
+
+    /* The waiter has the higher priority, so it has blocked on the lock by
+     * the time it is created. */
+    pxWaiter->xResult = testLOCK_WAITING;
+    pxWaiter->uxTakeOrder = testLOCK_NOT_TAKEN;
+    xReturned = xTaskCreate( prvLockWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, ( void * ) pxWaiter, uxPriority, &xWaiterTask );
+    configASSERT( xReturned == pdPASS );
+
+    return xWaiterTask;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckHolderPriority( UBaseType_t uxExpected,
+                                          const char * pcWhen )
+{
+    UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+    BaseType_t xResult = pdPASS;
+
+    if( uxPriority != uxExpected )
+    {
+        xResult = prvFail( "the holder's priority was %u %s, expected %u", ( unsigned ) uxPriority, pcWhen, ( unsigned ) uxExpected );
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckLockInheritance( LockWaiter_t * pxWaiter,
+                                           LockWaiter_t * pxUrgentWaiter,
+                                           void ( * pxHolderGive )( void ) )
+{
+    TaskHandle_t xWaiterTask, xUrgentWaiterTask;
+    BaseType_t xResult;
+
+    /* This task holds the lock.  Each waiter raises this task's priority to
+     * its own, and the urgent waiter lowers it again when it times out, but
+     * only as far as the priority of the waiter that is still waiting. */
+    xWaiterTask = prvStartLockWaiter( pxWaiter, testLOCK_WAITER_PRIORITY );
+    xResult = prvCheckHolderPriority( testLOCK_WAITER_PRIORITY, "while a task waited" );
+
+    xUrgentWaiterTask = prvStartLockWaiter( pxUrgentWaiter, testLOCK_URGENT_PRIORITY );
+
+    if( xResult == pdPASS )
+    {
+        xResult = prvCheckHolderPriority( testLOCK_URGENT_PRIORITY, "while a higher priority task waited" );
+    }
+
+    vTaskDelay( testLOCK_TIMEOUT * 2U );
+
+    if( xResult == pdPASS )
+    {
+        if( pxUrgentWaiter->xResult != pdFAIL )
+        {
+            xResult = prvFail( "the take that should have timed out returned %ld", ( long ) pxUrgentWaiter->xResult );
+        }
+        else
+        {
+            xResult = prvCheckHolderPriority( testLOCK_WAITER_PRIORITY, "after the higher priority task timed out" );
+        }
+    }
+
+    /* Giving the lock passes it to the waiter, which takes priority over this
+     * task again as soon as this task's priority is restored. */
+    pxHolderGive();
+
+    if( xResult == pdPASS )
+    {
+        if( pxWaiter->xResult != pdPASS )
+        {
+            xResult = prvFail( "the waiting task did not take the lock when it was given" );
+        }
+        else
+        {
+            xResult = prvCheckHolderPriority( testCONTROL_PRIORITY, "after the lock was given" );
+        }
+    }
+
+    vTaskDelete( xWaiterTask );
+    vTaskDelete( xUrgentWaiterTask );
+
+    /* Let the idle task free the tasks. */
+    vTaskDelay( 2 );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFastMutexTake( TickType_t xTicksToWait )
+{
+    return xFastMutexTake( xTestFastMutex, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFastMutexGive( void )
+{
+    ( void ) xFastMutexGive( xTestFastMutex );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFastMutexInheritanceTest( void )
+{
+    LockWaiter_t xWaiter = { prvFastMutexTake, prvFastMutexGive, portMAX_DELAY, testLOCK_WAITING, testLOCK_NOT_TAKEN };
+    LockWaiter_t xUrgentWaiter = { prvFastMutexTake, prvFastMutexGive, testLOCK_TIMEOUT, testLOCK_WAITING, testLOCK_NOT_TAKEN };
+    BaseType_t xResult;
+
+    xTestFastMutex = xFastMutexCreate();
+    configASSERT( xTestFastMutex );
+
+    if( xFastMutexTake( xTestFastMutex, 0 ) != pdPASS )
+    {
+        xResult = prvFail( "a fast mutex no task held could not be taken" );
+    }
+    else
+    {
+        xResult = prvCheckLockInheritance( &xWaiter, &xUrgentWaiter, prvFastMutexGive );
+
+        if( ( xResult == pdPASS ) && ( xFastMutexGetHolder( xTestFastMutex ) != NULL ) )
+        {
+            xResult = prvFail( "the mutex was still held after every task gave it" );
+        }
+    }
+
+    vFastMutexDelete( xTestFastMutex );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRwLockTakeRead( TickType_t xTicksToWait )
+{
+    return xRwLockTakeRead( xTestRwLock, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRwLockGiveRead( void )
+{
+    ( void ) xRwLockGiveRead( xTestRwLock );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRwLockTakeWrite( TickType_t xTicksToWait )
+{
+    return xRwLockTakeWrite( xTestRwLock, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRwLockGiveWrite( void )
+{
+    ( void ) xRwLockGiveWrite( xTestRwLock );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRwLockInheritanceTest( void )
+{
+    LockWaiter_t xWriter = { prvRwLockTakeWrite, prvRwLockGiveWrite, portMAX_DELAY, testLOCK_WAITING, testLOCK_NOT_TAKEN };
+    LockWaiter_t xUrgentWriter = { prvRwLockTakeWrite, prvRwLockGiveWrite, testLOCK_TIMEOUT, testLOCK_WAITING, testLOCK_NOT_TAKEN };
+    LockWaiter_t xReader = { prvRwLockTakeRead, prvRwLockGiveRead, portMAX_DELAY, testLOCK_WAITING, testLOCK_NOT_TAKEN };
+    LockWaiter_t xUrgentReader = { prvRwLockTakeRead, prvRwLockGiveRead, testLOCK_TIMEOUT, testLOCK_WAITING, testLOCK_NOT_TAKEN };
+    BaseType_t xResult;
+
+    xTestRwLock = xRwLockCreate( pdTRUE );
+    configASSERT( xTestRwLock );
+
+    /* Writers waiting for a reader raise the reader's priority. */
+    if( xRwLockTakeRead( xTestRwLock, 0 ) != pdPASS )
+    {
+        xResult = prvFail( "a lock no task held could not be taken for reading" );
+    }
+    else
+    {
+        xResult = prvCheckLockInheritance( &xWriter, &xUrgentWriter, prvRwLockGiveRead );
+    }
+
+    /* Readers waiting for a writer raise the writer's priority. */
+    if( xResult == pdPASS )
+    {
+        if( xRwLockTakeWrite( xTestRwLock, 0 ) != pdPASS )
+        {
+            xResult = prvFail( "a lock no task held could not be taken for writing" );
+        }
+        else
+        {
+            xResult = prvCheckLockInheritance( &xReader, &xUrgentReader, prvRwLockGiveWrite );
+        }
+    }
+
+    if( ( xResult == pdPASS ) && ( ( xRwLockGetWriter( xTestRwLock ) != NULL ) || ( uxRwLockGetReaderCount( xTestRwLock ) != 0U ) ) )
+    {
+        xResult = prvFail( "the lock was still held after every task gave it" );
+    }
+
+    vRwLockDelete( xTestRwLock );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRwLockPreferWritersTest( void )
+{
+    LockWaiter_t xWriter = { prvRwLockTakeWrite, prvRwLockGiveWrite, portMAX_DELAY, testLOCK_WAITING, testLOCK_NOT_TAKEN };
+    LockWaiter_t xReader = { prvRwLockTakeRead, prvRwLockGiveRead, portMAX_DELAY, testLOCK_WAITING, testLOCK_NOT_TAKEN };
+    TaskHandle_t xWriterTask, xReaderTask;
+    BaseType_t xPreferWriters, xResult = pdPASS;
+
+    /* This task holds the lock for reading while a writer waits for it, then
+     * a reader of a higher priority than the writer tries to take it too.  A
+     * lock that prefers writers holds the new reader back until the writer
+     * has had the lock.  A lock that prefers readers lets the new reader share
+     * the lock straight away. */
+    for( xPreferWriters = pdFALSE; ( xPreferWriters <= pdTRUE ) && ( xResult == pdPASS ); xPreferWriters++ )
+    {
+        xTestRwLock = xRwLockCreate( xPreferWriters );
+        configASSERT( xTestRwLock );
+        uxLockTakes = 0;
+
+        if( xRwLockTakeRead( xTestRwLock, 0 ) != pdPASS )
+        {
+            xResult = prvFail( "a lock no task held could not be taken for reading" );
+        }
+        else
+        {
+            xWriterTask = prvStartLockWaiter( &xWriter, testLOCK_WAITER_PRIORITY );
+            xReaderTask = prvStartLockWaiter( &xReader, testLOCK_URGENT_PRIORITY );
+
+            if( ( xPreferWriters != pdFALSE ) && ( xReader.xResult != testLOCK_WAITING ) )
+            {
+                xResult = prvFail( "a new reader took a lock that prefers writers while a writer was waiting" );
+            }
+            else if( ( xPreferWriters == pdFALSE ) && ( xReader.xResult != pdPASS ) )
+            {
+                xResult = prvFail( "a new reader waited for a lock that prefers readers while only readers held it" );
+            }
+
+            prvRwLockGiveRead();
+
+            if( xResult != pdPASS )
+            {
+                /* Already failed. */
+            }
+            else if( ( xWriter.xResult != pdPASS ) || ( xReader.xResult != pdPASS ) )
+            {
+                xResult = prvFail( "the waiting tasks did not both take the lock once it was given" );
+            }
+            else if( ( xPreferWriters != pdFALSE ) && ( ( xWriter.uxTakeOrder != 0U ) || ( xReader.uxTakeOrder != 1U ) ) )
+            {
+                xResult = prvFail( "the new reader took a lock that prefers writers before the writer that was waiting" );
+            }
+
+            vTaskDelete( xWriterTask );
+            vTaskDelete( xReaderTask );
+
+            /* Let the idle task free the tasks. */
+            vTaskDelay( 2 );
+        }
+
+        vRwLockDelete( xTestRwLock );
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventWaiterTask( void * pvParameters )
+{
+    EventWaiter_t * const pxWaiter = ( EventWaiter_t * ) pvParameters;
+
+    pxWaiter->uxReturnedBits = xEventGroupWaitBits( xTestEventGroup, pxWaiter->uxBitsToWaitFor, pdFALSE, pxWaiter->xWaitForAllBits, pxWaiter->xTicksToWait );
+    pxWaiter->xReturned = pdTRUE;
+
+    /* Wait to be deleted. */
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvStartEventWaiter( EventWaiter_t * pxWaiter )
+{
+    TaskHandle_t xWaiterTask;
+    BaseType_t xReturned;
+
+    /* The waiter has the higher priority, so it has blocked on the event
+     * group by the time it is created. */
+    pxWaiter->uxReturnedBits = 0;
+    pxWaiter->xReturned = pdFALSE;
+    xReturned = xTaskCreate( prvEventWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, ( void * ) pxWaiter, testHIGH_PRIORITY, &xWaiterTask );
+    configASSERT( xReturned == pdPASS );
+
+    return xWaiterTask;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvEventGroupWaitAllTest( void )
+{
+    /* Bits 0, 1, 2, 5 and 6, which fall in three of the lists of waiting
+     * tasks, set in ascending order, so the task moves list after every bit,
+     * in descending order, so it stays in the list of bit 0 throughout, and in
+     * a mixed order. */
+    static const UBaseType_t uxSetOrders[][ testEVENT_WAIT_ALL_BITS ] =
+    {
+        { 0, 1, 2, 5, 6 },
+        { 6, 5, 2, 1, 0 },
+        { 5, 0, 6, 2, 1 }
+    };
+    EventWaiter_t xWaiter;
+    TaskHandle_t xWaiterTask;
+    EventBits_t uxBitsToWaitFor = 0;
+    UBaseType_t uxOrder, x;
+    BaseType_t xResult = pdPASS;
+
+    for( x = 0; x < testEVENT_WAIT_ALL_BITS; x++ )
+    {
+        uxBitsToWaitFor |= ( EventBits_t ) 1 << uxSetOrders[ 0 ][ x ];
+    }
+
+    xWaiter.uxBitsToWaitFor = uxBitsToWaitFor;
+    xWaiter.xWaitForAllBits = pdTRUE;
+    xWaiter.xTicksToWait = portMAX_DELAY;
+
+    for( uxOrder = 0; ( uxOrder < testARRAY_LENGTH( uxSetOrders ) ) && ( xResult == pdPASS ); uxOrder++ )
+    {
+        xTestEventGroup = xEventGroupCreate();
+        configASSERT( xTestEventGroup );
+
+        xWaiterTask = prvStartEventWaiter( &xWaiter );
+        ulEventGroupSearches = 0;
+
+        /* The waiter has the higher priority, so it has returned by the time
+         * the bit that completes its wait is set. */
+        for( x = 0; ( x < testEVENT_WAIT_ALL_BITS ) && ( xResult == pdPASS ); x++ )
+        {
+            ( void ) xEventGroupSetBits( xTestEventGroup, ( EventBits_t ) 1 << uxSetOrders[ uxOrder ][ x ] );
+
+            if( ( x < ( testEVENT_WAIT_ALL_BITS - 1U ) ) && ( xWaiter.xReturned != pdFALSE ) )
+            {
+                xResult = prvFail( "a task waiting for all of its bits returned when %u of %u were set", ( unsigned ) ( x + 1U ), testEVENT_WAIT_ALL_BITS );
+            }
+        }
+
+        if( xResult != pdPASS )
+        {
+            /* Already failed. */
+        }
+        else if( xWaiter.xReturned == pdFALSE )
+        {
+            xResult = prvFail( "a task waiting for all of its bits did not return when they were set in set order %u", ( unsigned ) uxOrder );
+        }
+        else if( ( xWaiter.uxReturnedBits & uxBitsToWaitFor ) != uxBitsToWaitFor )
+        {
+            xResult = prvFail( "a task waiting for bits 0x%lx returned 0x%lx", ( unsigned long ) uxBitsToWaitFor, ( unsigned long ) xWaiter.uxReturnedBits );
+        }
+        else if( ( uxOrder == 1U ) && ( ulEventGroupSearches != 1UL ) )
+        {
+            /* Only the list of bit 0 holds a task, so only setting bit 0
+             * searches a list. */
+            xResult = prvFail( "setting bits in descending order searched %lu lists of waiting tasks, expected 1", ulEventGroupSearches );
+        }
+
+        vTaskDelete( xWaiterTask );
+
+        /* Let the idle task free the task. */
+        vTaskDelay( 2 );
+
+        vEventGroupDelete( xTestEventGroup );
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvEventGroupTimeoutTest( void )
+{
+    /* Both waiters are held in the list of bit 0, which bit 4 shares. */
+    const EventBits_t uxTimeoutBit = ( EventBits_t ) 1 << configEVENT_GROUP_WAITER_BUCKETS;
+    const EventBits_t uxWaitBit = ( EventBits_t ) 1;
+    EventWaiter_t xTimeoutWaiter, xWaiter;
+    TaskHandle_t xTimeoutWaiterTask, xWaiterTask;
+    BaseType_t xResult = pdPASS;
+
+    xTestEventGroup = xEventGroupCreate();
+    configASSERT( xTestEventGroup );
+
+    xTimeoutWaiter.uxBitsToWaitFor = uxTimeoutBit;
+    xTimeoutWaiter.xWaitForAllBits = pdFALSE;
+    xTimeoutWaiter.xTicksToWait = testMIN_DELAY;
+    xWaiter.uxBitsToWaitFor = uxWaitBit;
+    xWaiter.xWaitForAllBits = pdFALSE;
+    xWaiter.xTicksToWait = portMAX_DELAY;
+
+    xTimeoutWaiterTask = prvStartEventWaiter( &xTimeoutWaiter );
+    xWaiterTask = prvStartEventWaiter( &xWaiter );
+
+    vTaskDelay( testMIN_DELAY * 2U );
+
+    if( ( xTimeoutWaiter.xReturned == pdFALSE ) || ( ( xTimeoutWaiter.uxReturnedBits & uxTimeoutBit ) != 0U ) )
+    {
+        xResult = prvFail( "a task waiting for a bit that was never set did not time out" );
+    }
+    else
+    {
+        /* The list still records the bit of the task that timed out until the
+         * list is next searched, which drops it. */
+        ulEventGroupSearches = 0;
+        ( void ) xEventGroupSetBits( xTestEventGroup, uxTimeoutBit );
+
+        if( ulEventGroupSearches != 1UL )
+        {
+            xResult = prvFail( "setting the bit of a task that timed out searched %lu lists, expected 1", ulEventGroupSearches );
+        }
+        else if( xWaiter.xReturned != pdFALSE )
+        {
+            xResult = prvFail( "a task waiting for another bit returned" );
+        }
+    }
+
+    if( xResult == pdPASS )
+    {
+        ( void ) xEventGroupClearBits( xTestEventGroup, uxTimeoutBit );
+        ulEventGroupSearches = 0;
+        ( void ) xEventGroupSetBits( xTestEventGroup, uxTimeoutBit );
+
+        if( ulEventGroupSearches != 0UL )
+        {
+            xResult = prvFail( "the bit of a task that timed out was still recorded after its list was searched" );
+        }
+    }
+
+    if( xResult == pdPASS )
+    {
+        /* The bit of the task still waiting was kept. */
+        ( void ) xEventGroupSetBits( xTestEventGroup, uxWaitBit );
+
+        if( ( xWaiter.xReturned == pdFALSE ) || ( ( xWaiter.uxReturnedBits & uxWaitBit ) == 0U ) )
+        {
+            xResult = prvFail( "a task that shared a list with a task that timed out was not unblocked by its bit" );
+        }
+        else if( ulEventGroupSearches != 1UL )
+        {
+            xResult = prvFail( "setting the bit of a waiting task searched %lu lists, expected 1", ulEventGroupSearches );
+        }
+    }
+
+    vTaskDelete( xTimeoutWaiterTask );
+    vTaskDelete( xWaiterTask );
+
+    /* Let the idle task free the tasks. */
+    vTaskDelay( 2 );
+
+    vEventGroupDelete( xTestEventGroup );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventSyncTask( void * pvParameters )
+{
+    const UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+    const EventBits_t uxAllBits = ( ( EventBits_t ) 1 << testEVENT_SYNC_TASKS ) - ( EventBits_t ) 1;
+    EventBits_t uxReturned;
+    UBaseType_t uxRound;
+
+    for( uxRound = 0; uxRound < testEVENT_SYNC_ROUNDS; uxRound++ )
+    {
+        uxReturned = xEventGroupSync( xTestEventGroup, ( EventBits_t ) 1 << uxIndex, uxAllBits, testEVENT_SYNC_TIMEOUT );
+
+        if( ( uxReturned & uxAllBits ) != uxAllBits )
+        {
+            uxEventSyncFailures++;
+        }
+    }
+
+    xTaskNotifyGive( xControlTask );
+
+    /* Wait to be deleted. */
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvEventGroupSyncTest( void )
+{
+    TaskHandle_t xSyncTasks[ testEVENT_SYNC_TASKS ];
+    UBaseType_t x;
+    BaseType_t xResult = pdPASS, xReturned;
+
+    xTestEventGroup = xEventGroupCreate();
+    configASSERT( xTestEventGroup );
+    uxEventSyncFailures = 0;
+
+    /* Each task sets its own bit and waits for the bits of all of them, and
+     * the last task created completes the first round. */
+    for( x = 0; x < testEVENT_SYNC_TASKS; x++ )
+    {
+        xReturned = xTaskCreate( prvEventSyncTask, "Sync", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, testHIGH_PRIORITY, &( xSyncTasks[ x ] ) );
+        configASSERT( xReturned == pdPASS );
+    }
+
+    for( x = 0; ( x < testEVENT_SYNC_TASKS ) && ( xResult == pdPASS ); x++ )
+    {
+        if( ulTaskNotifyTake( pdFALSE, testEVENT_SYNC_TIMEOUT ) == 0U )
+        {
+            xResult = prvFail( "only %u of %u tasks completed %u rounds", ( unsigned ) x, testEVENT_SYNC_TASKS, testEVENT_SYNC_ROUNDS );
+        }
+    }
+
+    if( ( xResult == pdPASS ) && ( uxEventSyncFailures != 0U ) )
+    {
+        xResult = prvFail( "%u syncs returned before every task reached them", ( unsigned ) uxEventSyncFailures );
+    }
+    else if( ( xResult == pdPASS ) && ( xEventGroupGetBits( xTestEventGroup ) != 0U ) )
+    {
+        xResult = prvFail( "bits 0x%lx were left set after the last sync", ( unsigned long ) xEventGroupGetBits( xTestEventGroup ) );
+    }
+
+    for( x = 0; x < testEVENT_SYNC_TASKS; x++ )
+    {
+        vTaskDelete( xSyncTasks[ x ] );
+    }
+
+    /* Let the idle task free the tasks. */
+    vTaskDelay( 2 );
+
+    vEventGroupDelete( xTestEventGroup );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeLatencyTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        xTaskNotifyGive( xControlTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeHogTask( void * pvParameters )
+{
+    TickType_t xStartTick;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        /* Ready the lower priority task, then keep it from running. */
+        xStartTick = xTaskGetTickCount();
+        xTaskNotifyGive( xWakeLatencyTask );
+
+        while( ( TickType_t ) ( xTaskGetTickCount() - xStartTick ) < testWAKE_LATENCY_TICKS )
+        {
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckWakeLatency( UBaseType_t uxBucket,
+                                       const char * pcWhen )
+{
+    TaskStatus_t xStatus;
+    UBaseType_t x;
+    uint32_t ulExpected;
+    BaseType_t xResult = pdPASS;
+
+    if( ulTaskNotifyTake( pdTRUE, testEVENT_SYNC_TIMEOUT ) == 0U )
+    {
+        xResult = prvFail( "the task %s did not run", pcWhen );
+    }
+
+    vTaskGetInfo( xWakeLatencyTask, &xStatus, pdFALSE, eInvalid );
+
+    for( x = 0; ( x < configWAKE_LATENCY_HISTOGRAM_BUCKETS ) && ( xResult == pdPASS ); x++ )
+    {
+        ulExpected = ulWakeLatencyBefore[ x ] + ( ( x == uxBucket ) ? 1UL : 0UL );
+
+        if( xStatus.ulWakeLatencyHistogram[ x ] != ulExpected )
+        {
+            xResult = prvFail( "bucket %u of the histogram of the task %s counted %lu waits, expected %lu", ( unsigned ) x, pcWhen,
+                               ( unsigned long ) ( xStatus.ulWakeLatencyHistogram[ x ] - ulWakeLatencyBefore[ x ] ),
+                               ( unsigned long ) ( ulExpected - ulWakeLatencyBefore[ x ] ) );
+        }
+    }
+
+    ( void ) memcpy( ulWakeLatencyBefore, xStatus.ulWakeLatencyHistogram, sizeof( ulWakeLatencyBefore ) );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWakeLatencyHistogramTest( void )
+{
+    TaskStatus_t xStatus;
+    BaseType_t xResult, xReturned;
+
+    /* Both tasks block as soon as they are created. */
+    xReturned = xTaskCreate( prvWakeLatencyTask, "Latency", configMINIMAL_STACK_SIZE, NULL, testHIGH_PRIORITY, &xWakeLatencyTask );
+    configASSERT( xReturned == pdPASS );
+    xReturned = xTaskCreate( prvWakeHogTask, "Hog", configMINIMAL_STACK_SIZE, NULL, testWAKE_HOG_PRIORITY, &xWakeHogTask );
+    configASSERT( xReturned == pdPASS );
+
+    vTaskGetInfo( xWakeLatencyTask, &xStatus, pdFALSE, eInvalid );
+    ( void ) memcpy( ulWakeLatencyBefore, xStatus.ulWakeLatencyHistogram, sizeof( ulWakeLatencyBefore ) );
+
+    /* A task readied by a lower priority task runs at once. */
+    xTaskNotifyGive( xWakeLatencyTask );
+    xResult = prvCheckWakeLatency( 0U, "that ran at once" );
+
+    /* The higher priority task readies the task and keeps it from running
+     * for testWAKE_LATENCY_TICKS ticks. */
+    if( xResult == pdPASS )
+    {
+        xTaskNotifyGive( xWakeHogTask );
+        xResult = prvCheckWakeLatency( testWAKE_LATENCY_BUCKET, "kept from running" );
+    }
+
+    vTaskDelete( xWakeLatencyTask );
+    vTaskDelete( xWakeHogTask );
+
+    /* Let the idle task free the tasks. */
+    vTaskDelay( 2 );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+    static void prvEventGroupTickHook( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        if( xEventIsrPending != pdFALSE )
+        {
+            xEventIsrRunning = pdTRUE;
+            xEventIsrRanWhileLocked = xEventGroupHoldingLock;
+
+            if( xEventIsrClearFirst != pdFALSE )
+            {
+                ( void ) xEventGroupClearBitsFromISR( xTestEventGroup, uxEventIsrBitsToClear );
+            }
+
+            ( void ) xEventGroupSetBitsFromISR( xTestEventGroup, uxEventIsrBitsToSet, &xHigherPriorityTaskWoken );
+
+            if( xEventIsrClearFirst == pdFALSE )
+            {
+                ( void ) xEventGroupClearBitsFromISR( xTestEventGroup, uxEventIsrBitsToClear );
+            }
+
+            xEventIsrRunning = pdFALSE;
+            xEventIsrPending = pdFALSE;
+
+            /* The tick interrupt switches task itself if one is needed. */
+            ( void ) xHigherPriorityTaskWoken;
+        }
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+    static BaseType_t prvEventGroupIsrOrderTest( void )
+    {
+        /* The tick hook sets and clears bit 0.  Bit 1 is set by this task, and
+         * is waited for so that setting it searches a list, during which the
+         * event group is held locked. */
+        const EventBits_t uxIsrBit = ( EventBits_t ) 0x01;
+        const EventBits_t uxTaskBit = ( EventBits_t ) 0x02;
+        EventWaiter_t xIsrWaiter, xTaskWaiter;
+        TaskHandle_t xIsrWaiterTask, xTaskWaiterTask;
+        BaseType_t xClearFirst, xResult = pdPASS;
+
+        xIsrWaiter.uxBitsToWaitFor = uxIsrBit;
+        xIsrWaiter.xWaitForAllBits = pdFALSE;
+        xIsrWaiter.xTicksToWait = portMAX_DELAY;
+        xTaskWaiter.uxBitsToWaitFor = uxTaskBit;
+        xTaskWaiter.xWaitForAllBits = pdFALSE;
+        xTaskWaiter.xTicksToWait = portMAX_DELAY;
+
+        /* The tick hook sets then clears, or clears then sets, the same bit
+         * while this task holds the event group locked.  The bit is left as
+         * the later of the two left it, and when that is set the task waiting
+         * for it is unblocked as the event group is unlocked. */
+        for( xClearFirst = pdFALSE; ( xClearFirst <= pdTRUE ) && ( xResult == pdPASS ); xClearFirst++ )
+        {
+            xTestEventGroup = xEventGroupCreate();
+            configASSERT( xTestEventGroup );
+
+            xIsrWaiterTask = prvStartEventWaiter( &xIsrWaiter );
+            xTaskWaiterTask = prvStartEventWaiter( &xTaskWaiter );
+
+            uxEventIsrBitsToSet = uxIsrBit;
+            uxEventIsrBitsToClear = uxIsrBit;
+            xEventIsrClearFirst = xClearFirst;
+            xEventIsrRanWhileLocked = pdFALSE;
+            xEventGroupHoldLock = pdTRUE;
+
+            ( void ) xEventGroupSetBits( xTestEventGroup, uxTaskBit );
+
+            if( xEventIsrRanWhileLocked == pdFALSE )
+            {
+                xResult = prvFail( "the tick hook did not run while the event group was locked" );
+            }
+            else if( ( xTaskWaiter.xReturned == pdFALSE ) || ( ( xTaskWaiter.uxReturnedBits & uxTaskBit ) == 0U ) )
+            {
+                xResult = prvFail( "the task waiting for the bit set while the event group was locked was not unblocked" );
+            }
+            else if( xClearFirst == pdFALSE )
+            {
+                if( ( xEventGroupGetBits( xTestEventGroup ) & uxIsrBit ) != 0U )
+                {
+                    xResult = prvFail( "a bit an interrupt set then cleared while the event group was locked was left set" );
+                }
+            }
+            else if( ( xEventGroupGetBits( xTestEventGroup ) & uxIsrBit ) == 0U )
+            {
+                xResult = prvFail( "a bit an interrupt cleared then set while the event group was locked was left clear" );
+            }
+            else if( ( xIsrWaiter.xReturned == pdFALSE ) || ( ( xIsrWaiter.uxReturnedBits & uxIsrBit ) == 0U ) )
+            {
+                xResult = prvFail( "a bit an interrupt set while the event group was locked did not unblock the task waiting for it" );
+            }
+
+            vTaskDelete( xIsrWaiterTask );
+            vTaskDelete( xTaskWaiterTask );
+
+            /* Let the idle task free the tasks. */
+            vTaskDelay( 2 );
+
+            vEventGroupDelete( xTestEventGroup );
+        }
+
+        return xResult;
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+    static BaseType_t prvEventGroupIsrDeferTest( void )
+    {
+        const EventBits_t uxIsrBit = ( EventBits_t ) 0x01;
+        EventWaiter_t xWaiters[ configEVENT_GROUP_ISR_MAX_WAITERS + 1 ];
+        TaskHandle_t xWaiterTasks[ configEVENT_GROUP_ISR_MAX_WAITERS + 1 ];
+        UBaseType_t uxWaiters, x;
+        BaseType_t xResult = pdPASS;
+
+        /* The tick hook sets a bit as many tasks wait for as an interrupt may
+         * look at, which it unblocks itself, then a bit one more task waits
+         * for, which it leaves to the timer task.  This task is delayed
+         * throughout, so any list searched outside the tick hook was searched
+         * by the timer task. */
+        for( uxWaiters = configEVENT_GROUP_ISR_MAX_WAITERS; ( uxWaiters <= ( configEVENT_GROUP_ISR_MAX_WAITERS + 1U ) ) && ( xResult == pdPASS ); uxWaiters++ )
+        {
+            xTestEventGroup = xEventGroupCreate();
+            configASSERT( xTestEventGroup );
+
+            for( x = 0; x < uxWaiters; x++ )
+            {
+                xWaiters[ x ].uxBitsToWaitFor = uxIsrBit;
+                xWaiters[ x ].xWaitForAllBits = pdFALSE;
+                xWaiters[ x ].xTicksToWait = portMAX_DELAY;
+                xWaiterTasks[ x ] = prvStartEventWaiter( &( xWaiters[ x ] ) );
+            }
+
+            ulEventGroupSearches = 0;
+            ulEventIsrSearches = 0;
+            uxEventIsrBitsToSet = uxIsrBit;
+            uxEventIsrBitsToClear = 0;
+            xEventIsrClearFirst = pdFALSE;
+            xEventIsrPending = pdTRUE;
+
+            vTaskDelay( testMIN_DELAY );
+
+            for( x = 0; ( x < uxWaiters ) && ( xResult == pdPASS ); x++ )
+            {
+                if( ( xWaiters[ x ].xReturned == pdFALSE ) || ( ( xWaiters[ x ].uxReturnedBits & uxIsrBit ) == 0U ) )
+                {
+                    xResult = prvFail( "task %u of %u waiting for a bit an interrupt set was not unblocked", ( unsigned ) x, ( unsigned ) uxWaiters );
+                }
+            }
+
+            if( xResult != pdPASS )
+            {
+                /* Already failed. */
+            }
+            else if( ulEventGroupSearches == 0UL )
+            {
+                xResult = prvFail( "tasks were unblocked without a list of waiting tasks being searched" );
+            }
+            else if( ( uxWaiters <= configEVENT_GROUP_ISR_MAX_WAITERS ) && ( ulEventIsrSearches != ulEventGroupSearches ) )
+            {
+                xResult = prvFail( "an interrupt left a bit %u tasks waited for to the timer task", ( unsigned ) uxWaiters );
+            }
+            else if( ( uxWaiters > configEVENT_GROUP_ISR_MAX_WAITERS ) && ( ulEventIsrSearches != 0UL ) )
+            {
+                xResult = prvFail( "an interrupt searched the list of %u tasks waiting for a bit, more than configEVENT_GROUP_ISR_MAX_WAITERS", ( unsigned ) uxWaiters );
+            }
+
+            for( x = 0; x < uxWaiters; x++ )
+            {
+                vTaskDelete( xWaiterTasks[ x ] );
+            }
+
+            /* Let the idle task free the tasks. */
+            vTaskDelay( 2 );
+
+            vEventGroupDelete( xTestEventGroup );
+        }
+
+        return xResult;
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+    static BaseType_t prvEventGroupIsrPendingTest( void )
+    {
+        const EventBits_t uxIsrBit = ( EventBits_t ) 0x01;
+        EventWaiter_t xWaiter;
+        TaskHandle_t xWaiterTask;
+        BaseType_t xReturnedWhileSuspended, xResult = pdPASS;
+
+        xTestEventGroup = xEventGroupCreate();
+        configASSERT( xTestEventGroup );
+
+        xWaiter.uxBitsToWaitFor = uxIsrBit;
+        xWaiter.xWaitForAllBits = pdFALSE;
+        xWaiter.xTicksToWait = portMAX_DELAY;
+        xWaiterTask = prvStartEventWaiter( &xWaiter );
+
+        uxEventIsrBitsToSet = uxIsrBit;
+        uxEventIsrBitsToClear = 0;
+        xEventIsrClearFirst = pdFALSE;
+
+        /* The tick hook sets the bit while the scheduler is suspended but the
+         * event group is not locked, so unblocks the waiting task itself and
+         * holds it as pending ready until the scheduler is resumed.  The bit
+         * is cleared before then, so the task only returns the bit if the
+         * value it was unblocked with was kept. */
+        vTaskSuspendAll();
+        {
+            xEventIsrPending = pdTRUE;
+
+            while( xEventIsrPending != pdFALSE )
+            {
+                /* Wait for the tick hook. */
+            }
+
+            xReturnedWhileSuspended = xWaiter.xReturned;
+            ( void ) xEventGroupClearBits( xTestEventGroup, uxIsrBit );
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xReturnedWhileSuspended != pdFALSE )
+        {
+            xResult = prvFail( "a task an interrupt unblocked ran while the scheduler was suspended" );
+        }
+        else if( xWaiter.xReturned == pdFALSE )
+        {
+            xResult = prvFail( "a task an interrupt unblocked while the scheduler was suspended did not run when it was resumed" );
+        }
+        else if( ( xWaiter.uxReturnedBits & uxIsrBit ) == 0U )
+        {
+            xResult = prvFail( "a task an interrupt unblocked while the scheduler was suspended returned 0x%lx", ( unsigned long ) xWaiter.uxReturnedBits );
+        }
+
+        vTaskDelete( xWaiterTask );
+
+        /* Let the idle task free the task. */
+        vTaskDelay( 2 );
+
+        vEventGroupDelete( xTestEventGroup );
+
+        return xResult;
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    static void prvTicklessTickHook( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        if( ( xTicklessWaitingTask != NULL ) && ( ulTickHookCalls == ulTicklessNotifyAtCall ) )
+        {
+            vTaskNotifyGiveFromISR( xTicklessWaitingTask, &xHigherPriorityTaskWoken );
+            xTicklessWaitingTask = NULL;
+
+            /* The tick interrupt switches task itself if one is needed. */
+            ( void ) xHigherPriorityTaskWoken;
+        }
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    static BaseType_t prvTicklessNoTimeoutTest( void )
+    {
+        TickType_t xStartTick, xTicksPassed;
+        BaseType_t xResult = pdPASS;
+
+        /* Every other task is blocked without a timeout while this task waits
+         * for the tick hook, so the idle task sleeps with no task due to
+         * unblock.  Only the tick hook can end the wait, so it does not
+         * return if the tick is not restarted after such a sleep. */
+        xStartTick = xTaskGetTickCount();
+
+        taskENTER_CRITICAL();
+        {
+            ulTicklessNotifyAtCall = ulTickHookCalls + testTICKLESS_HOOK_CALLS;
+            xTicklessWaitingTask = xTaskGetCurrentTaskHandle();
+        }
+        taskEXIT_CRITICAL();
+
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        xTicksPassed = xTaskGetTickCount() - xStartTick;
+
+        /* The tick hook is not called for the ticks suppressed while the idle
+         * task sleeps. */
+        if( xTicksPassed <= ( TickType_t ) testTICKLESS_HOOK_CALLS )
+        {
+            xResult = prvFail( "the tick hook was called %lu times in %lu ticks, so the tick was never suppressed",
+                               testTICKLESS_HOOK_CALLS, ( unsigned long ) xTicksPassed );
+        }
+
+        return xResult;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static void prvEdfTask( void * pvParameters )
+    {
+        const UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+        TickType_t xStartTick;
+
+        for( ; ; )
+        {
+            /* Blocking here completes the previous job, so is where a late job
+             * is reported. */
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            xStartTick = xTaskGetTickCount();
+            uxEdfRunOrder[ uxEdfJobsRun ] = uxIndex;
+            uxEdfJobsRun++;
+
+            while( ( TickType_t ) ( xTaskGetTickCount() - xStartTick ) < xEdfBusyTicks[ uxIndex ] )
+            {
+                /* Keep the job running without blocking. */
+            }
+
+            xTaskNotifyGive( xControlTask );
+        }
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static BaseType_t prvRunEdfJobs( const TickType_t * pxDeadlines,
+                                     const TickType_t * pxBusyTicks,
+                                     UBaseType_t uxTasks )
+    {
+        UBaseType_t x;
+        BaseType_t xResult = pdPASS, xReturned;
+
+        configASSERT( uxTasks <= testEDF_MAX_TASKS );
+
+        uxEdfJobsRun = 0;
+
+        /* The tasks have a higher priority than this task, so they have
+         * blocked waiting for their first job by the time they are created. */
+        for( x = 0; x < uxTasks; x++ )
+        {
+            xEdfBusyTicks[ x ] = pxBusyTicks[ x ];
+            uxEdfMissedDeadlines[ x ] = 0;
+            xReturned = xTaskCreate( prvEdfTask, "EDF", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, configEDF_PRIORITY, &( xEdfTasks[ x ] ) );
+            configASSERT( xReturned == pdPASS );
+        }
+
+        /* Release every job at the same tick, in task order, so only their
+         * deadlines decide the order in which they run. */
+        vTaskSuspendAll();
+        {
+            for( x = 0; x < uxTasks; x++ )
+            {
+                vTaskSetDeadline( xEdfTasks[ x ], pxDeadlines[ x ] );
+                xTaskNotifyGive( xEdfTasks[ x ] );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        /* Every task notifies this task once its job has run, and this task
+         * only runs again once they have all blocked. */
+        for( x = 0; ( x < uxTasks ) && ( xResult == pdPASS ); x++ )
+        {
+            if( ulTaskNotifyTake( pdFALSE, pdMS_TO_TICKS( 1000 ) ) == 0U )
+            {
+                xResult = prvFail( "only %u of %u jobs ran", ( unsigned ) x, ( unsigned ) uxTasks );
+            }
+        }
+
+        for( x = 0; x < uxTasks; x++ )
+        {
+            vTaskDelete( xEdfTasks[ x ] );
+        }
+
+        /* Let the idle task free the tasks. */
+        vTaskDelay( 2 );
+
+        return xResult;
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static BaseType_t prvEdfDeadlineOrderTest( void )
+    {
+        /* The task without a deadline runs after all the tasks with one. */
+        static const TickType_t xDeadlines[] = { 40, 10, 0, 30, 20 };
+        static const TickType_t xBusyTicks[] = { 0, 0, 0, 0, 0 };
+        static const UBaseType_t uxExpectedOrder[] = { 1, 4, 3, 0, 2 };
+        const UBaseType_t uxTasks = testARRAY_LENGTH( xDeadlines );
+        UBaseType_t x;
+        BaseType_t xResult;
+
+        xResult = prvRunEdfJobs( xDeadlines, xBusyTicks, uxTasks );
+
+        for( x = 0; ( x < uxTasks ) && ( xResult == pdPASS ); x++ )
+        {
+            if( uxEdfRunOrder[ x ] != uxExpectedOrder[ x ] )
+            {
+                xResult = prvFail( "job %u to run had a deadline of %lu ticks, expected %lu ticks", ( unsigned ) x,
+                                   ( unsigned long ) xDeadlines[ uxEdfRunOrder[ x ] ],
+                                   ( unsigned long ) xDeadlines[ uxExpectedOrder[ x ] ] );
+            }
+            else if( uxEdfMissedDeadlines[ x ] != 0U )
+            {
+                xResult = prvFail( "a job with a deadline of %lu ticks that did not run late was reported late",
+                                   ( unsigned long ) xDeadlines[ x ] );
+            }
+        }
+
+        return xResult;
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static BaseType_t prvEdfDeadlineMissedTest( void )
+    {
+        /* The first job runs for well past its deadline, so is late.  The
+         * second only runs once the first has blocked, but still completes
+         * long before its own deadline. */
+        static const TickType_t xDeadlines[] = { 3, 50 };
+        static const TickType_t xBusyTicks[] = { 10, 0 };
+        BaseType_t xResult;
+
+        xResult = prvRunEdfJobs( xDeadlines, xBusyTicks, testARRAY_LENGTH( xDeadlines ) );
+
+        if( xResult == pdPASS )
+        {
+            if( ( uxEdfRunOrder[ 0 ] != 0U ) || ( uxEdfRunOrder[ 1 ] != 1U ) )
+            {
+                xResult = prvFail( "the job with the later deadline ran first" );
+            }
+            else if( uxEdfMissedDeadlines[ 0 ] != 1U )
+            {
+                xResult = prvFail( "a job that ran %lu ticks past its deadline was reported late %u times",
+                                   ( unsigned long ) ( xBusyTicks[ 0 ] - xDeadlines[ 0 ] ), ( unsigned ) uxEdfMissedDeadlines[ 0 ] );
+            }
+            else if( uxEdfMissedDeadlines[ 1 ] != 0U )
+            {
+                xResult = prvFail( "a job that completed before its deadline was reported late" );
+            }
+        }
+
+        return xResult;
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+
+    static void prvBitmapTask( void * pvParameters )
+    {
+        const UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            if( uxBitmapTasksRun < testBITMAP_TASKS )
+            {
+                uxBitmapRunOrder[ uxBitmapTasksRun ] = uxIndex;
+            }
+
+            uxBitmapTasksRun++;
+        }
+    }
+
+#endif /* configUSE_READY_PRIORITY_BITMAP */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+
+    static BaseType_t prvCheckBitmapRunOrder( const UBaseType_t * puxExpectedOrder,
+                                              UBaseType_t uxTasks )
+    {
+        UBaseType_t x;
+        BaseType_t xResult = pdPASS;
+
+        if( uxBitmapTasksRun != uxTasks )
+        {
+            xResult = prvFail( "%u tasks ran, expected %u", ( unsigned ) uxBitmapTasksRun, ( unsigned ) uxTasks );
+        }
+
+        for( x = 0; ( x < uxTasks ) && ( xResult == pdPASS ); x++ )
+        {
+            if( uxBitmapRunOrder[ x ] != puxExpectedOrder[ x ] )
+            {
+                xResult = prvFail( "task %u to run had priority %u, expected priority %u", ( unsigned ) x,
+                                   ( unsigned ) uxTaskPriorityGet( xBitmapTasks[ uxBitmapRunOrder[ x ] ] ),
+                                   ( unsigned ) uxTaskPriorityGet( xBitmapTasks[ puxExpectedOrder[ x ] ] ) );
+            }
+        }
+
+        uxBitmapTasksRun = 0;
+
+        return xResult;
+    }
+
+#endif /* configUSE_READY_PRIORITY_BITMAP */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+
+    static BaseType_t prvReadyPriorityBitmapTest( void )
+    {
+        /* Every task runs highest priority first.  Then the lowest priority
+         * task is moved up to a word above all but the highest priority task,
+         * and the only task in its word is suspended, while they are all
+         * ready. */
+        static const UBaseType_t uxAllOrder[] = { 7, 6, 5, 4, 3, 2, 1, 0 };
+        static const UBaseType_t uxMovedOrder[] = { 7, 0, 6, 5, 3, 2, 1 };
+        static const UBaseType_t uxResumedOrder[] = { 4 };
+        const UBaseType_t uxSuspended = 4;
+        UBaseType_t x;
+        BaseType_t xResult, xReturned;
+
+        configASSERT( uxBitmapPriorities[ testBITMAP_TASKS - 1U ] < testBITMAP_CONTROL_PRIORITY );
+
+        /* The tasks run once the control task lowers its priority, and block
+         * waiting to be notified. */
+        vTaskPrioritySet( NULL, testBITMAP_CONTROL_PRIORITY );
+
+        for( x = 0; x < testBITMAP_TASKS; x++ )
+        {
+            xReturned = xTaskCreate( prvBitmapTask, "Bitmap", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, uxBitmapPriorities[ x ], &( xBitmapTasks[ x ] ) );
+            configASSERT( xReturned == pdPASS );
+        }
+
+        vTaskPrioritySet( NULL, testCONTROL_PRIORITY );
+        uxBitmapTasksRun = 0;
+
+        /* Ready the tasks lowest priority first. */
+        vTaskPrioritySet( NULL, testBITMAP_CONTROL_PRIORITY );
+
+        for( x = 0; x < testBITMAP_TASKS; x++ )
+        {
+            xTaskNotifyGive( xBitmapTasks[ x ] );
+        }
+
+        vTaskPrioritySet( NULL, testCONTROL_PRIORITY );
+        xResult = prvCheckBitmapRunOrder( uxAllOrder, testARRAY_LENGTH( uxAllOrder ) );
+
+        if( xResult == pdPASS )
+        {
+            vTaskPrioritySet( NULL, testBITMAP_CONTROL_PRIORITY );
+
+            for( x = 0; x < testBITMAP_TASKS; x++ )
+            {
+                xTaskNotifyGive( xBitmapTasks[ x ] );
+            }
+
+            vTaskPrioritySet( xBitmapTasks[ 0 ], testBITMAP_MOVED_PRIORITY );
+            vTaskSuspend( xBitmapTasks[ uxSuspended ] );
+            vTaskPrioritySet( NULL, testCONTROL_PRIORITY );
+            xResult = prvCheckBitmapRunOrder( uxMovedOrder, testARRAY_LENGTH( uxMovedOrder ) );
+
+            /* The suspended task is still notified, so runs once resumed. */
+            vTaskResume( xBitmapTasks[ uxSuspended ] );
+
+            if( xResult == pdPASS )
+            {
+                xResult = prvCheckBitmapRunOrder( uxResumedOrder, testARRAY_LENGTH( uxResumedOrder ) );
+            }
+        }
+
+        for( x = 0; x < testBITMAP_TASKS; x++ )
+        {
+            vTaskDelete( xBitmapTasks[ x ] );
+        }
+
+        /* Let the idle task free the tasks. */
+        vTaskDelay( 2 );
+
+        return xResult;
+    }
+
+#endif /* configUSE_READY_PRIORITY_BITMAP */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+
+    static BaseType_t prvPendingTickTest( void )
+    {
+        unsigned long ulStartCalls, ulMaskedCalls, ulEndCalls;
+        UBaseType_t uxAttempt;
+        BaseType_t xMaskedRanOnce = pdFALSE, xUnmaskedRanOnce = pdFALSE;
+        BaseType_t xResult = pdPASS;
+
+        for( uxAttempt = 0; ( uxAttempt < testPENDING_TICK_ATTEMPTS ) && ( xResult == pdPASS ); uxAttempt++ )
+        {
+            /* Start just after a tick, so the next tick from the timer is
+             * unlikely to arrive while the checks are made. */
+            vTaskDelay( 1 );
+
+            /* Ticks that arrive while interrupts are masked are held pending,
+             * however many arrive, and run once when interrupts are
+             * unmasked. */
+            ulStartCalls = ulTickHookCalls;
+            taskENTER_CRITICAL();
+            {
+                ( void ) raise( SIGALRM );
+                ( void ) raise( SIGALRM );
+                ulMaskedCalls = ulTickHookCalls;
+            }
+            taskEXIT_CRITICAL();
+            ulEndCalls = ulTickHookCalls;
+
+            if( ulMaskedCalls != ulStartCalls )
+            {
+                xResult = prvFail( "%lu ticks ran while interrupts were masked", ulMaskedCalls - ulStartCalls );
+            }
+            else if( ulEndCalls == ulStartCalls )
+            {
+                xResult = prvFail( "the pending tick did not run when interrupts were unmasked" );
+            }
+            else if( ulEndCalls == ( ulStartCalls + 1UL ) )
+            {
+                xMaskedRanOnce = pdTRUE;
+            }
+
+            /* A tick that arrives once the flag is cleared, but before
+             * vPortEnableInterrupts() looks for a pending tick, is run by the
+             * signal handler and not run again by vPortEnableInterrupts(). */
+            if( xResult == pdPASS )
+            {
+                ulStartCalls = ulTickHookCalls;
+                taskENTER_CRITICAL();
+                {
+                    xRaiseTickWhenUnmasked = pdTRUE;
+                }
+                taskEXIT_CRITICAL();
+                ulEndCalls = ulTickHookCalls;
+
+                if( xRaiseTickWhenUnmasked != pdFALSE )
+                {
+                    xResult = prvFail( "unmasking interrupts did not call tracePORT_INTERRUPTS_UNMASKED()" );
+                }
+                else if( ulTickHookCallsAfterRaise == ulStartCalls )
+                {
+                    xResult = prvFail( "a tick that arrived as interrupts were unmasked was not run by the signal handler" );
+                }
+                else if( ulEndCalls == ( ulStartCalls + 1UL ) )
+                {
+                    xUnmaskedRanOnce = pdTRUE;
+                }
+            }
+        }
+
+        /* A tick from the timer can add to the count in any one attempt, but
+         * not in all of them. */
+        if( ( xResult == pdPASS ) && ( xMaskedRanOnce == pdFALSE ) )
+        {
+            xResult = prvFail( "ticks that arrived while interrupts were masked did not run exactly once in %u attempts", ( unsigned ) testPENDING_TICK_ATTEMPTS );
+        }
+        else if( ( xResult == pdPASS ) && ( xUnmaskedRanOnce == pdFALSE ) )
+        {
+            xResult = prvFail( "a tick that arrived as interrupts were unmasked did not run exactly once in %u attempts", ( unsigned ) testPENDING_TICK_ATTEMPTS );
+        }
+
+        return xResult;
+    }
+
+#endif /* configUSE_SOFTWARE_INTERRUPT_MASK */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_GREEN_THREADS == 1 )
+
+    static void prvGreenRingTask( void * pvParameters )
+    {
+        UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+        TaskStatus_t xStatus;
+        uint8_t * pucStackStart;
+
+        /* Every task runs on the thread that started the scheduler, but on the
+         * stack the kernel allocated for it. */
+        vTaskGetInfo( NULL, &xStatus, pdFALSE, eRunning );
+        pucStackStart = ( uint8_t * ) xStatus.pxStackBase;
+
+        if( ( ( uint8_t * ) &xStatus < pucStackStart ) ||
+            ( ( uint8_t * ) &xStatus >= ( pucStackStart + ( configMINIMAL_STACK_SIZE * sizeof( StackType_t ) ) ) ) )
+        {
+            uxGreenOffStack++;
+        }
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            uxGreenRingPasses++;
+
+            if( ( uxIndex + 1U ) < testGREEN_RING_TASKS )
+            {
+                xTaskNotifyGive( xGreenRingTasks[ uxIndex + 1U ] );
+            }
+            else
+            {
+                xTaskNotifyGive( xControlTask );
+            }
+        }
+    }
+
+#endif /* configUSE_GREEN_THREADS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_GREEN_THREADS == 1 )
+
+    static BaseType_t prvGreenThreadRingTest( void )
+    {
+        UBaseType_t x;
+        BaseType_t xReturned, xResult = pdPASS;
+
+        uxGreenRingPasses = 0;
+        uxGreenOffStack = 0;
+
+        /* Each task checks its stack and blocks as soon as it is created. */
+        for( x = 0; x < testGREEN_RING_TASKS; x++ )
+        {
+            xReturned = xTaskCreate( prvGreenRingTask, "Ring", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, testHIGH_PRIORITY, &( xGreenRingTasks[ x ] ) );
+            configASSERT( xReturned == pdPASS );
+        }
+
+        for( x = 0; ( x < testGREEN_RING_ROUNDS ) && ( xResult == pdPASS ); x++ )
+        {
+            xTaskNotifyGive( xGreenRingTasks[ 0 ] );
+
+            if( ulTaskNotifyTake( pdTRUE, testEVENT_SYNC_TIMEOUT ) == 0U )
+            {
+                xResult = prvFail( "round %u of the ring did not complete, the notification was passed on %u times",
+                                   ( unsigned ) x, ( unsigned ) uxGreenRingPasses );
+            }
+        }
+
+        if( ( xResult == pdPASS ) && ( uxGreenRingPasses != ( testGREEN_RING_TASKS * testGREEN_RING_ROUNDS ) ) )
+        {
+            xResult = prvFail( "the notification was passed on %u times, expected %u", ( unsigned ) uxGreenRingPasses,
+                               ( unsigned ) ( testGREEN_RING_TASKS * testGREEN_RING_ROUNDS ) );
+        }
+        else if( ( xResult == pdPASS ) && ( uxGreenOffStack != 0U ) )
+        {
+            xResult = prvFail( "%u tasks ran on a stack the kernel did not allocate for them", ( unsigned ) uxGreenOffStack );
+        }
+
+        for( x = 0; x < testGREEN_RING_TASKS; x++ )
+        {
+            vTaskDelete( xGreenRingTasks[ x ] );
+        }
+
+        /* Let the idle task free the tasks. */
+        vTaskDelay( 2 );
+
+        return xResult;
+    }
+
+#endif /* configUSE_GREEN_THREADS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+
+    static void prvRecordVirtualEvent( UBaseType_t uxSource,
+                                       TickType_t xTick,
+                                       uint32_t ulValue )
+    {
+        UBaseType_t uxEvent = uxVirtualEvents;
+
+        if( xVirtualRecording != pdFALSE )
+        {
+            /* One more event than fits is counted, so a run that recorded too
+             * many events can be told apart from one that filled the array. */
+            if( uxEvent < testVIRTUAL_MAX_EVENTS )
+            {
+                xVirtualEvents[ uxEvent ].xTick = xTick - xVirtualStartTick;
+                xVirtualEvents[ uxEvent ].uxSource = uxSource;
+                xVirtualEvents[ uxEvent ].ulValue = ulValue;
+                uxVirtualEvents = uxEvent + 1U;
+            }
+            else if( uxEvent == testVIRTUAL_MAX_EVENTS )
+            {
+                uxVirtualEvents = uxEvent + 1U;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvVirtualSleeperTask( void * pvParameters )
+    {
+        vTaskDelay( ( TickType_t ) ( uintptr_t ) pvParameters );
+        vTaskSuspend( NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvVirtualWorkloadTask( void * pvParameters )
+    {
+        const UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+        TickType_t xLastWakeTime = xVirtualStartTick;
+        uint32_t ulValue = 0;
+
+        while( ( TickType_t ) ( xTaskGetTickCount() - xVirtualStartTick ) < testVIRTUAL_WORKLOAD_TICKS )
+        {
+            if( xVirtualPeriods[ uxIndex ] == ( TickType_t ) 0 )
+            {
+                /* Receives what the other tasks send, timing out between
+                 * items. */
+                if( xQueueReceive( xVirtualQueue, &ulValue, testVIRTUAL_RECEIVE_TIMEOUT ) != pdPASS )
+                {
+                    ulValue = UINT32_MAX;
+                }
+
+                prvRecordVirtualEvent( uxIndex, xTaskGetTickCount(), ulValue );
+            }
+            else
+            {
+                vTaskDelayUntil( &xLastWakeTime, xVirtualPeriods[ uxIndex ] );
+                ulValue++;
+                prvRecordVirtualEvent( uxIndex, xTaskGetTickCount(), ulValue );
+                ( void ) xQueueSend( xVirtualQueue, &ulValue, 0 );
+            }
+        }
+
+        xTaskNotifyGive( xControlTask );
+        vTaskSuspend( NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvVirtualTimerCallback( TimerHandle_t xTimer )
+    {
+        ( void ) xTimer;
+
+        prvRecordVirtualEvent( testVIRTUAL_TIMER_EVENT, xTaskGetTickCount(), 0 );
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvRunVirtualWorkload( void )
+    {
+        UBaseType_t x;
+        BaseType_t xReturned, xResult = pdPASS;
+
+        xVirtualQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+        xVirtualTimer = xTimerCreate( "Virtual", testVIRTUAL_TIMER_PERIOD, pdTRUE, NULL, prvVirtualTimerCallback );
+        configASSERT( ( xVirtualQueue != NULL ) && ( xVirtualTimer != NULL ) );
+
+        /* Everything starts from the same tick, in the same order. */
+        vTaskSuspendAll();
+        {
+            xVirtualStartTick = xTaskGetTickCount();
+            uxVirtualEvents = 0;
+            xVirtualRecording = pdTRUE;
+
+            for( x = 0; x < testVIRTUAL_TASKS; x++ )
+            {
+                xReturned = xTaskCreate( prvVirtualWorkloadTask, "Virtual", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, testHIGH_PRIORITY + x, &( xVirtualTasks[ x ] ) );
+                configASSERT( xReturned == pdPASS );
+            }
+
+            xReturned = xTimerStart( xVirtualTimer, 0 );
+            configASSERT( xReturned == pdPASS );
+        }
+        ( void ) xTaskResumeAll();
+
+        for( x = 0; ( x < testVIRTUAL_TASKS ) && ( xResult == pdPASS ); x++ )
+        {
+            if( ulTaskNotifyTake( pdFALSE, testVIRTUAL_WORKLOAD_TICKS * 2U ) == 0U )
+            {
+                xResult = prvFail( "only %u of the workload's tasks finished", ( unsigned ) x );
+            }
+        }
+
+        xVirtualRecording = pdFALSE;
+
+        if( ( xResult == pdPASS ) && ( uxVirtualEvents > testVIRTUAL_MAX_EVENTS ) )
+        {
+            xResult = prvFail( "the workload recorded more than %u events", ( unsigned ) testVIRTUAL_MAX_EVENTS );
+        }
+
+        ( void ) xTimerDelete( xVirtualTimer, portMAX_DELAY );
+
+        for( x = 0; x < testVIRTUAL_TASKS; x++ )
+        {
+            vTaskDelete( xVirtualTasks[ x ] );
+        }
+
+        /* Let the idle task free the tasks. */
+        vTaskDelay( 2 );
+
+        vQueueDelete( xVirtualQueue );
+
+        return xResult;
+    }
+
+#endif /* configUSE_VIRTUAL_TIME */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+
+    static BaseType_t prvVirtualTimeIdleJumpTest( void )
+    {
+        TaskHandle_t xSleeperTask;
+        TickType_t xStartTick, xEndTick;
+        struct timespec xNow;
+        uint64_t ullStartNs, ullNowNs;
+        BaseType_t xReturned, xResult = pdPASS;
+
+        /* Time does not pass while a task runs, however long it runs for. */
+        xStartTick = xTaskGetTickCount();
+        ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+        ullStartNs = ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+
+        do
+        {
+            ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+            ullNowNs = ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+        } while( ( ullNowNs - ullStartNs ) < testVIRTUAL_SPIN_NS );
+
+        if( xTaskGetTickCount() != xStartTick )
+        {
+            xResult = prvFail( "%lu ticks passed while a task ran", ( unsigned long ) ( xTaskGetTickCount() - xStartTick ) );
+        }
+
+        /* Once every task is blocked the idle task moves time straight to the
+         * first task's wake time, then straight to the second's. */
+        if( xResult == pdPASS )
+        {
+            vTaskSuspendAll();
+            {
+                xStartTick = xTaskGetTickCount();
+                xVirtualStartTick = xStartTick;
+                uxVirtualEvents = 0;
+                xVirtualRecording = pdTRUE;
+
+                xReturned = xTaskCreate( prvVirtualSleeperTask, "Sleeper", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) testVIRTUAL_SHORT_DELAY, testHIGH_PRIORITY, &xSleeperTask );
+                configASSERT( xReturned == pdPASS );
+            }
+            ( void ) xTaskResumeAll();
+
+            vTaskDelay( testVIRTUAL_DELAY );
+            xEndTick = xTaskGetTickCount();
+            xVirtualRecording = pdFALSE;
+
+            if( ( xEndTick - xStartTick ) != testVIRTUAL_DELAY )
+            {
+                xResult = prvFail( "a delay of %lu ticks ended after %lu ticks", ( unsigned long ) testVIRTUAL_DELAY, ( unsigned long ) ( xEndTick - xStartTick ) );
+            }
+            else if( uxVirtualEvents != 2U )
+            {
+                xResult = prvFail( "time was moved forward %u times, expected 2", ( unsigned ) uxVirtualEvents );
+            }
+            else if( ( xVirtualEvents[ 0 ].xTick != 0U ) || ( xVirtualEvents[ 0 ].ulValue != ( uint32_t ) testVIRTUAL_SHORT_DELAY ) )
+            {
+                xResult = prvFail( "time was first moved forward %lu ticks at tick %lu, expected %lu ticks at tick 0",
+                                   ( unsigned long ) xVirtualEvents[ 0 ].ulValue, ( unsigned long ) xVirtualEvents[ 0 ].xTick, ( unsigned long ) testVIRTUAL_SHORT_DELAY );
+            }
+            else if( ( xVirtualEvents[ 1 ].xTick != testVIRTUAL_SHORT_DELAY ) || ( xVirtualEvents[ 1 ].ulValue != ( uint32_t ) ( testVIRTUAL_DELAY - testVIRTUAL_SHORT_DELAY ) ) )
+            {
+                xResult = prvFail( "time was next moved forward %lu ticks at tick %lu, expected %lu ticks at tick %lu",
+                                   ( unsigned long ) xVirtualEvents[ 1 ].ulValue, ( unsigned long ) xVirtualEvents[ 1 ].xTick,
+                                   ( unsigned long ) ( testVIRTUAL_DELAY - testVIRTUAL_SHORT_DELAY ), ( unsigned long ) testVIRTUAL_SHORT_DELAY );
+            }
+
+            vTaskDelete( xSleeperTask );
+
+            /* Let the idle task free the task. */
+            vTaskDelay( 2 );
+        }
+
+        return xResult;
+    }
+
+#endif /* configUSE_VIRTUAL_TIME */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+
+    static BaseType_t prvVirtualTimeRepeatTest( void )
+    {
+        UBaseType_t x, uxFirstRunEvents, uxTimerEvents = 0;
+        BaseType_t xResult;
+
+        /* The same workload run twice from different ticks sees the same
+         * events at the same ticks, and time moves forward in the same
+         * steps. */
+        xResult = prvRunVirtualWorkload();
+
+        if( xResult == pdPASS )
+        {
+            uxFirstRunEvents = uxVirtualEvents;
+            ( void ) memcpy( xVirtualFirstRun, xVirtualEvents, sizeof( xVirtualFirstRun ) );
+
+            /* Start the second run from a tick the first run did not. */
+            vTaskDelay( testVIRTUAL_SHORT_DELAY );
+            xResult = prvRunVirtualWorkload();
+        }
+
+        if( ( xResult == pdPASS ) && ( uxVirtualEvents != uxFirstRunEvents ) )
+        {
+            xResult = prvFail( "the first run recorded %u events and the second %u", ( unsigned ) uxFirstRunEvents, ( unsigned ) uxVirtualEvents );
+        }
+
+        for( x = 0; ( x < uxFirstRunEvents ) && ( xResult == pdPASS ); x++ )
+        {
+            if( ( xVirtualEvents[ x ].xTick != xVirtualFirstRun[ x ].xTick ) ||
+                ( xVirtualEvents[ x ].uxSource != xVirtualFirstRun[ x ].uxSource ) ||
+                ( xVirtualEvents[ x ].ulValue != xVirtualFirstRun[ x ].ulValue ) )
+            {
+                xResult = prvFail( "event %u was source %u value %lu at tick %lu in the first run, but source %u value %lu at tick %lu in the second",
+                                   ( unsigned ) x,
+                                   ( unsigned ) xVirtualFirstRun[ x ].uxSource, ( unsigned long ) xVirtualFirstRun[ x ].ulValue, ( unsigned long ) xVirtualFirstRun[ x ].xTick,
+                                   ( unsigned ) xVirtualEvents[ x ].uxSource, ( unsigned long ) xVirtualEvents[ x ].ulValue, ( unsigned long ) xVirtualEvents[ x ].xTick );
+            }
+            else if( xVirtualEvents[ x ].uxSource == testVIRTUAL_TIMER_EVENT )
+            {
+                uxTimerEvents++;
+            }
+        }
+
+        /* Make sure the workload did what it was meant to. */
+        if( ( xResult == pdPASS ) && ( uxTimerEvents != ( UBaseType_t ) ( testVIRTUAL_WORKLOAD_TICKS / testVIRTUAL_TIMER_PERIOD ) ) )
+        {
+            xResult = prvFail( "the timer expired %u times, expected %u", ( unsigned ) uxTimerEvents,
+                               ( unsigned ) ( testVIRTUAL_WORKLOAD_TICKS / testVIRTUAL_TIMER_PERIOD ) );
+        }
+
+        return xResult;
+    }
+
+#endif /* configUSE_VIRTUAL_TIME */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvSmpBusyTask( void * pvParameters )
+    {
+        const UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+        UBaseType_t uxCoreMask, uxBusyCores, x;
+        BaseType_t xCoreID;
+        TaskHandle_t xRunning;
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            while( ( TickType_t ) ( xTaskGetTickCount() - xSmpStartTick ) < xSmpBusyTicks )
+            {
+                xCoreID = portGET_CORE_ID();
+                uxCoreMask = ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID;
+                uxSmpChecks[ uxIndex ]++;
+                uxSmpCoresUsed[ uxIndex ] |= uxCoreMask;
+
+                if( ( uxTaskCoreAffinityGet( NULL ) & uxCoreMask ) == 0U )
+                {
+                    uxSmpWrongCore[ uxIndex ]++;
+                }
+
+                /* Count the cores running one of the busy tasks. */
+                uxBusyCores = 0;
+
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    xRunning = xTaskGetCurrentTaskHandleForCore( xCoreID );
+
+                    for( x = 0; x < testSMP_TASKS; x++ )
+                    {
+                        if( xRunning == xSmpTasks[ x ] )
+                        {
+                            uxBusyCores++;
+                            break;
+                        }
+                    }
+                }
+
+                if( uxBusyCores == configNUMBER_OF_CORES )
+                {
+                    xSmpAllCoresBusy = pdTRUE;
+                }
+            }
+
+            xTaskNotifyGive( xControlTask );
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvSmpSpinTask( void * pvParameters )
+    {
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            /* Nothing here enters a critical section, which would give the
+             * core a chance to reschedule when it left it. */
+            while( xSmpSpinning != pdFALSE )
+            {
+                ulSmpSpins++;
+            }
+
+            xTaskNotifyGive( xControlTask );
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvSmpPreemptTask( void * pvParameters )
+    {
+        BaseType_t xCoreID;
+
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            xCoreID = portGET_CORE_ID();
+            ulSmpPreemptCoreTicks = ulSmpCoreTicks[ xCoreID ];
+            xSmpPreemptCore = xCoreID;
+
+            xTaskNotifyGive( xControlTask );
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvStartSmpBusyTasks( UBaseType_t uxTasks )
+    {
+        UBaseType_t x;
+        BaseType_t xReturned;
+
+        configASSERT( uxTasks <= testSMP_TASKS );
+
+        /* The tasks wait to be notified before they check the cores they run
+         * on, so can be given an affinity mask first. */
+        for( x = 0; x < uxTasks; x++ )
+        {
+            xReturned = xTaskCreate( prvSmpBusyTask, "Busy", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, testSMP_BUSY_PRIORITY, &( xSmpTasks[ x ] ) );
+            configASSERT( xReturned == pdPASS );
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static BaseType_t prvRunSmpBusyTasks( UBaseType_t uxTasks )
+    {
+        UBaseType_t x;
+        BaseType_t xResult = pdPASS;
+
+        for( x = 0; x < uxTasks; x++ )
+        {
+            uxSmpChecks[ x ] = 0;
+            uxSmpCoresUsed[ x ] = 0;
+            uxSmpWrongCore[ x ] = 0;
+        }
+
+        xSmpAllCoresBusy = pdFALSE;
+        xSmpBusyTicks = testSMP_BUSY_TICKS;
+
+        /* Release every task at once, as this task would otherwise be
+         * preempted by the first tasks before it had notified the others. */
+        vTaskSuspendAll();
+        {
+            xSmpStartTick = xTaskGetTickCount();
+
+            for( x = 0; x < uxTasks; x++ )
+            {
+                xTaskNotifyGive( xSmpTasks[ x ] );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        for( x = 0; ( x < uxTasks ) && ( xResult == pdPASS ); x++ )
+        {
+            if( ulTaskNotifyTake( pdFALSE, testSMP_TIMEOUT ) == 0U )
+            {
+                xResult = prvFail( "only %u of %u busy tasks finished", ( unsigned ) x, ( unsigned ) uxTasks );
+            }
+        }
+
+        return xResult;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvDeleteSmpTasks( UBaseType_t uxTasks )
+    {
+        UBaseType_t x;
+
+        for( x = 0; x < uxTasks; x++ )
+        {
+            vTaskDelete( xSmpTasks[ x ] );
+        }
+
+        /* Let the idle tasks free the tasks. */
+        vTaskDelay( 2 );
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static BaseType_t prvSmpCoreAffinityTest( void )
+    {
+        const UBaseType_t uxCore0 = ( UBaseType_t ) 1U << 0U;
+        const UBaseType_t uxCore1 = ( UBaseType_t ) 1U << 1U;
+        UBaseType_t x;
+        BaseType_t xResult;
+
+        prvStartSmpBusyTasks( 2 );
+
+        /* Both tasks are held to core 0, so take turns on it. */
+        vTaskCoreAffinitySet( xSmpTasks[ 0 ], uxCore0 );
+        vTaskCoreAffinitySet( xSmpTasks[ 1 ], uxCore0 );
+        xResult = prvRunSmpBusyTasks( 2 );
+
+        for( x = 0; ( x < 2U ) && ( xResult == pdPASS ); x++ )
+        {
+            if( uxTaskCoreAffinityGet( xSmpTasks[ x ] ) != uxCore0 )
+            {
+                xResult = prvFail( "a task's affinity mask was 0x%x, expected 0x%x",
+                                   ( unsigned ) uxTaskCoreAffinityGet( xSmpTasks[ x ] ), ( unsigned ) uxCore0 );
+            }
+            else if( uxSmpWrongCore[ x ] != 0U )
+            {
+                xResult = prvFail( "a task held to core 0 ran on cores 0x%x", ( unsigned ) uxSmpCoresUsed[ x ] );
+            }
+        }
+
+        if( xResult == pdPASS )
+        {
+            if( ( uxSmpChecks[ 0 ] == 0U ) && ( uxSmpChecks[ 1 ] == 0U ) )
+            {
+                xResult = prvFail( "neither task held to core 0 ran" );
+            }
+            else if( xSmpAllCoresBusy != pdFALSE )
+            {
+                xResult = prvFail( "two tasks held to core 0 ran at the same time" );
+            }
+        }
+
+        /* Moving one of the tasks to core 1 lets them run at the same
+         * time. */
+        if( xResult == pdPASS )
+        {
+            vTaskCoreAffinitySet( xSmpTasks[ 0 ], uxCore1 );
+            xResult = prvRunSmpBusyTasks( 2 );
+        }
+
+        if( xResult == pdPASS )
+        {
+            if( ( uxSmpCoresUsed[ 0 ] != uxCore1 ) || ( uxSmpCoresUsed[ 1 ] != uxCore0 ) )
+            {
+                xResult = prvFail( "tasks held to cores 1 and 0 ran on cores 0x%x and 0x%x",
+                                   ( unsigned ) uxSmpCoresUsed[ 0 ], ( unsigned ) uxSmpCoresUsed[ 1 ] );
+            }
+            else if( xSmpAllCoresBusy == pdFALSE )
+            {
+                xResult = prvFail( "tasks held to different cores never ran at the same time" );
+            }
+        }
+
+        prvDeleteSmpTasks( 2 );
+
+        return xResult;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static BaseType_t prvSmpAllCoresBusyTest( void )
+    {
+        const UBaseType_t uxLowTask = testSMP_TASKS - 1U;
+        UBaseType_t x;
+        BaseType_t xResult;
+
+        /* One more task than there are cores, the last at a lower priority
+         * than the others, none with an affinity mask. */
+        prvStartSmpBusyTasks( testSMP_TASKS );
+        vTaskPrioritySet( xSmpTasks[ uxLowTask ], testSMP_BUSY_PRIORITY - 1U );
+        xResult = prvRunSmpBusyTasks( testSMP_TASKS );
+
+        for( x = 0; ( x < uxLowTask ) && ( xResult == pdPASS ); x++ )
+        {
+            if( uxSmpChecks[ x ] == 0U )
+            {
+                xResult = prvFail( "a task of the highest ready priority did not run" );
+            }
+        }
+
+        if( xResult == pdPASS )
+        {
+            if( xSmpAllCoresBusy == pdFALSE )
+            {
+                xResult = prvFail( "the %u tasks of the highest ready priority never ran on every core at the same time",
+                                   ( unsigned ) uxLowTask );
+            }
+            else if( uxSmpChecks[ uxLowTask ] != 0U )
+            {
+                xResult = prvFail( "a lower priority task ran while every core had a higher priority task to run" );
+            }
+        }
+
+        prvDeleteSmpTasks( testSMP_TASKS );
+
+        return xResult;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static BaseType_t prvSmpYieldCoreTest( void )
+    {
+        const UBaseType_t uxCore0 = ( UBaseType_t ) 1U << 0U;
+        const UBaseType_t uxCore1 = ( UBaseType_t ) 1U << 1U;
+        TaskHandle_t xSpinTask, xPreemptTask;
+        UBaseType_t x, uxWaitedForTick = 0;
+        unsigned long ulTicksBefore;
+        BaseType_t xResult = pdPASS, xReturned;
+
+        /* A task that never blocks spins on core 1 while this task readies a
+         * higher priority task that may only run on core 1, so core 1 only
+         * switches to it when it is interrupted. */
+        xReturned = xTaskCreate( prvSmpSpinTask, "Spin", configMINIMAL_STACK_SIZE, NULL, testSMP_BUSY_PRIORITY, &xSpinTask );
+        configASSERT( xReturned == pdPASS );
+        xReturned = xTaskCreate( prvSmpPreemptTask, "Preempt", configMINIMAL_STACK_SIZE, NULL, testSMP_PREEMPT_PRIORITY, &xPreemptTask );
+        configASSERT( xReturned == pdPASS );
+        vTaskCoreAffinitySet( xSpinTask, uxCore1 );
+        vTaskCoreAffinitySet( xPreemptTask, uxCore1 );
+        vTaskCoreAffinitySet( NULL, uxCore0 );
+
+        ulSmpSpins = 0;
+        xSmpSpinning = pdTRUE;
+        xTaskNotifyGive( xSpinTask );
+
+        for( x = 0; ( ulSmpSpins == 0UL ) && ( x < testSMP_TIMEOUT ); x++ )
+        {
+            vTaskDelay( 1 );
+        }
+
+        if( ulSmpSpins == 0UL )
+        {
+            xResult = prvFail( "the spinning task did not start" );
+        }
+
+        /* The interrupt from core 0 reschedules core 1 straight away, so the
+         * task readied for it runs before core 1 next handles the tick.  A
+         * tick can reach core 1 just before the interrupt does, so one
+         * attempt may have waited for it. */
+        for( x = 0; ( x < testSMP_PREEMPT_ATTEMPTS ) && ( xResult == pdPASS ); x++ )
+        {
+            xSmpPreemptCore = -1;
+            ulTicksBefore = ulSmpCoreTicks[ 1 ];
+            xTaskNotifyGive( xPreemptTask );
+
+            if( ulTaskNotifyTake( pdTRUE, testSMP_TIMEOUT ) == 0U )
+            {
+                xResult = prvFail( "a task readied to preempt core 1 never ran" );
+            }
+            else if( xSmpPreemptCore != 1 )
+            {
+                xResult = prvFail( "a task held to core 1 ran on core %d", ( int ) xSmpPreemptCore );
+            }
+            else if( ulSmpPreemptCoreTicks != ulTicksBefore )
+            {
+                uxWaitedForTick++;
+            }
+        }
+
+        if( ( xResult == pdPASS ) && ( uxWaitedForTick > 1U ) )
+        {
+            xResult = prvFail( "core 1 only switched to a task readied by core 0 on its next tick in %u of %u attempts",
+                               ( unsigned ) uxWaitedForTick, ( unsigned ) testSMP_PREEMPT_ATTEMPTS );
+        }
+
+        xSmpSpinning = pdFALSE;
+
+        if( ( ulTaskNotifyTake( pdTRUE, testSMP_TIMEOUT ) == 0U ) && ( xResult == pdPASS ) )
+        {
+            xResult = prvFail( "the spinning task did not stop" );
+        }
+
+        vTaskCoreAffinitySet( NULL, tskNO_AFFINITY );
+        vTaskDelete( xSpinTask );
+        vTaskDelete( xPreemptTask );
+
+        /* Let the idle tasks free the tasks. */
+        vTaskDelay( 2 );
+
+        return xResult;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+void vTestTaskMovedToReady( void * pvTask,
+                            unsigned long ulTickCount )
+{
+    UBaseType_t x;
+
+    /* Called from inside the kernel, so must not call the API. */
+    for( x = 0; x < testMAX_DELAYED_TASKS; x++ )
+    {
+        if( ( void * ) xDelayedTasks[ x ] == pvTask )
+        {
+            xReadyTicks[ x ] = ( TickType_t ) ulTickCount;
+            break;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTestSpscRingBlocking( void )
+{
+    uint32_t ulItem = testSPSC_HOOK_ITEM;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    /* Called just before a task blocks on a ring, outside any critical
+     * section, where an interrupt could also run. */
+    if( xSpscMakeUsable != pdFALSE )
+    {
+        xSpscMakeUsable = pdFALSE;
+
+        if( uxSpscRingItemsWaiting( xSpscRing ) == 0U )
+        {
+            ( void ) xSpscRingSendFromISR( xSpscRing, &ulItem, &xHigherPriorityTaskWoken );
+        }
+        else
+        {
+            ( void ) xSpscRingReceiveFromISR( xSpscRing, &ulItem, &xHigherPriorityTaskWoken );
+            ulSpscHookItem = ulItem;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTestEventGroupSearched( void )
+{
+    /* Called from inside the kernel, so must not call the API. */
+    ulEventGroupSearches++;
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+    {
+        if( xEventIsrRunning != pdFALSE )
+        {
+            ulEventIsrSearches++;
+        }
+        else if( xEventGroupHoldLock != pdFALSE )
+        {
+            /* The task setting bits holds the event group locked while it
+             * searches the lists, so the tick hook acts on the locked event
+             * group. */
+            xEventGroupHoldLock = pdFALSE;
+            xEventGroupHoldingLock = pdTRUE;
+            xEventIsrPending = pdTRUE;
+
+            while( xEventIsrPending != pdFALSE )
+            {
+                /* Wait for the tick hook. */
+            }
+
+            xEventGroupHoldingLock = pdFALSE;
+        }
+    }
+    #endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    void vTestDeadlineMissed( void * pvTask )
+    {
+        UBaseType_t x;
+
+        /* Called from inside the kernel, so must not call the API. */
+        for( x = 0; x < testEDF_MAX_TASKS; x++ )
+        {
+            if( ( void * ) xEdfTasks[ x ] == pvTask )
+            {
+                uxEdfMissedDeadlines[ x ]++;
+                break;
+            }
+        }
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+
+    void vTestVirtualTimeAdvanced( unsigned long ulTicks,
+                                   unsigned long ulTickCount )
+    {
+        /* Called from inside the kernel, so must not call the API. */
+        prvRecordVirtualEvent( testVIRTUAL_ADVANCE_EVENT, ( TickType_t ) ulTickCount, ( uint32_t ) ulTicks );
+    }
+
+#endif /* configUSE_VIRTUAL_TIME */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SOFTWARE_INTERRUPT_MASK == 1 )
+
+    void vTestInterruptsUnmasked( void )
+    {
+        /* Called from inside the port, so must not call the API. */
+        if( xRaiseTickWhenUnmasked != pdFALSE )
+        {
+            xRaiseTickWhenUnmasked = pdFALSE;
+
+            /* Interrupts are no longer masked, so the signal handler runs the
+             * tick before raise() returns. */
+            ( void ) raise( SIGALRM );
+            ulTickHookCallsAfterRaise = ulTickHookCalls;
+        }
+    }
+
+#endif /* configUSE_SOFTWARE_INTERRUPT_MASK */
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+    ulTickHookCalls++;
+    prvMpscTickHookProducers();
+    prvPubSubTickHookPublisher();
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+        prvEventGroupTickHook();
+    #endif
+
+    #if ( configUSE_TICKLESS_IDLE == 1 )
+        prvTicklessTickHook();
+    #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        ulSmpCoreTicks[ portGET_CORE_ID() ]++;
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * const pcFileName,
+                    unsigned long ulLine )
+{
+    if( uxAssertsExpected > 0U )
+    {
+        uxAssertsExpected--;
+    }
+    else
+    {
+        fprintf( stderr, "ASSERT! Line %lu, file %s\n", ulLine, pcFileName );
+        abort();
+    }
+}
+/*-----------------------------------------------------------*/
@@ -30,8 +30,153 @@
 #include <stdlib.h>
 #include <errno.h>
 
+#include "FreeRTOS.h"
 #include "wait_for_event.h"
 
+#if ( configUSE_FUTEX_EVENTS == 1 )
+
+#include <stdint.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*
+ * An event is a single futex word.  Only the thread that owns the event
+ * waits on it, so the word records whether the event has been signalled and
+ * whether its owner is asleep in the kernel.  Signalling an event whose owner
+ * is not asleep needs no system call.
+ */
+#define EVENT_CLEAR        0U
+#define EVENT_TRIGGERED    1U
+#define EVENT_SLEEPING     2U
+
+struct event
+{
+    uint32_t state;
+};
+
+static long futex( uint32_t * uaddr,
+                   int op,
+                   uint32_t val,
+                   const struct timespec * timeout )
+{
+    return syscall( SYS_futex, uaddr, op, val, timeout, NULL, 0 );
+}
+
+static bool event_take( struct event * ev )
+{
+    uint32_t expected = EVENT_TRIGGERED;
+
+    return __atomic_compare_exchange_n( &ev->state, &expected, EVENT_CLEAR, false,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED );
+}
+
+/*
+ * Sleeps until the event is signalled or the timeout, if any, expires.
+ * pthread_cancel() must still be able to cancel a thread waiting here, as
+ * it can when the thread is waiting on a condition variable, so cancellation
+ * is made asynchronous for the duration of the system call.
+ */
+static bool event_sleep( struct event * ev,
+                         const struct timespec * timeout )
+{
+    uint32_t expected = EVENT_CLEAR;
+    int oldtype;
+    long ret;
+
+    if( __atomic_compare_exchange_n( &ev->state, &expected, EVENT_SLEEPING, false,
+                                     __ATOMIC_RELAXED, __ATOMIC_RELAXED ) == false )
+    {
+        /* Either already signalled or already marked as sleeping. */
+        if( expected == EVENT_TRIGGERED )
+        {
+            return true;
+        }
+    }
+
+    pthread_setcanceltype( PTHREAD_CANCEL_ASYNCHRONOUS, &oldtype );
+    ret = futex( &ev->state, FUTEX_WAIT_PRIVATE, EVENT_SLEEPING, timeout );
+    pthread_setcanceltype( oldtype, NULL );
+
+    return ( ret == 0 ) || ( errno != ETIMEDOUT );
+}
+
+struct event * event_create( void )
+{
+    struct event * ev = malloc( sizeof( struct event ) );
+
+    ev->state = EVENT_CLEAR;
+    return ev;
+}
+
+void event_delete( struct event * ev )
+{
+    free( ev );
+}
+
+bool event_wait( struct event * ev )
+{
+    while( event_take( ev ) == false )
+    {
+        ( void ) event_sleep( ev, NULL );
+    }
+
+    return true;
+}
+
+bool event_wait_timed( struct event * ev,
+                       time_t ms )
+{
+    struct timespec now, deadline, remaining;
+    uint32_t expected;
+
+    clock_gettime( CLOCK_MONOTONIC, &deadline );
+    deadline.tv_sec += ms / 1000;
+    deadline.tv_nsec += ( ( ms % 1000 ) * 1000000 );
+
+    if( deadline.tv_nsec >= 1000000000 )
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    while( event_take( ev ) == false )
+    {
+        /* FUTEX_WAIT takes a relative timeout. */
+        clock_gettime( CLOCK_MONOTONIC, &now );
+        remaining.tv_sec = deadline.tv_sec - now.tv_sec;
+        remaining.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+
+        if( remaining.tv_nsec < 0 )
+        {
+            remaining.tv_sec--;
+            remaining.tv_nsec += 1000000000;
+        }
+
+        if( ( remaining.tv_sec < 0 ) || ( event_sleep( ev, &remaining ) == false ) )
+        {
+            /* Timed out.  The event stays signalled if it was signalled
+             * since it was last checked. */
+            expected = EVENT_SLEEPING;
+            ( void ) __atomic_compare_exchange_n( &ev->state, &expected, EVENT_CLEAR, false,
+                                                  __ATOMIC_RELAXED, __ATOMIC_RELAXED );
+            return event_take( ev );
+        }
+    }
+
+    return true;
+}
+
+void event_signal( struct event * ev )
+{
+    if( __atomic_exchange_n( &ev->state, EVENT_TRIGGERED, __ATOMIC_RELEASE ) == EVENT_SLEEPING )
+    {
+        ( void ) futex( &ev->state, FUTEX_WAKE_PRIVATE, 1, NULL );
+    }
+}
+
+#else /* configUSE_FUTEX_EVENTS */
+
 struct event
 {
     pthread_mutex_t mutex;
@@ -102,3 +247,5 @@ void event_signal( struct event * ev )
     pthread_cond_signal( &ev->cond );
     pthread_mutex_unlock( &ev->mutex );
 }
+
+#endif /* configUSE_FUTEX_EVENTS */
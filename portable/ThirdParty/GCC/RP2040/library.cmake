@@ -8,8 +8,14 @@ add_library(FreeRTOS-Kernel-Core INTERFACE)
 target_sources(FreeRTOS-Kernel-Core INTERFACE
         ${FREERTOS_KERNEL_PATH}/croutine.c
         ${FREERTOS_KERNEL_PATH}/event_groups.c
+        ${FREERTOS_KERNEL_PATH}/fast_mutex.c
         ${FREERTOS_KERNEL_PATH}/list.c
+        ${FREERTOS_KERNEL_PATH}/mpsc_queue.c
+        ${FREERTOS_KERNEL_PATH}/multi_wait.c
+        ${FREERTOS_KERNEL_PATH}/pubsub.c
         ${FREERTOS_KERNEL_PATH}/queue.c
+        ${FREERTOS_KERNEL_PATH}/rwlock.c
+        ${FREERTOS_KERNEL_PATH}/spsc_ring.c
         ${FREERTOS_KERNEL_PATH}/stream_buffer.c
         ${FREERTOS_KERNEL_PATH}/tasks.c
         ${FREERTOS_KERNEL_PATH}/timers.c
@@ -0,0 +1,510 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pubsub.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+    #define pubsubYIELD_IF_USING_PREEMPTION()
+#else
+    #define pubsubYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+#endif
+
+/* Bits that can be set in PubSub_t.ucFlags. */
+#define pubsubFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 ) /* Set if the channel was created using statically allocated memory. */
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the channel.  Items are numbered,
+ * in the order they are published, by a sequence number that is allowed to
+ * wrap.  The item with sequence number n is held in slot n % uxLength, so the
+ * slots hold the last uxLength items published, and a subscriber has missed
+ * items if its next sequence number is more than uxLength behind the
+ * channel's.  uxLength is a power of two so the slot index stays correct when
+ * the sequence numbers wrap. */
+typedef struct PubSubDef_t                 /*lint !e9058 Style convention uses tag. */
+{
+    List_t xTasksWaitingToReceive;         /*< List of subscriber tasks that are blocked waiting for an item to be published.  Stored in priority order. */
+    volatile UBaseType_t uxNextSequence;   /*< The sequence number the next published item will be given. */
+    uint8_t * pucStorage;                  /*< Points to the first slot. */
+    UBaseType_t uxLength;                  /*< The number of slots, which is a power of two. */
+    UBaseType_t uxItemSize;                /*< The size of each item. */
+    uint8_t ucFlags;
+} PubSub_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both xPubSubCreate() and xPubSubCreateStatic() to initialise the
+ * contents of a channel.
+ */
+static void prvInitialiseNewPubSub( PubSub_t * const pxChannel,
+                                    uint8_t * const pucStorage,
+                                    UBaseType_t uxLength,
+                                    UBaseType_t uxItemSize,
+                                    uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies an item into the next slot and moves every task that is waiting for
+ * an item out of the channel's event list.  Returns pdTRUE if one of the tasks
+ * has a priority above the calling task.  Must be called from a critical
+ * section.
+ */
+static BaseType_t prvPublishItem( PubSub_t * const pxChannel,
+                                  const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of items published after the one the subscriber last
+ * received, including any that have since been overwritten.
+ */
+#define prvItemsAvailable( pxChannel, pxSubscriber )    ( ( pxChannel )->uxNextSequence - ( pxSubscriber )->uxNextSequence )
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    PubSubHandle_t xPubSubCreate( const UBaseType_t uxLength,
+                                  const UBaseType_t uxItemSize )
+    {
+        uint8_t * pucAllocatedMemory;
+
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( ( uxLength & ( uxLength - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        /* Check for multiplication overflow. */
+        if( ( ( SIZE_MAX - sizeof( PubSub_t ) ) / uxLength ) > ( size_t ) uxItemSize )
+        {
+            /* The PubSub_t structure is placed at the start of the allocated
+             * memory and the slots follow immediately after.  Items are copied
+             * in and out with memcpy(), so the slots need no alignment. */
+            pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( PubSub_t ) + ( ( size_t ) uxLength * ( size_t ) uxItemSize ) ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            pucAllocatedMemory = NULL;
+        }
+
+        if( pucAllocatedMemory != NULL )
+        {
+            prvInitialiseNewPubSub( ( PubSub_t * ) pucAllocatedMemory, /* Structure at the start of the allocated memory. */ /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+                                    pucAllocatedMemory + sizeof( PubSub_t ), /* Slots follow. */
+                                    uxLength,
+                                    uxItemSize,
+                                    0 );
+
+            tracePUBSUB_CREATE( ( ( PubSub_t * ) pucAllocatedMemory ) );
+        }
+        else
+        {
+            tracePUBSUB_CREATE_FAILED();
+        }
+
+        return ( PubSubHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    PubSubHandle_t xPubSubCreateStatic( const UBaseType_t uxLength,
+                                        const UBaseType_t uxItemSize,
+                                        uint8_t * const pucStorageArea,
+                                        StaticPubSub_t * const pxStaticChannel )
+    {
+        PubSub_t * const pxChannel = ( PubSub_t * ) pxStaticChannel; /*lint !e740 !e9087 Safe cast as StaticPubSub_t is opaque PubSub_t. */
+        PubSubHandle_t xReturn;
+
+        configASSERT( pucStorageArea );
+        configASSERT( pxStaticChannel );
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( ( uxLength & ( uxLength - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticPubSub_t equals the size of the real
+             * channel structure. */
+            volatile size_t xSize = sizeof( StaticPubSub_t );
+            configASSERT( xSize == sizeof( PubSub_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucStorageArea != NULL ) && ( pxStaticChannel != NULL ) )
+        {
+            prvInitialiseNewPubSub( pxChannel,
+                                    pucStorageArea,
+                                    uxLength,
+                                    uxItemSize,
+                                    pubsubFLAGS_IS_STATICALLY_ALLOCATED );
+
+            tracePUBSUB_CREATE( pxChannel );
+
+            xReturn = ( PubSubHandle_t ) pxStaticChannel; /*lint !e9087 Data hiding requires cast to opaque type. */
+        }
+        else
+        {
+            xReturn = NULL;
+            tracePUBSUB_CREATE_FAILED();
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vPubSubDelete( PubSubHandle_t xChannel )
+{
+    PubSub_t * pxChannel = xChannel;
+
+    configASSERT( pxChannel );
+
+    /* No subscriber can be blocked on a channel that is being deleted. */
+    configASSERT( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToReceive ) ) != pdFALSE );
+
+    tracePUBSUB_DELETE( xChannel );
+
+    if( ( pxChannel->ucFlags & pubsubFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* Both the structure and the slots were allocated using a single
+             * call to pvPortMalloc(), hence only one call to vPortFree() is
+             * required. */
+            vPortFree( ( void * ) pxChannel ); /*lint !e9087 Standard free() semantics require void *, plus pxChannel was allocated by pvPortMalloc(). */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xChannel == ( PubSubHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure and slots were not allocated dynamically and cannot
+         * be freed - just scrub the structure so future use will assert. */
+        ( void ) memset( pxChannel, 0x00, sizeof( PubSub_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPubSubSubscribe( PubSubHandle_t xChannel,
+                       PubSubSubscriber_t * const pxSubscriber )
+{
+    configASSERT( xChannel );
+    configASSERT( pxSubscriber );
+
+    /* Reading the sequence number is atomic, so no critical section is
+     * needed.  An item published concurrently is either received by the
+     * subscriber or not, both of which are correct. */
+    pxSubscriber->xChannel = xChannel;
+    pxSubscriber->uxNextSequence = xChannel->uxNextSequence;
+}
+/*-----------------------------------------------------------*/
+
+void vPubSubPublish( PubSubHandle_t xChannel,
+                     const void * pvItem )
+{
+    PubSub_t * const pxChannel = xChannel;
+
+    configASSERT( pxChannel );
+    configASSERT( pvItem );
+
+    taskENTER_CRITICAL();
+    {
+        if( prvPublishItem( pxChannel, pvItem ) != pdFALSE )
+        {
+            /* One of the subscribers that were unblocked has a priority
+             * above this task. */
+            pubsubYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vPubSubPublishFromISR( PubSubHandle_t xChannel,
+                            const void * pvItem,
+                            BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    PubSub_t * const pxChannel = xChannel;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxChannel );
+    configASSERT( pvItem );
+
+    /* See the comments in xQueueGenericSendFromISR() on the use of
+     * portASSERT_IF_INTERRUPT_PRIORITY_INVALID(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        if( prvPublishItem( pxChannel, pvItem ) != pdFALSE )
+        {
+            if( pxHigherPriorityTaskWoken != NULL )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPubSubReceive( PubSubSubscriber_t * const pxSubscriber,
+                           void * const pvBuffer,
+                           UBaseType_t * const puxItemsLost,
+                           TickType_t xTicksToWait )
+{
+    PubSub_t * pxChannel;
+    BaseType_t xReturn = errQUEUE_EMPTY;
+    BaseType_t xEntryTimeSet = pdFALSE, xItemReceived = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxAvailable, uxLost = ( UBaseType_t ) 0;
+
+    configASSERT( pxSubscriber );
+    configASSERT( pvBuffer );
+
+    pxChannel = pxSubscriber->xChannel;
+    configASSERT( pxChannel );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            uxAvailable = prvItemsAvailable( pxChannel, pxSubscriber );
+
+            if( uxAvailable > ( UBaseType_t ) 0 )
+            {
+                /* If the subscriber has fallen more than a full ring behind
+                 * then the items it has not received have been overwritten.
+                 * Skip to the oldest item that is still held rather than hold
+                 * up the publisher. */
+                if( uxAvailable > pxChannel->uxLength )
+                {
+                    uxLost = uxAvailable - pxChannel->uxLength;
+                    pxSubscriber->uxNextSequence += uxLost;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ( void ) memcpy( pvBuffer, ( void * ) &( pxChannel->pucStorage[ ( pxSubscriber->uxNextSequence & ( pxChannel->uxLength - ( UBaseType_t ) 1 ) ) * pxChannel->uxItemSize ] ), ( size_t ) pxChannel->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+                ( pxSubscriber->uxNextSequence )++;
+
+                xReturn = pdPASS;
+                xItemReceived = pdTRUE;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                /* Nothing to receive and either no block time was specified
+                 * or the block time has expired. */
+                xItemReceived = pdTRUE;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                /* The timeout state is only captured once the call has to
+                 * block, so the path that does not block enters only one
+                 * critical section. */
+                vTaskInternalSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xItemReceived != pdFALSE )
+        {
+            break;
+        }
+
+        /* Interrupts and other tasks can publish between the two critical
+         * sections, so the channel is checked again before the task blocks.
+         * Publishers remove waiting tasks from the event list inside a
+         * critical section, so a task placed on the list here cannot miss an
+         * item published after the check. */
+        taskENTER_CRITICAL();
+        {
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvItemsAvailable( pxChannel, pxSubscriber ) == ( UBaseType_t ) 0 )
+                {
+                    traceBLOCKING_ON_PUBSUB_RECEIVE( pxChannel );
+                    vTaskPlaceOnEventList( &( pxChannel->xTasksWaitingToReceive ), xTicksToWait );
+
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until
+                     * the critical section exits) - but it is not something
+                     * that application code should ever do. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Timed out.  xTicksToWait is now zero, so the next pass
+                 * receives an item if one was published at the last moment,
+                 * and otherwise returns. */
+                xTicksToWait = ( TickType_t ) 0;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    if( puxItemsLost != NULL )
+    {
+        *puxItemsLost = uxLost;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPubSubItemsWaiting( const PubSubSubscriber_t * const pxSubscriber )
+{
+    UBaseType_t uxReturn;
+
+    configASSERT( pxSubscriber );
+    configASSERT( pxSubscriber->xChannel );
+
+    uxReturn = prvItemsAvailable( pxSubscriber->xChannel, pxSubscriber );
+
+    if( uxReturn > pxSubscriber->xChannel->uxLength )
+    {
+        uxReturn = pxSubscriber->xChannel->uxLength;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewPubSub( PubSub_t * const pxChannel,
+                                    uint8_t * const pucStorage,
+                                    UBaseType_t uxLength,
+                                    UBaseType_t uxItemSize,
+                                    uint8_t ucFlags )
+{
+    ( void ) memset( ( void * ) pxChannel, 0x00, sizeof( PubSub_t ) ); /*lint !e9087 memset() requires void *. */
+
+    vListInitialise( &( pxChannel->xTasksWaitingToReceive ) );
+    pxChannel->uxNextSequence = ( UBaseType_t ) 0;
+    pxChannel->pucStorage = pucStorage;
+    pxChannel->uxLength = uxLength;
+    pxChannel->uxItemSize = uxItemSize;
+    pxChannel->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPublishItem( PubSub_t * const pxChannel,
+                                  const void * pvItem )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    UBaseType_t uxSequence = pxChannel->uxNextSequence;
+
+    /* The item is copied once, however many subscribers there are.  The
+     * oldest item is overwritten if the ring is full - it is up to each
+     * subscriber to keep up. */
+    ( void ) memcpy( ( void * ) &( pxChannel->pucStorage[ ( uxSequence & ( pxChannel->uxLength - ( UBaseType_t ) 1 ) ) * pxChannel->uxItemSize ] ), pvItem, ( size_t ) pxChannel->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+    pxChannel->uxNextSequence = uxSequence + ( UBaseType_t ) 1;
+
+    /* Every waiting subscriber has now got an item to receive, so unblock
+     * them all.  The list is in priority order, so the highest priority
+     * subscriber is made ready first. */
+    while( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToReceive ) ) == pdFALSE )
+    {
+        if( xTaskRemoveFromEventList( &( pxChannel->xTasksWaitingToReceive ) ) != pdFALSE )
+        {
+            xHigherPriorityTaskWoken = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
@@ -130,17 +130,148 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucZeroCopyState; /*< Records whether a storage slot is currently reserved by a writer and/or acquired by a reader. */
+    #endif
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        UBaseType_t uxNextSequence; /*< Stamped on each item sent to a priority queue so items of equal priority are received in the order they were sent. */
+        uint8_t ucPriorityOrdered;  /*< Set to pdTRUE if the queue was created as a priority queue, in which case its items are held in a binary heap. */
+    #endif
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+        UBaseType_t uxSetMembers; /*< For a queue set, the number of queues and semaphores that have been added to it. */
+        uint8_t ucQueueSetFlags;  /*< For a queue set, records whether the set holds a ready list.  For a member of such a set, records whether the member is already in the ready list. */
+    #endif
+
+    #if ( configUSE_MULTI_WAIT == 1 )
+        TaskHandle_t xMultiWaitTask; /*< The task, if any, that is waiting for the queue in uxMultiWaitForAny(). */
+    #endif
+
+    #if ( configGENERATE_QUEUE_STATS == 1 )
+        QueueStatistics_t xStatistics; /*< Usage statistics returned by vQueueGetStatistics(). */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
  * name below to enable the use of older kernel aware debuggers. */
 typedef xQUEUE Queue_t;
 
+/* Bits set in ucZeroCopyState while a slot of the queue storage area is owned
+ * by a task or interrupt.  Only one slot at each end of the queue can be owned
+ * at a time, so while a slot is reserved the queue appears full to other
+ * writers, and while a slot is acquired it appears empty to other readers.
+ *
+ * An item sent to the front of the queue is written into the slot in front of
+ * the item that will be received next, and the read position is only moved
+ * past an acquired item when it is released.  While an item is acquired the
+ * queue therefore also appears full to writers that send to the front. */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    #define queueSLOT_RESERVED                      ( ( uint8_t ) 0x01U )
+    #define queueSLOT_ACQUIRED                      ( ( uint8_t ) 0x02U )
+    #define queueIS_WRITE_SLOT_RESERVED( pxQueue )    ( ( ( pxQueue )->ucZeroCopyState & queueSLOT_RESERVED ) != 0U )
+    #define queueIS_READ_SLOT_ACQUIRED( pxQueue )     ( ( ( pxQueue )->ucZeroCopyState & queueSLOT_ACQUIRED ) != 0U )
+    #define queueIS_FULL_FOR_POSITION( pxQueue, xCopyPosition )                                            \
+    ( ( ( pxQueue )->uxMessagesWaiting == ( pxQueue )->uxLength ) ||                                          \
+      ( queueIS_WRITE_SLOT_RESERVED( pxQueue ) != pdFALSE ) ||                                                \
+      ( ( ( xCopyPosition ) == queueSEND_TO_FRONT ) && ( queueIS_READ_SLOT_ACQUIRED( pxQueue ) != pdFALSE ) ) )
+#else
+    #define queueIS_WRITE_SLOT_RESERVED( pxQueue )    ( pdFALSE )
+    #define queueIS_READ_SLOT_ACQUIRED( pxQueue )     ( pdFALSE )
+    #define queueIS_FULL_FOR_POSITION( pxQueue, xCopyPosition )    ( ( pxQueue )->uxMessagesWaiting == ( pxQueue )->uxLength )
+#endif
+
+/* The storage area of a priority queue holds a binary heap of items, with the
+ * item that will be received next at the start of the storage area, followed
+ * by an array of sequence numbers, one per heap position, starting at pcTail.
+ * The priority of an item is the UBaseType_t at the start of the item. */
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+    #define queueIS_PRIORITY_ORDERED( pxQueue )    ( ( pxQueue )->ucPriorityOrdered != ( uint8_t ) pdFALSE )
+#else
+    #define queueIS_PRIORITY_ORDERED( pxQueue )    ( pdFALSE )
+#endif
+
+/* Bits set in ucQueueSetFlags.  A queue set created by xQueueCreateReadySet()
+ * holds each member that is ready at most once, rather than once per item
+ * sent to the member.  queueSET_MEMBER_READY is set in a member when its handle
+ * is posted to such a set, and cleared when the handle is selected from it, so
+ * sending to a member that is already in the ready list does not touch the
+ * set at all. */
+#define queueSET_USES_READY_LIST    ( ( uint8_t ) 0x01U )
+#define queueSET_MEMBER_READY       ( ( uint8_t ) 0x02U )
+
+/* Tell the task, if any, that is waiting for the queue in uxMultiWaitForAny()
+ * that the queue has received an item.  Must be called from a critical section,
+ * which is also used to register and unregister the waiting task, after the
+ * item has been added to the queue.  The waiting task checks the queue itself
+ * once it runs, so the notification carries no value. */
+#if ( configUSE_MULTI_WAIT == 1 )
+    #define prvNotifyMultiWaitTask( pxQueue )                                                                                         \
+    {                                                                                                                                 \
+        if( ( pxQueue )->xMultiWaitTask != NULL )                                                                                     \
+        {                                                                                                                             \
+            ( void ) xTaskNotifyIndexed( ( pxQueue )->xMultiWaitTask, configMULTI_WAIT_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction ); \
+        }                                                                                                                             \
+    }
+    #define prvNotifyMultiWaitTaskFromISR( pxQueue, pxHigherPriorityTaskWoken )                                                                                               \
+    {                                                                                                                                                                         \
+        if( ( pxQueue )->xMultiWaitTask != NULL )                                                                                                                             \
+        {                                                                                                                                                                     \
+            ( void ) xTaskNotifyIndexedFromISR( ( pxQueue )->xMultiWaitTask, configMULTI_WAIT_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction, ( pxHigherPriorityTaskWoken ) ); \
+        }                                                                                                                                                                     \
+    }
+#else
+    #define prvNotifyMultiWaitTask( pxQueue )
+    #define prvNotifyMultiWaitTaskFromISR( pxQueue, pxHigherPriorityTaskWoken )
+#endif
+
+/* Update the usage statistics of a queue.  prvRecordItemsSent() and
+ * prvRecordItemsReceived() must be called from a critical section, after
+ * uxMessagesWaiting has been updated.  prvRecordBlockedSend() and
+ * prvRecordBlockedReceive() are called by the blocking API functions before
+ * they return, and only record anything if the calling task had to wait. */
+#if ( configGENERATE_QUEUE_STATS == 1 )
+    #define prvRecordItemsSent( pxQueue, uxItemCount )                                                 \
+    {                                                                                                  \
+        ( pxQueue )->xStatistics.ulSendCount += ( uint32_t ) ( uxItemCount );                          \
+                                                                                                       \
+        if( ( pxQueue )->uxMessagesWaiting > ( pxQueue )->xStatistics.uxPeakMessagesWaiting )          \
+        {                                                                                              \
+            ( pxQueue )->xStatistics.uxPeakMessagesWaiting = ( pxQueue )->uxMessagesWaiting;           \
+        }                                                                                              \
+    }
+    #define prvRecordItemsReceived( pxQueue, uxItemCount )                                             \
+    {                                                                                                  \
+        ( pxQueue )->xStatistics.ulReceiveCount += ( uint32_t ) ( uxItemCount );                       \
+    }
+    #define prvRecordBlockedSend( pxQueue, xEntryTimeSet, xTimeBlockingStarted )                       \
+    {                                                                                                  \
+        if( ( xEntryTimeSet ) != pdFALSE )                                                             \
+        {                                                                                              \
+            prvRecordBlockingTime( ( pxQueue ), ( xTimeBlockingStarted ), pdTRUE );                    \
+        }                                                                                              \
+    }
+    #define prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted )                    \
+    {                                                                                                  \
+        if( ( xEntryTimeSet ) != pdFALSE )                                                             \
+        {                                                                                              \
+            prvRecordBlockingTime( ( pxQueue ), ( xTimeBlockingStarted ), pdFALSE );                   \
+        }                                                                                              \
+    }
+#else
+    #define prvRecordItemsSent( pxQueue, uxItemCount )
+    #define prvRecordItemsReceived( pxQueue, uxItemCount )
+    #define prvRecordBlockedSend( pxQueue, xEntryTimeSet, xTimeBlockingStarted )
+    #define prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
- * The queue registry is just a means for kernel aware debuggers to locate
- * queue structures.  It has no other purpose so is an optional component.
+ * The queue registry is a means for kernel aware debuggers, and the
+ * application, to locate queue structures by name.  It is an optional
+ * component.
  */
 #if ( configQUEUE_REGISTRY_SIZE > 0 )
 
@@ -158,11 +289,25 @@ typedef xQUEUE Queue_t;
  * debuggers. */
     typedef xQueueRegistryItem QueueRegistryItem_t;
 
-/* The queue registry is simply an array of QueueRegistryItem_t structures.
- * The pcQueueName member of a structure being NULL is indicative of the
- * array position being vacant. */
+/* The queue registry is an array of QueueRegistryItem_t structures.  The
+ * pcQueueName member of a structure being NULL is indicative of the array
+ * position being vacant, so kernel aware debuggers can still find every
+ * registered queue by scanning the whole array.  The array is used as a hash
+ * table indexed by queue handle: a queue is stored at the position its handle
+ * hashes to, or at the next vacant position after it, wrapping around.
+ * Entries are moved back when an entry before them is removed so there is
+ * never a vacant position between an entry and the position it hashes to,
+ * which means a search can stop at the first vacant position. */
     PRIVILEGED_DATA QueueRegistryItem_t xQueueRegistry[ configQUEUE_REGISTRY_SIZE ];
 
+/* The same entries again, indexed by the hash of the queue name rather than
+ * the queue handle, so xQueueGetHandleFromName() does not need to scan the
+ * registry either. */
+    PRIVILEGED_DATA static QueueRegistryItem_t xQueueRegistryByName[ configQUEUE_REGISTRY_SIZE ];
+
+/* The number of queues in the registry. */
+    PRIVILEGED_DATA static UBaseType_t uxQueueRegistryCount = 0U;
+
 #endif /* configQUEUE_REGISTRY_SIZE */
 
 /*
@@ -183,11 +328,13 @@ static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
- * Uses a critical section to determine if there is any space in a queue.
+ * Uses a critical section to determine if there is any space in a queue for an
+ * item sent to xCopyPosition.
  *
  * @return pdTRUE if there is no space, otherwise pdFALSE;
  */
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvIsQueueFull( const Queue_t * pxQueue,
+                                  const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 
 /*
  * Copies an item into the queue, either at the front of the queue or the
@@ -203,13 +350,160 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies the item that would be received next out of a queue without
+ * removing it from the queue.
+ */
+static void prvPeekDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies uxItemCount items to the back of a queue, or out of the front of a
+ * queue, with at most two calls to memcpy() however the items wrap around the
+ * end of the queue storage area.  The caller must have checked that there is
+ * space for, or that the queue holds, that many items.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                 const int8_t * pcItemsToQueue,
+                                 const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                   int8_t * const pcBuffer,
+                                   const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock up to one task per item after uxItemCount items have been posted to,
+ * or removed from, a queue - or update the queue lock count instead if the
+ * queue is locked.  Must be called from within a critical section.
+ *
+ * @return pdTRUE if a task with a priority higher than the calling task was
+ * unblocked, otherwise pdFALSE.
+ */
+static BaseType_t prvNotifyItemsPosted( Queue_t * const pxQueue,
+                                        UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static BaseType_t prvNotifyItemsRemoved( Queue_t * const pxQueue,
+                                         UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+/*
+ * Return the position in the queue registry at which a search for xQueue, or
+ * for pcQueueName, starts.
+ */
+    static UBaseType_t prvRegistryHashHandle( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+    static UBaseType_t prvRegistryHashName( const char * pcQueueName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/*
+ * Return the position of xQueue in pxTable, which is either xQueueRegistry or
+ * xQueueRegistryByName, starting the search at uxPosition.  Returns
+ * configQUEUE_REGISTRY_SIZE if xQueue is not in the table.
+ */
+    static UBaseType_t prvRegistryFind( const QueueRegistryItem_t * const pxTable,
+                                        UBaseType_t uxPosition,
+                                        QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Store an entry in pxTable at the first vacant position at or after
+ * uxPosition.  There must be a vacant position.
+ */
+    static void prvRegistryInsert( QueueRegistryItem_t * const pxTable,
+                                   UBaseType_t uxPosition,
+                                   const char * pcQueueName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                   QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Vacate position uxPosition of pxTable, moving back the entries that follow
+ * it so none of them becomes unreachable.
+ */
+    static void prvRegistryRemove( QueueRegistryItem_t * const pxTable,
+                                   UBaseType_t uxPosition ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configGENERATE_QUEUE_STATS == 1 )
+
+/*
+ * Adds one to the count of blocked sends or receives of a queue, and the time
+ * since xTimeBlockingStarted to the total time they have spent blocked.
+ */
+    static void prvRecordBlockingTime( Queue_t * const pxQueue,
+                                       const TickType_t xTimeBlockingStarted,
+                                       const BaseType_t xWasSending ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
  * Checks to see if a queue is a member of a queue set, and if so, notifies
  * the queue set that the queue contains data.
  */
-    static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvNotifyQueueSetContainer( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes up to uxMaxMembers member handles from a queue set, writing them to
+ * pxMembers, and returns the number removed.  Must be called from a critical
+ * section.
+ */
+    static UBaseType_t prvTakeFromQueueSet( Queue_t * const pxQueueSet,
+                                            QueueSetMemberHandle_t * const pxMembers,
+                                            const UBaseType_t uxMaxMembers ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+/*
+ * Adds an item to the heap of a priority queue that holds uxItemCount items,
+ * or removes the item at the root of the heap and copies it into pvBuffer.
+ * Both move O(log n) items.  Must be called from a critical section, and do
+ * not update uxMessagesWaiting.
+ */
+    static void prvInsertHeapItem( Queue_t * const pxQueue,
+                                   const void * pvItemToQueue,
+                                   UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+    static void prvRemoveHeapRoot( Queue_t * const pxQueue,
+                                   void * const pvBuffer,
+                                   UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Helpers for the heap functions above.  prvGetHeapKey() reads the priority
+ * and sequence number of the item at heap position uxIndex.
+ * prvIsReceivedBefore() returns pdTRUE if an item with the given priority and
+ * sequence number must be received before the item at heap position uxIndex.
+ * prvMoveHeapItem() moves the item, and its sequence number, at heap position
+ * uxFrom to heap position uxTo.
+ */
+    static void prvGetHeapKey( const Queue_t * const pxQueue,
+                               UBaseType_t uxIndex,
+                               UBaseType_t * const puxPriority,
+                               UBaseType_t * const puxSequence ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvIsReceivedBefore( const Queue_t * const pxQueue,
+                                           UBaseType_t uxPriority,
+                                           UBaseType_t uxSequence,
+                                           UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+    static void prvMoveHeapItem( Queue_t * const pxQueue,
+                                 UBaseType_t uxFrom,
+                                 UBaseType_t uxTo ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/*
+ * Publish the slot reserved by pvQueueReserve() or pvQueueReserveFromISR() as
+ * the item at the back of the queue, and unblock the tasks that can now make
+ * progress.  Must be called from within a critical section.
+ *
+ * @return pdTRUE if a task with a priority higher than the calling task was
+ * unblocked, otherwise pdFALSE.
+ */
+    static BaseType_t prvCommitReservedSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the item acquired by pvQueueAcquire() or pvQueueAcquireFromISR() from
+ * the queue, and unblock the tasks that can now make progress.  Must be called
+ * from within a critical section.
+ *
+ * @return pdTRUE if a task with a priority higher than the calling task was
+ * unblocked, otherwise pdFALSE.
+ */
+    static BaseType_t prvReleaseAcquiredSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
 /*
@@ -315,6 +609,12 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                pxQueue->ucZeroCopyState = 0U;
+            }
+            #endif
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -432,17 +732,32 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
         Queue_t * pxNewQueue = NULL;
         size_t xQueueSizeInBytes;
         uint8_t * pucQueueStorage;
+        UBaseType_t uxSlotSize = uxItemSize;
+
+        #if ( configUSE_PRIORITY_QUEUES == 1 )
+        {
+            /* A priority queue also stores a sequence number for each item. */
+            if( ( ucQueueType == queueQUEUE_TYPE_PRIORITY ) && ( uxItemSize <= ( ( UBaseType_t ) SIZE_MAX - ( UBaseType_t ) sizeof( UBaseType_t ) ) ) )
+            {
+                uxSlotSize += ( UBaseType_t ) sizeof( UBaseType_t );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_PRIORITY_QUEUES */
 
         if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
             /* Check for multiplication overflow. */
-            ( ( SIZE_MAX / uxQueueLength ) >= uxItemSize ) &&
+            ( ( SIZE_MAX / uxQueueLength ) >= uxSlotSize ) &&
             /* Check for addition overflow. */
-            ( ( SIZE_MAX - sizeof( Queue_t ) ) >= ( uxQueueLength * uxItemSize ) ) )
+            ( ( SIZE_MAX - sizeof( Queue_t ) ) >= ( uxQueueLength * uxSlotSize ) ) )
         {
             /* Allocate enough space to hold the maximum number of items that
              * can be in the queue at any time.  It is valid for uxItemSize to be
              * zero in the case the queue is used as a semaphore. */
-            xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxSlotSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
             /* Allocate the queue and storage area.  Justification for MISRA
              * deviation as follows:  pvPortMalloc() always ensures returned memory
@@ -530,9 +845,40 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     #if ( configUSE_QUEUE_SETS == 1 )
     {
         pxNewQueue->pxQueueSetContainer = NULL;
+        pxNewQueue->uxSetMembers = ( UBaseType_t ) 0U;
+        pxNewQueue->ucQueueSetFlags = ( uint8_t ) 0U;
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_MULTI_WAIT == 1 )
+    {
+        pxNewQueue->xMultiWaitTask = NULL;
+    }
+    #endif /* configUSE_MULTI_WAIT */
+
+    #if ( configGENERATE_QUEUE_STATS == 1 )
+    {
+        ( void ) memset( ( void * ) &( pxNewQueue->xStatistics ), 0x00, sizeof( pxNewQueue->xStatistics ) );
+    }
+    #endif /* configGENERATE_QUEUE_STATS */
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+    {
+        if( ucQueueType == queueQUEUE_TYPE_PRIORITY )
+        {
+            /* The priority is read from the start of each item. */
+            configASSERT( uxItemSize >= ( UBaseType_t ) sizeof( UBaseType_t ) );
+            pxNewQueue->ucPriorityOrdered = ( uint8_t ) pdTRUE;
+        }
+        else
+        {
+            pxNewQueue->ucPriorityOrdered = ( uint8_t ) pdFALSE;
+        }
+
+        pxNewQueue->uxNextSequence = ( UBaseType_t ) configPRIORITY_QUEUE_INITIAL_SEQUENCE;
+    }
+    #endif /* configUSE_PRIORITY_QUEUES */
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -778,6 +1124,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             {
                 ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
 
+                #if ( configGENERATE_QUEUE_STATS == 1 )
+                {
+                    ( ( Queue_t * ) xHandle )->xStatistics.uxPeakMessagesWaiting = uxInitialCount;
+                }
+                #endif
+
                 traceCREATE_COUNTING_SEMAPHORE();
             }
             else
@@ -813,6 +1165,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             {
                 ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
 
+                #if ( configGENERATE_QUEUE_STATS == 1 )
+                {
+                    ( ( Queue_t * ) xHandle )->xStatistics.uxPeakMessagesWaiting = uxInitialCount;
+                }
+                #endif
+
                 traceCREATE_COUNTING_SEMAPHORE();
             }
             else
@@ -839,11 +1197,16 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
 {
     BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
     TimeOut_t xTimeOut;
+    #if ( configGENERATE_QUEUE_STATS == 1 )
+        TickType_t xTimeBlockingStarted = ( TickType_t ) 0;
+    #endif
     Queue_t * const pxQueue = xQueue;
 
     configASSERT( pxQueue );
     configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( queueIS_WRITE_SLOT_RESERVED( pxQueue ) != pdFALSE ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( queueIS_READ_SLOT_ACQUIRED( pxQueue ) != pdFALSE ) ) );
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
         configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
@@ -860,8 +1223,11 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             /* Is there room on the queue now?  The running task must be the
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
-             * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+             * queue is full.  A slot reserved for a zero copy write makes the
+             * queue appear full until the reserved item is committed, and an
+             * acquired item does the same for sends to the front of the queue
+             * until it is released. */
+            if( ( queueIS_FULL_FOR_POSITION( pxQueue, xCopyPosition ) == pdFALSE ) || ( xCopyPosition == queueOVERWRITE ) )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -961,7 +1327,10 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 }
                 #endif /* configUSE_QUEUE_SETS */
 
+                prvNotifyMultiWaitTask( pxQueue );
+
                 taskEXIT_CRITICAL();
+                prvRecordBlockedSend( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                 return pdPASS;
             }
             else
@@ -975,6 +1344,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                     /* Return to the original privilege level before exiting
                      * the function. */
                     traceQUEUE_SEND_FAILED( pxQueue );
+                    prvRecordBlockedSend( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                     return errQUEUE_FULL;
                 }
                 else if( xEntryTimeSet == pdFALSE )
@@ -983,6 +1353,12 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                      * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+
+                    #if ( configGENERATE_QUEUE_STATS == 1 )
+                    {
+                        xTimeBlockingStarted = xTimeOut.xTimeOnEntering;
+                    }
+                    #endif
                 }
                 else
                 {
@@ -1002,7 +1378,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue, xCopyPosition ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_SEND( pxQueue );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
@@ -1038,6 +1414,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             ( void ) xTaskResumeAll();
 
             traceQUEUE_SEND_FAILED( pxQueue );
+            prvRecordBlockedSend( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
             return errQUEUE_FULL;
         }
     } /*lint -restore */
@@ -1056,6 +1433,8 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
     configASSERT( pxQueue );
     configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( queueIS_WRITE_SLOT_RESERVED( pxQueue ) != pdFALSE ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( queueIS_READ_SLOT_ACQUIRED( pxQueue ) != pdFALSE ) ) );
 
     /* RTOS ports that support interrupt nesting have the concept of a maximum
      * system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -1078,9 +1457,9 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
      * read, instead return a flag to say whether a context switch is required or
      * not (i.e. has a task with a higher priority than us been woken by this
      * post). */
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( ( queueIS_FULL_FOR_POSITION( pxQueue, xCopyPosition ) == pdFALSE ) || ( xCopyPosition == queueOVERWRITE ) )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1195,6 +1574,8 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 prvIncrementQueueTxLock( pxQueue, cTxLock );
             }
 
+            prvNotifyMultiWaitTaskFromISR( pxQueue, pxHigherPriorityTaskWoken );
+
             xReturn = pdPASS;
         }
         else
@@ -1203,7 +1584,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
             xReturn = errQUEUE_FULL;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1249,7 +1630,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1269,6 +1650,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
              * priority disinheritance is needed.  Simply increase the count of
              * messages (semaphores) available. */
             pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+            prvRecordItemsSent( pxQueue, ( UBaseType_t ) 1 );
 
             /* The event list is not altered if the queue is locked.  This will
              * be done when the queue is unlocked later. */
@@ -1361,6 +1743,8 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                 prvIncrementQueueTxLock( pxQueue, cTxLock );
             }
 
+            prvNotifyMultiWaitTaskFromISR( pxQueue, pxHigherPriorityTaskWoken );
+
             xReturn = pdPASS;
         }
         else
@@ -1369,7 +1753,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
             xReturn = errQUEUE_FULL;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1381,6 +1765,9 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 {
     BaseType_t xEntryTimeSet = pdFALSE;
     TimeOut_t xTimeOut;
+    #if ( configGENERATE_QUEUE_STATS == 1 )
+        TickType_t xTimeBlockingStarted = ( TickType_t ) 0;
+    #endif
     Queue_t * const pxQueue = xQueue;
 
     /* Check the pointer is not NULL. */
@@ -1407,13 +1794,16 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
             /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+             * must be the highest priority task wanting to access the queue.
+             * While an item is acquired for a zero copy read the queue appears
+             * empty until the acquired item is released. */
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueIS_READ_SLOT_ACQUIRED( pxQueue ) == pdFALSE ) )
             {
                 /* Data available, remove one item. */
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
                 traceQUEUE_RECEIVE( pxQueue );
                 pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+                prvRecordItemsReceived( pxQueue, ( UBaseType_t ) 1 );
 
                 /* There is now space in the queue, were any tasks waiting to
                  * post to the queue?  If so, unblock the highest priority waiting
@@ -1435,6 +1825,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 }
 
                 taskEXIT_CRITICAL();
+                prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                 return pdPASS;
             }
             else
@@ -1445,6 +1836,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                      * the block time has expired) so leave now. */
                     taskEXIT_CRITICAL();
                     traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                     return errQUEUE_EMPTY;
                 }
                 else if( xEntryTimeSet == pdFALSE )
@@ -1453,6 +1845,12 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                      * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+
+                    #if ( configGENERATE_QUEUE_STATS == 1 )
+                    {
+                        xTimeBlockingStarted = xTimeOut.xTimeOnEntering;
+                    }
+                    #endif
                 }
                 else
                 {
@@ -1507,6 +1905,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceQUEUE_RECEIVE_FAILED( pxQueue );
+                prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                 return errQUEUE_EMPTY;
             }
             else
@@ -1523,6 +1922,9 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 {
     BaseType_t xEntryTimeSet = pdFALSE;
     TimeOut_t xTimeOut;
+    #if ( configGENERATE_QUEUE_STATS == 1 )
+        TickType_t xTimeBlockingStarted = ( TickType_t ) 0;
+    #endif
     Queue_t * const pxQueue = xQueue;
 
     #if ( configUSE_MUTEXES == 1 )
@@ -1563,6 +1965,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 /* Semaphores are queues with a data size of zero and where the
                  * messages waiting is the semaphore's count.  Reduce the count. */
                 pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+                prvRecordItemsReceived( pxQueue, ( UBaseType_t ) 1 );
 
                 #if ( configUSE_MUTEXES == 1 )
                 {
@@ -1598,6 +2001,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
 
                 taskEXIT_CRITICAL();
+                prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                 return pdPASS;
             }
             else
@@ -1608,6 +2012,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                      * (or the block time has expired) so exit now. */
                     taskEXIT_CRITICAL();
                     traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                     return errQUEUE_EMPTY;
                 }
                 else if( xEntryTimeSet == pdFALSE )
@@ -1616,6 +2021,12 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                      * so configure the timeout structure ready to block. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+
+                    #if ( configGENERATE_QUEUE_STATS == 1 )
+                    {
+                        xTimeBlockingStarted = xTimeOut.xTimeOnEntering;
+                    }
+                    #endif
                 }
                 else
                 {
@@ -1717,6 +2128,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 #endif /* configUSE_MUTEXES */
 
                 traceQUEUE_RECEIVE_FAILED( pxQueue );
+                prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                 return errQUEUE_EMPTY;
             }
             else
@@ -1734,7 +2146,9 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 {
     BaseType_t xEntryTimeSet = pdFALSE;
     TimeOut_t xTimeOut;
-    int8_t * pcOriginalReadPosition;
+    #if ( configGENERATE_QUEUE_STATS == 1 )
+        TickType_t xTimeBlockingStarted = ( TickType_t ) 0;
+    #endif
     Queue_t * const pxQueue = xQueue;
 
     /* Check the pointer is not NULL. */
@@ -1761,20 +2175,14 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
             const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
             /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+             * must be the highest priority task wanting to access the queue.
+             * While an item is acquired for a zero copy read the queue appears
+             * empty until the acquired item is released. */
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueIS_READ_SLOT_ACQUIRED( pxQueue ) == pdFALSE ) )
             {
-                /* Remember the read position so it can be reset after the data
-                 * is read from the queue as this function is only peeking the
-                 * data, not removing it. */
-                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                prvPeekDataFromQueue( pxQueue, pvBuffer );
                 traceQUEUE_PEEK( pxQueue );
 
-                /* The data is not being removed, so reset the read pointer. */
-                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
-
                 /* The data is being left in the queue, so see if there are
                  * any other tasks waiting for the data. */
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
@@ -1795,6 +2203,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                 }
 
                 taskEXIT_CRITICAL();
+                prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                 return pdPASS;
             }
             else
@@ -1805,6 +2214,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                      * the block time has expired) so leave now. */
                     taskEXIT_CRITICAL();
                     traceQUEUE_PEEK_FAILED( pxQueue );
+                    prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                     return errQUEUE_EMPTY;
                 }
                 else if( xEntryTimeSet == pdFALSE )
@@ -1814,6 +2224,12 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                      * state. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+
+                    #if ( configGENERATE_QUEUE_STATS == 1 )
+                    {
+                        xTimeBlockingStarted = xTimeOut.xTimeOnEntering;
+                    }
+                    #endif
                 }
                 else
                 {
@@ -1868,6 +2284,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceQUEUE_PEEK_FAILED( pxQueue );
+                prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
                 return errQUEUE_EMPTY;
             }
             else
@@ -1906,12 +2323,12 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
         /* Cannot block in an ISR, so check there is data available. */
-        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueIS_READ_SLOT_ACQUIRED( pxQueue ) == pdFALSE ) )
         {
             const int8_t cRxLock = pxQueue->cRxLock;
 
@@ -1919,6 +2336,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
 
             prvCopyDataFromQueue( pxQueue, pvBuffer );
             pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+            prvRecordItemsReceived( pxQueue, ( UBaseType_t ) 1 );
 
             /* If the queue is locked the event list will not be modified.
              * Instead update the lock count so the task that unlocks the queue
@@ -1966,7 +2384,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
             traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1977,7 +2395,6 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
 {
     BaseType_t xReturn;
     UBaseType_t uxSavedInterruptStatus;
-    int8_t * pcOriginalReadPosition;
     Queue_t * const pxQueue = xQueue;
 
     configASSERT( pxQueue );
@@ -2000,18 +2417,14 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         /* Cannot block in an ISR, so check there is data available. */
-        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueIS_READ_SLOT_ACQUIRED( pxQueue ) == pdFALSE ) )
         {
             traceQUEUE_PEEK_FROM_ISR( pxQueue );
 
-            /* Remember the read position so it can be reset as nothing is
-             * actually being removed from the queue. */
-            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+            prvPeekDataFromQueue( pxQueue, pvBuffer );
 
             xReturn = pdPASS;
         }
@@ -2021,329 +2434,353 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
             traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-
-    configASSERT( xQueue );
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
 
-    taskENTER_CRITICAL();
+    void * pvQueueReserve( QueueHandle_t xQueue,
+                           TickType_t xTicksToWait )
     {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
-
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        #if ( configGENERATE_QUEUE_STATS == 1 )
+            TickType_t xTimeBlockingStarted = ( TickType_t ) 0;
+        #endif
+        Queue_t * const pxQueue = xQueue;
+        void * pvSlot;
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+        configASSERT( pxQueue );
 
-    configASSERT( pxQueue );
+        /* Semaphores have no storage area to write into. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( queueIS_PRIORITY_ORDERED( pxQueue ) == pdFALSE );
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Is there a free slot that is not already reserved?  Nothing
+                 * is copied, the slot is only marked as owned by the caller, so
+                 * the item remains invisible to readers until it is committed. */
+                if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( queueIS_WRITE_SLOT_RESERVED( pxQueue ) == pdFALSE ) )
+                {
+                    traceQUEUE_RESERVE( pxQueue );
+                    pxQueue->ucZeroCopyState |= queueSLOT_RESERVED;
+                    pvSlot = ( void * ) pxQueue->pcWriteTo;
+                    taskEXIT_CRITICAL();
+                    prvRecordBlockedSend( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
+                    return pvSlot;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The queue was full and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_RESERVE_FAILED( pxQueue );
+                        prvRecordBlockedSend( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
+                        return NULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The queue was full and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+                        #if ( configGENERATE_QUEUE_STATS == 1 )
+                        {
+                            xTimeBlockingStarted = xTimeOut.xTimeOnEntering;
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+            /* Interrupts and other tasks can send to and receive from the queue
+             * now the critical section has been exited. */
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
 
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
-    {
-        vQueueUnregisterQueue( pxQueue );
+                traceQUEUE_RESERVE_FAILED( pxQueue );
+                prvRecordBlockedSend( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
+                return NULL;
+            }
+        } /*lint -restore */
     }
-    #endif
+/*-----------------------------------------------------------*/
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    void * pvQueueReserveFromISR( QueueHandle_t xQueue )
     {
-        /* The queue can only have been allocated dynamically - free it
-         * again. */
-        vPortFree( pxQueue );
-    }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-    {
-        /* The queue could have been allocated statically or dynamically, so
-         * check before attempting to free the memory. */
-        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
-        {
-            vPortFree( pxQueue );
-        }
-        else
+        void * pvSlot;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( queueIS_PRIORITY_ORDERED( pxQueue ) == pdFALSE );
+
+        /* See the comment in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
-            mtCOVERAGE_TEST_MARKER();
+            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( queueIS_WRITE_SLOT_RESERVED( pxQueue ) == pdFALSE ) )
+            {
+                traceQUEUE_RESERVE( pxQueue );
+                pxQueue->ucZeroCopyState |= queueSLOT_RESERVED;
+                pvSlot = ( void * ) pxQueue->pcWriteTo;
+            }
+            else
+            {
+                traceQUEUE_RESERVE_FAILED( pxQueue );
+                pvSlot = NULL;
+            }
         }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return pvSlot;
     }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
-    {
-        /* The queue must have been statically allocated, so is not going to be
-         * deleted.  Avoid compiler warnings about the unused parameter. */
-        ( void ) pxQueue;
-    }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-}
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
-    {
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-    }
-
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
-    {
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
-    }
-
-#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    BaseType_t xQueueCommit( QueueHandle_t xQueue )
     {
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
-    }
-
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_MUTEXES == 1 )
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
 
-    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
-    {
-        UBaseType_t uxHighestPriorityOfWaitingTasks;
+        configASSERT( pxQueue );
 
-        /* If a task waiting for a mutex causes the mutex holder to inherit a
-         * priority, but the waiting task times out, then the holder should
-         * disinherit the priority - but only down to the highest priority of any
-         * other tasks that are waiting for the same mutex.  For this purpose,
-         * return the priority of the highest priority task that is waiting for the
-         * mutex. */
-        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
-        {
-            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
-        }
-        else
+        taskENTER_CRITICAL();
         {
-            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
-        }
-
-        return uxHighestPriorityOfWaitingTasks;
-    }
-
-#endif /* configUSE_MUTEXES */
-/*-----------------------------------------------------------*/
-
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
-                                      const void * pvItemToQueue,
-                                      const BaseType_t xPosition )
-{
-    BaseType_t xReturn = pdFALSE;
-    UBaseType_t uxMessagesWaiting;
-
-    /* This function is called from a critical section. */
+            if( queueIS_WRITE_SLOT_RESERVED( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_COMMIT( pxQueue );
 
-    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+                if( prvCommitReservedSlot( pxQueue ) != pdFALSE )
+                {
+                    /* The unblocked task has a priority higher than our own so
+                     * yield immediately.  Yes it is ok to do this from within
+                     * the critical section - the kernel takes care of that. */
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
-    {
-        #if ( configUSE_MUTEXES == 1 )
-        {
-            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
-            {
-                /* The mutex is no longer being held. */
-                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
-                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+                prvNotifyMultiWaitTask( pxQueue );
+                xReturn = pdPASS;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                xReturn = pdFAIL;
             }
         }
-        #endif /* configUSE_MUTEXES */
-    }
-    else if( xPosition == queueSEND_TO_BACK )
-    {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
-        pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+        taskEXIT_CRITICAL();
 
-        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
-        {
-            pxQueue->pcWriteTo = pxQueue->pcHead;
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        return xReturn;
     }
-    else
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
-        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
 
-        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
-        {
-            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        configASSERT( pxQueue );
 
-        if( xPosition == queueOVERWRITE )
+        /* See the comment in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            if( queueIS_WRITE_SLOT_RESERVED( pxQueue ) != pdFALSE )
             {
-                /* An item is not being added but overwritten, so subtract
-                 * one from the recorded number of items in the queue so when
-                 * one is added again below the number of recorded items remains
-                 * correct. */
-                --uxMessagesWaiting;
+                traceQUEUE_COMMIT( pxQueue );
+
+                if( prvCommitReservedSlot( pxQueue ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvNotifyMultiWaitTaskFromISR( pxQueue, pxHigherPriorityTaskWoken );
+                xReturn = pdPASS;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                xReturn = pdFAIL;
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-
-    pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
-    return xReturn;
-}
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue,
-                                  void * const pvBuffer )
-{
-    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+    const void * pvQueueAcquire( QueueHandle_t xQueue,
+                                 TickType_t xTicksToWait )
     {
-        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
-
-        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
-        {
-            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        #if ( configGENERATE_QUEUE_STATS == 1 )
+            TickType_t xTimeBlockingStarted = ( TickType_t ) 0;
+        #endif
+        Queue_t * const pxQueue = xQueue;
+        int8_t * pcSlot;
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
-    }
-}
-/*-----------------------------------------------------------*/
+        configASSERT( pxQueue );
 
-static void prvUnlockQueue( Queue_t * const pxQueue )
-{
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+        /* Semaphores have no storage area to read from. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( queueIS_PRIORITY_ORDERED( pxQueue ) == pdFALSE );
 
-    /* The lock counts contains the number of extra data items placed or
-     * removed from the queue while the queue was locked.  When a queue is
-     * locked items can be added or removed, but the event lists cannot be
-     * updated. */
-    taskENTER_CRITICAL();
-    {
-        int8_t cTxLock = pxQueue->cTxLock;
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
 
-        /* See if data was added to the queue while it was locked. */
-        while( cTxLock > queueLOCKED_UNMODIFIED )
+        /*lint -save -e904  This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
         {
-            /* Data was posted while the queue was locked.  Are any tasks
-             * blocked waiting for data to become available? */
-            #if ( configUSE_QUEUE_SETS == 1 )
+            taskENTER_CRITICAL();
             {
-                if( pxQueue->pxQueueSetContainer != NULL )
+                /* Is there an item that is not already acquired?  The item
+                 * stays in the queue, and keeps its slot, until it is released. */
+                if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueIS_READ_SLOT_ACQUIRED( pxQueue ) == pdFALSE ) )
                 {
-                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    traceQUEUE_ACQUIRE( pxQueue );
+                    pxQueue->ucZeroCopyState |= queueSLOT_ACQUIRED;
+
+                    pcSlot = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                    if( pcSlot >= pxQueue->u.xQueue.pcTail )
                     {
-                        /* The queue is a member of a queue set, and posting to
-                         * the queue set caused a higher priority task to unblock.
-                         * A context switch is required. */
-                        vTaskMissedYield();
+                        pcSlot = pxQueue->pcHead;
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+
+                    taskEXIT_CRITICAL();
+                    prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
+                    return ( const void * ) pcSlot;
                 }
                 else
                 {
-                    /* Tasks that are removed from the event list will get
-                     * added to the pending ready list as the scheduler is still
-                     * suspended. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( xTicksToWait == ( TickType_t ) 0 )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                        {
-                            /* The task waiting has a higher priority so record that a
-                             * context switch is required. */
-                            vTaskMissedYield();
-                        }
-                        else
+                        /* The queue was empty and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_ACQUIRE_FAILED( pxQueue );
+                        prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
+                        return NULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The queue was empty and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+
+                        #if ( configGENERATE_QUEUE_STATS == 1 )
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            xTimeBlockingStarted = xTimeOut.xTimeOnEntering;
                         }
+                        #endif
                     }
                     else
                     {
-                        break;
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
             }
-            #else /* configUSE_QUEUE_SETS */
+            taskEXIT_CRITICAL();
+
+            /* Interrupts and other tasks can send to and receive from the queue
+             * now the critical section has been exited. */
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
             {
-                /* Tasks that are removed from the event list will get added to
-                 * the pending ready list as the scheduler is still suspended. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
                     {
-                        /* The task waiting has a higher priority so record that
-                         * a context switch is required. */
-                        vTaskMissedYield();
+                        portYIELD_WITHIN_API();
                     }
                     else
                     {
@@ -2352,187 +2789,135 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                 }
                 else
                 {
-                    break;
+                    /* The queue contains data again.  Loop back to try and
+                     * acquire it. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
                 }
             }
-            #endif /* configUSE_QUEUE_SETS */
-
-            --cTxLock;
-        }
+            else
+            {
+                /* Timed out.  If there is no data in the queue exit, otherwise
+                 * loop back and attempt to acquire the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
 
-        pxQueue->cTxLock = queueUNLOCKED;
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_ACQUIRE_FAILED( pxQueue );
+                    prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
+                    return NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
     }
-    taskEXIT_CRITICAL();
+/*-----------------------------------------------------------*/
 
-    /* Do the same for the Rx lock. */
-    taskENTER_CRITICAL();
+    const void * pvQueueAcquireFromISR( QueueHandle_t xQueue )
     {
-        int8_t cRxLock = pxQueue->cRxLock;
+        int8_t * pcSlot;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
 
-        while( cRxLock > queueLOCKED_UNMODIFIED )
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( queueIS_PRIORITY_ORDERED( pxQueue ) == pdFALSE );
+
+        /* See the comment in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
-            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueIS_READ_SLOT_ACQUIRED( pxQueue ) == pdFALSE ) )
             {
-                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                traceQUEUE_ACQUIRE( pxQueue );
+                pxQueue->ucZeroCopyState |= queueSLOT_ACQUIRED;
+
+                pcSlot = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                if( pcSlot >= pxQueue->u.xQueue.pcTail )
                 {
-                    vTaskMissedYield();
+                    pcSlot = pxQueue->pcHead;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-
-                --cRxLock;
             }
             else
             {
-                break;
+                traceQUEUE_ACQUIRE_FAILED( pxQueue );
+                pcSlot = NULL;
             }
         }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
-        pxQueue->cRxLock = queueUNLOCKED;
-    }
-    taskEXIT_CRITICAL();
-}
-/*-----------------------------------------------------------*/
-
-static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
-{
-    BaseType_t xReturn;
-
-    taskENTER_CRITICAL();
-    {
-        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
-        {
-            xReturn = pdTRUE;
-        }
-        else
-        {
-            xReturn = pdFALSE;
-        }
+        return ( const void * ) pcSlot;
     }
-    taskEXIT_CRITICAL();
-
-    return xReturn;
-}
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
-{
-    BaseType_t xReturn;
-    Queue_t * const pxQueue = xQueue;
-
-    configASSERT( pxQueue );
-
-    if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
-    {
-        xReturn = pdTRUE;
-    }
-    else
+    BaseType_t xQueueRelease( QueueHandle_t xQueue )
     {
-        xReturn = pdFALSE;
-    }
-
-    return xReturn;
-} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
-/*-----------------------------------------------------------*/
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
 
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
-{
-    BaseType_t xReturn;
+        configASSERT( pxQueue );
 
-    taskENTER_CRITICAL();
-    {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
-        {
-            xReturn = pdTRUE;
-        }
-        else
+        taskENTER_CRITICAL();
         {
-            xReturn = pdFALSE;
-        }
-    }
-    taskEXIT_CRITICAL();
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+            if( queueIS_READ_SLOT_ACQUIRED( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RELEASE( pxQueue );
 
-BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
-{
-    BaseType_t xReturn;
-    Queue_t * const pxQueue = xQueue;
+                if( prvReleaseAcquiredSlot( pxQueue ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    configASSERT( pxQueue );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
 
-    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
-    {
-        xReturn = pdTRUE;
-    }
-    else
-    {
-        xReturn = pdFALSE;
+        return xReturn;
     }
-
-    return xReturn;
-} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
-
-    BaseType_t xQueueCRSend( QueueHandle_t xQueue,
-                             const void * pvItemToQueue,
-                             TickType_t xTicksToWait )
+    BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue,
+                                     BaseType_t * const pxHigherPriorityTaskWoken )
     {
         BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
         Queue_t * const pxQueue = xQueue;
 
-        /* If the queue is already full we may have to block.  A critical section
-         * is required to prevent an interrupt removing something from the queue
-         * between the check to see if the queue is full and blocking on the queue. */
-        portDISABLE_INTERRUPTS();
-        {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
-            {
-                /* The queue is full - do we want to block or just leave without
-                 * posting? */
-                if( xTicksToWait > ( TickType_t ) 0 )
-                {
-                    /* As this is called from a coroutine we cannot block directly, but
-                     * return indicating that we need to block. */
-                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToSend ) );
-                    portENABLE_INTERRUPTS();
-                    return errQUEUE_BLOCKED;
-                }
-                else
-                {
-                    portENABLE_INTERRUPTS();
-                    return errQUEUE_FULL;
-                }
-            }
-        }
-        portENABLE_INTERRUPTS();
+        configASSERT( pxQueue );
 
-        portDISABLE_INTERRUPTS();
+        /* See the comment in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
-            if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+            if( queueIS_READ_SLOT_ACQUIRED( pxQueue ) != pdFALSE )
             {
-                /* There is room in the queue, copy the data into the queue. */
-                prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
-                xReturn = pdPASS;
+                traceQUEUE_RELEASE( pxQueue );
 
-                /* Were any co-routines waiting for data to become available? */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( prvReleaseAcquiredSlot( pxQueue ) != pdFALSE )
                 {
-                    /* In this instance the co-routine could be placed directly
-                     * into the ready list as we are within a critical section.
-                     * Instead the same pending ready list mechanism is used as if
-                     * the event were caused from within an interrupt. */
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( pxHigherPriorityTaskWoken != NULL )
                     {
-                        /* The co-routine waiting has a higher priority so record
-                         * that a yield might be appropriate. */
-                        xReturn = errQUEUE_YIELD;
+                        *pxHigherPriorityTaskWoken = pdTRUE;
                     }
                     else
                     {
@@ -2543,522 +2928,2541 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                xReturn = pdPASS;
             }
             else
             {
-                xReturn = errQUEUE_FULL;
+                xReturn = pdFAIL;
             }
         }
-        portENABLE_INTERRUPTS();
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_QUEUE_ZERO_COPY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * const pvItemsToQueue,
+                                 const UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    #if ( configGENERATE_QUEUE_STATS == 1 )
+        TickType_t xTimeBlockingStarted = ( TickType_t ) 0;
+    #endif
+    UBaseType_t uxItemsSent = 0, uxItemsToSend;
+    Queue_t * const pxQueue = xQueue;
 
-    BaseType_t xQueueCRReceive( QueueHandle_t xQueue,
-                                void * pvBuffer,
-                                TickType_t xTicksToWait )
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemsToQueue == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+
+    /* Semaphores are given one at a time. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    configASSERT( queueIS_PRIORITY_ORDERED( pxQueue ) == pdFALSE );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
-        BaseType_t xReturn;
-        Queue_t * const pxQueue = xQueue;
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
 
-        /* If the queue is already empty we may have to block.  A critical section
-         * is required to prevent an interrupt adding something to the queue
-         * between the check to see if the queue is empty and blocking on the queue. */
-        portDISABLE_INTERRUPTS();
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
         {
-            if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+            /* Post as many of the remaining items as there is space for. */
+            if( queueIS_WRITE_SLOT_RESERVED( pxQueue ) == pdFALSE )
             {
-                /* There are no messages in the queue, do we want to block or just
-                 * leave with nothing? */
-                if( xTicksToWait > ( TickType_t ) 0 )
-                {
-                    /* As this is a co-routine we cannot block directly, but return
-                     * indicating that we need to block. */
-                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToReceive ) );
-                    portENABLE_INTERRUPTS();
-                    return errQUEUE_BLOCKED;
-                }
-                else
+                uxItemsToSend = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+                if( uxItemsToSend > ( uxItemCount - uxItemsSent ) )
                 {
-                    portENABLE_INTERRUPTS();
-                    return errQUEUE_FULL;
+                    uxItemsToSend = uxItemCount - uxItemsSent;
                 }
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                uxItemsToSend = 0;
             }
-        }
-        portENABLE_INTERRUPTS();
 
-        portDISABLE_INTERRUPTS();
-        {
-            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            if( uxItemsToSend > ( UBaseType_t ) 0 )
             {
-                /* Data is available from the queue. */
-                pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+                traceQUEUE_SEND_MULTIPLE( pxQueue, uxItemsToSend );
 
-                if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+                prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItemsToQueue + ( uxItemsSent * pxQueue->uxItemSize ), uxItemsToSend ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+                uxItemsSent += uxItemsToSend;
+
+                /* Unblock one waiting receiver per item posted, all from within
+                 * the same critical section. */
+                if( prvNotifyItemsPosted( pxQueue, uxItemsToSend ) != pdFALSE )
                 {
-                    pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+                    queueYIELD_IF_USING_PREEMPTION();
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
 
-                --( pxQueue->uxMessagesWaiting );
-                ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+                prvNotifyMultiWaitTask( pxQueue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-                xReturn = pdPASS;
+            if( uxItemsSent == uxItemCount )
+            {
+                taskEXIT_CRITICAL();
+                prvRecordBlockedSend( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
+                return uxItemsSent;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                /* The queue was full and no block time is specified (or the
+                 * block time has expired) so leave now, having posted only some
+                 * of the items. */
+                taskEXIT_CRITICAL();
+                traceQUEUE_SEND_FAILED( pxQueue );
+                prvRecordBlockedSend( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
+                return uxItemsSent;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                /* The queue was full and a block time was specified so
+                 * configure the timeout structure. */
+                vTaskInternalSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
 
-                /* Were any co-routines waiting for space to become available? */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
-                {
-                    /* In this instance the co-routine could be placed directly
-                     * into the ready list as we are within a critical section.
-                     * Instead the same pending ready list mechanism is used as if
-                     * the event were caused from within an interrupt. */
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        xReturn = errQUEUE_YIELD;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
+                #if ( configGENERATE_QUEUE_STATS == 1 )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    xTimeBlockingStarted = xTimeOut.xTimeOnEntering;
                 }
+                #endif
             }
             else
             {
-                xReturn = pdFAIL;
+                /* Entry time was already set. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet.  The block
+         * time covers the whole transfer, not each item. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired.  Loop back once more with no block
+             * time to post any items there is now space for. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+            xTicksToWait = ( TickType_t ) 0;
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                        const void * const pvItemsToQueue,
+                                        const UBaseType_t uxItemCount,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxItemsSent;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemsToQueue == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    configASSERT( queueIS_PRIORITY_ORDERED( pxQueue ) == pdFALSE );
+
+    /* See the comment in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        if( queueIS_WRITE_SLOT_RESERVED( pxQueue ) == pdFALSE )
+        {
+            uxItemsSent = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+            if( uxItemsSent > uxItemCount )
+            {
+                uxItemsSent = uxItemCount;
+            }
+        }
+        else
+        {
+            uxItemsSent = 0;
+        }
+
+        if( uxItemsSent > ( UBaseType_t ) 0 )
+        {
+            traceQUEUE_SEND_MULTIPLE( pxQueue, uxItemsSent );
+
+            prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItemsToQueue, uxItemsSent );
+
+            /* prvNotifyItemsPosted() does not alter the event lists if the
+             * queue is locked, but records the items in the lock count
+             * instead. */
+            if( prvNotifyItemsPosted( pxQueue, uxItemsSent ) != pdFALSE )
+            {
+                if( pxHigherPriorityTaskWoken != NULL )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvNotifyMultiWaitTaskFromISR( pxQueue, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxItemsSent;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * const pvBuffer,
+                                    const UBaseType_t uxItemCount,
+                                    TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    #if ( configGENERATE_QUEUE_STATS == 1 )
+        TickType_t xTimeBlockingStarted = ( TickType_t ) 0;
+    #endif
+    UBaseType_t uxItemsReceived = 0, uxItemsToReceive;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+
+    /* Semaphores are taken one at a time. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    configASSERT( queueIS_PRIORITY_ORDERED( pxQueue ) == pdFALSE );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            /* Remove as many of the outstanding items as the queue holds. */
+            if( queueIS_READ_SLOT_ACQUIRED( pxQueue ) == pdFALSE )
+            {
+                uxItemsToReceive = pxQueue->uxMessagesWaiting;
+
+                if( uxItemsToReceive > ( uxItemCount - uxItemsReceived ) )
+                {
+                    uxItemsToReceive = uxItemCount - uxItemsReceived;
+                }
+            }
+            else
+            {
+                uxItemsToReceive = 0;
+            }
+
+            if( uxItemsToReceive > ( UBaseType_t ) 0 )
+            {
+                prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer + ( uxItemsReceived * pxQueue->uxItemSize ), uxItemsToReceive ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+                traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxItemsToReceive );
+                uxItemsReceived += uxItemsToReceive;
+
+                /* There is now space in the queue, so unblock one waiting
+                 * sender per item removed. */
+                if( prvNotifyItemsRemoved( pxQueue, uxItemsToReceive ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( uxItemsReceived == uxItemCount )
+            {
+                taskEXIT_CRITICAL();
+                prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
+                return uxItemsReceived;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                /* The queue was empty and no block time is specified (or the
+                 * block time has expired) so leave now, having received only
+                 * some of the items. */
+                taskEXIT_CRITICAL();
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                prvRecordBlockedReceive( pxQueue, xEntryTimeSet, xTimeBlockingStarted );
+                return uxItemsReceived;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                /* The queue was empty and a block time was specified so
+                 * configure the timeout structure. */
+                vTaskInternalSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+
+                #if ( configGENERATE_QUEUE_STATS == 1 )
+                {
+                    xTimeBlockingStarted = xTimeOut.xTimeOnEntering;
+                }
+                #endif
+            }
+            else
+            {
+                /* Entry time was already set. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet.  The block
+         * time covers the whole transfer, not each item. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The queue contains data again.  Loop back to try and read the
+                 * data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out.  Loop back once more with no block time to receive
+             * any items that have arrived since. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+            xTicksToWait = ( TickType_t ) 0;
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                           void * const pvBuffer,
+                                           const UBaseType_t uxItemCount,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxItemsReceived;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    configASSERT( queueIS_PRIORITY_ORDERED( pxQueue ) == pdFALSE );
+
+    /* See the comment in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        if( queueIS_READ_SLOT_ACQUIRED( pxQueue ) == pdFALSE )
+        {
+            uxItemsReceived = pxQueue->uxMessagesWaiting;
+
+            if( uxItemsReceived > uxItemCount )
+            {
+                uxItemsReceived = uxItemCount;
+            }
+        }
+        else
+        {
+            uxItemsReceived = 0;
+        }
+
+        if( uxItemsReceived > ( UBaseType_t ) 0 )
+        {
+            prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxItemsReceived );
+            traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxItemsReceived );
+
+            /* prvNotifyItemsRemoved() does not alter the event lists if the
+             * queue is locked, but records the items in the lock count
+             * instead. */
+            if( prvNotifyItemsRemoved( pxQueue, uxItemsReceived ) != pdFALSE )
+            {
+                if( pxHigherPriorityTaskWoken != NULL )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxItemsReceived;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    configASSERT( xQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    {
+        vQueueUnregisterQueue( pxQueue );
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The queue can only have been allocated dynamically - free it
+         * again. */
+        vPortFree( pxQueue );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        /* The queue could have been allocated statically or dynamically, so
+         * check before attempting to free the memory. */
+        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFree( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+    {
+        /* The queue must have been statically allocated, so is not going to be
+         * deleted.  Avoid compiler warnings about the unused parameter. */
+        ( void ) pxQueue;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* If a task waiting for a mutex causes the mutex holder to inherit a
+         * priority, but the waiting task times out, then the holder should
+         * disinherit the priority - but only down to the highest priority of any
+         * other tasks that are waiting for the same mutex.  For this purpose,
+         * return the priority of the highest priority task that is waiting for the
+         * mutex. */
+        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+        }
+        else
+        {
+            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        }
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
+                                      const void * pvItemToQueue,
+                                      const BaseType_t xPosition )
+{
+    BaseType_t xReturn = pdFALSE;
+    UBaseType_t uxMessagesWaiting;
+
+    /* This function is called from a critical section. */
+
+    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+    {
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+            {
+                /* The mutex is no longer being held. */
+                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MUTEXES */
+    }
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        else if( queueIS_PRIORITY_ORDERED( pxQueue ) )
+        {
+            /* The position of an item in a priority queue is set by its
+             * priority, not xPosition, other than an overwrite replacing the
+             * only item in the queue. */
+            if( ( xPosition == queueOVERWRITE ) && ( uxMessagesWaiting > ( UBaseType_t ) 0 ) )
+            {
+                --uxMessagesWaiting;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvInsertHeapItem( pxQueue, pvItemToQueue, uxMessagesWaiting );
+        }
+    #endif /* configUSE_PRIORITY_QUEUES */
+    else if( xPosition == queueSEND_TO_BACK ) /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
+
+        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xPosition == queueOVERWRITE )
+        {
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                /* An item is not being added but overwritten, so subtract
+                 * one from the recorded number of items in the queue so when
+                 * one is added again below the number of recorded items remains
+                 * correct. */
+                --uxMessagesWaiting;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+    prvRecordItemsSent( pxQueue, ( UBaseType_t ) 1 );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
+{
+    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        else if( queueIS_PRIORITY_ORDERED( pxQueue ) )
+        {
+            prvRemoveHeapRoot( pxQueue, pvBuffer, pxQueue->uxMessagesWaiting );
+        }
+    #endif /* configUSE_PRIORITY_QUEUES */
+    else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
+    {
+        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        {
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeekDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
+{
+    int8_t * pcOriginalReadPosition;
+
+    if( queueIS_PRIORITY_ORDERED( pxQueue ) )
+    {
+        /* The item that would be received next is at the root of the heap. */
+        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->pcHead, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+    }
+    else
+    {
+        /* Remember the read position so it can be reset after the data is
+         * read from the queue as this function is only peeking the data, not
+         * removing it. */
+        pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+        prvCopyDataFromQueue( pxQueue, pvBuffer );
+        pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+    static void prvGetHeapKey( const Queue_t * const pxQueue,
+                               UBaseType_t uxIndex,
+                               UBaseType_t * const puxPriority,
+                               UBaseType_t * const puxSequence )
+    {
+        /* memcpy() is used as neither the item nor the sequence number array
+         * is guaranteed to be aligned. */
+        ( void ) memcpy( ( void * ) puxPriority, ( const void * ) ( pxQueue->pcHead + ( uxIndex * pxQueue->uxItemSize ) ), sizeof( UBaseType_t ) );               /*lint !e9016 !e9087 Pointer arithmetic on char types ok. */
+        ( void ) memcpy( ( void * ) puxSequence, ( const void * ) ( pxQueue->u.xQueue.pcTail + ( uxIndex * sizeof( UBaseType_t ) ) ), sizeof( UBaseType_t ) ); /*lint !e9016 !e9087 Pointer arithmetic on char types ok. */
+    }
+
+#endif /* configUSE_PRIORITY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+    static BaseType_t prvIsReceivedBefore( const Queue_t * const pxQueue,
+                                           UBaseType_t uxPriority,
+                                           UBaseType_t uxSequence,
+                                           UBaseType_t uxIndex )
+    {
+        UBaseType_t uxOtherPriority, uxOtherSequence;
+        BaseType_t xReturn;
+
+        prvGetHeapKey( pxQueue, uxIndex, &uxOtherPriority, &uxOtherSequence );
+
+        if( uxPriority != uxOtherPriority )
+        {
+            xReturn = ( uxPriority > uxOtherPriority ) ? pdTRUE : pdFALSE;
+        }
+        else
+        {
+            /* Items of equal priority are received in the order they were
+             * sent.  Comparing the difference of the sequence numbers, rather
+             * than the sequence numbers themselves, remains correct when the
+             * sequence count wraps as there can never be more than
+             * uxLength items in the queue. */
+            xReturn = ( ( BaseType_t ) ( uxSequence - uxOtherSequence ) < ( BaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_PRIORITY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+    static void prvMoveHeapItem( Queue_t * const pxQueue,
+                                 UBaseType_t uxFrom,
+                                 UBaseType_t uxTo )
+    {
+        ( void ) memcpy( ( void * ) ( pxQueue->pcHead + ( uxTo * pxQueue->uxItemSize ) ), ( void * ) ( pxQueue->pcHead + ( uxFrom * pxQueue->uxItemSize ) ), ( size_t ) pxQueue->uxItemSize );                                 /*lint !e9016 !e9087 Pointer arithmetic on char types ok. */
+        ( void ) memcpy( ( void * ) ( pxQueue->u.xQueue.pcTail + ( uxTo * sizeof( UBaseType_t ) ) ), ( void * ) ( pxQueue->u.xQueue.pcTail + ( uxFrom * sizeof( UBaseType_t ) ) ), sizeof( UBaseType_t ) ); /*lint !e9016 !e9087 Pointer arithmetic on char types ok. */
+    }
+
+#endif /* configUSE_PRIORITY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+    static void prvInsertHeapItem( Queue_t * const pxQueue,
+                                   const void * pvItemToQueue,
+                                   UBaseType_t uxItemCount )
+    {
+        UBaseType_t uxPriority, uxSequence, uxHole = uxItemCount, uxParent;
+        BaseType_t xHoleFound = pdFALSE;
+
+        ( void ) memcpy( ( void * ) &uxPriority, pvItemToQueue, sizeof( UBaseType_t ) ); /*lint !e9087 Item may not be aligned. */
+        uxSequence = pxQueue->uxNextSequence;
+        pxQueue->uxNextSequence++;
+
+        /* Sift up - move parents that must be received after the new item
+         * down into the hole until the position of the new item is found. */
+        while( ( uxHole > ( UBaseType_t ) 0 ) && ( xHoleFound == pdFALSE ) )
+        {
+            uxParent = ( uxHole - ( UBaseType_t ) 1 ) / ( UBaseType_t ) 2;
+
+            if( prvIsReceivedBefore( pxQueue, uxPriority, uxSequence, uxParent ) != pdFALSE )
+            {
+                prvMoveHeapItem( pxQueue, uxParent, uxHole );
+                uxHole = uxParent;
+            }
+            else
+            {
+                xHoleFound = pdTRUE;
+            }
+        }
+
+        ( void ) memcpy( ( void * ) ( pxQueue->pcHead + ( uxHole * pxQueue->uxItemSize ) ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize );                                /*lint !e9016 !e9087 !e418 Pointer arithmetic on char types ok. */
+        ( void ) memcpy( ( void * ) ( pxQueue->u.xQueue.pcTail + ( uxHole * sizeof( UBaseType_t ) ) ), ( const void * ) &uxSequence, sizeof( UBaseType_t ) ); /*lint !e9016 !e9087 Pointer arithmetic on char types ok. */
+    }
+
+#endif /* configUSE_PRIORITY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+    static void prvRemoveHeapRoot( Queue_t * const pxQueue,
+                                   void * const pvBuffer,
+                                   UBaseType_t uxItemCount )
+    {
+        UBaseType_t uxLast, uxPriority, uxSequence, uxHole = ( UBaseType_t ) 0, uxChild;
+        UBaseType_t uxChildPriority, uxChildSequence;
+        BaseType_t xHoleFound = pdFALSE;
+
+        configASSERT( uxItemCount > ( UBaseType_t ) 0 );
+
+        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->pcHead, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        /* The last item in the heap is conceptually moved into the hole left
+         * at the root, then sifted down.  Children that must be received
+         * before it are moved up into the hole until its position is found. */
+        uxLast = uxItemCount - ( UBaseType_t ) 1;
+        prvGetHeapKey( pxQueue, uxLast, &uxPriority, &uxSequence );
+
+        while( xHoleFound == pdFALSE )
+        {
+            uxChild = ( uxHole * ( UBaseType_t ) 2 ) + ( UBaseType_t ) 1;
+
+            if( uxChild >= uxLast )
+            {
+                xHoleFound = pdTRUE;
+            }
+            else
+            {
+                /* Select the child that would be received first. */
+                if( ( uxChild + ( UBaseType_t ) 1 ) < uxLast )
+                {
+                    prvGetHeapKey( pxQueue, uxChild + ( UBaseType_t ) 1, &uxChildPriority, &uxChildSequence );
+
+                    if( prvIsReceivedBefore( pxQueue, uxChildPriority, uxChildSequence, uxChild ) != pdFALSE )
+                    {
+                        uxChild++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( prvIsReceivedBefore( pxQueue, uxPriority, uxSequence, uxChild ) != pdFALSE )
+                {
+                    xHoleFound = pdTRUE;
+                }
+                else
+                {
+                    prvMoveHeapItem( pxQueue, uxChild, uxHole );
+                    uxHole = uxChild;
+                }
+            }
+        }
+
+        if( uxHole != uxLast )
+        {
+            prvMoveHeapItem( pxQueue, uxLast, uxHole );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_PRIORITY_QUEUES */
+/*-----------------------------------------------------------*/
+
+static void prvUnlockQueue( Queue_t * const pxQueue )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+
+    /* The lock counts contains the number of extra data items placed or
+     * removed from the queue while the queue was locked.  When a queue is
+     * locked items can be added or removed, but the event lists cannot be
+     * updated. */
+    taskENTER_CRITICAL();
+    {
+        int8_t cTxLock = pxQueue->cTxLock;
+
+        /* See if data was added to the queue while it was locked. */
+        while( cTxLock > queueLOCKED_UNMODIFIED )
+        {
+            /* Data was posted while the queue was locked.  Are any tasks
+             * blocked waiting for data to become available? */
+            #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                if( pxQueue->pxQueueSetContainer != NULL )
+                {
+                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    {
+                        /* The queue is a member of a queue set, and posting to
+                         * the queue set caused a higher priority task to unblock.
+                         * A context switch is required. */
+                        vTaskMissedYield();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Tasks that are removed from the event list will get
+                     * added to the pending ready list as the scheduler is still
+                     * suspended. */
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The task waiting has a higher priority so record that a
+                             * context switch is required. */
+                            vTaskMissedYield();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+            }
+            #else /* configUSE_QUEUE_SETS */
+            {
+                /* Tasks that are removed from the event list will get added to
+                 * the pending ready list as the scheduler is still suspended. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority so record that
+                         * a context switch is required. */
+                        vTaskMissedYield();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    break;
+                }
+            }
+            #endif /* configUSE_QUEUE_SETS */
+
+            --cTxLock;
+        }
+
+        pxQueue->cTxLock = queueUNLOCKED;
+    }
+    taskEXIT_CRITICAL();
+
+    /* Do the same for the Rx lock. */
+    taskENTER_CRITICAL();
+    {
+        int8_t cRxLock = pxQueue->cRxLock;
+
+        while( cRxLock > queueLOCKED_UNMODIFIED )
+        {
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    vTaskMissedYield();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                --cRxLock;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        pxQueue->cRxLock = queueUNLOCKED;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
+{
+    BaseType_t xReturn;
+
+    taskENTER_CRITICAL();
+    {
+        if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) || ( queueIS_READ_SLOT_ACQUIRED( pxQueue ) != pdFALSE ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
+{
+    BaseType_t xReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsQueueFull( const Queue_t * pxQueue,
+                                  const BaseType_t xCopyPosition )
+{
+    BaseType_t xReturn;
+
+    taskENTER_CRITICAL();
+    {
+        if( queueIS_FULL_FOR_POSITION( pxQueue, xCopyPosition ) != pdFALSE )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
+{
+    BaseType_t xReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+    BaseType_t xQueueCRSend( QueueHandle_t xQueue,
+                             const void * pvItemToQueue,
+                             TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        /* If the queue is already full we may have to block.  A critical section
+         * is required to prevent an interrupt removing something from the queue
+         * between the check to see if the queue is full and blocking on the queue. */
+        portDISABLE_INTERRUPTS();
+        {
+            if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+            {
+                /* The queue is full - do we want to block or just leave without
+                 * posting? */
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    /* As this is called from a coroutine we cannot block directly, but
+                     * return indicating that we need to block. */
+                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToSend ) );
+                    portENABLE_INTERRUPTS();
+                    return errQUEUE_BLOCKED;
+                }
+                else
+                {
+                    portENABLE_INTERRUPTS();
+                    return errQUEUE_FULL;
+                }
+            }
+        }
+        portENABLE_INTERRUPTS();
+
+        portDISABLE_INTERRUPTS();
+        {
+            if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+            {
+                /* There is room in the queue, copy the data into the queue. */
+                prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
+                xReturn = pdPASS;
+
+                /* Were any co-routines waiting for data to become available? */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    /* In this instance the co-routine could be placed directly
+                     * into the ready list as we are within a critical section.
+                     * Instead the same pending ready list mechanism is used as if
+                     * the event were caused from within an interrupt. */
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        /* The co-routine waiting has a higher priority so record
+                         * that a yield might be appropriate. */
+                        xReturn = errQUEUE_YIELD;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xReturn = errQUEUE_FULL;
+            }
+        }
+        portENABLE_INTERRUPTS();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+    BaseType_t xQueueCRReceive( QueueHandle_t xQueue,
+                                void * pvBuffer,
+                                TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        /* If the queue is already empty we may have to block.  A critical section
+         * is required to prevent an interrupt adding something to the queue
+         * between the check to see if the queue is empty and blocking on the queue. */
+        portDISABLE_INTERRUPTS();
+        {
+            if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+            {
+                /* There are no messages in the queue, do we want to block or just
+                 * leave with nothing? */
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    /* As this is a co-routine we cannot block directly, but return
+                     * indicating that we need to block. */
+                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToReceive ) );
+                    portENABLE_INTERRUPTS();
+                    return errQUEUE_BLOCKED;
+                }
+                else
+                {
+                    portENABLE_INTERRUPTS();
+                    return errQUEUE_FULL;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portENABLE_INTERRUPTS();
+
+        portDISABLE_INTERRUPTS();
+        {
+            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                /* Data is available from the queue. */
+                pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+
+                if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+                {
+                    pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                --( pxQueue->uxMessagesWaiting );
+                prvRecordItemsReceived( pxQueue, ( UBaseType_t ) 1 );
+                ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+
+                xReturn = pdPASS;
+
+                /* Were any co-routines waiting for space to become available? */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    /* In this instance the co-routine could be placed directly
+                     * into the ready list as we are within a critical section.
+                     * Instead the same pending ready list mechanism is used as if
+                     * the event were caused from within an interrupt. */
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        xReturn = errQUEUE_YIELD;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        portENABLE_INTERRUPTS();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+    BaseType_t xQueueCRSendFromISR( QueueHandle_t xQueue,
+                                    const void * pvItemToQueue,
+                                    BaseType_t xCoRoutinePreviouslyWoken )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        /* Cannot block within an ISR so if there is no space on the queue then
+         * exit without doing anything. */
+        if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+        {
+            prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
+
+            /* We only want to wake one co-routine per ISR, so check that a
+             * co-routine has not already been woken. */
+            if( xCoRoutinePreviouslyWoken == pdFALSE )
+            {
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        return pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xCoRoutinePreviouslyWoken;
+    }
+
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+    BaseType_t xQueueCRReceiveFromISR( QueueHandle_t xQueue,
+                                       void * pvBuffer,
+                                       BaseType_t * pxCoRoutineWoken )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        /* We cannot block from an ISR, so check there is data available. If
+         * not then just leave without doing anything. */
+        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            /* Copy the data from the queue. */
+            pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+
+            if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            --( pxQueue->uxMessagesWaiting );
+            prvRecordItemsReceived( pxQueue, ( UBaseType_t ) 1 );
+            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+
+            if( ( *pxCoRoutineWoken ) == pdFALSE )
+            {
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        *pxCoRoutineWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+    static UBaseType_t prvRegistryHashHandle( QueueHandle_t xQueue )
+    {
+        uint32_t ulHash;
+
+        /* Queue structures are at least pointer aligned, so the low bits of
+         * the handle carry no information.  The multiplication spreads the
+         * remaining bits across the whole word. */
+        ulHash = ( uint32_t ) ( ( ( portPOINTER_SIZE_TYPE ) xQueue ) / ( portPOINTER_SIZE_TYPE ) sizeof( void * ) ); /*lint !e923 !e9078 Cast between pointer and integer is required to hash the handle. */
+        ulHash *= 0x9E3779B1UL;
+        ulHash ^= ulHash >> 16;
+
+        return ( UBaseType_t ) ( ulHash % ( uint32_t ) configQUEUE_REGISTRY_SIZE );
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvRegistryHashName( const char * pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        uint32_t ulHash = 2166136261UL;
+
+        /* 32-bit FNV-1a. */
+        while( *pcQueueName != ( char ) 0x00 )
+        {
+            ulHash ^= ( uint32_t ) ( ( uint8_t ) *pcQueueName );
+            ulHash *= 16777619UL;
+            pcQueueName++;
+        }
+
+        return ( UBaseType_t ) ( ulHash % ( uint32_t ) configQUEUE_REGISTRY_SIZE );
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvRegistryFind( const QueueRegistryItem_t * const pxTable,
+                                        UBaseType_t uxPosition,
+                                        QueueHandle_t xQueue )
+    {
+        UBaseType_t ux, uxReturn = ( UBaseType_t ) configQUEUE_REGISTRY_SIZE;
+
+        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+        {
+            if( pxTable[ uxPosition ].pcQueueName == NULL )
+            {
+                /* Reached a vacant position, so the queue is not in the
+                 * table. */
+                break;
+            }
+            else if( pxTable[ uxPosition ].xHandle == xQueue )
+            {
+                uxReturn = uxPosition;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxPosition++;
+
+            if( uxPosition == ( UBaseType_t ) configQUEUE_REGISTRY_SIZE )
+            {
+                uxPosition = ( UBaseType_t ) 0U;
+            }
+        }
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRegistryInsert( QueueRegistryItem_t * const pxTable,
+                                   UBaseType_t uxPosition,
+                                   const char * pcQueueName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                   QueueHandle_t xQueue )
+    {
+        while( pxTable[ uxPosition ].pcQueueName != NULL )
+        {
+            uxPosition++;
+
+            if( uxPosition == ( UBaseType_t ) configQUEUE_REGISTRY_SIZE )
+            {
+                uxPosition = ( UBaseType_t ) 0U;
+            }
+        }
+
+        pxTable[ uxPosition ].pcQueueName = pcQueueName;
+        pxTable[ uxPosition ].xHandle = xQueue;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRegistryRemove( QueueRegistryItem_t * const pxTable,
+                                   UBaseType_t uxPosition )
+    {
+        UBaseType_t uxNext = uxPosition, uxHome;
+        BaseType_t xCanMove;
+
+        /* Set the name to NULL to show that this position is free again, and
+         * the handle to NULL to ensure the same queue handle cannot appear in
+         * the registry twice if it is added, removed, then added again.  The
+         * search below always ends at a vacant position, if only this one. */
+        pxTable[ uxPosition ].pcQueueName = NULL;
+        pxTable[ uxPosition ].xHandle = ( QueueHandle_t ) 0;
+
+        for( ; ; )
+        {
+            uxNext++;
+
+            if( uxNext == ( UBaseType_t ) configQUEUE_REGISTRY_SIZE )
+            {
+                uxNext = ( UBaseType_t ) 0U;
+            }
+
+            if( pxTable[ uxNext ].pcQueueName == NULL )
+            {
+                break;
+            }
+
+            if( pxTable == xQueueRegistry )
+            {
+                uxHome = prvRegistryHashHandle( pxTable[ uxNext ].xHandle );
+            }
+            else
+            {
+                uxHome = prvRegistryHashName( pxTable[ uxNext ].pcQueueName );
+            }
+
+            /* The entry at uxNext can fill the vacant position unless the
+             * position it hashes to lies cyclically after the vacant
+             * position, in which case moving it back would place it before
+             * the start of its own search. */
+            if( uxPosition <= uxNext )
+            {
+                xCanMove = ( ( uxHome <= uxPosition ) || ( uxHome > uxNext ) ) ? pdTRUE : pdFALSE;
+            }
+            else
+            {
+                xCanMove = ( ( uxHome <= uxPosition ) && ( uxHome > uxNext ) ) ? pdTRUE : pdFALSE;
+            }
+
+            if( xCanMove != pdFALSE )
+            {
+                pxTable[ uxPosition ] = pxTable[ uxNext ];
+                pxTable[ uxNext ].pcQueueName = NULL;
+                pxTable[ uxNext ].xHandle = ( QueueHandle_t ) 0;
+                uxPosition = uxNext;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueAddToRegistry( QueueHandle_t xQueue,
+                              const char * pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        UBaseType_t ux, uxByName;
+
+        configASSERT( xQueue );
+
+        if( pcQueueName != NULL )
+        {
+            /* The scheduler is suspended, rather than a critical section
+             * entered, as adding and removing entries can require names to be
+             * hashed. */
+            vTaskSuspendAll();
+            {
+                ux = prvRegistryFind( xQueueRegistry, prvRegistryHashHandle( xQueue ), xQueue );
+
+                if( ux != ( UBaseType_t ) configQUEUE_REGISTRY_SIZE )
+                {
+                    /* Replace the name of a queue that is already in the
+                     * registry, which means moving it in the name index. */
+                    uxByName = prvRegistryFind( xQueueRegistryByName, prvRegistryHashName( xQueueRegistry[ ux ].pcQueueName ), xQueue );
+                    configASSERT( uxByName != ( UBaseType_t ) configQUEUE_REGISTRY_SIZE );
+                    prvRegistryRemove( xQueueRegistryByName, uxByName );
+                    xQueueRegistry[ ux ].pcQueueName = pcQueueName;
+                    prvRegistryInsert( xQueueRegistryByName, prvRegistryHashName( pcQueueName ), pcQueueName, xQueue );
+
+                    traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
+                }
+                else if( uxQueueRegistryCount < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE )
+                {
+                    /* Store the information on this queue. */
+                    prvRegistryInsert( xQueueRegistry, prvRegistryHashHandle( xQueue ), pcQueueName, xQueue );
+                    prvRegistryInsert( xQueueRegistryByName, prvRegistryHashName( pcQueueName ), pcQueueName, xQueue );
+                    uxQueueRegistryCount++;
+
+                    traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
+                }
+                else
+                {
+                    /* The registry is full. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+    const char * pcQueueGetName( QueueHandle_t xQueue ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        UBaseType_t ux;
+        const char * pcReturn = NULL; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+        configASSERT( xQueue );
+
+        /* Note there is nothing here to protect against another task adding or
+         * removing entries from the registry while it is being searched. */
+        ux = prvRegistryFind( xQueueRegistry, prvRegistryHashHandle( xQueue ), xQueue );
+
+        if( ux != ( UBaseType_t ) configQUEUE_REGISTRY_SIZE )
+        {
+            pcReturn = xQueueRegistry[ ux ].pcQueueName;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pcReturn;
+    } /*lint !e818 xQueue cannot be a pointer to const because it is a typedef. */
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+    QueueHandle_t xQueueGetHandleFromName( const char * pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        UBaseType_t ux, uxPosition;
+        QueueHandle_t xReturn = NULL;
+
+        configASSERT( pcQueueName );
+
+        /* Note there is nothing here to protect against another task adding or
+         * removing entries from the registry while it is being searched. */
+        uxPosition = prvRegistryHashName( pcQueueName );
+
+        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+        {
+            if( xQueueRegistryByName[ uxPosition ].pcQueueName == NULL )
+            {
+                break;
+            }
+            else if( strcmp( xQueueRegistryByName[ uxPosition ].pcQueueName, pcQueueName ) == 0 )
+            {
+                xReturn = xQueueRegistryByName[ uxPosition ].xHandle;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxPosition++;
+
+            if( uxPosition == ( UBaseType_t ) configQUEUE_REGISTRY_SIZE )
+            {
+                uxPosition = ( UBaseType_t ) 0U;
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+    void vQueueUnregisterQueue( QueueHandle_t xQueue )
+    {
+        UBaseType_t ux, uxByName;
+
+        configASSERT( xQueue );
+
+        vTaskSuspendAll();
+        {
+            /* See if the handle of the queue being unregistered in actually in
+             * the registry. */
+            ux = prvRegistryFind( xQueueRegistry, prvRegistryHashHandle( xQueue ), xQueue );
+
+            if( ux != ( UBaseType_t ) configQUEUE_REGISTRY_SIZE )
+            {
+                uxByName = prvRegistryFind( xQueueRegistryByName, prvRegistryHashName( xQueueRegistry[ ux ].pcQueueName ), xQueue );
+                configASSERT( uxByName != ( UBaseType_t ) configQUEUE_REGISTRY_SIZE );
+                prvRegistryRemove( xQueueRegistryByName, uxByName );
+                prvRegistryRemove( xQueueRegistry, ux );
+                uxQueueRegistryCount--;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+    } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_QUEUE_STATS == 1 )
+
+    static void prvRecordBlockingTime( Queue_t * const pxQueue,
+                                       const TickType_t xTimeBlockingStarted,
+                                       const BaseType_t xWasSending )
+    {
+        const uint32_t ulTicksBlocked = ( uint32_t ) ( xTaskGetTickCount() - xTimeBlockingStarted );
+
+        taskENTER_CRITICAL();
+        {
+            if( xWasSending != pdFALSE )
+            {
+                pxQueue->xStatistics.ulBlockedSendCount++;
+                pxQueue->xStatistics.ulBlockedSendTicks += ulTicksBlocked;
+            }
+            else
+            {
+                pxQueue->xStatistics.ulBlockedReceiveCount++;
+                pxQueue->xStatistics.ulBlockedReceiveTicks += ulTicksBlocked;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueGetStatistics( QueueHandle_t xQueue,
+                              QueueStatistics_t * const pxStatistics )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pxStatistics );
+
+        taskENTER_CRITICAL();
+        {
+            *pxStatistics = pxQueue->xStatistics;
+        }
+        taskEXIT_CRITICAL();
+    } /*lint !e818 xQueue cannot be a pointer to const because it is a typedef. */
+
+#endif /* configGENERATE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configGENERATE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+
+    UBaseType_t uxQueueGetRegistryStatistics( QueueRegistryStatistics_t * const pxRegistryStatistics,
+                                              const UBaseType_t uxArraySize )
+    {
+        UBaseType_t ux, uxReturn = 0U;
+
+        configASSERT( pxRegistryStatistics );
+
+        vTaskSuspendAll();
+        {
+            /* Is there a space in the array for each registered queue? */
+            if( uxArraySize >= uxQueueRegistryCount )
+            {
+                for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+                {
+                    if( xQueueRegistry[ ux ].pcQueueName != NULL )
+                    {
+                        pxRegistryStatistics[ uxReturn ].pcQueueName = xQueueRegistry[ ux ].pcQueueName;
+                        pxRegistryStatistics[ uxReturn ].xHandle = xQueueRegistry[ ux ].xHandle;
+                        vQueueGetStatistics( xQueueRegistry[ ux ].xHandle, &( pxRegistryStatistics[ uxReturn ].xStatistics ) );
+                        uxReturn++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxReturn;
+    }
+
+#endif /* ( configGENERATE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+    void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
+                                         TickType_t xTicksToWait,
+                                         const BaseType_t xWaitIndefinitely )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        /* This function should not be called by application code hence the
+         * 'Restricted' in its name.  It is not part of the public API.  It is
+         * designed for use by kernel code, and has special calling requirements.
+         * It can result in vListInsert() being called on a list that can only
+         * possibly ever have one item in it, so the list will be fast, but even
+         * so it should be called with the scheduler locked and not from a critical
+         * section. */
+
+        /* Only do anything if there are no messages in the queue.  This function
+         *  will not actually cause the task to block, just place it on a blocked
+         *  list.  It will not block until the scheduler is unlocked - at which
+         *  time a yield will be performed.  If an item is added to the queue while
+         *  the queue is locked, and the calling task blocks on the queue, then the
+         *  calling task will be immediately unblocked when the queue is unlocked. */
+        prvLockQueue( pxQueue );
+
+        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0U )
+        {
+            /* There is nothing in the queue, block for the specified period. */
+            vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait, xWaitIndefinitely );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvUnlockQueue( pxQueue );
+    }
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MULTI_WAIT == 1 )
+
+    BaseType_t xQueueRegisterMultiWaitTask( QueueHandle_t xQueue,
+                                            TaskHandle_t xTask )
+    {
+        Queue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+
+        /* This function should not be called by application code.  It is used
+         * by uxMultiWaitForAny() to set the task that is notified when an item
+         * is sent to the queue, or to clear it by passing NULL. */
+        taskENTER_CRITICAL();
+        {
+            if( ( xTask != NULL ) && ( pxQueue->xMultiWaitTask != NULL ) && ( pxQueue->xMultiWaitTask != xTask ) )
+            {
+                /* Only one task at a time can wait for the queue in
+                 * uxMultiWaitForAny(). */
+                xReturn = pdFAIL;
+            }
+            else
+            {
+                pxQueue->xMultiWaitTask = xTask;
+                xReturn = pdPASS;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MULTI_WAIT */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength )
+    {
+        QueueSetHandle_t pxQueue;
+
+        pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+
+        return pxQueue;
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueSetHandle_t xQueueCreateReadySet( const UBaseType_t uxMaxMembers )
+    {
+        Queue_t * pxNewQueueSet;
+
+        /* Each member appears in the ready list at most once, so the set only
+         * needs space for one handle per member. */
+        pxNewQueueSet = xQueueGenericCreate( uxMaxMembers, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+
+        if( pxNewQueueSet != NULL )
+        {
+            pxNewQueueSet->ucQueueSetFlags = queueSET_USES_READY_LIST;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return ( QueueSetHandle_t ) pxNewQueueSet;
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+    BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                               QueueSetHandle_t xQueueSet )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueueSet = ( Queue_t * ) xQueueSet;
+
+        taskENTER_CRITICAL();
+        {
+            if( ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer != NULL )
+            {
+                /* Cannot add a queue/semaphore to more than one queue set. */
+                xReturn = pdFAIL;
+            }
+            else if( ( ( Queue_t * ) xQueueOrSemaphore )->uxMessagesWaiting != ( UBaseType_t ) 0 )
+            {
+                /* Cannot add a queue/semaphore to a queue set if there are already
+                 * items in the queue/semaphore. */
+                xReturn = pdFAIL;
+            }
+            else if( ( ( pxQueueSet->ucQueueSetFlags & queueSET_USES_READY_LIST ) != 0U ) &&
+                     ( pxQueueSet->uxSetMembers >= pxQueueSet->uxLength ) )
+            {
+                /* A set with a ready list only has space for one handle per
+                 * member, so cannot hold more members than its length. */
+                xReturn = pdFAIL;
+            }
+            else
+            {
+                ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
+                ( pxQueueSet->uxSetMembers )++;
+                xReturn = pdPASS;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+    BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                                    QueueSetHandle_t xQueueSet )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueueOrSemaphore = ( Queue_t * ) xQueueOrSemaphore;
+
+        if( pxQueueOrSemaphore->pxQueueSetContainer != xQueueSet )
+        {
+            /* The queue was not a member of the set. */
+            xReturn = pdFAIL;
+        }
+        else if( ( pxQueueOrSemaphore->uxMessagesWaiting != ( UBaseType_t ) 0 ) ||
+                 ( ( pxQueueOrSemaphore->ucQueueSetFlags & queueSET_MEMBER_READY ) != 0U ) )
+        {
+            /* It is dangerous to remove a queue from a set when the queue is
+             * not empty, or is still in the ready list of the set, because the
+             * queue set will still hold pending events for the queue. */
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+            {
+                /* The queue is no longer contained in the set. */
+                pxQueueOrSemaphore->pxQueueSetContainer = NULL;
+                ( ( ( Queue_t * ) xQueueSet )->uxSetMembers )--;
             }
+            taskEXIT_CRITICAL();
+            xReturn = pdPASS;
         }
-        portENABLE_INTERRUPTS();
 
         return xReturn;
-    }
+    } /*lint !e818 xQueueSet could not be declared as pointing to const as it is a typedef. */
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+#if ( configUSE_QUEUE_SETS == 1 )
 
-    BaseType_t xQueueCRSendFromISR( QueueHandle_t xQueue,
-                                    const void * pvItemToQueue,
-                                    BaseType_t xCoRoutinePreviouslyWoken )
+    QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
+                                                TickType_t const xTicksToWait )
     {
-        Queue_t * const pxQueue = xQueue;
+        QueueSetMemberHandle_t xReturn = NULL;
 
-        /* Cannot block within an ISR so if there is no space on the queue then
-         * exit without doing anything. */
-        if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+        if( ( ( ( Queue_t * ) xQueueSet )->ucQueueSetFlags & queueSET_USES_READY_LIST ) != 0U )
         {
-            prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
-
-            /* We only want to wake one co-routine per ISR, so check that a
-             * co-routine has not already been woken. */
-            if( xCoRoutinePreviouslyWoken == pdFALSE )
-            {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                {
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                    {
-                        return pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            /* The member must leave the ready list in the same critical
+             * section that removes it from the set. */
+            ( void ) uxQueueSelectAllFromSet( xQueueSet, &xReturn, ( UBaseType_t ) 1, xTicksToWait );
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait ); /*lint !e961 Casting from one typedef to another is not redundant. */
         }
 
-        return xCoRoutinePreviouslyWoken;
+        return xReturn;
     }
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+#if ( configUSE_QUEUE_SETS == 1 )
 
-    BaseType_t xQueueCRReceiveFromISR( QueueHandle_t xQueue,
-                                       void * pvBuffer,
-                                       BaseType_t * pxCoRoutineWoken )
+    QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet )
     {
-        BaseType_t xReturn;
-        Queue_t * const pxQueue = xQueue;
+        QueueSetMemberHandle_t xReturn = NULL;
 
-        /* We cannot block from an ISR, so check there is data available. If
-         * not then just leave without doing anything. */
-        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        if( ( ( ( Queue_t * ) xQueueSet )->ucQueueSetFlags & queueSET_USES_READY_LIST ) != 0U )
         {
-            /* Copy the data from the queue. */
-            pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
-
-            if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
-            {
-                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-
-            --( pxQueue->uxMessagesWaiting );
-            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
-
-            if( ( *pxCoRoutineWoken ) == pdFALSE )
-            {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
-                {
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        *pxCoRoutineWoken = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-
-            xReturn = pdPASS;
+            ( void ) uxQueueSelectAllFromSetFromISR( xQueueSet, &xReturn, ( UBaseType_t ) 1 );
         }
         else
         {
-            xReturn = pdFAIL;
+            ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL ); /*lint !e961 Casting from one typedef to another is not redundant. */
         }
 
         return xReturn;
     }
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( configUSE_QUEUE_SETS == 1 )
 
-    void vQueueAddToRegistry( QueueHandle_t xQueue,
-                              const char * pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    UBaseType_t uxQueueSelectAllFromSet( QueueSetHandle_t xQueueSet,
+                                         QueueSetMemberHandle_t * const pxMembers,
+                                         const UBaseType_t uxMaxMembers,
+                                         TickType_t xTicksToWait )
     {
-        UBaseType_t ux;
-        QueueRegistryItem_t * pxEntryToWrite = NULL;
+        Queue_t * const pxQueueSet = ( Queue_t * ) xQueueSet;
+        UBaseType_t uxCount;
+        BaseType_t xEntryTimeSet = pdFALSE, xKeepWaiting;
+        TimeOut_t xTimeOut;
+        QueueSetMemberHandle_t xMember;
 
-        configASSERT( xQueue );
+        configASSERT( pxQueueSet );
+        configASSERT( !( ( pxMembers == NULL ) && ( uxMaxMembers != ( UBaseType_t ) 0U ) ) );
 
-        if( pcQueueName != NULL )
+        do
         {
-            /* See if there is an empty space in the registry.  A NULL name denotes
-             * a free slot. */
-            for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+            taskENTER_CRITICAL();
+            {
+                uxCount = prvTakeFromQueueSet( pxQueueSet, pxMembers, uxMaxMembers );
+            }
+            taskEXIT_CRITICAL();
+
+            if( ( uxCount == ( UBaseType_t ) 0 ) && ( uxMaxMembers != ( UBaseType_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
             {
-                /* Replace an existing entry if the queue is already in the registry. */
-                if( xQueue == xQueueRegistry[ ux ].xHandle )
+                if( xEntryTimeSet == pdFALSE )
                 {
-                    pxEntryToWrite = &( xQueueRegistry[ ux ] );
-                    break;
+                    vTaskSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                    xKeepWaiting = pdTRUE;
+                }
+                else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                {
+                    xKeepWaiting = pdTRUE;
+                }
+                else
+                {
+                    xKeepWaiting = pdFALSE;
                 }
-                /* Otherwise, store in the next empty location */
-                else if( ( pxEntryToWrite == NULL ) && ( xQueueRegistry[ ux ].pcQueueName == NULL ) )
+
+                if( xKeepWaiting != pdFALSE )
                 {
-                    pxEntryToWrite = &( xQueueRegistry[ ux ] );
+                    /* Block until a member is ready.  Peeking leaves the
+                     * member in the set so it is taken, and leaves the ready
+                     * list, under the critical section above.  Another task
+                     * may take it first, in which case the loop waits again
+                     * for whatever remains of the block time. */
+                    ( void ) xQueuePeek( ( QueueHandle_t ) pxQueueSet, &xMember, xTicksToWait ); /*lint !e961 Casting from one typedef to another is not redundant. */
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-        }
-
-        if( pxEntryToWrite != NULL )
-        {
-            /* Store the information on this queue. */
-            pxEntryToWrite->pcQueueName = pcQueueName;
-            pxEntryToWrite->xHandle = xQueue;
+            else
+            {
+                xKeepWaiting = pdFALSE;
+            }
+        } while( xKeepWaiting != pdFALSE );
 
-            traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
-        }
+        return uxCount;
     }
 
-#endif /* configQUEUE_REGISTRY_SIZE */
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( configUSE_QUEUE_SETS == 1 )
 
-    const char * pcQueueGetName( QueueHandle_t xQueue ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    UBaseType_t uxQueueSelectAllFromSetFromISR( QueueSetHandle_t xQueueSet,
+                                                QueueSetMemberHandle_t * const pxMembers,
+                                                const UBaseType_t uxMaxMembers )
     {
-        UBaseType_t ux;
-        const char * pcReturn = NULL; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        Queue_t * const pxQueueSet = ( Queue_t * ) xQueueSet;
+        UBaseType_t uxCount;
+        UBaseType_t uxSavedInterruptStatus;
 
-        configASSERT( xQueue );
+        configASSERT( pxQueueSet );
+        configASSERT( !( ( pxMembers == NULL ) && ( uxMaxMembers != ( UBaseType_t ) 0U ) ) );
 
-        /* Note there is nothing here to protect against another task adding or
-         * removing entries from the registry while it is being searched. */
+        /* See the comments in xQueueReceiveFromISR() regarding interrupt
+         * priorities. */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
-            if( xQueueRegistry[ ux ].xHandle == xQueue )
-            {
-                pcReturn = xQueueRegistry[ ux ].pcQueueName;
-                break;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            uxCount = prvTakeFromQueueSet( pxQueueSet, pxMembers, uxMaxMembers );
         }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
-        return pcReturn;
-    } /*lint !e818 xQueue cannot be a pointer to const because it is a typedef. */
+        return uxCount;
+    }
 
-#endif /* configQUEUE_REGISTRY_SIZE */
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( configUSE_QUEUE_SETS == 1 )
 
-    void vQueueUnregisterQueue( QueueHandle_t xQueue )
+    static UBaseType_t prvTakeFromQueueSet( Queue_t * const pxQueueSet,
+                                            QueueSetMemberHandle_t * const pxMembers,
+                                            const UBaseType_t uxMaxMembers )
     {
-        UBaseType_t ux;
-
-        configASSERT( xQueue );
+        UBaseType_t uxCount = ( UBaseType_t ) 0;
+        Queue_t * pxMember;
 
-        /* See if the handle of the queue being unregistered in actually in the
-         * registry. */
-        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+        /* This function must be called from a critical section.  Members post
+         * to a queue set without blocking, so no task is ever waiting to send
+         * to the set and there is no need to unblock one here. */
+        while( ( uxCount < uxMaxMembers ) && ( pxQueueSet->uxMessagesWaiting > ( UBaseType_t ) 0 ) )
         {
-            if( xQueueRegistry[ ux ].xHandle == xQueue )
-            {
-                /* Set the name to NULL to show that this slot if free again. */
-                xQueueRegistry[ ux ].pcQueueName = NULL;
+            prvCopyDataFromQueue( pxQueueSet, &pxMember );
+            pxQueueSet->uxMessagesWaiting--;
+
+            /* The member will be posted to the set again by the next item
+             * sent to it. */
+            pxMember->ucQueueSetFlags &= ( uint8_t ) ~queueSET_MEMBER_READY;
+            pxMembers[ uxCount ] = ( QueueSetMemberHandle_t ) pxMember;
+            uxCount++;
+        }
 
-                /* Set the handle to NULL to ensure the same queue handle cannot
-                 * appear in the registry twice if it is added, removed, then
-                 * added again. */
-                xQueueRegistry[ ux ].xHandle = ( QueueHandle_t ) 0;
-                break;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+        if( uxCount != ( UBaseType_t ) 0 )
+        {
+            traceQUEUE_RECEIVE( pxQueueSet );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-    } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 
-#endif /* configQUEUE_REGISTRY_SIZE */
+        return uxCount;
+    }
+
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TIMERS == 1 )
+#if ( configUSE_QUEUE_SETS == 1 )
 
-    void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
-                                         TickType_t xTicksToWait,
-                                         const BaseType_t xWaitIndefinitely )
+    static BaseType_t prvNotifyQueueSetContainer( Queue_t * const pxQueue )
     {
-        Queue_t * const pxQueue = xQueue;
+        Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
+        BaseType_t xReturn = pdFALSE;
 
-        /* This function should not be called by application code hence the
-         * 'Restricted' in its name.  It is not part of the public API.  It is
-         * designed for use by kernel code, and has special calling requirements.
-         * It can result in vListInsert() being called on a list that can only
-         * possibly ever have one item in it, so the list will be fast, but even
-         * so it should be called with the scheduler locked and not from a critical
-         * section. */
+        /* This function must be called form a critical section. */
 
-        /* Only do anything if there are no messages in the queue.  This function
-         *  will not actually cause the task to block, just place it on a blocked
-         *  list.  It will not block until the scheduler is unlocked - at which
-         *  time a yield will be performed.  If an item is added to the queue while
-         *  the queue is locked, and the calling task blocks on the queue, then the
-         *  calling task will be immediately unblocked when the queue is unlocked. */
-        prvLockQueue( pxQueue );
+        /* The following line is not reachable in unit tests because every call
+         * to prvNotifyQueueSetContainer is preceded by a check that
+         * pxQueueSetContainer != NULL */
+        configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
+        configASSERT( ( ( pxQueue->ucQueueSetFlags & queueSET_MEMBER_READY ) != 0U ) || ( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength ) );
 
-        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0U )
+        if( ( pxQueue->ucQueueSetFlags & queueSET_MEMBER_READY ) != 0U )
         {
-            /* There is nothing in the queue, block for the specified period. */
-            vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait, xWaitIndefinitely );
+            /* The queue is already in the ready list of the set, so the set
+             * does not need to be told about this item. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+        else if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        {
+            const int8_t cTxLock = pxQueueSetContainer->cTxLock;
+
+            traceQUEUE_SET_SEND( pxQueueSetContainer );
+
+            if( ( pxQueueSetContainer->ucQueueSetFlags & queueSET_USES_READY_LIST ) != 0U )
+            {
+                pxQueue->ucQueueSetFlags |= queueSET_MEMBER_READY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The data copied is the handle of the queue that contains data. */
+            xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+
+            if( cTxLock == queueUNLOCKED )
+            {
+                if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority. */
+                        xReturn = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                prvIncrementQueueTxLock( pxQueueSetContainer, cTxLock );
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        prvUnlockQueue( pxQueue );
+        return xReturn;
     }
 
-#endif /* configUSE_TIMERS */
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
 
-    QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength )
+    static BaseType_t prvCommitReservedSlot( Queue_t * const pxQueue )
     {
-        QueueSetHandle_t pxQueue;
-
-        pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
-
-        return pxQueue;
-    }
+        BaseType_t xReturn = pdFALSE;
+        const int8_t cTxLock = pxQueue->cTxLock;
+        const int8_t cRxLock = pxQueue->cRxLock;
 
-#endif /* configUSE_QUEUE_SETS */
-/*-----------------------------------------------------------*/
+        /* This function must be called from a critical section.  The item was
+         * written in place, so publishing it only requires the write position
+         * and item count to be updated as prvCopyDataToQueue() would have. */
+        pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
-#if ( configUSE_QUEUE_SETS == 1 )
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
-                               QueueSetHandle_t xQueueSet )
-    {
-        BaseType_t xReturn;
+        pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1;
+        prvRecordItemsSent( pxQueue, ( UBaseType_t ) 1 );
+        pxQueue->ucZeroCopyState &= ( uint8_t ) ~queueSLOT_RESERVED;
 
-        taskENTER_CRITICAL();
+        /* The event lists are not altered if the queue is locked.  This will be
+         * done when the queue is unlocked later. */
+        if( cTxLock == queueUNLOCKED )
         {
-            if( ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer != NULL )
+            #if ( configUSE_QUEUE_SETS == 1 )
             {
-                /* Cannot add a queue/semaphore to more than one queue set. */
-                xReturn = pdFAIL;
+                if( pxQueue->pxQueueSetContainer != NULL )
+                {
+                    xReturn = prvNotifyQueueSetContainer( pxQueue );
+                }
+                else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else if( ( ( Queue_t * ) xQueueOrSemaphore )->uxMessagesWaiting != ( UBaseType_t ) 0 )
+            #else /* configUSE_QUEUE_SETS */
             {
-                /* Cannot add a queue/semaphore to a queue set if there are already
-                 * items in the queue/semaphore. */
-                xReturn = pdFAIL;
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_QUEUE_SETS */
+        }
+        else
+        {
+            prvIncrementQueueTxLock( pxQueue, cTxLock );
+        }
+
+        /* Writers that blocked only because the slot was reserved can use the
+         * space that remains. */
+        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+        {
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
-                ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
-                xReturn = pdPASS;
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
             }
         }
-        taskEXIT_CRITICAL();
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
         return xReturn;
     }
-
-#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
-
-    BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
-                                    QueueSetHandle_t xQueueSet )
+    static BaseType_t prvReleaseAcquiredSlot( Queue_t * const pxQueue )
     {
-        BaseType_t xReturn;
-        Queue_t * const pxQueueOrSemaphore = ( Queue_t * ) xQueueOrSemaphore;
+        BaseType_t xReturn = pdFALSE;
+        const int8_t cTxLock = pxQueue->cTxLock;
+        const int8_t cRxLock = pxQueue->cRxLock;
 
-        if( pxQueueOrSemaphore->pxQueueSetContainer != xQueueSet )
+        /* This function must be called from a critical section.  Move the read
+         * position past the acquired item as prvCopyDataFromQueue() would have,
+         * then free its slot. */
+        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
         {
-            /* The queue was not a member of the set. */
-            xReturn = pdFAIL;
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
         }
-        else if( pxQueueOrSemaphore->uxMessagesWaiting != ( UBaseType_t ) 0 )
+        else
         {
-            /* It is dangerous to remove a queue from a set when the queue is
-             * not empty because the queue set will still hold pending events for
-             * the queue. */
-            xReturn = pdFAIL;
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+        prvRecordItemsReceived( pxQueue, ( UBaseType_t ) 1 );
+        pxQueue->ucZeroCopyState &= ( uint8_t ) ~queueSLOT_ACQUIRED;
+
+        /* There is now space in the queue, so unblock the highest priority task
+         * waiting to post to it, unless the queue is locked. */
+        if( cRxLock == queueUNLOCKED )
+        {
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
-            taskENTER_CRITICAL();
+            prvIncrementQueueRxLock( pxQueue, cRxLock );
+        }
+
+        /* Readers that blocked only because the item was acquired can read the
+         * items that remain. */
+        if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+        {
+            if( cTxLock == queueUNLOCKED )
             {
-                /* The queue is no longer contained in the set. */
-                pxQueueOrSemaphore->pxQueueSetContainer = NULL;
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            taskEXIT_CRITICAL();
-            xReturn = pdPASS;
+            else
+            {
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
 
         return xReturn;
-    } /*lint !e818 xQueueSet could not be declared as pointing to const as it is a typedef. */
+    }
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_QUEUE_ZERO_COPY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
-
-    QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
-                                                TickType_t const xTicksToWait )
+static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                 const int8_t * pcItemsToQueue,
+                                 const UBaseType_t uxItemCount )
+{
+    const size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+    const size_t xBytesToTail = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+    /* This function must be called from a critical section, with space for
+     * uxItemCount items in the queue.  The items are copied to the back of the
+     * queue in at most two blocks, one up to the end of the storage area and
+     * one from its start. */
+    if( xBytes < xBytesToTail )
     {
-        QueueSetMemberHandle_t xReturn = NULL;
-
-        ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait ); /*lint !e961 Casting from one typedef to another is not redundant. */
-        return xReturn;
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItemsToQueue, xBytes ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxQueue->pcWriteTo += xBytes;                                                              /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    }
+    else
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItemsToQueue, xBytesToTail );                     /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+        ( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) ( pcItemsToQueue + xBytesToTail ), xBytes - xBytesToTail ); /*lint !e961 !e418 !e9087 !e9016 MISRA exception as the casts are only redundant for some ports. */
+        pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xBytesToTail );                                                    /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
     }
 
-#endif /* configUSE_QUEUE_SETS */
+    pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + uxItemCount;
+    prvRecordItemsSent( pxQueue, uxItemCount );
+}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
-
-    QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet )
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                   int8_t * const pcBuffer,
+                                   const UBaseType_t uxItemCount )
+{
+    const size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+    int8_t * pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    size_t xBytesToTail;
+
+    /* This function must be called from a critical section, with at least
+     * uxItemCount items in the queue.  pcReadFrom points to the item last read,
+     * so the first item to copy is the one after it. */
+    if( pcReadFrom >= pxQueue->u.xQueue.pcTail )
     {
-        QueueSetMemberHandle_t xReturn = NULL;
+        pcReadFrom = pxQueue->pcHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-        ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL ); /*lint !e961 Casting from one typedef to another is not redundant. */
-        return xReturn;
+    xBytesToTail = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom );
+
+    if( xBytes <= xBytesToTail )
+    {
+        ( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcReadFrom, xBytes ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxQueue->u.xQueue.pcReadFrom = pcReadFrom + ( xBytes - pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    }
+    else
+    {
+        ( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcReadFrom, xBytesToTail );                                      /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+        ( void ) memcpy( ( void * ) ( pcBuffer + xBytesToTail ), ( void * ) pxQueue->pcHead, xBytes - xBytesToTail ); /*lint !e961 !e418 !e9087 !e9016 MISRA exception as the casts are only redundant for some ports. */
+        pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( ( xBytes - xBytesToTail ) - pxQueue->uxItemSize );          /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
     }
 
-#endif /* configUSE_QUEUE_SETS */
+    pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - uxItemCount;
+    prvRecordItemsReceived( pxQueue, uxItemCount );
+}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+static BaseType_t prvNotifyItemsPosted( Queue_t * const pxQueue,
+                                        UBaseType_t uxItemCount )
+{
+    BaseType_t xReturn = pdFALSE;
 
-    static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue )
+    /* This function must be called from a critical section.  Each item posted
+     * can satisfy one task blocked on the queue, or is one more entry in the
+     * queue set that contains the queue. */
+    for( ; uxItemCount > ( UBaseType_t ) 0; uxItemCount-- )
     {
-        Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
-        BaseType_t xReturn = pdFALSE;
+        const int8_t cTxLock = pxQueue->cTxLock;
 
-        /* This function must be called form a critical section. */
-
-        /* The following line is not reachable in unit tests because every call
-         * to prvNotifyQueueSetContainer is preceded by a check that
-         * pxQueueSetContainer != NULL */
-        configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
-        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
-
-        if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        if( cTxLock != queueUNLOCKED )
         {
-            const int8_t cTxLock = pxQueueSetContainer->cTxLock;
-
-            traceQUEUE_SET_SEND( pxQueueSetContainer );
-
-            /* The data copied is the handle of the queue that contains data. */
-            xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
-
-            if( cTxLock == queueUNLOCKED )
+            /* The event lists are not altered while the queue is locked.  The
+             * lock count tells the task that unlocks it how many items were
+             * posted in the meantime. */
+            prvIncrementQueueTxLock( pxQueue, cTxLock );
+        }
+        else
+        {
+            #if ( configUSE_QUEUE_SETS == 1 )
             {
-                if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( pxQueue->pxQueueSetContainer != NULL )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    {
+                        xReturn = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
-                        /* The task waiting has a higher priority. */
                         xReturn = pdTRUE;
                     }
                     else
@@ -3068,20 +5472,69 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* No more tasks to unblock. */
+                    break;
+                }
+            }
+            #else /* configUSE_QUEUE_SETS */
+            {
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        xReturn = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* No more tasks to unblock. */
+                    break;
                 }
             }
+            #endif /* configUSE_QUEUE_SETS */
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvNotifyItemsRemoved( Queue_t * const pxQueue,
+                                         UBaseType_t uxItemCount )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    /* This function must be called from a critical section.  Each item
+     * removed frees the space one task blocked on the queue is waiting for. */
+    for( ; uxItemCount > ( UBaseType_t ) 0; uxItemCount-- )
+    {
+        const int8_t cRxLock = pxQueue->cRxLock;
+
+        if( cRxLock != queueUNLOCKED )
+        {
+            prvIncrementQueueRxLock( pxQueue, cRxLock );
+        }
+        else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+        {
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
             else
             {
-                prvIncrementQueueTxLock( pxQueueSetContainer, cTxLock );
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* No more tasks to unblock. */
+            break;
         }
-
-        return xReturn;
     }
 
-#endif /* configUSE_QUEUE_SETS */
+    return xReturn;
+}
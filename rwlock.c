@@ -0,0 +1,805 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+#if ( configUSE_MUTEXES != 1 )
+    #error configUSE_MUTEXES must be set to 1 to build rwlock.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+    #define rwlockYIELD_IF_USING_PREEMPTION()
+#else
+    #define rwlockYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+#endif
+
+/* Bits that can be set in RwLock_t.ucFlags. */
+#define rwlockFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 ) /* Set if the lock was created using statically allocated memory. */
+#define rwlockFLAGS_PREFER_WRITERS             ( ( uint8_t ) 2 ) /* Set if new readers wait while a writer is waiting. */
+
+/* Returns the priority of the task at the head of a non-empty event list. */
+#define rwlockHEAD_PRIORITY( pxList )          ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( ( pxList ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the lock.  The handles of the
+ * tasks that hold the lock for reading are recorded, in no particular order,
+ * so a task that blocks on the lock can raise their priorities. */
+typedef struct RwLockDef_t                             /*lint !e9058 Style convention uses tag. */
+{
+    List_t xTasksWaitingToRead;                        /*< List of tasks that are blocked waiting to take the lock for reading.  Stored in priority order. */
+    List_t xTasksWaitingToWrite;                       /*< List of tasks that are blocked waiting to take the lock for writing.  Stored in priority order. */
+    TaskHandle_t xWriter;                              /*< The task that holds the lock for writing, or NULL. */
+    TaskHandle_t xReaders[ configRWLOCK_MAX_READERS ]; /*< The tasks that hold the lock for reading.  Unused entries are NULL. */
+    UBaseType_t uxReaders;                             /*< The number of non-NULL entries in xReaders. */
+    uint8_t ucFlags;
+} RwLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both xRwLockCreate() and xRwLockCreateStatic() to initialise the
+ * contents of a lock.
+ */
+static void prvInitialiseNewRwLock( RwLock_t * const pxLock,
+                                    uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes the lock for reading or writing, blocking for up to xTicksToWait.
+ * The first pass never blocks, so it is also the path taken when the lock is
+ * available.
+ */
+static BaseType_t prvTakeLock( RwLock_t * const pxLock,
+                               const BaseType_t xForWriting,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the calling task can take the lock for reading or writing
+ * without waiting.  Must be called from a critical section.
+ */
+static BaseType_t prvCanTake( const RwLock_t * const pxLock,
+                              const BaseType_t xForWriting ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records xTask as a holder of the lock and increments its mutex held count.
+ * Must be called from a critical section.
+ */
+static void prvAddHolder( RwLock_t * const pxLock,
+                          const TaskHandle_t xTask,
+                          const BaseType_t xForWriting ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes xTask from the tasks that hold the lock for reading.  Returns
+ * pdFALSE if xTask did not hold the lock for reading.  Must be called from a
+ * critical section.
+ */
+static BaseType_t prvRemoveReader( RwLock_t * const pxLock,
+                                   const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if xTask holds the lock, for reading or for writing.  Must be
+ * called from a critical section.
+ */
+static BaseType_t prvIsHolder( const RwLock_t * const pxLock,
+                               const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Grants the lock to as many of the waiting tasks as can hold it, and
+ * unblocks them.  Returns pdTRUE if a task that was unblocked has a priority
+ * above the calling task.  Must be called from a critical section.
+ */
+static BaseType_t prvGrantWaitingTasks( RwLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the priority of the highest priority task waiting for the lock, or
+ * tskIDLE_PRIORITY if no tasks are waiting.  Must be called from a critical
+ * section.
+ */
+static UBaseType_t prvGetHighestWaitingPriority( const RwLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    RwLockHandle_t xRwLockCreate( const BaseType_t xPreferWriters )
+    {
+        RwLock_t * pxLock;
+
+        pxLock = ( RwLock_t * ) pvPortMalloc( sizeof( RwLock_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxLock != NULL )
+        {
+            prvInitialiseNewRwLock( pxLock, ( xPreferWriters != pdFALSE ) ? rwlockFLAGS_PREFER_WRITERS : ( uint8_t ) 0 );
+            traceRWLOCK_CREATE( pxLock );
+        }
+        else
+        {
+            traceRWLOCK_CREATE_FAILED();
+        }
+
+        return pxLock;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    RwLockHandle_t xRwLockCreateStatic( const BaseType_t xPreferWriters,
+                                        StaticRwLock_t * const pxStaticLock )
+    {
+        RwLock_t * const pxLock = ( RwLock_t * ) pxStaticLock; /*lint !e740 !e9087 Safe cast as StaticRwLock_t is opaque RwLock_t. */
+
+        configASSERT( pxStaticLock );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticRwLock_t equals the size of the real lock
+             * structure. */
+            volatile size_t xSize = sizeof( StaticRwLock_t );
+            configASSERT( xSize == sizeof( RwLock_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( pxLock != NULL )
+        {
+            prvInitialiseNewRwLock( pxLock, ( uint8_t ) ( rwlockFLAGS_IS_STATICALLY_ALLOCATED | ( ( xPreferWriters != pdFALSE ) ? rwlockFLAGS_PREFER_WRITERS : ( uint8_t ) 0 ) ) );
+            traceRWLOCK_CREATE( pxLock );
+        }
+        else
+        {
+            traceRWLOCK_CREATE_FAILED();
+        }
+
+        return pxLock;
+    }
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vRwLockDelete( RwLockHandle_t xLock )
+{
+    RwLock_t * pxLock = xLock;
+
+    configASSERT( pxLock );
+
+    /* A lock that is held, or has tasks waiting for it, cannot be deleted. */
+    configASSERT( ( pxLock->xWriter == NULL ) && ( pxLock->uxReaders == ( UBaseType_t ) 0 ) );
+    configASSERT( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) != pdFALSE );
+    configASSERT( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) != pdFALSE );
+
+    traceRWLOCK_DELETE( xLock );
+
+    if( ( pxLock->ucFlags & rwlockFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            vPortFree( ( void * ) pxLock ); /*lint !e9087 Standard free() semantics require void *, plus pxLock was allocated by pvPortMalloc(). */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xLock == ( RwLockHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure was not allocated dynamically and cannot be freed -
+         * just scrub it so future use will assert. */
+        ( void ) memset( pxLock, 0x00, sizeof( RwLock_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRwLockTakeRead( RwLockHandle_t xLock,
+                            TickType_t xTicksToWait )
+{
+    configASSERT( xLock );
+
+    return prvTakeLock( xLock, pdFALSE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRwLockTakeWrite( RwLockHandle_t xLock,
+                             TickType_t xTicksToWait )
+{
+    configASSERT( xLock );
+
+    return prvTakeLock( xLock, pdTRUE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRwLockGiveRead( RwLockHandle_t xLock )
+{
+    RwLock_t * const pxLock = xLock;
+    const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+    BaseType_t xReturn, xYieldRequired;
+
+    configASSERT( pxLock );
+
+    taskENTER_CRITICAL();
+    {
+        if( prvRemoveReader( pxLock, xCurrentTask ) != pdFALSE )
+        {
+            /* The held count is decremented, and any inherited priority is
+             * disinherited if no other mutexes are held. */
+            xYieldRequired = xTaskPriorityDisinherit( xCurrentTask );
+
+            if( prvGrantWaitingTasks( pxLock ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xYieldRequired != pdFALSE )
+            {
+                rwlockYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            /* The calling task does not hold the lock for reading. */
+            xReturn = pdFAIL;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRwLockGiveWrite( RwLockHandle_t xLock )
+{
+    RwLock_t * const pxLock = xLock;
+    const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+    BaseType_t xReturn, xYieldRequired;
+
+    configASSERT( pxLock );
+
+    taskENTER_CRITICAL();
+    {
+        if( ( pxLock->xWriter == xCurrentTask ) && ( xCurrentTask != NULL ) )
+        {
+            pxLock->xWriter = NULL;
+            xYieldRequired = xTaskPriorityDisinherit( xCurrentTask );
+
+            if( prvGrantWaitingTasks( pxLock ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xYieldRequired != pdFALSE )
+            {
+                rwlockYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            /* The calling task does not hold the lock for writing. */
+            xReturn = pdFAIL;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRwLockGetReaderCount( RwLockHandle_t xLock )
+{
+    const RwLock_t * const pxLock = xLock;
+
+    configASSERT( pxLock );
+
+    return pxLock->uxReaders;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xRwLockGetWriter( RwLockHandle_t xLock )
+{
+    const RwLock_t * const pxLock = xLock;
+
+    configASSERT( pxLock );
+
+    return pxLock->xWriter;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewRwLock( RwLock_t * const pxLock,
+                                    uint8_t ucFlags )
+{
+    ( void ) memset( ( void * ) pxLock, 0x00, sizeof( RwLock_t ) ); /*lint !e9087 memset() requires void *. */
+
+    vListInitialise( &( pxLock->xTasksWaitingToRead ) );
+    vListInitialise( &( pxLock->xTasksWaitingToWrite ) );
+    pxLock->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeLock( RwLock_t * const pxLock,
+                               const BaseType_t xForWriting,
+                               TickType_t xTicksToWait )
+{
+    const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+    BaseType_t xReturn = pdFAIL, xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE, xFinished = pdFALSE, xYieldRequired;
+    TimeOut_t xTimeOut;
+    UBaseType_t ux, uxHighestWaitingPriority;
+
+    configASSERT( xCurrentTask );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    while( xFinished == pdFALSE )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( ( xEntryTimeSet != pdFALSE ) && ( prvIsHolder( pxLock, xCurrentTask ) != pdFALSE ) )
+            {
+                /* The task that gave the lock granted it to this task while
+                 * this task was blocked. */
+                xReturn = pdPASS;
+                xFinished = pdTRUE;
+            }
+            else if( prvCanTake( pxLock, xForWriting ) != pdFALSE )
+            {
+                prvAddHolder( pxLock, xCurrentTask, xForWriting );
+                xReturn = pdPASS;
+                xFinished = pdTRUE;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                /* The lock is not available and either no block time was
+                 * specified or the block time has expired. */
+                xFinished = pdTRUE;
+            }
+            else
+            {
+                if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                {
+                    /* The lock is not recursive - a task that blocks on a lock
+                     * it already holds would never be unblocked. */
+                    configASSERT( prvIsHolder( pxLock, xCurrentTask ) == pdFALSE );
+
+                    /* Raise the priority of every task that holds the lock,
+                     * as this task cannot run again until they have all given
+                     * it back. */
+                    if( pxLock->xWriter != NULL )
+                    {
+                        if( xTaskPriorityInherit( pxLock->xWriter ) != pdFALSE )
+                        {
+                            xInheritanceOccurred = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        for( ux = ( UBaseType_t ) 0; ux < ( UBaseType_t ) configRWLOCK_MAX_READERS; ux++ )
+                        {
+                            if( ( pxLock->xReaders[ ux ] != NULL ) && ( xTaskPriorityInherit( pxLock->xReaders[ ux ] ) != pdFALSE ) )
+                            {
+                                xInheritanceOccurred = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    }
+
+                    if( xForWriting != pdFALSE )
+                    {
+                        traceBLOCKING_ON_RWLOCK_TAKE_WRITE( pxLock );
+                        vTaskPlaceOnEventList( &( pxLock->xTasksWaitingToWrite ), xTicksToWait );
+                    }
+                    else
+                    {
+                        traceBLOCKING_ON_RWLOCK_TAKE_READ( pxLock );
+                        vTaskPlaceOnEventList( &( pxLock->xTasksWaitingToRead ), xTicksToWait );
+                    }
+
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until
+                     * the critical section exits) - but it is not something
+                     * that application code should ever do. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    /* Timed out.  A writer that stops waiting for a lock that
+                     * prefers writers can let waiting readers in. */
+                    xYieldRequired = prvGrantWaitingTasks( pxLock );
+
+                    /* If this task caused the holders to inherit its priority
+                     * then they should disinherit it - but only down to the
+                     * highest priority of any task that is still waiting for
+                     * the lock. */
+                    if( xInheritanceOccurred != pdFALSE )
+                    {
+                        uxHighestWaitingPriority = prvGetHighestWaitingPriority( pxLock );
+
+                        if( pxLock->xWriter != NULL )
+                        {
+                            vTaskPriorityDisinheritAfterTimeout( pxLock->xWriter, uxHighestWaitingPriority );
+                        }
+                        else
+                        {
+                            for( ux = ( UBaseType_t ) 0; ux < ( UBaseType_t ) configRWLOCK_MAX_READERS; ux++ )
+                            {
+                                if( pxLock->xReaders[ ux ] != NULL )
+                                {
+                                    vTaskPriorityDisinheritAfterTimeout( pxLock->xReaders[ ux ], uxHighestWaitingPriority );
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xYieldRequired != pdFALSE )
+                    {
+                        rwlockYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xFinished = pdTRUE;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCanTake( const RwLock_t * const pxLock,
+                              const BaseType_t xForWriting )
+{
+    BaseType_t xReturn;
+
+    if( pxLock->xWriter != NULL )
+    {
+        xReturn = pdFALSE;
+    }
+    else if( xForWriting != pdFALSE )
+    {
+        xReturn = ( pxLock->uxReaders == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+    }
+    else if( pxLock->uxReaders >= ( UBaseType_t ) configRWLOCK_MAX_READERS )
+    {
+        xReturn = pdFALSE;
+    }
+    else if( ( ( pxLock->ucFlags & rwlockFLAGS_PREFER_WRITERS ) != ( uint8_t ) 0 ) &&
+             ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) == pdFALSE ) )
+    {
+        xReturn = pdFALSE;
+    }
+    else
+    {
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddHolder( RwLock_t * const pxLock,
+                          const TaskHandle_t xTask,
+                          const BaseType_t xForWriting )
+{
+    UBaseType_t ux;
+
+    if( xForWriting != pdFALSE )
+    {
+        pxLock->xWriter = xTask;
+    }
+    else
+    {
+        for( ux = ( UBaseType_t ) 0; ux < ( UBaseType_t ) configRWLOCK_MAX_READERS; ux++ )
+        {
+            if( pxLock->xReaders[ ux ] == NULL )
+            {
+                pxLock->xReaders[ ux ] = xTask;
+                ( pxLock->uxReaders )++;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+    /* The lock counts as a mutex for priority disinheritance. */
+    vTaskIncrementMutexHeldCount( xTask );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRemoveReader( RwLock_t * const pxLock,
+                                   const TaskHandle_t xTask )
+{
+    UBaseType_t ux;
+    BaseType_t xReturn = pdFALSE;
+
+    if( xTask != NULL )
+    {
+        for( ux = ( UBaseType_t ) 0; ux < ( UBaseType_t ) configRWLOCK_MAX_READERS; ux++ )
+        {
+            if( pxLock->xReaders[ ux ] == xTask )
+            {
+                pxLock->xReaders[ ux ] = NULL;
+                ( pxLock->uxReaders )--;
+                xReturn = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsHolder( const RwLock_t * const pxLock,
+                               const TaskHandle_t xTask )
+{
+    UBaseType_t ux;
+    BaseType_t xReturn = pdFALSE;
+
+    if( pxLock->xWriter == xTask )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        for( ux = ( UBaseType_t ) 0; ux < ( UBaseType_t ) configRWLOCK_MAX_READERS; ux++ )
+        {
+            if( pxLock->xReaders[ ux ] == xTask )
+            {
+                xReturn = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvGrantWaitingTasks( RwLock_t * const pxLock )
+{
+    BaseType_t xYieldRequired = pdFALSE, xWritersWaiting;
+    UBaseType_t uxLowestGrantedPriority = ( UBaseType_t ) configMAX_PRIORITIES;
+    List_t * pxListToUnblock = NULL;
+    TaskHandle_t xTask;
+
+    xWritersWaiting = ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) == pdFALSE ) ? pdTRUE : pdFALSE;
+
+    if( pxLock->xWriter == NULL )
+    {
+        if( ( pxLock->uxReaders == ( UBaseType_t ) 0 ) && ( xWritersWaiting != pdFALSE ) &&
+            ( ( ( pxLock->ucFlags & rwlockFLAGS_PREFER_WRITERS ) != ( uint8_t ) 0 ) || ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) != pdFALSE ) ) )
+        {
+            /* Grant the lock to the highest priority waiting writer. */
+            uxLowestGrantedPriority = rwlockHEAD_PRIORITY( &( pxLock->xTasksWaitingToWrite ) );
+            xTask = ( TaskHandle_t ) listGET_OWNER_OF_HEAD_ENTRY( &( pxLock->xTasksWaitingToWrite ) );
+            prvAddHolder( pxLock, xTask, pdTRUE );
+
+            if( xTaskRemoveFromEventList( &( pxLock->xTasksWaitingToWrite ) ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( ( ( pxLock->ucFlags & rwlockFLAGS_PREFER_WRITERS ) == ( uint8_t ) 0 ) || ( xWritersWaiting == pdFALSE ) )
+        {
+            /* Grant the lock to as many waiting readers as it can hold, in
+             * priority order. */
+            while( ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) == pdFALSE ) &&
+                   ( pxLock->uxReaders < ( UBaseType_t ) configRWLOCK_MAX_READERS ) )
+            {
+                uxLowestGrantedPriority = rwlockHEAD_PRIORITY( &( pxLock->xTasksWaitingToRead ) );
+                xTask = ( TaskHandle_t ) listGET_OWNER_OF_HEAD_ENTRY( &( pxLock->xTasksWaitingToRead ) );
+                prvAddHolder( pxLock, xTask, pdFALSE );
+
+                if( xTaskRemoveFromEventList( &( pxLock->xTasksWaitingToRead ) ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            /* Readers are held back by a waiting writer that is itself
+             * waiting for the current readers to give the lock back. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* The tasks still waiting only raised the priorities of the tasks that
+     * held the lock when they blocked.  If the highest priority of them has a
+     * priority above a task that has just been granted the lock then it is
+     * unblocked, so it blocks again and the new holders inherit its
+     * priority. */
+    if( uxLowestGrantedPriority < ( UBaseType_t ) configMAX_PRIORITIES )
+    {
+        if( ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) == pdFALSE ) &&
+            ( rwlockHEAD_PRIORITY( &( pxLock->xTasksWaitingToWrite ) ) > uxLowestGrantedPriority ) )
+        {
+            pxListToUnblock = &( pxLock->xTasksWaitingToWrite );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) == pdFALSE ) &&
+            ( rwlockHEAD_PRIORITY( &( pxLock->xTasksWaitingToRead ) ) > uxLowestGrantedPriority ) &&
+            ( ( pxListToUnblock == NULL ) || ( rwlockHEAD_PRIORITY( &( pxLock->xTasksWaitingToRead ) ) > rwlockHEAD_PRIORITY( pxListToUnblock ) ) ) )
+        {
+            pxListToUnblock = &( pxLock->xTasksWaitingToRead );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( pxListToUnblock != NULL ) && ( xTaskRemoveFromEventList( pxListToUnblock ) != pdFALSE ) )
+        {
+            xYieldRequired = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvGetHighestWaitingPriority( const RwLock_t * const pxLock )
+{
+    UBaseType_t uxHighestPriority = tskIDLE_PRIORITY;
+
+    if( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) == pdFALSE )
+    {
+        uxHighestPriority = rwlockHEAD_PRIORITY( &( pxLock->xTasksWaitingToWrite ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) == pdFALSE ) &&
+        ( rwlockHEAD_PRIORITY( &( pxLock->xTasksWaitingToRead ) ) > uxHighestPriority ) )
+    {
+        uxHighestPriority = rwlockHEAD_PRIORITY( &( pxLock->xTasksWaitingToRead ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return uxHighestPriority;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,697 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_ring.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build spsc_ring.c
+#endif
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+    #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build spsc_ring.c
+#endif
+
+#if !defined( __GNUC__ )
+    #error spsc_ring.c requires a compiler that provides the __atomic builtins
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* The atomic operations used by the lock free paths.  atomic.h implements its
+ * operations with critical sections on ports that do not have native atomic
+ * instructions, which is exactly what the ring avoids, so the compiler's own
+ * builtins are used instead.  An index is published with release semantics
+ * after the item it covers has been copied, and read with acquire semantics
+ * before the item it covers is copied.  The full barrier orders a side's own
+ * index store before its read of the other side's waiting task handle (and a
+ * waiting task's handle store before its read of the other side's index), so
+ * either the running side sees the blocked task or the blocking task sees the
+ * space or item that would have woken it. */
+#define spscLOAD_RELAXED( pxVariable )             __atomic_load_n( ( pxVariable ), __ATOMIC_RELAXED )
+#define spscLOAD_ACQUIRE( pxVariable )             __atomic_load_n( ( pxVariable ), __ATOMIC_ACQUIRE )
+#define spscSTORE_RELAXED( pxVariable, xValue )    __atomic_store_n( ( pxVariable ), ( xValue ), __ATOMIC_RELAXED )
+#define spscSTORE_RELEASE( pxVariable, xValue )    __atomic_store_n( ( pxVariable ), ( xValue ), __ATOMIC_RELEASE )
+#define spscEXCHANGE( pxVariable, xValue )         __atomic_exchange_n( ( pxVariable ), ( xValue ), __ATOMIC_RELAXED )
+#define spscFULL_BARRIER()                         __atomic_thread_fence( __ATOMIC_SEQ_CST )
+
+/* Bits that can be set in SpscRing_t.ucFlags. */
+#define spscFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 ) /* Set if the ring was created using statically allocated memory. */
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the ring.  Each index is written
+ * on every transfer by one side only, and shares its cache line with the
+ * waiting task handle that the same side reads on every transfer.  A handle is
+ * only written when a task blocks on the ring or is woken, which is when the
+ * other side writes to the line.  The two groups are separated by a cache line
+ * of padding so the writes made by one side on every transfer do not
+ * invalidate the line the other side is using. */
+typedef struct SpscRingDef_t                 /*lint !e9058 Style convention uses tag. */
+{
+    /* Used by the producer on every send. */
+    volatile UBaseType_t uxHead;                  /*< Index of the slot the next item will be written to.  Written by the producer only. */
+    volatile TaskHandle_t xTaskWaitingToReceive;  /*< Holds the handle of a consumer task that is waiting for an item, or NULL.  Set by the consumer, cleared by whichever side finds it set. */
+    uint8_t ucProducerPadding[ configSPSC_RING_CACHE_LINE_BYTES ];
+
+    /* Used by the consumer on every receive. */
+    volatile UBaseType_t uxTail;                  /*< Index of the slot the next item will be read from.  Written by the consumer only. */
+    volatile TaskHandle_t xTaskWaitingToSend;     /*< Holds the handle of a producer task that is waiting for space, or NULL.  Set by the producer, cleared by whichever side finds it set. */
+    uint8_t ucConsumerPadding[ configSPSC_RING_CACHE_LINE_BYTES ];
+
+    /* Set when the ring is created and not written again. */
+    uint8_t * pucBuffer;                          /*< Points to the slots themselves. */
+    UBaseType_t uxLength;                         /*< The number of slots, which is one more than the number of items the ring can hold. */
+    UBaseType_t uxItemSize;                       /*< The size of each item. */
+    uint8_t ucFlags;
+} SpscRing_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both xSpscRingCreate() and xSpscRingCreateStatic() to initialise
+ * the contents of a ring.
+ */
+static void prvInitialiseNewSpscRing( SpscRing_t * const pxRing,
+                                      uint8_t * const pucBuffer,
+                                      UBaseType_t uxLength,
+                                      UBaseType_t uxItemSize,
+                                      uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies an item into the ring if there is space, without entering a critical
+ * section.  Returns pdTRUE if the item was written.  Must only be called by the
+ * producer.
+ */
+static BaseType_t prvWriteItem( SpscRing_t * const pxRing,
+                                const void * pvItemToSend ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies an item out of the ring if there is one, without entering a critical
+ * section.  Returns pdTRUE if an item was read.  Must only be called by the
+ * consumer.
+ */
+static BaseType_t prvReadItem( SpscRing_t * const pxRing,
+                               void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task on the notification at index
+ * configSPSC_RING_NOTIFICATION_INDEX until the other side of the ring notifies
+ * it or xTicksToWait expires.  pxTaskWaiting is the calling side's waiting task
+ * handle and pxOtherIndex the other side's index, which is re-read after the
+ * handle is published in case the other side moved it before it could see the
+ * handle.  uxFullOrEmptyIndex is the value of *pxOtherIndex at which the ring
+ * is still full or empty from the point of view of the calling task.
+ */
+static void prvWaitForOtherSide( volatile TaskHandle_t * const pxTaskWaiting,
+                                 const volatile UBaseType_t * const pxOtherIndex,
+                                 UBaseType_t uxFullOrEmptyIndex,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the task waiting on the other side of the ring, if any, and clears
+ * the handle so the task is only notified once however many items are sent or
+ * received before it runs again.  The read-modify-write is only made when a
+ * task is actually waiting, so the fast path remains a plain load.
+ */
+static TaskHandle_t prvTakeWaitingTask( volatile TaskHandle_t * const pxTaskWaiting ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    SpscRingHandle_t xSpscRingCreate( const UBaseType_t uxLength,
+                                      const UBaseType_t uxItemSize )
+    {
+        uint8_t * pucAllocatedMemory;
+        size_t xStorageSizeBytes;
+
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        /* Check for multiplication overflow, remembering the extra slot. */
+        if( ( uxLength < ( UBaseType_t ) ( SIZE_MAX / uxItemSize ) ) &&
+            ( spscRING_STORAGE_BYTES( uxLength, uxItemSize ) < ( SIZE_MAX - sizeof( SpscRing_t ) ) ) )
+        {
+            /* Like a stream buffer, a ring requires a SpscRing_t structure and a
+             * storage area, both of which are allocated in a single call to
+             * pvPortMalloc().  The structure is placed at the start of the
+             * allocated memory and the storage area follows immediately after. */
+            xStorageSizeBytes = spscRING_STORAGE_BYTES( uxLength, uxItemSize );
+            pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( SpscRing_t ) + xStorageSizeBytes ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            pucAllocatedMemory = NULL;
+        }
+
+        if( pucAllocatedMemory != NULL )
+        {
+            prvInitialiseNewSpscRing( ( SpscRing_t * ) pucAllocatedMemory,    /* Structure at the start of the allocated memory. */ /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+                                      pucAllocatedMemory + sizeof( SpscRing_t ), /* Storage area follows. */ /*lint !e9016 Indexing past structure valid for uint8_t pointer. */
+                                      uxLength,
+                                      uxItemSize,
+                                      0 );
+
+            traceSPSC_RING_CREATE( ( ( SpscRing_t * ) pucAllocatedMemory ) );
+        }
+        else
+        {
+            traceSPSC_RING_CREATE_FAILED();
+        }
+
+        return ( SpscRingHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    SpscRingHandle_t xSpscRingCreateStatic( const UBaseType_t uxLength,
+                                            const UBaseType_t uxItemSize,
+                                            uint8_t * const pucRingStorageArea,
+                                            StaticSpscRing_t * const pxStaticRing )
+    {
+        SpscRing_t * const pxRing = ( SpscRing_t * ) pxStaticRing; /*lint !e740 !e9087 Safe cast as StaticSpscRing_t is opaque SpscRing_t. */
+        SpscRingHandle_t xReturn;
+
+        configASSERT( pucRingStorageArea );
+        configASSERT( pxStaticRing );
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticSpscRing_t equals the size of the real
+             * ring structure. */
+            volatile size_t xSize = sizeof( StaticSpscRing_t );
+            configASSERT( xSize == sizeof( SpscRing_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucRingStorageArea != NULL ) && ( pxStaticRing != NULL ) )
+        {
+            prvInitialiseNewSpscRing( pxRing,
+                                      pucRingStorageArea,
+                                      uxLength,
+                                      uxItemSize,
+                                      spscFLAGS_IS_STATICALLY_ALLOCATED );
+
+            traceSPSC_RING_CREATE( pxRing );
+
+            xReturn = ( SpscRingHandle_t ) pxStaticRing; /*lint !e9087 Data hiding requires cast to opaque type. */
+        }
+        else
+        {
+            xReturn = NULL;
+            traceSPSC_RING_CREATE_FAILED();
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vSpscRingDelete( SpscRingHandle_t xRing )
+{
+    SpscRing_t * pxRing = xRing;
+
+    configASSERT( pxRing );
+
+    /* A task must not be blocked on a ring that is being deleted. */
+    configASSERT( pxRing->xTaskWaitingToSend == NULL );
+    configASSERT( pxRing->xTaskWaitingToReceive == NULL );
+
+    traceSPSC_RING_DELETE( xRing );
+
+    if( ( pxRing->ucFlags & spscFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* Both the structure and the storage area were allocated using a
+             * single call to pvPortMalloc(), hence only one call to vPortFree()
+             * is required. */
+            vPortFree( ( void * ) pxRing ); /*lint !e9087 Standard free() semantics require void *, plus pxRing was allocated by pvPortMalloc(). */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xRing == ( SpscRingHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure and storage area were not allocated dynamically and
+         * cannot be freed - just scrub the structure so future use will
+         * assert. */
+        ( void ) memset( pxRing, 0x00, sizeof( SpscRing_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingSend( SpscRingHandle_t xRing,
+                          const void * pvItemToSend,
+                          TickType_t xTicksToWait )
+{
+    SpscRing_t * const pxRing = xRing;
+    BaseType_t xReturn;
+    TimeOut_t xTimeOut;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    UBaseType_t uxNextHead;
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( pxRing );
+    configASSERT( pvItemToSend );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        xReturn = prvWriteItem( pxRing, pvItemToSend );
+
+        if( xReturn != pdFALSE )
+        {
+            break;
+        }
+
+        /* The timeout state is only captured once the call has to block, so
+         * the path that does not block never enters a critical section. */
+        if( xTicksToWait == ( TickType_t ) 0 )
+        {
+            xReturn = errQUEUE_FULL;
+            break;
+        }
+        else if( xEntryTimeSet == pdFALSE )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+            xEntryTimeSet = pdTRUE;
+        }
+        else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+        {
+            xReturn = errQUEUE_FULL;
+            break;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The ring is full, so the write cannot succeed until the consumer
+         * moves the tail off the slot that follows the head. */
+        uxNextHead = pxRing->uxHead + ( UBaseType_t ) 1;
+
+        if( uxNextHead >= pxRing->uxLength )
+        {
+            uxNextHead = ( UBaseType_t ) 0;
+        }
+
+        traceBLOCKING_ON_SPSC_RING_SEND( xRing );
+        prvWaitForOtherSide( &( pxRing->xTaskWaitingToSend ), &( pxRing->uxTail ), uxNextHead, xTicksToWait );
+    }
+
+    if( xReturn != pdFALSE )
+    {
+        /* Wake the consumer if it is blocked waiting for an item.  The barrier
+         * orders the head store made by prvWriteItem() before the read of the
+         * handle. */
+        spscFULL_BARRIER();
+        xTaskToNotify = prvTakeWaitingTask( &( pxRing->xTaskWaitingToReceive ) );
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyIndexed( xTaskToNotify, configSPSC_RING_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingSendFromISR( SpscRingHandle_t xRing,
+                                 const void * pvItemToSend,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SpscRing_t * const pxRing = xRing;
+    BaseType_t xReturn;
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( pxRing );
+    configASSERT( pvItemToSend );
+
+    if( prvWriteItem( pxRing, pvItemToSend ) != pdFALSE )
+    {
+        /* Only enter the kernel if the consumer is blocked waiting for an
+         * item, so a high rate producer does not mask interrupts for each
+         * item it sends. */
+        spscFULL_BARRIER();
+        xTaskToNotify = prvTakeWaitingTask( &( pxRing->xTaskWaitingToReceive ) );
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyIndexedFromISR( xTaskToNotify, configSPSC_RING_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errQUEUE_FULL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+                             void * pvBuffer,
+                             TickType_t xTicksToWait )
+{
+    SpscRing_t * const pxRing = xRing;
+    BaseType_t xReturn;
+    TimeOut_t xTimeOut;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( pxRing );
+    configASSERT( pvBuffer );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        xReturn = prvReadItem( pxRing, pvBuffer );
+
+        if( xReturn != pdFALSE )
+        {
+            break;
+        }
+
+        if( xTicksToWait == ( TickType_t ) 0 )
+        {
+            xReturn = errQUEUE_EMPTY;
+            break;
+        }
+        else if( xEntryTimeSet == pdFALSE )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+            xEntryTimeSet = pdTRUE;
+        }
+        else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+        {
+            xReturn = errQUEUE_EMPTY;
+            break;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The ring is empty, so the read cannot succeed until the producer
+         * moves the head off the tail. */
+        traceBLOCKING_ON_SPSC_RING_RECEIVE( xRing );
+        prvWaitForOtherSide( &( pxRing->xTaskWaitingToReceive ), &( pxRing->uxHead ), pxRing->uxTail, xTicksToWait );
+    }
+
+    if( xReturn != pdFALSE )
+    {
+        /* Wake the producer if it is blocked waiting for space. */
+        spscFULL_BARRIER();
+        xTaskToNotify = prvTakeWaitingTask( &( pxRing->xTaskWaitingToSend ) );
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyIndexed( xTaskToNotify, configSPSC_RING_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingReceiveFromISR( SpscRingHandle_t xRing,
+                                    void * pvBuffer,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SpscRing_t * const pxRing = xRing;
+    BaseType_t xReturn;
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( pxRing );
+    configASSERT( pvBuffer );
+
+    if( prvReadItem( pxRing, pvBuffer ) != pdFALSE )
+    {
+        spscFULL_BARRIER();
+        xTaskToNotify = prvTakeWaitingTask( &( pxRing->xTaskWaitingToSend ) );
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyIndexedFromISR( xTaskToNotify, configSPSC_RING_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errQUEUE_EMPTY;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing )
+{
+    const SpscRing_t * const pxRing = xRing;
+    UBaseType_t uxHead, uxTail, uxReturn;
+
+    configASSERT( pxRing );
+
+    uxTail = spscLOAD_ACQUIRE( &( pxRing->uxTail ) );
+    uxHead = spscLOAD_ACQUIRE( &( pxRing->uxHead ) );
+
+    if( uxHead >= uxTail )
+    {
+        uxReturn = uxHead - uxTail;
+    }
+    else
+    {
+        uxReturn = ( pxRing->uxLength - uxTail ) + uxHead;
+    }
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteItem( SpscRing_t * const pxRing,
+                                const void * pvItemToSend )
+{
+    UBaseType_t uxHead, uxNextHead;
+    BaseType_t xReturn;
+
+    /* Only the producer writes the head, so it can be read without ordering. */
+    uxHead = spscLOAD_RELAXED( &( pxRing->uxHead ) );
+    uxNextHead = uxHead + ( UBaseType_t ) 1;
+
+    if( uxNextHead >= pxRing->uxLength )
+    {
+        uxNextHead = ( UBaseType_t ) 0;
+    }
+
+    /* The ring is full when advancing the head would make it equal to the
+     * tail.  The acquire ensures the consumer has finished copying out of the
+     * slot before it is overwritten. */
+    if( uxNextHead != spscLOAD_ACQUIRE( &( pxRing->uxTail ) ) )
+    {
+        ( void ) memcpy( ( void * ) &( pxRing->pucBuffer[ uxHead * pxRing->uxItemSize ] ), pvItemToSend, ( size_t ) pxRing->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        /* Publish the item. */
+        spscSTORE_RELEASE( &( pxRing->uxHead ), uxNextHead );
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReadItem( SpscRing_t * const pxRing,
+                               void * pvBuffer )
+{
+    UBaseType_t uxTail, uxNextTail;
+    BaseType_t xReturn;
+
+    /* Only the consumer writes the tail, so it can be read without ordering. */
+    uxTail = spscLOAD_RELAXED( &( pxRing->uxTail ) );
+
+    /* The ring is empty when the head equals the tail.  The acquire ensures
+     * the producer has finished copying into the slot before it is read. */
+    if( uxTail != spscLOAD_ACQUIRE( &( pxRing->uxHead ) ) )
+    {
+        ( void ) memcpy( pvBuffer, ( void * ) &( pxRing->pucBuffer[ uxTail * pxRing->uxItemSize ] ), ( size_t ) pxRing->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        uxNextTail = uxTail + ( UBaseType_t ) 1;
+
+        if( uxNextTail >= pxRing->uxLength )
+        {
+            uxNextTail = ( UBaseType_t ) 0;
+        }
+
+        /* Hand the slot back to the producer. */
+        spscSTORE_RELEASE( &( pxRing->uxTail ), uxNextTail );
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForOtherSide( volatile TaskHandle_t * const pxTaskWaiting,
+                                 const volatile UBaseType_t * const pxOtherIndex,
+                                 UBaseType_t uxFullOrEmptyIndex,
+                                 TickType_t xTicksToWait )
+{
+    /* Discard any notification left over from an earlier wake up that raced
+     * with the calling task finding the ring usable without blocking. */
+    ( void ) xTaskNotifyStateClearIndexed( NULL, configSPSC_RING_NOTIFICATION_INDEX );
+
+    /* Publish the handle, then look at the other side's index again.  The
+     * other side publishes its index before it reads the handle, so either it
+     * sees the handle and notifies the calling task, or the calling task sees
+     * the new index here and does not block. */
+    spscSTORE_RELAXED( pxTaskWaiting, xTaskGetCurrentTaskHandle() );
+    spscFULL_BARRIER();
+
+    if( spscLOAD_RELAXED( pxOtherIndex ) == uxFullOrEmptyIndex )
+    {
+        ( void ) xTaskNotifyWaitIndexed( configSPSC_RING_NOTIFICATION_INDEX, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* The other side clears the handle when it notifies the calling task, but
+     * not if the wait timed out or was not needed. */
+    spscSTORE_RELAXED( pxTaskWaiting, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvTakeWaitingTask( volatile TaskHandle_t * const pxTaskWaiting )
+{
+    TaskHandle_t xReturn;
+
+    xReturn = spscLOAD_RELAXED( pxTaskWaiting );
+
+    if( xReturn != NULL )
+    {
+        /* The waiting task may have cleared the handle itself since it was
+         * read, having timed out or found the ring usable, in which case NULL
+         * is returned and it is not notified. */
+        xReturn = spscEXCHANGE( pxTaskWaiting, NULL );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewSpscRing( SpscRing_t * const pxRing,
+                                      uint8_t * const pucBuffer,
+                                      UBaseType_t uxLength,
+                                      UBaseType_t uxItemSize,
+                                      uint8_t ucFlags )
+{
+    /* Check the padding keeps the fields used by the producer on every send
+     * a whole cache line away from those used by the consumer on every
+     * receive. */
+    configASSERT( ( offsetof( SpscRing_t, uxTail ) - ( offsetof( SpscRing_t, xTaskWaitingToReceive ) + sizeof( TaskHandle_t ) ) ) >= ( size_t ) configSPSC_RING_CACHE_LINE_BYTES );
+
+    ( void ) memset( ( void * ) pxRing, 0x00, sizeof( SpscRing_t ) ); /*lint !e9087 memset() requires void *. */
+    pxRing->pucBuffer = pucBuffer;
+
+    /* One slot is always left empty so a full ring can be told apart from an
+     * empty ring using only the head and tail. */
+    pxRing->uxLength = uxLength + ( UBaseType_t ) 1;
+    pxRing->uxItemSize = uxItemSize;
+    pxRing->ucFlags = ucFlags;
+}
@@ -98,7 +98,7 @@
     {                                                                                \
         UBaseType_t uxSavedInterruptStatus;                                          \
                                                                                      \
-        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();  \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();      \
         {                                                                            \
             if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                     \
             {                                                                        \
@@ -109,7 +109,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                       \
             }                                                                        \
         }                                                                            \
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                 \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                        \
     }
 #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -175,7 +175,7 @@
     {                                                                                   \
         UBaseType_t uxSavedInterruptStatus;                                             \
                                                                                         \
-        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();     \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();         \
         {                                                                               \
             if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                     \
             {                                                                           \
@@ -186,7 +186,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                       \
             }                                                                           \
         }                                                                               \
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                    \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                           \
     }
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 
@@ -208,6 +208,49 @@
     sbSEND_COMPLETE_FROM_ISR( ( pxStreamBuffer ), ( pxHigherPriorityTaskWoken ) )
 #endif /* if ( configUSE_SB_COMPLETED_CALLBACK == 1 ) */
 
+/* Tell the task, if any, that is waiting for the stream buffer in
+ * uxMultiWaitForAny() that data has been written to the buffer.  Unlike the
+ * task waiting to receive, which is only unblocked once the trigger level is
+ * reached, it is notified of every write, as it waits for the buffer to be not
+ * empty. */
+#if ( configUSE_MULTI_WAIT == 1 )
+    #define prvNOTIFY_MULTI_WAIT_TASK( pxStreamBuffer )                                      \
+    {                                                                                        \
+        taskENTER_CRITICAL();                                                                \
+        {                                                                                    \
+            if( ( pxStreamBuffer )->xMultiWaitTask != NULL )                                 \
+            {                                                                                \
+                ( void ) xTaskNotifyIndexed( ( pxStreamBuffer )->xMultiWaitTask,             \
+                                             configMULTI_WAIT_NOTIFICATION_INDEX,            \
+                                             ( uint32_t ) 0,                                 \
+                                             eNoAction );                                    \
+            }                                                                                \
+        }                                                                                    \
+        taskEXIT_CRITICAL();                                                                 \
+    }
+
+    #define prvNOTIFY_MULTI_WAIT_TASK_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )  \
+    {                                                                                        \
+        UBaseType_t uxSavedInterruptStatus;                                                  \
+                                                                                             \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();              \
+        {                                                                                    \
+            if( ( pxStreamBuffer )->xMultiWaitTask != NULL )                                 \
+            {                                                                                \
+                ( void ) xTaskNotifyIndexedFromISR( ( pxStreamBuffer )->xMultiWaitTask,      \
+                                                    configMULTI_WAIT_NOTIFICATION_INDEX,     \
+                                                    ( uint32_t ) 0,                          \
+                                                    eNoAction,                               \
+                                                    ( pxHigherPriorityTaskWoken ) );         \
+            }                                                                                \
+        }                                                                                    \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                                \
+    }
+#else /* if ( configUSE_MULTI_WAIT == 1 ) */
+    #define prvNOTIFY_MULTI_WAIT_TASK( pxStreamBuffer )
+    #define prvNOTIFY_MULTI_WAIT_TASK_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )
+#endif /* if ( configUSE_MULTI_WAIT == 1 ) */
+
 /*lint -restore (9026) */
 
 /* The number of bytes used to hold the length of a message in the buffer. */
@@ -239,6 +282,10 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
         StreamBufferCallbackFunction_t pxSendCompletedCallback;    /* Optional callback called on send complete. sbSEND_COMPLETED is called if this is NULL. */
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
+
+    #if ( configUSE_MULTI_WAIT == 1 )
+        TaskHandle_t xMultiWaitTask; /* The task, if any, that is waiting for the stream buffer in uxMultiWaitForAny(). */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -517,6 +564,10 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_MULTI_WAIT == 1 )
+        TaskHandle_t xMultiWaitTask;
+    #endif
+
     configASSERT( pxStreamBuffer );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -539,6 +590,14 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_MULTI_WAIT == 1 )
+            {
+                /* A task waiting in uxMultiWaitForAny() is not waiting to
+                 * receive, so can remain registered across the reset. */
+                xMultiWaitTask = pxStreamBuffer->xMultiWaitTask;
+            }
+            #endif
+
             prvInitialiseNewStreamBuffer( pxStreamBuffer,
                                           pxStreamBuffer->pucBuffer,
                                           pxStreamBuffer->xLength,
@@ -553,6 +612,12 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_MULTI_WAIT == 1 )
+            {
+                pxStreamBuffer->xMultiWaitTask = xMultiWaitTask;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET( xStreamBuffer );
 
             xReturn = pdPASS;
@@ -750,6 +815,8 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
     {
         traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
 
+        prvNOTIFY_MULTI_WAIT_TASK( pxStreamBuffer );
+
         /* Was a task waiting for the data? */
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
         {
@@ -800,6 +867,8 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
 
     if( xReturn > ( size_t ) 0 )
     {
+        prvNOTIFY_MULTI_WAIT_TASK_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+
         /* Was a task waiting for the data? */
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
         {
@@ -1192,7 +1261,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 
     configASSERT( pxStreamBuffer );
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
         if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
         {
@@ -1208,7 +1277,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
             xReturn = pdFALSE;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1223,7 +1292,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 
     configASSERT( pxStreamBuffer );
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
         if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
         {
@@ -1239,7 +1308,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
             xReturn = pdFALSE;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1395,6 +1464,41 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
     #endif
 }
 
+#if ( configUSE_MULTI_WAIT == 1 )
+
+    BaseType_t xStreamBufferRegisterMultiWaitTask( StreamBufferHandle_t xStreamBuffer,
+                                                   TaskHandle_t xTask )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        BaseType_t xReturn;
+
+        configASSERT( pxStreamBuffer );
+
+        /* This function should not be called by application code.  It is used
+         * by uxMultiWaitForAny() to set the task that is notified when data is
+         * written to the stream buffer, or to clear it by passing NULL. */
+        taskENTER_CRITICAL();
+        {
+            if( ( xTask != NULL ) && ( pxStreamBuffer->xMultiWaitTask != NULL ) && ( pxStreamBuffer->xMultiWaitTask != xTask ) )
+            {
+                /* Only one task at a time can wait for the stream buffer in
+                 * uxMultiWaitForAny(). */
+                xReturn = pdFAIL;
+            }
+            else
+            {
+                pxStreamBuffer->xMultiWaitTask = xTask;
+                xReturn = pdPASS;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MULTI_WAIT */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
     UBaseType_t uxStreamBufferGetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer )
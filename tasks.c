@@ -115,7 +115,7 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 0 ) )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
  * performed in a generic way that is not optimised to any particular
@@ -146,6 +146,7 @@
                                                                               \
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
          * the  same priority get an equal share of the processor time. */                    \
+        taskEDF_SELECT_FROM_HEAD( uxTopPriority );                                            \
         listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK */
@@ -158,6 +159,80 @@
     #define taskRESET_READY_PRIORITY( uxPriority )
     #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+
+/* If configUSE_READY_PRIORITY_BITMAP is 1 then task selection is still
+ * performed in a generic way, but the ready priorities are held in a two level
+ * bitmap rather than found by walking down the ready lists.  Each bit of
+ * ulReadyPriorityBits[] represents one priority, and each bit of
+ * ulReadyPriorityGroups represents one 32 bit word of ulReadyPriorityBits[]
+ * that has at least one bit set.  Finding the highest priority ready task is
+ * therefore two count leading zeros operations whatever the value of
+ * configMAX_PRIORITIES. */
+    #define taskREADY_BITMAP_WORDS    ( ( ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 31U ) >> 5U )
+
+/* Count the leading zeros in a 32 bit value that is known to be non zero.
+ * GCC and compatible compilers provide a builtin that most architectures map
+ * onto a single instruction, which configUSE_READY_PRIORITY_BITMAP_BUILTIN
+ * selects by default.  The builtin is used on unsigned long as that is
+ * at least 32 bits wide on every architecture, whereas unsigned int is not. */
+    #if ( configUSE_READY_PRIORITY_BITMAP_BUILTIN == 1 )
+        #define taskCOUNT_LEADING_ZEROS( ulBits )    ( ( UBaseType_t ) __builtin_clzl( ( unsigned long ) ( ulBits ) ) - ( UBaseType_t ) ( ( sizeof( unsigned long ) * 8U ) - 32U ) )
+    #else
+        #define taskCOUNT_LEADING_ZEROS( ulBits )    prvCountLeadingZeros( ulBits )
+    #endif
+
+/*-----------------------------------------------------------*/
+
+    #define taskRECORD_READY_PRIORITY( uxPriority )                                                       \
+    {                                                                                                     \
+        ulReadyPriorityBits[ ( uxPriority ) >> 5U ] |= ( ( uint32_t ) 1U << ( ( uxPriority ) & 0x1fU ) ); \
+        ulReadyPriorityGroups |= ( ( uint32_t ) 1U << ( ( uxPriority ) >> 5U ) );                         \
+    } /* taskRECORD_READY_PRIORITY */
+
+/*-----------------------------------------------------------*/
+
+    #define taskSELECT_HIGHEST_PRIORITY_TASK()                                                                  \
+    {                                                                                                           \
+        UBaseType_t uxTopGroup, uxTopPriority;                                                                  \
+                                                                                                                \
+        /* Find the highest priority list that contains ready tasks.  The idle                                  \
+         * task is always ready so at least one bit is always set. */                                           \
+        configASSERT( ulReadyPriorityGroups != 0U );                                                            \
+        uxTopGroup = ( UBaseType_t ) 31U - taskCOUNT_LEADING_ZEROS( ulReadyPriorityGroups );                    \
+        uxTopPriority = ( uxTopGroup << 5U ) +                                                                  \
+                        ( ( UBaseType_t ) 31U - taskCOUNT_LEADING_ZEROS( ulReadyPriorityBits[ uxTopGroup ] ) ); \
+        configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );                 \
+        taskEDF_SELECT_FROM_HEAD( uxTopPriority );                                                              \
+        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );                   \
+    } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
+
+/*-----------------------------------------------------------*/
+
+/* Clear the bit for a priority that no longer has any ready tasks, and clear
+ * the group bit too if that was the last ready priority in its group.  The
+ * name matches the port optimised version so the call sites that already use
+ * portRESET_READY_PRIORITY() keep the bitmap consistent. */
+    #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )                                      \
+    {                                                                                                      \
+        ulReadyPriorityBits[ ( uxPriority ) >> 5U ] &= ~( ( uint32_t ) 1U << ( ( uxPriority ) & 0x1fU ) ); \
+                                                                                                           \
+        if( ulReadyPriorityBits[ ( uxPriority ) >> 5U ] == 0U )                                            \
+        {                                                                                                  \
+            ulReadyPriorityGroups &= ~( ( uint32_t ) 1U << ( ( uxPriority ) >> 5U ) );                     \
+        }                                                                                                  \
+    }
+
+/* As per the port optimised version, only reset the bit if the TCB being
+ * reset is being referenced from a ready list that is now empty. */
+    #define taskRESET_READY_PRIORITY( uxPriority )                                                     \
+    {                                                                                                  \
+        if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 ) \
+        {                                                                                              \
+            portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );                        \
+        }                                                                                              \
+    }
+
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
@@ -176,6 +251,7 @@
         /* Find the highest priority list that contains ready tasks. */                         \
         portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
+        taskEDF_SELECT_FROM_HEAD( uxTopPriority );                                              \
         listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
@@ -196,9 +272,11 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
-#define taskSWITCH_DELAYED_LISTS()                                                \
+    #define taskSWITCH_DELAYED_LISTS()                                            \
     {                                                                             \
         List_t * pxTemp;                                                          \
                                                                                   \
@@ -212,17 +290,127 @@
         prvResetNextTaskUnblockTime();                                            \
     }
 
+#else /* configUSE_DELAYED_TASK_WHEEL */
+
+/* The delayed task wheel is indexed by the bits of each task's wake time, so
+ * there are no lists to switch when the tick count overflows.  Instead the
+ * tick count wrapping to 0 is treated as an event in its own right so the top
+ * level of the wheel is cascaded, which moves the tasks whose wake time had
+ * itself overflowed down towards the bottom level. */
+    #define taskSWITCH_DELAYED_LISTS()                   \
+    {                                                    \
+        xNumOfOverflows++;                               \
+        xNextTaskUnblockTime = ( TickType_t ) 0U;        \
+    }
+
+/* Sizes of the delayed task wheel.  Each level holds taskWHEEL_SLOTS lists and
+ * is indexed by taskWHEEL_SLOT_BITS bits of the wake time, with enough levels
+ * to cover every bit of TickType_t. */
+    #define taskWHEEL_SLOT_BITS     ( ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS )
+    #define taskWHEEL_SLOTS         ( ( UBaseType_t ) 1U << taskWHEEL_SLOT_BITS )
+    #define taskWHEEL_SLOT_MASK     ( taskWHEEL_SLOTS - ( UBaseType_t ) 1U )
+    #define taskWHEEL_TICK_BITS     ( ( UBaseType_t ) ( sizeof( TickType_t ) * ( size_t ) 8 ) )
+    #define taskWHEEL_LEVELS        ( ( taskWHEEL_TICK_BITS + taskWHEEL_SLOT_BITS - ( UBaseType_t ) 1U ) / taskWHEEL_SLOT_BITS )
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 0 )
+
+/* Without the earliest deadline first (EDF) scheduling class every ready list
+ * is shared in turn, and only priorities decide which task runs. */
+    #define taskEDF_SELECT_FROM_HEAD( uxPriority )
+    #define taskRELEASE_JOB( pxTCB, xReleaseTime )
+    #define taskRUNS_BEFORE( pxTCB, pxOtherTCB )    ( ( pxTCB )->uxPriority > ( pxOtherTCB )->uxPriority )
+    #define taskSHOULD_TIME_SLICE( uxPriority )     ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) > ( UBaseType_t ) 1 )
+
+#else /* configUSE_EDF_SCHEDULING */
+
+/* The ready list for configEDF_PRIORITY is held in deadline order.  Moving its
+ * index back to the end of the list before a task is selected from it makes
+ * listGET_OWNER_OF_NEXT_ENTRY() return the task at the head of the list, which
+ * is the task with the earliest deadline, rather than the next task in turn. */
+    #define taskEDF_SELECT_FROM_HEAD( uxPriority )                                                                                       \
+    {                                                                                                                                    \
+        if( ( uxPriority ) == ( UBaseType_t ) configEDF_PRIORITY )                                                                       \
+        {                                                                                                                                \
+            pxReadyTasksLists[ configEDF_PRIORITY ].pxIndex = ( ListItem_t * ) &( pxReadyTasksLists[ configEDF_PRIORITY ].xListEnd ); \
+        }                                                                                                                                \
+    }
+
+/* A task starts a new job each time it leaves the Blocked or Suspended state,
+ * and the job must complete, by the task blocking again, before its absolute
+ * deadline. */
+    #define taskRELEASE_JOB( pxTCB, xReleaseTime )    ( pxTCB )->xAbsoluteDeadline = ( TickType_t ) ( ( xReleaseTime ) + ( pxTCB )->xRelativeDeadline )
+
+/* Tasks of higher priority run first.  Within the EDF band the task with the
+ * earlier deadline runs first. */
+    #define taskRUNS_BEFORE( pxTCB, pxOtherTCB )                                  \
+    ( ( ( pxTCB )->uxPriority > ( pxOtherTCB )->uxPriority ) ||                   \
+      ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&        \
+        ( ( pxOtherTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&   \
+        ( prvDeadlineIsEarlier( ( pxTCB ), ( pxOtherTCB ) ) != pdFALSE ) ) )
+
+/* The task with the earliest deadline runs until it blocks, so the EDF band is
+ * not time sliced. */
+    #define taskSHOULD_TIME_SLICE( uxPriority )                                                         \
+    ( ( ( uxPriority ) != ( UBaseType_t ) configEDF_PRIORITY ) &&                                       \
+      ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) > ( UBaseType_t ) 1 ) )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAKE_LATENCY_HISTOGRAMS == 1 )
+
+/* Records the run time counter value at which a blocked or suspended task is
+ * made ready, so the time it then waits before it runs can be measured when it
+ * is next switched in. */
+    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+        #define taskRECORD_WAKE_TIME( pxTCB )                                  \
+    {                                                                          \
+        portALT_GET_RUN_TIME_COUNTER_VALUE( ( pxTCB )->ulWakeTime );           \
+        ( pxTCB )->ucWakeTimeRecorded = ( uint8_t ) pdTRUE;                    \
+    }
+    #else
+        #define taskRECORD_WAKE_TIME( pxTCB )                                  \
+    {                                                                          \
+        ( pxTCB )->ulWakeTime = portGET_RUN_TIME_COUNTER_VALUE();              \
+        ( pxTCB )->ucWakeTimeRecorded = ( uint8_t ) pdTRUE;                    \
+    }
+    #endif
+#else
+    #define taskRECORD_WAKE_TIME( pxTCB )
+#endif /* configUSE_WAKE_LATENCY_HISTOGRAMS */
+
 /*-----------------------------------------------------------*/
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order if it
+ * is in the EDF band.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                 \
+#if ( configUSE_EDF_SCHEDULING == 0 )
+    #define prvAddTaskToReadyList( pxTCB )                                                                 \
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
     taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
     listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#else
+    #define prvAddTaskToReadyList( pxTCB )                                                                     \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                                   \
+    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                        \
+    if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY )                                          \
+    {                                                                                                          \
+        prvAddTaskToDeadlineOrderedList( pxTCB );                                                              \
+    }                                                                                                          \
+    else                                                                                                       \
+    {                                                                                                          \
+        listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+    }                                                                                                          \
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
 /*
@@ -231,7 +419,64 @@
  * task should be used in place of the parameter.  This macro simply checks to
  * see if the parameter is NULL and returns a pointer to the appropriate TCB.
  */
-#define prvGetTCBFromHandle( pxHandle )    ( ( ( pxHandle ) == NULL ) ? pxCurrentTCB : ( pxHandle ) )
+#if ( configNUMBER_OF_CORES == 1 )
+    #define prvGetTCBFromHandle( pxHandle )    ( ( ( pxHandle ) == NULL ) ? pxCurrentTCB : ( pxHandle ) )
+#else
+
+/* The calling task could be moved to another core between reading the core ID
+ * and reading the current TCB of that core, so the handle is obtained from a
+ * function that prevents that from happening. */
+    #define prvGetTCBFromHandle( pxHandle )    ( ( ( pxHandle ) == NULL ) ? xTaskGetCurrentTaskHandle() : ( pxHandle ) )
+#endif
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+/* The task that is running.  Whether a newly readied task should preempt it
+ * only depends on its priority. */
+    #define taskTASK_IS_RUNNING( pxTCB )    ( ( pxTCB ) == pxCurrentTCB )
+    #define taskSHOULD_PREEMPT( pxTCB )     taskRUNS_BEFORE( ( pxTCB ), pxCurrentTCB )
+#else
+
+/* Value of xTaskRunState when the task is not running on any core. */
+    #define taskTASK_NOT_RUNNING            ( ( BaseType_t ) -1 )
+
+/* pxCurrentTCB is the task running on the calling core.  It must only be used
+ * where the calling task cannot be moved to another core - from within a
+ * critical section, while the scheduler is suspended, or from an interrupt. */
+    #define pxCurrentTCB                    pxCurrentTCBs[ portGET_CORE_ID() ]
+
+/* As pxCurrentTCB, xYieldPending refers to the calling core. */
+    #define xYieldPending                   xYieldPendings[ portGET_CORE_ID() ]
+
+    #define taskTASK_IS_RUNNING( pxTCB )    ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+/* Selects the core, if any, on which a newly readied task should run.  Other
+ * cores are interrupted directly; pdTRUE is returned if it is the calling core
+ * that should yield.  Without preemption a readied task waits for a running
+ * task to yield. */
+    #if ( configUSE_PREEMPTION == 1 )
+        #define taskSHOULD_PREEMPT( pxTCB )    ( prvYieldForTask( pxTCB ) != pdFALSE )
+    #else
+        #define taskSHOULD_PREEMPT( pxTCB )    ( ( void ) ( pxTCB ), pdFALSE )
+    #endif
+#endif
+
+#if ( ( configNUMBER_OF_CORES == 1 ) || ( configASSERT_DEFINED == 0 ) )
+    #define taskASSERT_SCHEDULER_NOT_SUSPENDED()    configASSERT( uxSchedulerSuspended == 0 )
+#else
+
+/* Another core may suspend the scheduler at any time, so outside of a critical
+ * section uxSchedulerSuspended is only checked once the task lock is held, which
+ * any core that has suspended the scheduler also holds. */
+    #define taskASSERT_SCHEDULER_NOT_SUSPENDED()       \
+    {                                                  \
+        taskENTER_CRITICAL();                          \
+        {                                              \
+            configASSERT( uxSchedulerSuspended == 0 ); \
+        }                                              \
+        taskEXIT_CRITICAL();                           \
+    }
+#endif
 
 /* The item value of the event list item is normally used to hold the priority
  * of the task to which it belongs (coded to allow it to be held in reverse
@@ -318,6 +563,24 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        volatile BaseType_t xTaskRunState; /*< The core the task is running on, or taskTASK_NOT_RUNNING. */
+        #if ( configUSE_CORE_AFFINITY == 1 )
+            UBaseType_t uxCoreAffinityMask; /*< Bit n is set if the task is allowed to run on core n. */
+        #endif
+    #endif
+
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xRelativeDeadline; /*< The deadline of each job of the task relative to its release, or 0 if the task has no deadline. */
+        TickType_t xAbsoluteDeadline; /*< The tick count by which the current job of the task must complete. */
+    #endif
+
+    #if ( configUSE_WAKE_LATENCY_HISTOGRAMS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulWakeTime;                                    /*< The run time counter value when the task was last made ready after being blocked or suspended. */
+        uint32_t ulWakeLatencyHistogram[ configWAKE_LATENCY_HISTOGRAM_BUCKETS ]; /*< Counts of the times between the task being made ready and it running, in log2 buckets. */
+        uint8_t ucWakeTimeRecorded;                                                /*< Set to pdTRUE when ulWakeTime is held for a task that has not yet run. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -326,17 +589,26 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
-portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#else
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ]; /*< The task running on each core. */
+#endif
 
 /* Lists for ready and blocked tasks. --------------------
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+    PRIVILEGED_DATA static List_t xDelayedTaskList1;                     /*< Delayed tasks. */
+    PRIVILEGED_DATA static List_t xDelayedTaskList2;                     /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+    PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;          /*< Points to the delayed task list currently being used. */
+    PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;  /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#else
+    PRIVILEGED_DATA static List_t xDelayedTaskWheel[ taskWHEEL_LEVELS ][ taskWHEEL_SLOTS ]; /*< Delayed tasks, hashed by the bits of their wake time that differ from the tick count when they were placed. */
+    PRIVILEGED_DATA static uint32_t ulDelayedTaskWheelSlotsInUse[ taskWHEEL_LEVELS ];       /*< Bit n is set if slot n of the level might not be empty. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -361,14 +633,27 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) )
+    PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityGroups = 0U;                          /*< Bit n is set if ulReadyPriorityBits[ n ] is not zero. */
+    PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityBits[ taskREADY_BITMAP_WORDS ] = { 0U }; /*< Bit n of word w is set if priority ( w * 32 ) + n has ready tasks. */
+#else
+    PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#else
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE }; /*< Set if the core must reschedule as soon as it can. */
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows = ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                      /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#else
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ];   /*< Holds the handles of the idle tasks, one per core.  The idle tasks are created automatically when the scheduler is started. */
+#endif
 
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
@@ -389,7 +674,11 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 /* Do not move these variables to function scope as doing so prevents the
  * code working with debuggers that need to remove the static qualifier. */
-    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;    /*< Holds the value of a timer/counter the last time a task was switched in. */
+    #if ( configNUMBER_OF_CORES == 1 )
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;                                /*< Holds the value of a timer/counter the last time a task was switched in. */
+    #else
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ configNUMBER_OF_CORES ] = { 0UL }; /*< Holds the value of a timer/counter the last time a task was switched in on each core. */
+    #endif
     PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL; /*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
@@ -417,6 +706,16 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
  */
 static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Count the leading zeros in a non zero 32 bit value, for use by the ready
+ * priority bitmap when the compiler does not provide a builtin to do so.
+ */
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) && ( configUSE_READY_PRIORITY_BITMAP_BUILTIN == 0 ) )
+
+    static UBaseType_t prvCountLeadingZeros( uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * The idle task, which as all tasks is implemented as a never ending loop.
  * The idle task is automatically created and added to the ready lists upon
@@ -504,18 +803,94 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  * defined low power mode implementations require configUSE_TICKLESS_IDLE to be
  * set to a value other than 1.
  */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( ( configUSE_TICKLESS_IDLE != 0 ) || ( configUSE_VIRTUAL_TIME == 1 ) )
 
     static TickType_t prvGetExpectedIdleTime( void ) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * Called by the idle task when configUSE_VIRTUAL_TIME is 1.  If no other task
+ * can run, moves the tick count forward to the time at which the next task
+ * leaves the Blocked state.
+ */
+#if ( configUSE_VIRTUAL_TIME == 1 )
+
+    static void prvAdvanceVirtualTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Set xNextTaskUnblockTime to the time at which the next Blocked state task
  * will exit the Blocked state.
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Move the tick count forward by xTicksToAdvance ticks with the same result as
+ * calling xTaskIncrementTick() xTicksToAdvance times.  xTaskIncrementTick() is
+ * only called for the ticks at which a task can leave the Blocked state (or at
+ * which the tick count overflows), so the time taken depends on the number of
+ * tasks unblocked rather than the number of ticks.  Returns pdTRUE if any of
+ * the calls to xTaskIncrementTick() returned pdTRUE.  Must be called from a
+ * critical section with the scheduler not suspended.
+ */
+static BaseType_t prvIncrementTickCountBy( TickType_t xTicksToAdvance ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/*
+ * Returns the number of the lowest slot set in the non zero bitmap ulSlots.
+ */
+    static UBaseType_t prvLowestWheelSlot( uint32_t ulSlots ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the tick count at which the tick count next reaches slot uxSlot of
+ * level uxLevel of the delayed task wheel, assuming that is no later than the
+ * point at which the bits of xTimeNow above uxLevel next change.
+ */
+    static TickType_t prvWheelSlotTime( UBaseType_t uxLevel,
+                                        UBaseType_t uxSlot,
+                                        TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place a delayed task's state list item into the delayed task wheel, relative
+ * to xTimeNow, using the wake time held in the list item's value.  Returns the
+ * tick count at which the wheel next needs to be processed because of the
+ * item, or portMAX_DELAY if that will not occur until the tick count has
+ * overflowed.
+ */
+    static TickType_t prvInsertIntoDelayedTaskWheel( ListItem_t * pxStateListItem,
+                                                     TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from xTaskIncrementTick() when the tick count reaches
+ * xNextTaskUnblockTime.  Moves tasks down the wheel levels that have been
+ * reached and unblocks the tasks whose wake time is xTimeNow.  Returns pdTRUE
+ * if an unblocked task should preempt the running task.
+ */
+    static BaseType_t prvProcessDelayedTaskWheel( TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * The delayed task wheel equivalent of inserting the running task into
+ * pxDelayedTaskList or pxOverflowDelayedTaskList, including updating
+ * xNextTaskUnblockTime.
+ */
+    static void prvAddCurrentTaskToDelayedTaskWheel( TickType_t xTimeToWake,
+                                                     const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+    #if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+
+/*
+ * Returns pdTRUE if pxList is one of the lists that make up the delayed task
+ * wheel, otherwise pdFALSE.  Only used by eTaskGetState().
+ */
+        static BaseType_t prvIsDelayedTaskWheelList( const List_t * pxList ) PRIVILEGED_FUNCTION;
+
+    #endif
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -546,6 +921,64 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/*
+ * Returns pdTRUE if the current job of pxTCB has an earlier deadline than the
+ * current job of pxOtherTCB.  A task without a deadline never has the earlier
+ * deadline.
+ */
+    static BaseType_t prvDeadlineIsEarlier( const TCB_t * pxTCB,
+                                            const TCB_t * pxOtherTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Inserts pxTCB into the ready list for configEDF_PRIORITY after any tasks
+ * that have the same or an earlier deadline.
+ */
+    static void prvAddTaskToDeadlineOrderedList( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if ( configUSE_WAKE_LATENCY_HISTOGRAMS == 1 )
+
+/*
+ * Adds the time between pxTCB being made ready and ulSwitchedInTime, the run
+ * time counter value at which it was switched in, to the wake latency
+ * histogram of pxTCB.
+ */
+    static void prvRecordWakeLatency( TCB_t * pxTCB,
+                                      configRUN_TIME_COUNTER_TYPE ulSwitchedInTime ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_WAKE_LATENCY_HISTOGRAMS */
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * Selects the task that core xCoreID should run next - the highest priority
+ * ready task that is not running on another core and, if core affinity is
+ * used, that is allowed to run on xCoreID.  Tasks of equal priority are
+ * selected in turn.
+ */
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when pxTCB has become ready.  Finds the core running the lowest
+ * priority task that pxTCB can preempt, if any, and makes that core yield.
+ * Returns pdTRUE if the core found is the calling core, in which case it is
+ * left to the caller to yield.
+ */
+    #if ( configUSE_PREEMPTION == 1 )
+        static BaseType_t prvYieldForTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Makes core xCoreID reschedule - directly using an inter-core interrupt if it
+ * is not the calling core, otherwise by holding a yield pending.
+ */
+    static void prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -940,6 +1373,18 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+
+        #if ( configUSE_CORE_AFFINITY == 1 )
+        {
+            pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+        }
+        #endif
+    }
+    #endif /* configNUMBER_OF_CORES */
+
     #if ( portUSING_MPU_WRAPPERS == 1 )
     {
         vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1031,45 +1476,62 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         uxCurrentNumberOfTasks++;
 
-        if( pxCurrentTCB == NULL )
+        #if ( configNUMBER_OF_CORES == 1 )
         {
-            /* There are no other tasks, or all the other tasks are in
-             * the suspended state - make this the current task. */
-            pxCurrentTCB = pxNewTCB;
-
-            if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+            if( pxCurrentTCB == NULL )
             {
-                /* This is the first task to be created so do the preliminary
-                 * initialisation required.  We will not recover if this call
-                 * fails, but we will report the failure. */
-                prvInitialiseTaskLists();
+                /* There are no other tasks, or all the other tasks are in
+                 * the suspended state - make this the current task. */
+                pxCurrentTCB = pxNewTCB;
+
+                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+                {
+                    /* This is the first task to be created so do the preliminary
+                     * initialisation required.  We will not recover if this call
+                     * fails, but we will report the failure. */
+                    prvInitialiseTaskLists();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        else
-        {
-            /* If the scheduler is not already running, make this task the
-             * current task if it is the highest priority task to be created
-             * so far. */
-            if( xSchedulerRunning == pdFALSE )
-            {
-                if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                /* If the scheduler is not already running, make this task the
+                 * current task if it is the highest priority task to be created
+                 * so far. */
+                if( xSchedulerRunning == pdFALSE )
                 {
-                    pxCurrentTCB = pxNewTCB;
+                    if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                    {
+                        pxCurrentTCB = pxNewTCB;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+        }
+        #else /* configNUMBER_OF_CORES */
+        {
+            /* The task each core runs first is selected when the scheduler is
+             * started, as by then the idle task of each core exists. */
+            if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+            {
+                prvInitialiseTaskLists();
+            }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+        #endif /* configNUMBER_OF_CORES */
 
         uxTaskNumber++;
 
@@ -1084,74 +1546,213 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         prvAddTaskToReadyList( pxNewTCB );
 
         portSETUP_TCB( pxNewTCB );
+
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* The core the created task should run on, if any, must be chosen
+             * before the tasks running on the other cores can change. */
+            if( xSchedulerRunning != pdFALSE )
+            {
+                if( taskSHOULD_PREEMPT( pxNewTCB ) )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configNUMBER_OF_CORES */
     }
     taskEXIT_CRITICAL();
 
-    if( xSchedulerRunning != pdFALSE )
+    #if ( configNUMBER_OF_CORES == 1 )
     {
-        /* If the created task is of a higher priority than the current task
-         * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        if( xSchedulerRunning != pdFALSE )
         {
-            taskYIELD_IF_USING_PREEMPTION();
+            /* If the created task is of a higher priority than the current task
+             * then it should run now. */
+            if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+            {
+                taskYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
     }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
 
-    void vTaskDelete( TaskHandle_t xTaskToDelete )
+    static BaseType_t prvDeadlineIsEarlier( const TCB_t * pxTCB,
+                                            const TCB_t * pxOtherTCB )
     {
-        TCB_t * pxTCB;
+        BaseType_t xReturn;
 
-        taskENTER_CRITICAL();
+        if( pxTCB->xRelativeDeadline == ( TickType_t ) 0U )
         {
-            /* If null is passed in here then it is the calling task that is
-             * being deleted. */
-            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
-
-            /* Remove task from the ready/delayed list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            xReturn = pdFALSE;
+        }
+        else if( pxOtherTCB->xRelativeDeadline == ( TickType_t ) 0U )
+        {
+            /* Tasks in the EDF band that do not have a deadline run after all
+             * those that do. */
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            /* The deadlines are compared by their difference, so the result is
+             * still correct when one of them has overflowed, provided they are
+             * less than half the range of TickType_t apart. */
+            if( ( TickType_t ) ( pxTCB->xAbsoluteDeadline - pxOtherTCB->xAbsoluteDeadline ) > ( portMAX_DELAY >> 1 ) )
             {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+                xReturn = pdTRUE;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                xReturn = pdFALSE;
             }
+        }
 
-            /* Is the task waiting on an event also? */
-            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+        return xReturn;
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static void prvAddTaskToDeadlineOrderedList( TCB_t * pxTCB )
+    {
+        List_t * const pxReadyList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+        ListItem_t * pxIterator;
+
+        /* Find the first task with a later deadline.  The list is short, being
+         * only the ready tasks in the EDF band, so is searched linearly. */
+        for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != listGET_END_MARKER( pxReadyList ); pxIterator = listGET_NEXT( pxIterator ) ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+        {
+            if( prvDeadlineIsEarlier( pxTCB, listGET_LIST_ITEM_OWNER( pxIterator ) ) != pdFALSE )
             {
-                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                break;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+        }
 
-            /* Increment the uxTaskNumber also so kernel aware debuggers can
-             * detect that the task lists need re-generating.  This is done before
-             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
-             * not return. */
-            uxTaskNumber++;
+        /* listINSERT_END() inserts in front of the list's index.  The index of
+         * this list is not used to share the processor time, as the task at the
+         * head of the list is always selected, so it can be moved. */
+        pxReadyList->pxIndex = pxIterator;
+        listINSERT_END( pxReadyList, &( pxTCB->xStateListItem ) );
+    }
 
-            if( pxTCB == pxCurrentTCB )
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAKE_LATENCY_HISTOGRAMS == 1 )
+
+    static void prvRecordWakeLatency( TCB_t * pxTCB,
+                                      configRUN_TIME_COUNTER_TYPE ulSwitchedInTime )
+    {
+        configRUN_TIME_COUNTER_TYPE ulLatency;
+        UBaseType_t uxBucket = 0U;
+
+        /* As with the run time stats, guard against a counter that appears to
+         * go backwards. */
+        if( ulSwitchedInTime > pxTCB->ulWakeTime )
+        {
+            ulLatency = ulSwitchedInTime - pxTCB->ulWakeTime;
+        }
+        else
+        {
+            ulLatency = 0U;
+        }
+
+        /* Bucket 0 counts latencies of 0, and bucket n counts latencies of at
+         * least 2^(n-1) but less than 2^n.  The last bucket also counts all the
+         * latencies that are longer than that. */
+        while( ( ulLatency != 0U ) && ( uxBucket < ( UBaseType_t ) ( configWAKE_LATENCY_HISTOGRAM_BUCKETS - 1 ) ) )
+        {
+            ulLatency >>= 1;
+            uxBucket++;
+        }
+
+        if( pxTCB->ulWakeLatencyHistogram[ uxBucket ] != ( uint32_t ) 0xffffffffUL )
+        {
+            pxTCB->ulWakeLatencyHistogram[ uxBucket ]++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_WAKE_LATENCY_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+    void vTaskDelete( TaskHandle_t xTaskToDelete )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xDeleteTCBInIdleTask = pdFALSE;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the calling task that is
+             * being deleted. */
+            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
+
+            /* Remove task from the ready/delayed list. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Is the task waiting on an event also? */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Increment the uxTaskNumber also so kernel aware debuggers can
+             * detect that the task lists need re-generating.  This is done before
+             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
+             * not return. */
+            uxTaskNumber++;
+
+            if( taskTASK_IS_RUNNING( pxTCB ) )
             {
-                /* A task is deleting itself.  This cannot complete within the
-                 * task itself, as a context switch to another task is required.
-                 * Place the task in the termination list.  The idle task will
-                 * check the termination list and free up any memory allocated by
-                 * the scheduler for the TCB and stack of the deleted task. */
+                /* A task is deleting itself, or on a multi-core system is being
+                 * deleted while it runs on another core.  This cannot complete
+                 * within the task itself, as a context switch to another task is
+                 * required.  Place the task in the termination list.  The idle
+                 * task will check the termination list and free up any memory
+                 * allocated by the scheduler for the TCB and stack of the deleted
+                 * task. */
                 vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
 
                 /* Increment the ucTasksDeleted variable so the idle task knows
@@ -1169,6 +1770,25 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * hence xYieldPending is used to latch that a context switch is
                  * required. */
                 portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+
+                xDeleteTCBInIdleTask = pdTRUE;
+
+                #if ( configNUMBER_OF_CORES > 1 )
+                {
+                    /* The core the task is running on must switch it out before
+                     * the idle task can free it.  The calling core yields when
+                     * it leaves the critical section. */
+                    if( pxTCB->xTaskRunState == portGET_CORE_ID() )
+                    {
+                        configASSERT( uxSchedulerSuspended == 0 );
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                }
+                #endif /* configNUMBER_OF_CORES */
             }
             else
             {
@@ -1185,25 +1805,29 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         /* If the task is not deleting itself, call prvDeleteTCB from outside of
          * critical section. If a task deletes itself, prvDeleteTCB is called
          * from prvCheckTasksWaitingTermination which is called from Idle task. */
-        if( pxTCB != pxCurrentTCB )
+        if( xDeleteTCBInIdleTask != pdTRUE )
         {
             prvDeleteTCB( pxTCB );
         }
 
-        /* Force a reschedule if it is the currently running task that has just
-         * been deleted. */
-        if( xSchedulerRunning != pdFALSE )
+        #if ( configNUMBER_OF_CORES == 1 )
         {
-            if( pxTCB == pxCurrentTCB )
-            {
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
-            }
-            else
+            /* Force a reschedule if it is the currently running task that has just
+             * been deleted. */
+            if( xSchedulerRunning != pdFALSE )
             {
-                mtCOVERAGE_TEST_MARKER();
+                if( pxTCB == pxCurrentTCB )
+                {
+                    configASSERT( uxSchedulerSuspended == 0 );
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
+        #endif /* configNUMBER_OF_CORES */
     }
 
 #endif /* INCLUDE_vTaskDelete */
@@ -1219,7 +1843,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
         configASSERT( pxPreviousWakeTime );
         configASSERT( ( xTimeIncrement > 0U ) );
-        configASSERT( uxSchedulerSuspended == 0 );
+        taskASSERT_SCHEDULER_NOT_SUSPENDED();
 
         vTaskSuspendAll();
         {
@@ -1305,7 +1929,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         /* A delay time of zero just forces a reschedule. */
         if( xTicksToDelay > ( TickType_t ) 0U )
         {
-            configASSERT( uxSchedulerSuspended == 0 );
+            taskASSERT_SCHEDULER_NOT_SUSPENDED();
             vTaskSuspendAll();
             {
                 traceTASK_DELAY();
@@ -1347,15 +1971,18 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         eTaskState eReturn;
         List_t const * pxStateList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
+        #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+            List_t const * pxDelayedList;
+            List_t const * pxOverflowedDelayedList;
+        #endif
         const TCB_t * const pxTCB = xTask;
 
         configASSERT( pxTCB );
 
-        if( pxTCB == pxCurrentTCB )
+        if( taskTASK_IS_RUNNING( pxTCB ) )
         {
-            /* The task calling this function is querying its own state. */
+            /* The task calling this function is querying its own state, or
+             * the state of a task running on another core. */
             eReturn = eRunning;
         }
         else
@@ -1363,12 +1990,22 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             taskENTER_CRITICAL();
             {
                 pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+
+                #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+                {
+                    pxDelayedList = pxDelayedTaskList;
+                    pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                }
+                #endif
             }
             taskEXIT_CRITICAL();
 
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+                if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #else
+                /* Every list in the wheel is a delayed list. */
+                if( prvIsDelayedTaskWheelList( pxStateList ) != pdFALSE )
+            #endif
             {
                 /* The task being queried is referenced from one of the Blocked
                  * lists. */
@@ -1487,14 +2124,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
         {
             /* If null is passed in here then it is the priority of the calling
              * task that is being queried. */
             pxTCB = prvGetTCBFromHandle( xTask );
             uxReturn = pxTCB->uxPriority;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
 
         return uxReturn;
     }
@@ -1543,44 +2180,48 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
             if( uxCurrentBasePriority != uxNewPriority )
             {
-                /* The priority change may have readied a task of higher
-                 * priority than the calling task. */
-                if( uxNewPriority > uxCurrentBasePriority )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB != pxCurrentTCB )
+                    /* The priority change may have readied a task of higher
+                     * priority than the calling task. */
+                    if( uxNewPriority > uxCurrentBasePriority )
                     {
-                        /* The priority of a task other than the currently
-                         * running task is being raised.  Is the priority being
-                         * raised above that of the running task? */
-                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                        if( pxTCB != pxCurrentTCB )
                         {
-                            xYieldRequired = pdTRUE;
+                            /* The priority of a task other than the currently
+                             * running task is being raised.  Is the priority being
+                             * raised above that of the running task? */
+                            if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                            {
+                                xYieldRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
                         else
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            /* The priority of the running task is being raised,
+                             * but the running task must already be the highest
+                             * priority task able to run so no yield is required. */
                         }
                     }
+                    else if( pxTCB == pxCurrentTCB )
+                    {
+                        /* Setting the priority of the running task down means
+                         * there may now be another task of higher priority that
+                         * is ready to execute. */
+                        xYieldRequired = pdTRUE;
+                    }
                     else
                     {
-                        /* The priority of the running task is being raised,
-                         * but the running task must already be the highest
-                         * priority task able to run so no yield is required. */
+                        /* Setting the priority of any other task down does not
+                         * require a yield as the running task must be above the
+                         * new priority of the task being modified. */
                     }
                 }
-                else if( pxTCB == pxCurrentTCB )
-                {
-                    /* Setting the priority of the running task down means
-                     * there may now be another task of higher priority that
-                     * is ready to execute. */
-                    xYieldRequired = pdTRUE;
-                }
-                else
-                {
-                    /* Setting the priority of any other task down does not
-                     * require a yield as the running task must be above the
-                     * new priority of the task being modified. */
-                }
+                #endif /* configNUMBER_OF_CORES */
 
                 /* Remember the ready list the task might be referenced from
                  * before its uxPriority member is changed so the
@@ -1648,6 +2289,50 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     mtCOVERAGE_TEST_MARKER();
                 }
 
+                #if ( configNUMBER_OF_CORES > 1 )
+                {
+                    if( taskTASK_IS_RUNNING( pxTCB ) )
+                    {
+                        /* Setting the priority of a running task down means
+                         * there may now be another task of higher priority that
+                         * should run on its core. */
+                        if( uxNewPriority < uxCurrentBasePriority )
+                        {
+                            if( pxTCB->xTaskRunState == portGET_CORE_ID() )
+                            {
+                                xYieldRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                prvYieldCore( pxTCB->xTaskRunState );
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else if( ( uxNewPriority > uxCurrentBasePriority ) &&
+                             ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+                    {
+                        /* A ready task has been raised above the priority of a
+                         * running task. */
+                        if( taskSHOULD_PREEMPT( pxTCB ) )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configNUMBER_OF_CORES */
+
                 if( xYieldRequired != pdFALSE )
                 {
                     taskYIELD_IF_USING_PREEMPTION();
@@ -1668,6 +2353,178 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xCoreID;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the core affinity of the
+             * calling task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+            if( xSchedulerRunning != pdFALSE )
+            {
+                if( taskTASK_IS_RUNNING( pxTCB ) )
+                {
+                    /* The task must leave a core it is no longer allowed to
+                     * run on. */
+                    xCoreID = pxTCB->xTaskRunState;
+
+                    if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) == 0U )
+                    {
+                        prvYieldCore( xCoreID );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                {
+                    /* A ready task may now be allowed onto a core that is
+                     * running a lower priority task.  Should that be the
+                     * calling core the yield is performed when the critical
+                     * section exits. */
+                    ( void ) taskSHOULD_PREEMPT( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+
+    UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        UBaseType_t uxCoreAffinityMask;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxCoreAffinityMask;
+    }
+
+#endif /* ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    void vTaskSetDeadline( TaskHandle_t xTask,
+                           TickType_t xRelativeDeadline )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        configASSERT( xRelativeDeadline <= ( portMAX_DELAY >> 1 ) );
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the deadline of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* The current job of the task is taken to have been released now,
+             * with the new deadline. */
+            pxTCB->xRelativeDeadline = xRelativeDeadline;
+            taskRELEASE_JOB( pxTCB, xTickCount );
+
+            /* A ready task in the EDF band must move to its new position in
+             * deadline order.  The list cannot become empty as the task is put
+             * straight back, so the ready priority is not reset. */
+            if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+            {
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                prvAddTaskToReadyList( pxTCB );
+
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    /* The running task may no longer have the earliest deadline,
+                     * or another task may now have a deadline earlier than that
+                     * of the running task. */
+                    if( ( pxTCB == pxCurrentTCB ) || ( taskSHOULD_PREEMPT( pxTCB ) != pdFALSE ) )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* configNUMBER_OF_CORES */
+                {
+                    if( taskTASK_IS_RUNNING( pxTCB ) )
+                    {
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                    else
+                    {
+                        ( void ) taskSHOULD_PREEMPT( pxTCB );
+                    }
+                }
+                #endif /* configNUMBER_OF_CORES */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xYieldRequired != pdFALSE ) && ( xSchedulerRunning != pdFALSE ) )
+            {
+                taskYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    TickType_t xTaskGetDeadline( TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        TickType_t xRelativeDeadline;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            xRelativeDeadline = pxTCB->xRelativeDeadline;
+        }
+        taskEXIT_CRITICAL();
+
+        return xRelativeDeadline;
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskSuspend == 1 )
 
     void vTaskSuspend( TaskHandle_t xTaskToSuspend )
@@ -1720,13 +2577,37 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 }
             }
             #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-        }
-        taskEXIT_CRITICAL();
 
-        if( xSchedulerRunning != pdFALSE )
-        {
-            /* Reset the next expected unblock time in case it referred to the
-             * task that is now in the Suspended state. */
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* A suspended task that is running must be switched out by the
+                 * core it is running on.  The calling core yields when it
+                 * leaves the critical section. */
+                if( taskTASK_IS_RUNNING( pxTCB ) )
+                {
+                    if( pxTCB->xTaskRunState == portGET_CORE_ID() )
+                    {
+                        configASSERT( uxSchedulerSuspended == 0 );
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configNUMBER_OF_CORES */
+        }
+        taskEXIT_CRITICAL();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Reset the next expected unblock time in case it referred to the
+             * task that is now in the Suspended state. */
             taskENTER_CRITICAL();
             {
                 prvResetNextTaskUnblockTime();
@@ -1738,37 +2619,41 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             mtCOVERAGE_TEST_MARKER();
         }
 
-        if( pxTCB == pxCurrentTCB )
+        #if ( configNUMBER_OF_CORES == 1 )
         {
-            if( xSchedulerRunning != pdFALSE )
-            {
-                /* The current task has just been suspended. */
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
-            }
-            else
+            if( pxTCB == pxCurrentTCB )
             {
-                /* The scheduler is not running, but the task that was pointed
-                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
-                 * must be adjusted to point to a different task. */
-                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                if( xSchedulerRunning != pdFALSE )
                 {
-                    /* No other tasks are ready, so set pxCurrentTCB back to
-                     * NULL so when the next task is created pxCurrentTCB will
-                     * be set to point to it no matter what its relative priority
-                     * is. */
-                    pxCurrentTCB = NULL;
+                    /* The current task has just been suspended. */
+                    configASSERT( uxSchedulerSuspended == 0 );
+                    portYIELD_WITHIN_API();
                 }
                 else
                 {
-                    vTaskSwitchContext();
+                    /* The scheduler is not running, but the task that was pointed
+                     * to by pxCurrentTCB has just been suspended and pxCurrentTCB
+                     * must be adjusted to point to a different task. */
+                    if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                    {
+                        /* No other tasks are ready, so set pxCurrentTCB back to
+                         * NULL so when the next task is created pxCurrentTCB will
+                         * be set to point to it no matter what its relative priority
+                         * is. */
+                        pxCurrentTCB = NULL;
+                    }
+                    else
+                    {
+                        vTaskSwitchContext();
+                    }
                 }
             }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        #endif /* configNUMBER_OF_CORES */
     }
 
 #endif /* INCLUDE_vTaskSuspend */
@@ -1842,10 +2727,16 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     /* The ready list can be accessed even if the scheduler is
                      * suspended because this is inside a critical section. */
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    taskRELEASE_JOB( pxTCB, xTickCount );
+                    taskRECORD_WAKE_TIME( pxTCB );
                     prvAddTaskToReadyList( pxTCB );
 
                     /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #else
+                        if( taskSHOULD_PREEMPT( pxTCB ) )
+                    #endif
                     {
                         /* This yield may not cause the task just resumed to run,
                          * but will leave the lists in the correct state for the
@@ -1902,7 +2793,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
             {
@@ -1913,7 +2804,11 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 {
                     /* Ready lists can be accessed so move the task from the
                      * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #else
+                        if( taskSHOULD_PREEMPT( pxTCB ) )
+                    #endif
                     {
                         xYieldRequired = pdTRUE;
 
@@ -1928,6 +2823,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     }
 
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    taskRELEASE_JOB( pxTCB, xTickCount );
+                    taskRECORD_WAKE_TIME( pxTCB );
                     prvAddTaskToReadyList( pxTCB );
                 }
                 else
@@ -1935,6 +2832,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     /* The delayed or ready lists cannot be accessed so the task
                      * is held in the pending ready list until the scheduler is
                      * unsuspended. */
+                    taskRELEASE_JOB( pxTCB, xTickCount );
+                    taskRECORD_WAKE_TIME( pxTCB );
                     vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
             }
@@ -1943,7 +2842,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xYieldRequired;
     }
@@ -1956,43 +2855,86 @@ void vTaskStartScheduler( void )
     BaseType_t xReturn;
 
     /* Add the idle task at the lowest priority. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    #if ( configNUMBER_OF_CORES == 1 )
     {
-        StaticTask_t * pxIdleTaskTCBBuffer = NULL;
-        StackType_t * pxIdleTaskStackBuffer = NULL;
-        uint32_t ulIdleTaskStackSize;
-
-        /* The Idle task is created using user provided RAM - obtain the
-         * address of the RAM then create the idle task. */
-        vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
-        xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
-                                             configIDLE_TASK_NAME,
-                                             ulIdleTaskStackSize,
-                                             ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
-                                             portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                             pxIdleTaskStackBuffer,
-                                             pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
-
-        if( xIdleTaskHandle != NULL )
-        {
-            xReturn = pdPASS;
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+            StackType_t * pxIdleTaskStackBuffer = NULL;
+            uint32_t ulIdleTaskStackSize;
+
+            /* The Idle task is created using user provided RAM - obtain the
+             * address of the RAM then create the idle task. */
+            vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+            xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
+                                                 configIDLE_TASK_NAME,
+                                                 ulIdleTaskStackSize,
+                                                 ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
+                                                 portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                 pxIdleTaskStackBuffer,
+                                                 pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+            if( xIdleTaskHandle != NULL )
+            {
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
         }
-        else
+        #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
         {
-            xReturn = pdFAIL;
+            /* The Idle task is being created using dynamically allocated RAM. */
+            xReturn = xTaskCreate( prvIdleTask,
+                                   configIDLE_TASK_NAME,
+                                   configMINIMAL_STACK_SIZE,
+                                   ( void * ) NULL,
+                                   portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                   &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
         }
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
     }
-    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+    #else /* configNUMBER_OF_CORES */
     {
-        /* The Idle task is being created using dynamically allocated RAM. */
-        xReturn = xTaskCreate( prvIdleTask,
-                               configIDLE_TASK_NAME,
-                               configMINIMAL_STACK_SIZE,
-                               ( void * ) NULL,
-                               portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                               &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+        BaseType_t xCoreID, xDivisor;
+        UBaseType_t x;
+        char cIdleName[ configMAX_TASK_NAME_LEN ];
+
+        xReturn = pdPASS;
+
+        /* One idle task is created for each core so every core always has a
+         * task to run.  The idle tasks are created using dynamically
+         * allocated RAM and are not bound to a core. */
+        for( xCoreID = 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+        {
+            /* Append the number of the core to the name of the idle task. */
+            for( x = 0; ( x < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 1 ) ) && ( configIDLE_TASK_NAME[ x ] != ( char ) 0x00 ); x++ )
+            {
+                cIdleName[ x ] = configIDLE_TASK_NAME[ x ];
+            }
+
+            for( xDivisor = 1; ( xCoreID / xDivisor ) >= 10; xDivisor *= 10 )
+            {
+            }
+
+            for( ; ( xDivisor > 0 ) && ( x < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 1 ) ); xDivisor /= 10 )
+            {
+                cIdleName[ x ] = ( char ) ( '0' + ( ( xCoreID / xDivisor ) % 10 ) );
+                x++;
+            }
+
+            cIdleName[ x ] = ( char ) 0x00;
+
+            xReturn = xTaskCreate( prvIdleTask,
+                                   cIdleName,
+                                   configMINIMAL_STACK_SIZE,
+                                   ( void * ) NULL,
+                                   portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                   &( xIdleTaskHandles[ xCoreID ] ) );
+        }
     }
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
+    #endif /* configNUMBER_OF_CORES */
 
     #if ( configUSE_TIMERS == 1 )
     {
@@ -2025,6 +2967,18 @@ void vTaskStartScheduler( void )
          * starts to run. */
         portDISABLE_INTERRUPTS();
 
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            BaseType_t xCoreID;
+
+            /* Select the task each core will run first. */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                prvSelectHighestPriorityTask( xCoreID );
+            }
+        }
+        #endif /* configNUMBER_OF_CORES */
+
         #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
         {
             /* Switch C-Runtime's TLS Block to point to the TLS
@@ -2068,7 +3022,11 @@ void vTaskStartScheduler( void )
 
     /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
      * meaning xIdleTaskHandle is not used anywhere else. */
-    ( void ) xIdleTaskHandle;
+    #if ( configNUMBER_OF_CORES == 1 )
+        ( void ) xIdleTaskHandle;
+    #else
+        ( void ) xIdleTaskHandles;
+    #endif
 
     /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
      * from getting optimized out as it is no longer used by the kernel. */
@@ -2089,26 +3047,55 @@ void vTaskEndScheduler( void )
 
 void vTaskSuspendAll( void )
 {
-    /* A critical section is not required as the variable is of type
-     * BaseType_t.  Please read Richard Barry's reply in the following link to a
-     * post in the FreeRTOS support forum before reporting this as a bug! -
-     * https://goo.gl/wu4acr */
-
-    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
-     * do not otherwise exhibit real time behaviour. */
-    portSOFTWARE_BARRIER();
-
-    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-     * is used to allow calls to vTaskSuspendAll() to nest. */
-    ++uxSchedulerSuspended;
-
-    /* Enforces ordering for ports and optimised compilers that may otherwise place
-     * the above increment elsewhere. */
-    portMEMORY_BARRIER();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* A critical section is not required as the variable is of type
+         * BaseType_t.  Please read Richard Barry's reply in the following link to a
+         * post in the FreeRTOS support forum before reporting this as a bug! -
+         * https://goo.gl/wu4acr */
+
+        /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
+         * do not otherwise exhibit real time behaviour. */
+        portSOFTWARE_BARRIER();
+
+        /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+         * is used to allow calls to vTaskSuspendAll() to nest. */
+        ++uxSchedulerSuspended;
+
+        /* Enforces ordering for ports and optimised compilers that may otherwise place
+         * the above increment elsewhere. */
+        portMEMORY_BARRIER();
+    }
+    #else /* configNUMBER_OF_CORES */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* The task lock is held until the scheduler is resumed so tasks
+             * running on other cores cannot access the task lists either.
+             * Interrupts are masked while the lock is taken so the calling task
+             * cannot be switched out between taking the lock and suspending the
+             * scheduler. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                portGET_TASK_LOCK();
+                portGET_ISR_LOCK();
+                ++uxSchedulerSuspended;
+                portRELEASE_ISR_LOCK();
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            ++uxSchedulerSuspended;
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( ( configUSE_TICKLESS_IDLE != 0 ) || ( configUSE_VIRTUAL_TIME == 1 ) )
 
     static TickType_t prvGetExpectedIdleTime( void )
     {
@@ -2119,13 +3106,23 @@ void vTaskSuspendAll( void )
          * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
          * task that are in the Ready state, even though the idle task is
          * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        #if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 0 ) )
         {
             if( uxTopReadyPriority > tskIDLE_PRIORITY )
             {
                 uxHigherPriorityReadyTasks = pdTRUE;
             }
         }
+        #elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        {
+            /* The idle priority is bit 0 of the first word, so if any other bit
+             * in the bitmap is set there are tasks above the idle priority in
+             * the Ready state. */
+            if( ( ulReadyPriorityGroups > 1U ) || ( ulReadyPriorityBits[ 0 ] > 1U ) )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
         #else
         {
             const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
@@ -2168,7 +3165,7 @@ void vTaskSuspendAll( void )
         return xReturn;
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
+#endif /* ( configUSE_TICKLESS_IDLE != 0 ) || ( configUSE_VIRTUAL_TIME == 1 ) */
 /*----------------------------------------------------------*/
 
 BaseType_t xTaskResumeAll( void )
@@ -2189,6 +3186,21 @@ BaseType_t xTaskResumeAll( void )
     {
         --uxSchedulerSuspended;
 
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* Release the task lock taken by vTaskSuspendAll().  It is still
+             * held by the critical section. */
+            if( xSchedulerRunning != pdFALSE )
+            {
+                portRELEASE_TASK_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configNUMBER_OF_CORES */
+
         if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
         {
             if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
@@ -2205,7 +3217,11 @@ BaseType_t xTaskResumeAll( void )
 
                     /* If the moved task has a priority higher than or equal to
                      * the current task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #else
+                        if( taskSHOULD_PREEMPT( pxTCB ) )
+                    #endif
                     {
                         xYieldPending = pdTRUE;
                     }
@@ -2235,19 +3251,14 @@ BaseType_t xTaskResumeAll( void )
 
                     if( xPendedCounts > ( TickType_t ) 0U )
                     {
-                        do
+                        if( prvIncrementTickCountBy( xPendedCounts ) != pdFALSE )
                         {
-                            if( xTaskIncrementTick() != pdFALSE )
-                            {
-                                xYieldPending = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-
-                            --xPendedCounts;
-                        } while( xPendedCounts > ( TickType_t ) 0U );
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
 
                         xPendedTicks = 0;
                     }
@@ -2446,15 +3457,31 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
             } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
             /* Search the delayed lists. */
-            if( pxTCB == NULL )
+            #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-            }
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                }
 
-            if( pxTCB == NULL )
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                }
+            }
+            #else
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                UBaseType_t uxLevel, uxSlot;
+
+                for( uxLevel = 0U; ( uxLevel < taskWHEEL_LEVELS ) && ( pxTCB == NULL ); uxLevel++ )
+                {
+                    for( uxSlot = 0U; ( uxSlot < taskWHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ), pcNameToQuery );
+                    }
+                }
             }
+            #endif /* configUSE_DELAYED_TASK_WHEEL */
 
             #if ( INCLUDE_vTaskSuspend == 1 )
             {
@@ -2507,8 +3534,24 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Blocked state. */
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+                {
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                }
+                #else
+                {
+                    UBaseType_t uxLevel, uxSlot;
+
+                    for( uxLevel = 0U; uxLevel < taskWHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0U; uxSlot < taskWHEEL_SLOTS; uxSlot++ )
+                        {
+                            uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ), eBlocked );
+                        }
+                    }
+                }
+                #endif /* configUSE_DELAYED_TASK_WHEEL */
 
                 #if ( INCLUDE_vTaskDelete == 1 )
                 {
@@ -2563,12 +3606,34 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 
     TaskHandle_t xTaskGetIdleTaskHandle( void )
     {
-        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-         * started, then xIdleTaskHandle will be NULL. */
-        configASSERT( ( xIdleTaskHandle != NULL ) );
-        return xIdleTaskHandle;
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+             * started, then xIdleTaskHandle will be NULL. */
+            configASSERT( ( xIdleTaskHandle != NULL ) );
+            return xIdleTaskHandle;
+        }
+        #else
+        {
+            return xTaskGetIdleTaskHandleForCore( 0 );
+        }
+        #endif
     }
 
+    #if ( configNUMBER_OF_CORES > 1 )
+
+        TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
+        {
+            configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+            /* If xTaskGetIdleTaskHandleForCore() is called before the scheduler
+             * has been started, then the handle will be NULL. */
+            configASSERT( ( xIdleTaskHandles[ xCoreID ] != NULL ) );
+            return xIdleTaskHandles[ xCoreID ];
+        }
+
+    #endif /* configNUMBER_OF_CORES */
+
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
 
@@ -2613,13 +3678,72 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 #endif /* configUSE_TICKLESS_IDLE */
 /*----------------------------------------------------------*/
 
+static BaseType_t prvIncrementTickCountBy( TickType_t xTicksToAdvance )
+{
+    TickType_t xTicksToSkip;
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    while( xTicksToAdvance > ( TickType_t ) 0U )
+    {
+        /* No task can leave the Blocked state before xNextTaskUnblockTime,
+         * and xNextTaskUnblockTime is never beyond the tick count overflowing,
+         * so the ticks before it only need adding to the tick count.  Nothing
+         * can be skipped if xNextTaskUnblockTime has already been reached. */
+        if( xNextTaskUnblockTime > xTickCount )
+        {
+            xTicksToSkip = ( xNextTaskUnblockTime - xTickCount ) - ( TickType_t ) 1U;
+        }
+        else
+        {
+            xTicksToSkip = ( TickType_t ) 0U;
+        }
+
+        /* Always leave at least one tick to pass through xTaskIncrementTick(),
+         * so the time slice and yield pending checks are made as they would be
+         * if every tick was processed individually. */
+        if( xTicksToSkip >= xTicksToAdvance )
+        {
+            xTicksToSkip = xTicksToAdvance - ( TickType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xTicksToSkip > ( TickType_t ) 0U )
+        {
+            xTickCount += xTicksToSkip;
+            traceINCREASE_TICK_COUNT( xTicksToSkip );
+            xTicksToAdvance -= xTicksToSkip;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xTaskIncrementTick() != pdFALSE )
+        {
+            xSwitchRequired = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        --xTicksToAdvance;
+    }
+
+    return xSwitchRequired;
+}
+/*----------------------------------------------------------*/
+
 BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 {
     BaseType_t xYieldOccurred;
 
     /* Must not be called with the scheduler suspended as the implementation
      * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == 0 );
+    taskASSERT_SCHEDULER_NOT_SUSPENDED();
 
     /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
      * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
@@ -2682,6 +3806,8 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                 taskEXIT_CRITICAL();
 
                 /* Place the unblocked task into the appropriate ready list. */
+                taskRELEASE_JOB( pxTCB, xTickCount );
+                taskRECORD_WAKE_TIME( pxTCB );
                 prvAddTaskToReadyList( pxTCB );
 
                 /* A task being unblocked cannot cause an immediate context
@@ -2691,7 +3817,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                     /* Preemption is on, but a context switch should only be
                      * performed if the unblocked task has a priority that is
                      * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskSHOULD_PREEMPT( pxTCB ) )
                     {
                         /* Pend the yield to be performed when the scheduler
                          * is unsuspended. */
@@ -2719,8 +3845,10 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 
 BaseType_t xTaskIncrementTick( void )
 {
-    TCB_t * pxTCB;
-    TickType_t xItemValue;
+    #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+        TCB_t * pxTCB;
+        TickType_t xItemValue;
+    #endif
     BaseType_t xSwitchRequired = pdFALSE;
 
     /* Called by the portable layer each time a tick interrupt occurs.
@@ -2747,105 +3875,157 @@ BaseType_t xTaskIncrementTick( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
-        /* See if this tick has made a timeout expire.  Tasks are stored in
-         * the  queue in the order of their wake time - meaning once one task
-         * has been found whose block time has not expired there is no need to
-         * look any further down the list. */
-        if( xConstTickCount >= xNextTaskUnblockTime )
+        #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
         {
-            for( ; ; )
+            /* See if this tick has made a timeout expire.  Tasks are stored in
+             * the  queue in the order of their wake time - meaning once one task
+             * has been found whose block time has not expired there is no need to
+             * look any further down the list. */
+            if( xConstTickCount >= xNextTaskUnblockTime )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-                {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    break;
-                }
-                else
+                for( ; ; )
                 {
-                    /* The delayed list is not empty, get the value of the
-                     * item at the head of the delayed list.  This is the time
-                     * at which the task at the head of the delayed list must
-                     * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-                    if( xConstTickCount < xItemValue )
-                    {
-                        /* It is not time to unblock this item yet, but the
-                         * item value is the time at which the task at the head
-                         * of the blocked list must be removed from the Blocked
-                         * state -  so record the item value in
-                         * xNextTaskUnblockTime. */
-                        xNextTaskUnblockTime = xItemValue;
-                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* It is time to remove the item from the Blocked state. */
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-
-                    /* Is the task waiting on an event also?  If so remove
-                     * it from the event list. */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
                     {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                        /* The delayed list is empty.  Set xNextTaskUnblockTime
+                         * to the maximum possible value so it is extremely
+                         * unlikely that the
+                         * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                         * next time through. */
+                        xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                        break;
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                        /* The delayed list is not empty, get the value of the
+                         * item at the head of the delayed list.  This is the time
+                         * at which the task at the head of the delayed list must
+                         * be removed from the Blocked state. */
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                        xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+                        if( xConstTickCount < xItemValue )
+                        {
+                            /* It is not time to unblock this item yet, but the
+                             * item value is the time at which the task at the head
+                             * of the blocked list must be removed from the Blocked
+                             * state -  so record the item value in
+                             * xNextTaskUnblockTime. */
+                            xNextTaskUnblockTime = xItemValue;
+                            break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
 
-                    /* Place the unblocked task into the appropriate ready
-                     * list. */
-                    prvAddTaskToReadyList( pxTCB );
+                        /* It is time to remove the item from the Blocked state. */
+                        listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
 
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
-                    {
-                        /* Preemption is on, but a context switch should
-                         * only be performed if the unblocked task's
-                         * priority is higher than the currently executing
-                         * task.
-                         * The case of equal priority tasks sharing
-                         * processing time (which happens when both
-                         * preemption and time slicing are on) is
-                         * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        /* Is the task waiting on an event also?  If so remove
+                         * it from the event list. */
+                        if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
                         {
-                            xSwitchRequired = pdTRUE;
+                            listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
+
+                        /* Place the unblocked task into the appropriate ready
+                         * list. */
+                        taskRELEASE_JOB( pxTCB, xItemValue );
+                        taskRECORD_WAKE_TIME( pxTCB );
+                        prvAddTaskToReadyList( pxTCB );
+
+                        /* A task being unblocked cannot cause an immediate
+                         * context switch if preemption is turned off. */
+                        #if ( configUSE_PREEMPTION == 1 )
+                        {
+                            /* Preemption is on, but a context switch should
+                             * only be performed if the unblocked task's
+                             * priority is higher than the currently executing
+                             * task.
+                             * The case of equal priority tasks sharing
+                             * processing time (which happens when both
+                             * preemption and time slicing are on) is
+                             * handled below.*/
+                            if( taskSHOULD_PREEMPT( pxTCB ) )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configUSE_PREEMPTION */
                     }
-                    #endif /* configUSE_PREEMPTION */
                 }
             }
         }
+        #else /* configUSE_DELAYED_TASK_WHEEL */
+        {
+            /* Only the wheel slots that hold tasks waking at this tick, or
+             * tasks due to move down the wheel at this tick, are visited. */
+            if( xConstTickCount >= xNextTaskUnblockTime )
+            {
+                if( prvProcessDelayedTaskWheel( xConstTickCount ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvResetNextTaskUnblockTime();
+            }
+        }
+        #endif /* configUSE_DELAYED_TASK_WHEEL */
 
         /* Tasks of equal priority to the currently running task will share
          * processing time (time slice) if preemption is on, and the application
          * writer has not explicitly turned time slicing off. */
         #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                xSwitchRequired = pdTRUE;
+                if( taskSHOULD_TIME_SLICE( pxCurrentTCB->uxPriority ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #else /* configNUMBER_OF_CORES */
             {
-                mtCOVERAGE_TEST_MARKER();
+                BaseType_t xCoreID;
+
+                /* Every core is time sliced from the one tick interrupt. */
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( taskSHOULD_TIME_SLICE( pxCurrentTCBs[ xCoreID ]->uxPriority ) != pdFALSE )
+                    {
+                        if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            prvYieldCore( xCoreID );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
+            #endif /* configNUMBER_OF_CORES */
         }
         #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
@@ -2905,7 +4085,7 @@ BaseType_t xTaskIncrementTick( void )
          * getting set. */
         if( xTask == NULL )
         {
-            xTCB = ( TCB_t * ) pxCurrentTCB;
+            xTCB = ( TCB_t * ) prvGetTCBFromHandle( NULL );
         }
         else
         {
@@ -2961,11 +4141,11 @@ BaseType_t xTaskIncrementTick( void )
 
         /* Save the hook function in the TCB.  A critical section is required as
          * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             xReturn = pxTCB->pxTaskTag;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
@@ -2984,7 +4164,7 @@ BaseType_t xTaskIncrementTick( void )
         /* If xTask is NULL then we are calling our own task hook. */
         if( xTask == NULL )
         {
-            xTCB = pxCurrentTCB;
+            xTCB = prvGetTCBFromHandle( NULL );
         }
         else
         {
@@ -3006,8 +4186,204 @@ BaseType_t xTaskIncrementTick( void )
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+    {
+        UBaseType_t uxCurrentPriority = uxTopReadyPriority;
+        BaseType_t xTaskScheduled = pdFALSE;
+        BaseType_t xDecrementTopPriority = pdTRUE;
+        List_t * pxReadyList;
+        TCB_t * pxTCB;
+        UBaseType_t uxTasksChecked;
+
+        /* The task that was running on this core is a candidate again. */
+        if( pxCurrentTCBs[ xCoreID ] != NULL )
+        {
+            pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        while( xTaskScheduled == pdFALSE )
+        {
+            pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
+
+            if( listLIST_IS_EMPTY( pxReadyList ) == pdFALSE )
+            {
+                /* uxTopReadyPriority must not be lowered past a list that
+                 * holds a task, even if that task is running on another core. */
+                xDecrementTopPriority = pdFALSE;
+
+                /* listGET_OWNER_OF_NEXT_ENTRY() starts from the task selected
+                 * from this list last time so tasks of equal priority are
+                 * selected in turn, other than in the EDF band, which is always
+                 * searched from the earliest deadline. */
+                taskEDF_SELECT_FROM_HEAD( uxCurrentPriority );
+
+                for( uxTasksChecked = 0U; uxTasksChecked < listCURRENT_LIST_LENGTH( pxReadyList ); uxTasksChecked++ )
+                {
+                    listGET_OWNER_OF_NEXT_ENTRY( pxTCB, pxReadyList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                    if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                    {
+                        #if ( configUSE_CORE_AFFINITY == 1 )
+                            if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                        #endif
+                        {
+                            pxTCB->xTaskRunState = xCoreID;
+                            pxCurrentTCBs[ xCoreID ] = pxTCB;
+                            xTaskScheduled = pdTRUE;
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xTaskScheduled == pdFALSE )
+            {
+                /* There is an idle task for every core, so a task will always
+                 * be found by the time the idle priority is reached. */
+                configASSERT( uxCurrentPriority > tskIDLE_PRIORITY );
+
+                if( xDecrementTopPriority != pdFALSE )
+                {
+                    --uxTopReadyPriority;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                --uxCurrentPriority;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+
+    static BaseType_t prvYieldForTask( const TCB_t * pxTCB )
+    {
+        const BaseType_t xCurrentCoreID = ( BaseType_t ) portGET_CORE_ID();
+        const TCB_t * pxLowestTCB = pxTCB;
+        BaseType_t xLowestPriorityCoreID = taskTASK_NOT_RUNNING;
+        BaseType_t xCoreID, x;
+        BaseType_t xReturn = pdFALSE;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Cores are checked starting from the calling core, and a core is
+             * only chosen over one already found if it is running a task that
+             * pxTCB, or the task running on that core, should strictly run
+             * before, so the calling core is preferred.  Other
+             * cores that are already going to reschedule are skipped as they
+             * will select pxTCB anyway if it is of high enough priority. */
+            for( x = 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+            {
+                xCoreID = ( xCurrentCoreID + x ) % ( BaseType_t ) configNUMBER_OF_CORES;
+
+                if( ( taskRUNS_BEFORE( pxLowestTCB, pxCurrentTCBs[ xCoreID ] ) != pdFALSE ) &&
+                    ( ( xCoreID == xCurrentCoreID ) || ( xYieldPendings[ xCoreID ] == pdFALSE ) ) )
+                {
+                    #if ( configUSE_CORE_AFFINITY == 1 )
+                        if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                    #endif
+                    {
+                        pxLowestTCB = pxCurrentTCBs[ xCoreID ];
+                        xLowestPriorityCoreID = xCoreID;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( xLowestPriorityCoreID == xCurrentCoreID )
+            {
+                xYieldPendings[ xCurrentCoreID ] = pdTRUE;
+                xReturn = pdTRUE;
+            }
+            else if( xLowestPriorityCoreID != taskTASK_NOT_RUNNING )
+            {
+                prvYieldCore( xLowestPriorityCoreID );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvYieldCore( BaseType_t xCoreID )
+    {
+        if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+        {
+            /* The calling core yields when it leaves its critical section or
+             * unsuspends the scheduler. */
+            xYieldPendings[ xCoreID ] = pdTRUE;
+        }
+        else if( xYieldPendings[ xCoreID ] == pdFALSE )
+        {
+            /* Only interrupt the other core if it is not already going to
+             * reschedule. */
+            xYieldPendings[ xCoreID ] = pdTRUE;
+            portYIELD_CORE( xCoreID );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES == 1 )
+    void vTaskSwitchContext( void )
+#else
+    void vTaskSwitchContext( BaseType_t xCoreID )
+#endif
 {
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* A core can only switch its own context.  The locks are taken in the
+         * same order as by a critical section so the ready lists cannot change
+         * while the next task is selected. */
+        configASSERT( xCoreID == ( BaseType_t ) portGET_CORE_ID() );
+        portGET_TASK_LOCK();
+        portGET_ISR_LOCK();
+    }
+    #endif /* configNUMBER_OF_CORES */
+
     if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
     {
         /* The scheduler is currently suspended - do not allow a context
@@ -3034,16 +4410,33 @@ void vTaskSwitchContext( void )
              * overflows.  The guard against negative values is to protect
              * against suspect run time stat counter implementations - which
              * are provided by the application, not the kernel. */
-            if( ulTotalRunTime > ulTaskSwitchedInTime )
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                if( ulTotalRunTime > ulTaskSwitchedInTime )
+                {
+                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulTaskSwitchedInTime = ulTotalRunTime;
             }
-            else
+            #else /* configNUMBER_OF_CORES */
             {
-                mtCOVERAGE_TEST_MARKER();
-            }
+                if( ulTotalRunTime > ulTaskSwitchedInTime[ xCoreID ] )
+                {
+                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime[ xCoreID ] );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-            ulTaskSwitchedInTime = ulTotalRunTime;
+                ulTaskSwitchedInTime[ xCoreID ] = ulTotalRunTime;
+            }
+            #endif /* configNUMBER_OF_CORES */
         }
         #endif /* configGENERATE_RUN_TIME_STATS */
 
@@ -3059,9 +4452,29 @@ void vTaskSwitchContext( void )
 
         /* Select a new task to run using either the generic C or port
          * optimised asm code. */
-        taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #if ( configNUMBER_OF_CORES == 1 )
+            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #else
+            prvSelectHighestPriorityTask( xCoreID );
+        #endif
         traceTASK_SWITCHED_IN();
 
+        #if ( configUSE_WAKE_LATENCY_HISTOGRAMS == 1 )
+        {
+            /* ulTotalRunTime was read above, as configGENERATE_RUN_TIME_STATS
+             * is 1, so is the time at which the new task is switched in. */
+            if( pxCurrentTCB->ucWakeTimeRecorded != ( uint8_t ) pdFALSE )
+            {
+                pxCurrentTCB->ucWakeTimeRecorded = ( uint8_t ) pdFALSE;
+                prvRecordWakeLatency( pxCurrentTCB, ulTotalRunTime );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_WAKE_LATENCY_HISTOGRAMS */
+
         /* After the new task is switched in, update the global errno. */
         #if ( configUSE_POSIX_ERRNO == 1 )
         {
@@ -3077,6 +4490,13 @@ void vTaskSwitchContext( void )
         }
         #endif
     }
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        portRELEASE_ISR_LOCK();
+        portRELEASE_TASK_LOCK();
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -3191,6 +4611,8 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
     if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
     {
         listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+        taskRELEASE_JOB( pxUnblockedTCB, xTickCount );
+        taskRECORD_WAKE_TIME( pxUnblockedTCB );
         prvAddTaskToReadyList( pxUnblockedTCB );
 
         #if ( configUSE_TICKLESS_IDLE != 0 )
@@ -3211,10 +4633,12 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
     {
         /* The delayed and ready lists cannot be accessed, so hold this task
          * pending until the scheduler is resumed. */
+        taskRELEASE_JOB( pxUnblockedTCB, xTickCount );
+        taskRECORD_WAKE_TIME( pxUnblockedTCB );
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    if( taskSHOULD_PREEMPT( pxUnblockedTCB ) )
     {
         /* Return true if the task removed from the event list has a higher
          * priority than the calling task.  This allows the calling task to know if
@@ -3270,9 +4694,11 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
      * scheduler is suspended so interrupts will not be accessing the ready
      * lists. */
     listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+    taskRELEASE_JOB( pxUnblockedTCB, xTickCount );
+    taskRECORD_WAKE_TIME( pxUnblockedTCB );
     prvAddTaskToReadyList( pxUnblockedTCB );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    if( taskSHOULD_PREEMPT( pxUnblockedTCB ) )
     {
         /* The unblocked task has a priority above that of the calling task, so
          * a context switch is required.  This function is called with the
@@ -3283,6 +4709,63 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                     const TickType_t xItemValue )
+{
+    TCB_t * pxUnblockedTCB;
+    BaseType_t xReturn;
+
+    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+     * called from a critical section within an ISR.  It is used by the event
+     * flags implementation when bits can be set directly from an interrupt. */
+
+    /* Store the new item value in the event list. */
+    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( pxEventListItem );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+        taskRELEASE_JOB( pxUnblockedTCB, xTickCount );
+        taskRECORD_WAKE_TIME( pxUnblockedTCB );
+        prvAddTaskToReadyList( pxUnblockedTCB );
+
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            /* See the comment in xTaskRemoveFromEventList(). */
+            prvResetNextTaskUnblockTime();
+        }
+        #endif
+    }
+    else
+    {
+        /* The delayed and ready lists cannot be accessed, so hold this task
+         * pending until the scheduler is resumed.  The event list item keeps
+         * the value stored above while it is in the pending ready list. */
+        taskRELEASE_JOB( pxUnblockedTCB, xTickCount );
+        taskRECORD_WAKE_TIME( pxUnblockedTCB );
+        listINSERT_END( &( xPendingReadyList ), pxEventListItem );
+    }
+
+    if( taskSHOULD_PREEMPT( pxUnblockedTCB ) )
+    {
+        /* Mark that a yield is pending in case the user is not using the
+         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+        xReturn = pdTRUE;
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
     configASSERT( pxTimeOut );
@@ -3463,8 +4946,9 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
              * A critical region is not required here as we are just reading from
              * the list, and an occasional incorrect value will not matter.  If
              * the ready list at the idle priority contains more than one task
-             * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+             * then a task other than the idle task is ready to execute.  There
+             * is one idle task per core. */
+            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
             {
                 taskYIELD();
             }
@@ -3537,10 +5021,50 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
             }
         }
         #endif /* configUSE_TICKLESS_IDLE */
+
+        #if ( configUSE_VIRTUAL_TIME == 1 )
+        {
+            prvAdvanceVirtualTime();
+        }
+        #endif /* configUSE_VIRTUAL_TIME */
     }
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_VIRTUAL_TIME == 1 )
+
+    static void prvAdvanceVirtualTime( void )
+    {
+        TickType_t xTicksToAdvance;
+
+        /* Without a periodic tick nothing else can make a task ready, so the
+         * expected idle time cannot change while it is used. */
+        taskENTER_CRITICAL();
+        {
+            xTicksToAdvance = prvGetExpectedIdleTime();
+        }
+        taskEXIT_CRITICAL();
+
+        if( xTicksToAdvance > ( TickType_t ) 0U )
+        {
+            /* The ticks are processed when the scheduler is resumed inside
+             * xTaskCatchUpTicks(), which skips straight to the unblock time and
+             * switches to the task that is unblocked. */
+            traceVIRTUAL_TIME_ADVANCE( xTicksToAdvance );
+            ( void ) xTaskCatchUpTicks( xTicksToAdvance );
+        }
+        else
+        {
+            /* Another task at the idle priority is ready, or the tick count
+             * has reached the unblock time.  There is no tick to time slice, so
+             * let any other task at the idle priority run. */
+            taskYIELD();
+        }
+    }
+
+#endif /* configUSE_VIRTUAL_TIME */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TICKLESS_IDLE != 0 )
 
     eSleepModeStatus eTaskConfirmSleepModeStatus( void )
@@ -3663,8 +5187,27 @@ static void prvInitialiseTaskLists( void )
         vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
     }
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
+    #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+    {
+        vListInitialise( &xDelayedTaskList1 );
+        vListInitialise( &xDelayedTaskList2 );
+    }
+    #else
+    {
+        UBaseType_t uxLevel, uxSlot;
+
+        for( uxLevel = 0U; uxLevel < taskWHEEL_LEVELS; uxLevel++ )
+        {
+            for( uxSlot = 0U; uxSlot < taskWHEEL_SLOTS; uxSlot++ )
+            {
+                vListInitialise( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ) );
+            }
+
+            ulDelayedTaskWheelSlotsInUse[ uxLevel ] = 0U;
+        }
+    }
+    #endif /* configUSE_DELAYED_TASK_WHEEL */
+
     vListInitialise( &xPendingReadyList );
 
     #if ( INCLUDE_vTaskDelete == 1 )
@@ -3679,13 +5222,60 @@ static void prvInitialiseTaskLists( void )
     }
     #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+    {
+        /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+         * using list2. */
+        pxDelayedTaskList = &xDelayedTaskList1;
+        pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) && ( configUSE_READY_PRIORITY_BITMAP_BUILTIN == 0 ) )
+
+    static UBaseType_t prvCountLeadingZeros( uint32_t ulBits )
+    {
+        UBaseType_t uxZeros = 0U;
+
+        /* A fixed number of steps regardless of the value, so selecting the
+         * highest priority ready task takes constant time. */
+        if( ( ulBits & 0xffff0000UL ) == 0U )
+        {
+            uxZeros += 16U;
+            ulBits <<= 16U;
+        }
+
+        if( ( ulBits & 0xff000000UL ) == 0U )
+        {
+            uxZeros += 8U;
+            ulBits <<= 8U;
+        }
+
+        if( ( ulBits & 0xf0000000UL ) == 0U )
+        {
+            uxZeros += 4U;
+            ulBits <<= 4U;
+        }
+
+        if( ( ulBits & 0xc0000000UL ) == 0U )
+        {
+            uxZeros += 2U;
+            ulBits <<= 2U;
+        }
+
+        if( ( ulBits & 0x80000000UL ) == 0U )
+        {
+            uxZeros += 1U;
+        }
+
+        return uxZeros;
+    }
+
+#endif /* ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) && ( configUSE_READY_PRIORITY_BITMAP_BUILTIN == 0 ) ) */
+/*-----------------------------------------------------------*/
+
 static void prvCheckTasksWaitingTermination( void )
 {
     /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
@@ -3698,16 +5288,64 @@ static void prvCheckTasksWaitingTermination( void )
          * being called too often in the idle task. */
         while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
         {
-            taskENTER_CRITICAL();
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                --uxCurrentNumberOfTasks;
-                --uxDeletedTasksWaitingCleanUp;
+                taskENTER_CRITICAL();
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    --uxCurrentNumberOfTasks;
+                    --uxDeletedTasksWaitingCleanUp;
+                }
+                taskEXIT_CRITICAL();
+
+                prvDeleteTCB( pxTCB );
             }
-            taskEXIT_CRITICAL();
+            #else /* configNUMBER_OF_CORES */
+            {
+                pxTCB = NULL;
 
-            prvDeleteTCB( pxTCB );
+                taskENTER_CRITICAL();
+                {
+                    /* The idle task of another core may have cleaned up the
+                     * last deleted task since uxDeletedTasksWaitingCleanUp was
+                     * checked. */
+                    if( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+                    {
+                        /* A task that deleted itself keeps running on its core
+                         * until that core next switches context, so it cannot be
+                         * freed until then. */
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                        if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                        {
+                            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                            --uxCurrentNumberOfTasks;
+                            --uxDeletedTasksWaitingCleanUp;
+                        }
+                        else
+                        {
+                            pxTCB = NULL;
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( pxTCB != NULL )
+                {
+                    prvDeleteTCB( pxTCB );
+                }
+                else
+                {
+                    /* Try again the next time the idle task runs. */
+                    break;
+                }
+            }
+            #endif /* configNUMBER_OF_CORES */
         }
     }
     #endif /* INCLUDE_vTaskDelete */
@@ -3756,12 +5394,18 @@ static void prvCheckTasksWaitingTermination( void )
         }
         #endif
 
+        #if ( configUSE_WAKE_LATENCY_HISTOGRAMS == 1 )
+        {
+            ( void ) memcpy( ( void * ) pxTaskStatus->ulWakeLatencyHistogram, ( void * ) pxTCB->ulWakeLatencyHistogram, sizeof( pxTaskStatus->ulWakeLatencyHistogram ) );
+        }
+        #endif
+
         /* Obtaining the task state is a little fiddly, so is only done if the
          * value of eState passed into this function is eInvalid - otherwise the
          * state is just set to whatever is passed in. */
         if( eState != eInvalid )
         {
-            if( pxTCB == pxCurrentTCB )
+            if( taskTASK_IS_RUNNING( pxTCB ) )
             {
                 pxTaskStatus->eCurrentState = eRunning;
             }
@@ -3996,42 +5640,340 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+
+    static void prvResetNextTaskUnblockTime( void )
+    {
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+        {
+            /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+             * the maximum possible value so it is  extremely unlikely that the
+             * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+             * there is an item in the delayed list. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            /* The new current delayed list is not empty, get the value of
+             * the item at the head of the delayed list.  This is the time at
+             * which the task at the head of the delayed list should be removed
+             * from the Blocked state. */
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
+    }
+
+#else /* configUSE_DELAYED_TASK_WHEEL */
+
+    static UBaseType_t prvLowestWheelSlot( uint32_t ulSlots )
+    {
+        UBaseType_t uxSlot;
+
+        #if defined( __GNUC__ )
+        {
+            uxSlot = ( UBaseType_t ) __builtin_ctzl( ( unsigned long ) ulSlots );
+        }
+        #else
+        {
+            for( uxSlot = 0U; ( ulSlots & ( ( uint32_t ) 1U << uxSlot ) ) == 0U; uxSlot++ )
+            {
+            }
+        }
+        #endif
+
+        return uxSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvWheelSlotTime( UBaseType_t uxLevel,
+                                        UBaseType_t uxSlot,
+                                        TickType_t xTimeNow )
     {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
+        const UBaseType_t uxShift = uxLevel * taskWHEEL_SLOT_BITS;
+        const UBaseType_t uxUpperShift = uxShift + taskWHEEL_SLOT_BITS;
+        TickType_t xUpperBits = ( TickType_t ) 0U;
+
+        /* The bits of xTimeNow above this level are kept, the bits for this
+         * level are the slot number and the bits below this level are zero.
+         * That is the tick count at which the slot is next reached. */
+        if( uxUpperShift < taskWHEEL_TICK_BITS )
+        {
+            xUpperBits = ( xTimeNow >> uxUpperShift ) << uxUpperShift;
+        }
+
+        return xUpperBits | ( ( TickType_t ) uxSlot << uxShift );
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvInsertIntoDelayedTaskWheel( ListItem_t * pxStateListItem,
+                                                     TickType_t xTimeNow )
+    {
+        const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxStateListItem );
+        TickType_t xDifferentBits = xTimeToWake ^ xTimeNow;
+        UBaseType_t uxLevel = 0U, uxSlot;
+        TickType_t xSlotTime;
+
+        /* The level is the most significant group of bits in which the wake
+         * time differs from the current time, so the task only moves down a
+         * level when the tick count reaches the slot it is held in.  A wake time
+         * that has overflowed differs from the current time in the top level. */
+        while( ( xDifferentBits >> taskWHEEL_SLOT_BITS ) != ( TickType_t ) 0U )
+        {
+            xDifferentBits >>= taskWHEEL_SLOT_BITS;
+            uxLevel++;
+        }
+
+        uxSlot = ( UBaseType_t ) ( xTimeToWake >> ( uxLevel * taskWHEEL_SLOT_BITS ) ) & taskWHEEL_SLOT_MASK;
+
+        listINSERT_END( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ), pxStateListItem );
+        ulDelayedTaskWheelSlotsInUse[ uxLevel ] |= ( uint32_t ) 1U << uxSlot;
+
+        xSlotTime = prvWheelSlotTime( uxLevel, uxSlot, xTimeNow );
+
+        if( xSlotTime <= xTimeNow )
+        {
+            /* The slot will not be reached until the tick count has
+             * overflowed, at which point xNextTaskUnblockTime is recalculated
+             * anyway. */
+            xSlotTime = portMAX_DELAY;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xSlotTime;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvProcessDelayedTaskWheel( TickType_t xTimeNow )
+    {
+        UBaseType_t uxLevel, uxSlot;
+        List_t * pxSlotList;
+        TCB_t * pxTCB;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        /* Every level for which all the lower bits of xTimeNow are zero has
+         * reached a new slot.  The tasks held in that slot now share all but
+         * their lower bits with xTimeNow so are moved down the wheel, starting
+         * from the top so a task can fall through several levels at once. */
+        for( uxLevel = taskWHEEL_LEVELS - ( UBaseType_t ) 1U; uxLevel > ( UBaseType_t ) 0U; uxLevel-- )
+        {
+            if( ( xTimeNow & ( ( ( TickType_t ) 1U << ( uxLevel * taskWHEEL_SLOT_BITS ) ) - ( TickType_t ) 1U ) ) == ( TickType_t ) 0U )
+            {
+                uxSlot = ( UBaseType_t ) ( xTimeNow >> ( uxLevel * taskWHEEL_SLOT_BITS ) ) & taskWHEEL_SLOT_MASK;
+
+                if( ( ulDelayedTaskWheelSlotsInUse[ uxLevel ] & ( ( uint32_t ) 1U << uxSlot ) ) != 0U )
+                {
+                    ulDelayedTaskWheelSlotsInUse[ uxLevel ] &= ~( ( uint32_t ) 1U << uxSlot );
+                    pxSlotList = &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] );
+
+                    while( listLIST_IS_EMPTY( pxSlotList ) == pdFALSE )
+                    {
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxSlotList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                        listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                        ( void ) prvInsertIntoDelayedTaskWheel( &( pxTCB->xStateListItem ), xTimeNow );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* If the lower bits are not zero for this level they are not
+                 * zero for any level above it either. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        /* Every task in the bottom level slot for xTimeNow has reached its
+         * wake time. */
+        uxSlot = ( UBaseType_t ) xTimeNow & taskWHEEL_SLOT_MASK;
+        ulDelayedTaskWheelSlotsInUse[ 0 ] &= ~( ( uint32_t ) 1U << uxSlot );
+        pxSlotList = &( xDelayedTaskWheel[ 0 ][ uxSlot ] );
+
+        while( listLIST_IS_EMPTY( pxSlotList ) == pdFALSE )
+        {
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxSlotList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* It is time to remove the item from the Blocked state. */
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+            /* Is the task waiting on an event also?  If so remove it from
+             * the event list. */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            taskRELEASE_JOB( pxTCB, xTimeNow );
+            taskRECORD_WAKE_TIME( pxTCB );
+            prvAddTaskToReadyList( pxTCB );
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                if( taskSHOULD_PREEMPT( pxTCB ) )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_PREEMPTION */
+        }
+
+        return xSwitchRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddCurrentTaskToDelayedTaskWheel( TickType_t xTimeToWake,
+                                                     const TickType_t xConstTickCount )
+    {
+        TickType_t xSlotTime;
+
+        /* A wake time equal to the current tick count would not be reached
+         * again until the tick count overflows, so it is treated as the next
+         * tick - which is when the delayed lists would unblock the task too. */
+        if( xTimeToWake == xConstTickCount )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake + ( TickType_t ) 1U );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xSlotTime = prvInsertIntoDelayedTaskWheel( &( pxCurrentTCB->xStateListItem ), xConstTickCount );
+
+        /* If the task's slot is the next one the wheel will reach then
+         * xNextTaskUnblockTime needs to be updated too. */
+        if( xSlotTime < xNextTaskUnblockTime )
+        {
+            xNextTaskUnblockTime = xSlotTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+
+        static BaseType_t prvIsDelayedTaskWheelList( const List_t * pxList )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            if( ( pxList >= &( xDelayedTaskWheel[ 0 ][ 0 ] ) ) &&
+                ( pxList <= &( xDelayedTaskWheel[ taskWHEEL_LEVELS - ( UBaseType_t ) 1U ][ taskWHEEL_SLOT_MASK ] ) ) )
+            {
+                xReturn = pdTRUE;
+            }
+
+            return xReturn;
+        }
+
+    #endif /* if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    static void prvResetNextTaskUnblockTime( void )
+    {
+        const TickType_t xTimeNow = xTickCount;
+        UBaseType_t uxLevel, uxSlot;
+        uint32_t ulLaterSlots;
+
         xNextTaskUnblockTime = portMAX_DELAY;
+
+        /* Every slot that can be reached before the tick count overflows is
+         * above the current position in its level, and any such slot in a
+         * level is reached before any such slot in the levels above it.  The
+         * first level with a slot in use above the current position therefore
+         * gives the time at which the wheel next needs processing.  That can
+         * be a slot whose tasks only move down a level rather than unblock, so
+         * xNextTaskUnblockTime is never later than the next wake time but can
+         * be earlier, and a tickless idle period can end without a task
+         * unblocking.  Slots whose tasks have since been removed by other
+         * means are cleared as they are found. */
+        for( uxLevel = 0U; uxLevel < taskWHEEL_LEVELS; uxLevel++ )
+        {
+            uxSlot = ( UBaseType_t ) ( xTimeNow >> ( uxLevel * taskWHEEL_SLOT_BITS ) ) & taskWHEEL_SLOT_MASK;
+            ulLaterSlots = ulDelayedTaskWheelSlotsInUse[ uxLevel ] & ( ( ~( uint32_t ) 0U << uxSlot ) << 1U );
+
+            while( ulLaterSlots != 0U )
+            {
+                uxSlot = prvLowestWheelSlot( ulLaterSlots );
+
+                if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ) ) == pdFALSE )
+                {
+                    xNextTaskUnblockTime = prvWheelSlotTime( uxLevel, uxSlot, xTimeNow );
+                    break;
+                }
+
+                ulDelayedTaskWheelSlotsInUse[ uxLevel ] &= ~( ( uint32_t ) 1U << uxSlot );
+                ulLaterSlots &= ~( ( uint32_t ) 1U << uxSlot );
+            }
+
+            if( xNextTaskUnblockTime != portMAX_DELAY )
+            {
+                break;
+            }
+        }
     }
-    else
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) )
+
+    TaskHandle_t xTaskGetCurrentTaskHandle( void )
     {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        TaskHandle_t xReturn;
+
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            /* A critical section is not required as this is not called from
+             * an interrupt and the current TCB will always be the same for any
+             * individual execution thread. */
+            xReturn = pxCurrentTCB;
+        }
+        #else /* configNUMBER_OF_CORES */
+        {
+            UBaseType_t uxSavedInterruptStatus;
+
+            /* Interrupts are masked so the calling task cannot be moved to
+             * another core between reading the core ID and reading the TCB
+             * running on that core. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        #endif /* configNUMBER_OF_CORES */
+
+        return xReturn;
     }
-}
+
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    TaskHandle_t xTaskGetCurrentTaskHandle( void )
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
     {
-        TaskHandle_t xReturn;
-
-        /* A critical section is not required as this is not called from
-         * an interrupt and the current TCB will always be the same for any
-         * individual execution thread. */
-        xReturn = pxCurrentTCB;
+        configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
 
-        return xReturn;
+        return pxCurrentTCBs[ xCoreID ];
     }
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -4040,21 +5982,33 @@ static void prvResetNextTaskUnblockTime( void )
     {
         BaseType_t xReturn;
 
-        if( xSchedulerRunning == pdFALSE )
-        {
-            xReturn = taskSCHEDULER_NOT_STARTED;
-        }
-        else
+        #if ( configNUMBER_OF_CORES > 1 )
+
+            /* Wait for any other core that has suspended the scheduler to
+             * resume it, so that only a scheduler suspended by the calling core
+             * is reported. */
+            taskENTER_CRITICAL();
+        #endif
         {
-            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            if( xSchedulerRunning == pdFALSE )
             {
-                xReturn = taskSCHEDULER_RUNNING;
+                xReturn = taskSCHEDULER_NOT_STARTED;
             }
             else
             {
-                xReturn = taskSCHEDULER_SUSPENDED;
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    xReturn = taskSCHEDULER_RUNNING;
+                }
+                else
+                {
+                    xReturn = taskSCHEDULER_SUSPENDED;
+                }
             }
         }
+        #if ( configNUMBER_OF_CORES > 1 )
+            taskEXIT_CRITICAL();
+        #endif
 
         return xReturn;
     }
@@ -4318,6 +6272,22 @@ static void prvResetNextTaskUnblockTime( void )
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+
+                    #if ( configNUMBER_OF_CORES > 1 )
+                    {
+                        /* The mutex holder may be running on another core, in
+                         * which case a task of higher priority than its
+                         * disinherited priority may now need to run there. */
+                        if( ( taskTASK_IS_RUNNING( pxTCB ) ) && ( uxPriorityToUse < uxPriorityUsedOnEntry ) )
+                        {
+                            prvYieldCore( pxTCB->xTaskRunState );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configNUMBER_OF_CORES */
                 }
                 else
                 {
@@ -4401,6 +6371,185 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* portCRITICAL_NESTING_IN_TCB */
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            {
+                /* The task lock is always taken before the ISR lock so two
+                 * cores cannot each hold the lock the other is waiting for. */
+                portGET_TASK_LOCK();
+                portGET_ISR_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( portGET_CRITICAL_NESTING_COUNT() == 1U )
+            {
+                portASSERT_IF_IN_ISR();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskExitCritical( void )
+    {
+        BaseType_t xYieldCurrentTask;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( portGET_CRITICAL_NESTING_COUNT() > 0U )
+            {
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    /* A yield requested from within the critical section was
+                     * held pending, so is performed now the locks have been
+                     * released. */
+                    xYieldCurrentTask = xYieldPending;
+
+                    portRELEASE_ISR_LOCK();
+                    portRELEASE_TASK_LOCK();
+                    portENABLE_INTERRUPTS();
+
+                    if( xYieldCurrentTask != pdFALSE )
+                    {
+                        portYIELD();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    UBaseType_t vTaskEnterCriticalFromISR( void )
+    {
+        UBaseType_t uxSavedInterruptStatus = 0;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+            /* Interrupts do not access the task lock, so only the ISR lock is
+             * taken. */
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            {
+                portGET_ISR_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxSavedInterruptStatus;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
+    {
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( portGET_CRITICAL_NESTING_COUNT() > 0U )
+            {
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    portRELEASE_ISR_LOCK();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskYieldWithinAPI( void )
+    {
+        if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+        {
+            portYIELD();
+        }
+        else
+        {
+            xYieldPending = pdTRUE;
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
     static char * prvWriteNameToBuffer( char * pcBuffer,
@@ -4658,12 +6807,13 @@ static void prvResetNextTaskUnblockTime( void )
 TickType_t uxTaskResetEventItemValue( void )
 {
     TickType_t uxReturn;
+    TCB_t * const pxTCB = prvGetTCBFromHandle( NULL );
 
-    uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+    uxReturn = listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) );
 
     /* Reset the event list item to its normal value - so it can be used with
      * queues and semaphores. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
     return uxReturn;
 }
@@ -4686,6 +6836,55 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
+
+    void vTaskIncrementMutexHeldCount( TaskHandle_t const pxMutexHolder )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+
+        /* Outside of a critical section the held count is only written by
+         * the task that holds the mutexes, so the calling task can update its
+         * own count without one.  A blocked task's count can only be updated
+         * from a critical section, as when a mutex is passed to it. */
+        configASSERT( pxTCB );
+        ( pxTCB->uxMutexesHeld )++;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    BaseType_t xTaskDecrementMutexHeldCount( TaskHandle_t const pxMutexHolder )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+        BaseType_t xReturn;
+
+        configASSERT( pxTCB );
+        configASSERT( pxTCB->uxMutexesHeld );
+
+        /* If the task has not inherited a priority then giving the mutex only
+         * decrements the held count.  Another task can raise the priority
+         * after it has been checked, but only by waiting for a different mutex
+         * the task still holds, so the count cannot then reach zero here. */
+        if( pxTCB->uxPriority == pxTCB->uxBasePriority )
+        {
+            ( pxTCB->uxMutexesHeld )--;
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            /* The priority may have to be disinherited, which must be done
+             * by xTaskPriorityDisinherit() from a critical section. */
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
@@ -4922,6 +7121,8 @@ TickType_t uxTaskResetEventItemValue( void )
             if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
                 listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                taskRELEASE_JOB( pxTCB, xTickCount );
+                taskRECORD_WAKE_TIME( pxTCB );
                 prvAddTaskToReadyList( pxTCB );
 
                 /* The task should not have been on an event list. */
@@ -4943,7 +7144,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskSHOULD_PREEMPT( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5004,7 +7205,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
         pxTCB = xTaskToNotify;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             if( pulPreviousNotificationValue != NULL )
             {
@@ -5069,16 +7270,20 @@ TickType_t uxTaskResetEventItemValue( void )
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    taskRELEASE_JOB( pxTCB, xTickCount );
+                    taskRECORD_WAKE_TIME( pxTCB );
                     prvAddTaskToReadyList( pxTCB );
                 }
                 else
                 {
                     /* The delayed and ready lists cannot be accessed, so hold
                      * this task pending until the scheduler is resumed. */
+                    taskRELEASE_JOB( pxTCB, xTickCount );
+                    taskRECORD_WAKE_TIME( pxTCB );
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskSHOULD_PREEMPT( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5098,7 +7303,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
@@ -5139,7 +7344,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
         pxTCB = xTaskToNotify;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
             pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
@@ -5160,16 +7365,20 @@ TickType_t uxTaskResetEventItemValue( void )
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    taskRELEASE_JOB( pxTCB, xTickCount );
+                    taskRECORD_WAKE_TIME( pxTCB );
                     prvAddTaskToReadyList( pxTCB );
                 }
                 else
                 {
                     /* The delayed and ready lists cannot be accessed, so hold
                      * this task pending until the scheduler is resumed. */
+                    taskRELEASE_JOB( pxTCB, xTickCount );
+                    taskRECORD_WAKE_TIME( pxTCB );
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskSHOULD_PREEMPT( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5189,7 +7398,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
     }
 
 #endif /* configUSE_TASK_NOTIFICATIONS */
@@ -5261,7 +7470,24 @@ TickType_t uxTaskResetEventItemValue( void )
 
     configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
     {
-        return xIdleTaskHandle->ulRunTimeCounter;
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            return xIdleTaskHandle->ulRunTimeCounter;
+        }
+        #else
+        {
+            configRUN_TIME_COUNTER_TYPE ulReturn = 0;
+            BaseType_t xCoreID;
+
+            /* The run time of all the idle tasks together. */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                ulReturn += xIdleTaskHandles[ xCoreID ]->ulRunTimeCounter;
+            }
+
+            return ulReturn;
+        }
+        #endif
     }
 
 #endif
@@ -5275,13 +7501,19 @@ TickType_t uxTaskResetEventItemValue( void )
 
         ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
 
+        /* The idle tasks of all the cores together can run for the total time
+         * multiplied by the number of cores. */
+        #if ( configNUMBER_OF_CORES > 1 )
+            ulTotalTime *= ( configRUN_TIME_COUNTER_TYPE ) configNUMBER_OF_CORES;
+        #endif
+
         /* For percentage calculations. */
         ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
 
         /* Avoid divide by zero errors. */
         if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
         {
-            ulReturn = xIdleTaskHandle->ulRunTimeCounter / ulTotalTime;
+            ulReturn = ulTaskGetIdleRunTimeCounter() / ulTotalTime;
         }
         else
         {
@@ -5309,6 +7541,22 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     }
     #endif
 
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+    {
+        /* Blocking completes the task's current job, so report the job as late
+         * if its absolute deadline has already passed. */
+        if( ( pxCurrentTCB->xRelativeDeadline != ( TickType_t ) 0U ) &&
+            ( ( TickType_t ) ( pxCurrentTCB->xAbsoluteDeadline - xConstTickCount ) > ( portMAX_DELAY >> 1 ) ) )
+        {
+            traceTASK_DEADLINE_MISSED( pxCurrentTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_EDF_SCHEDULING */
+
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
     if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -5341,30 +7589,38 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             /* The list item will be inserted in wake time order. */
             listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-            if( xTimeToWake < xConstTickCount )
+            #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
             {
-                /* Wake time has overflowed.  Place this item in the overflow
-                 * list. */
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-            }
-            else
-            {
-                /* The wake time has not overflowed, so the current block list
-                 * is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-                /* If the task entering the blocked state was placed at the
-                 * head of the list of blocked tasks then xNextTaskUnblockTime
-                 * needs to be updated too. */
-                if( xTimeToWake < xNextTaskUnblockTime )
+                if( xTimeToWake < xConstTickCount )
                 {
-                    xNextTaskUnblockTime = xTimeToWake;
+                    /* Wake time has overflowed.  Place this item in the overflow
+                     * list. */
+                    vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The wake time has not overflowed, so the current block list
+                     * is used. */
+                    vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+                    /* If the task entering the blocked state was placed at the
+                     * head of the list of blocked tasks then xNextTaskUnblockTime
+                     * needs to be updated too. */
+                    if( xTimeToWake < xNextTaskUnblockTime )
+                    {
+                        xNextTaskUnblockTime = xTimeToWake;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
             }
+            #else
+            {
+                prvAddCurrentTaskToDelayedTaskWheel( xTimeToWake, xConstTickCount );
+            }
+            #endif /* configUSE_DELAYED_TASK_WHEEL */
         }
     }
     #else /* INCLUDE_vTaskSuspend */
@@ -5377,28 +7633,36 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         /* The list item will be inserted in wake time order. */
         listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-        if( xTimeToWake < xConstTickCount )
+        #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
         {
-            /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-        }
-        else
-        {
-            /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-            /* If the task entering the blocked state was placed at the head of the
-             * list of blocked tasks then xNextTaskUnblockTime needs to be updated
-             * too. */
-            if( xTimeToWake < xNextTaskUnblockTime )
+            if( xTimeToWake < xConstTickCount )
             {
-                xNextTaskUnblockTime = xTimeToWake;
+                /* Wake time has overflowed.  Place this item in the overflow list. */
+                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* The wake time has not overflowed, so the current block list is used. */
+                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+                /* If the task entering the blocked state was placed at the head of the
+                 * list of blocked tasks then xNextTaskUnblockTime needs to be updated
+                 * too. */
+                if( xTimeToWake < xNextTaskUnblockTime )
+                {
+                    xNextTaskUnblockTime = xTimeToWake;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
+        #else
+        {
+            prvAddCurrentTaskToDelayedTaskWheel( xTimeToWake, xConstTickCount );
+        }
+        #endif /* configUSE_DELAYED_TASK_WHEEL */
 
         /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
         ( void ) xCanBlockIndefinitely;